@@ -22,9 +22,11 @@
 #include <cstdio>
 #include <csignal>
 #include <string.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <meteoio/MeteoIO.h>
+#include <meteoio/IOHandler.h>
 
 #ifdef _MSC_VER
 	/*
@@ -67,15 +69,44 @@ using namespace mio; //The MeteoIO namespace is called mio
  *    * alternatively, a duration in days with the "-d" option;
  *    * the configuration file to use, with the "-c" option;
  *    * the output sampling rate in minutes with the "-s" option;
- *    * a progressive writing out of the data by specifying how many timesteps to buffer before writing
- * with the "-o" option;
- *    * some progress indicator with the "-p" option.
+ *    * the number of timesteps to buffer before writing them out with the "-o" option (see below);
+ *    * some progress indicator with the "-p" option;
+ *    * a performance report (time spent in each processing stage, cache hit rates, etc) with the "--profile" option
+ * (use "--profile=json" to get it formatted as JSON).
  * 
  * For example, in order to output data from the 1st of September 2004 at noon until the 3rd of April 2008 with 
  * half-hourly values, using the ini file "io_myStation.ini" in the "cfgfiles" sub-directory:
  * @code
  * meteoio_timeseries -c cfgfiles/io_myStation.ini -b 2004-09-01T12:00 -e 2008-04-03 -s 30
  * @endcode
+ *
+ * @subsection meteoio_timeseries_shards Splitting the processing between several processes
+ * Large datasets can be processed by several independent processes (on one or several computers), each of them
+ * processing one shard of the data given as "--shard=k/N" (for k between 1 and N):
+ *    * with "--shard-by=stations" (the default), each process only handles the stations that belong to its shard (see
+ * \ref Stations_shards "SHARD"). The stations are distributed by hashing their IDs, so each station is always
+ * written by the same process and all the processes can write into the same output directory;
+ *    * with "--shard-by=time", the requested period is split into N contiguous time slabs (on the output timesteps), each
+ * process handling one slab. The data is read with margins around each slab that are derived from the resampling and
+ * filtering windows, so the results are the same as for a single run (except for filters that only define their window
+ * as a number of points or depend on the whole history, such as IIR, that are then only covered by the BUFF_BEFORE
+ * margin). Each process writes into the "shard_k" sub-directory of the output METEOPATH. Once all the processes are
+ * done, the time slabs are merged into the output METEOPATH with "--merge-shards=N" (on the same configuration file
+ * and period). This requires an output plugin that can also read back its own outputs from METEOPATH
+ * (such as SMET or iCSV).
+ *
+ * For example, to process one year of data in three time slabs and merge them afterwards:
+ * @code
+ * meteoio_timeseries -c io.ini -b 2008-01-01 -e 2009-01-01 --shard-by=time --shard=1/3
+ * meteoio_timeseries -c io.ini -b 2008-01-01 -e 2009-01-01 --shard-by=time --shard=2/3
+ * meteoio_timeseries -c io.ini -b 2008-01-01 -e 2009-01-01 --shard-by=time --shard=3/3
+ * meteoio_timeseries -c io.ini -b 2008-01-01 -e 2009-01-01 --merge-shards=3
+ * @endcode
+ *
+ * When the output plugin supports it (for example SMET or iCSV), the data is processed and written by chunks of 10000 timesteps
+ * (or the number of timesteps given with the "-o" option), so the memory usage does not depend on the length of the
+ * processed period. Otherwise, all the data is kept in memory and written at the end (or, if the "-o" option is given, written
+ * at each chunk relying on the APPEND mode of the output plugin).
  * 
  * @subsection Inishell The Inishell Graphical User Interface
  * The <a href="https://code.wsl.ch/snow-models/inishell">Inishell</a> software is a tool that automatically and semantically 
@@ -158,7 +189,12 @@ using namespace mio; //The MeteoIO namespace is called mio
 static std::string cfgfile( "io.ini" );
 static double samplingRate = IOUtils::nodata;
 static size_t outputBufferSize = 0;
+static const size_t dflt_chunk_size = 10000; //number of timesteps to process at once when streaming the data
 static unsigned int timeout_secs = 0;
+static bool profile = false, profile_json = false;
+static std::string shard_str; //"k/N" if only one shard of the data should be processed
+static bool shard_by_time = false; //otherwise, by stations
+static size_t merge_shards = 0; //number of time shards to merge
 
 inline void Version()
 {
@@ -180,9 +216,13 @@ inline void Usage(const std::string& programname)
 		<< "\t[-d, --duration=<in days>] (e.g.: 30)\n"
 		<< "\t[-c, --config=<ini file>] (e.g. io.ini)\n"
 		<< "\t[-s, --sampling-rate=<sampling rate in minutes>] (default: 60)\n"
-		<< "\t[-o, --output-buffer=<output buffer size in number of timesteps>] (e.g. 24, requires APPEND mode enabled in output plugin)\n"
+		<< "\t[-o, --output-buffer=<output buffer size in number of timesteps>] (default: 10000 if the output plugin can append chunks, otherwise all)\n"
 		<< "\t[-p, --progress] Show progress\n"
 		<< "\t[-t, --timeout] Kill the process after that many seconds if still running\n"
+		<< "\t[--profile[=text|json]] Print how much time has been spent in each processing stage\n"
+		<< "\t[--shard=k/N] Only process the k-th out of N shards of the data\n"
+		<< "\t[--shard-by=stations|time] Split the data by stations or by time slabs (default: stations)\n"
+		<< "\t[--merge-shards=N] Merge the outputs of N time shards into the output METEOPATH\n"
 		<< "\t[-v, --version] Print the version number\n"
 		<< "\t[-h, --help] Print help message and version information\n\n";
 
@@ -207,6 +247,45 @@ inline Date getDate(const std::string& date_str, const double& TZ)
 	return parsedDate;
 }
 
+static std::string getShardPath(const std::string& outpath, const size_t& shard_nr)
+{
+	return outpath + "/shard_" + IOUtils::toString(shard_nr);
+}
+
+/**
+* @brief Restrict the period to the time slab of the requested shard and redirect the outputs to the shard's sub-directory
+* @details The period is split on the output timesteps, so the slabs do not overlap and their union is the original period.
+* The raw data is read with margins around each slab, derived from the filtering and resampling windows as returned by
+* MeteoProcessor::getWindowSize() (this is done by the TimeSeriesManager for any request). Filters that only define their
+* window by a number of points, or that depend on the whole history (such as IIR) are only covered by the buffer
+* centering margin (BUFF_BEFORE), so they might give slightly different results close to the slab boundaries.
+*/
+static void applyTimeShard(Config& cfg, Date& begin_date, Date& end_date)
+{
+	size_t shard_idx, nr_shards;
+	IOHandler::parseShard(shard_str, shard_idx, nr_shards);
+	
+	const size_t nr_steps = static_cast<size_t>(Optim::floor( (end_date.getJulian() - begin_date.getJulian()) / samplingRate + 1e-6 ) + 1);
+	const size_t start_idx = shard_idx * nr_steps / nr_shards;
+	const size_t end_idx = (shard_idx+1) * nr_steps / nr_shards; //excluded
+	if (start_idx==end_idx)
+		throw InvalidArgumentException("Shard "+shard_str+" is empty: there are only "+IOUtils::toString(nr_steps)+" timesteps to process", AT);
+	
+	const Date slab_begin( begin_date + static_cast<double>(start_idx)*samplingRate );
+	end_date = begin_date + static_cast<double>(end_idx-1)*samplingRate;
+	begin_date = slab_begin;
+	
+	ProcessingProperties window;
+	MeteoProcessor(cfg).getWindowSize( window );
+	std::cout << "Processing time slab " << shard_str << " from " << begin_date.toString(Date::ISO) << " to " << end_date.toString(Date::ISO);
+	std::cout << " with overlaps of " << window.time_before.getJulian()*24. << "h before and " << window.time_after.getJulian()*24. << "h after\n";
+	
+	const std::string meteopath = cfg.get("METEOPATH", "Output");
+	const std::string outpath( getShardPath(meteopath, shard_idx+1) );
+	FileUtils::createDirectories( outpath );
+	cfg.addKey("METEOPATH", "Output", outpath);
+}
+
 inline void parseCmdLine(int argc, char **argv, Config &cfg, Date& begin_date, Date& end_date, bool& showProgress)
 {
 	std::string begin_date_str, end_date_str;
@@ -229,6 +308,10 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg, Date& begin_date, D
 		{"output-buffer", required_argument, nullptr, 0},
 		{"progress", no_argument, nullptr, 0},
 		{"timeout", no_argument, nullptr, 0},
+		{"profile", optional_argument, nullptr, 'P'},
+		{"shard", required_argument, nullptr, 'S'},
+		{"shard-by", required_argument, nullptr, 'B'},
+		{"merge-shards", required_argument, nullptr, 'M'},
 		{"version", no_argument, nullptr, 0},
 		{"help", no_argument, nullptr, 0},
 		{nullptr, 0, nullptr, 0}
@@ -273,6 +356,28 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg, Date& begin_date, D
 			if (!mio::IOUtils::convertString(timeout_secs, std::string(optarg)))
 				throw ConversionFailedException("Could not parse the timeout argument '"+std::string(optarg)+"'", AT);
 			break;
+		case 'P': {
+			const std::string format( (optarg!=nullptr)? IOUtils::strToLower(std::string(optarg)) : "text" );
+			if (format!="text" && format!="json")
+				throw InvalidArgumentException("Unknown profiling output format '"+format+"', please use either 'text' or 'json'", AT);
+			profile = true;
+			profile_json = (format=="json");
+			break;
+		}
+		case 'S':
+			shard_str = std::string(optarg);
+			break;
+		case 'B': {
+			const std::string mode( IOUtils::strToLower(std::string(optarg)) );
+			if (mode!="stations" && mode!="time")
+				throw InvalidArgumentException("Unknown sharding mode '"+mode+"', please use either 'stations' or 'time'", AT);
+			shard_by_time = (mode=="time");
+			break;
+		}
+		case 'M':
+			if (!mio::IOUtils::convertString(merge_shards, std::string(optarg)) || merge_shards==0)
+				throw ConversionFailedException("Could not parse the merge-shards argument '"+std::string(optarg)+"'", AT);
+			break;
 		case 'v': 
 			Version();
 			exit(0);
@@ -298,6 +403,7 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg, Date& begin_date, D
 	}
 	
 	cfg.addFile(cfgfile);
+	if (profile) cfg.addKey("PROFILING", "General", "true");
 	const double TZ = cfg.get("TIME_ZONE", "Input"); //get user provided input time_zone
 	
 	//the date range specification has been validated above
@@ -315,6 +421,13 @@ inline void parseCmdLine(int argc, char **argv, Config &cfg, Date& begin_date, D
 	samplingRate /= 24.*60; //convert to sampling rate in days
 	if (samplingRate<=0)
 		throw InvalidArgumentException("The sampling rate argument must be > 0! (check both on the command line and as configuration key)", AT);
+	
+	if (!shard_str.empty()) {
+		if (merge_shards>0)
+			throw InvalidArgumentException("The --shard and --merge-shards options can not be used together", AT);
+		if (shard_by_time) applyTimeShard(cfg, begin_date, end_date);
+		else cfg.addKey("SHARD", "Input", shard_str);
+	}
 }
 
 static void signal_handler( int signal_num ) 
@@ -340,7 +453,7 @@ static void signals_catching(void)
 
 static void validMeteoData(const std::vector<std::string>& enforce_variables, const mio::MeteoData& md)
 {
-	const std::string msg_head( "[DATA_QA] Missing "+md.meta.getStationID()+"::" );
+	const std::string msg_head( "[DATA_QA] Missing "+md.meta->getStationID()+"::" );
 
 	for (const std::string& var : enforce_variables) {
 		if (md(var) == mio::IOUtils::nodata)
@@ -348,6 +461,92 @@ static void validMeteoData(const std::vector<std::string>& enforce_variables, co
 	}
 }
 
+/**
+* @brief Run the QA checks on a chunk of data and only keep the stations that have valid data
+* @details The chunk contains all the timesteps, even when all the data is missing, so they can be reported. They are then
+* removed and the stations that only had missing data so far are left out, the others keeping the same index in all chunks.
+* @param enforce_variables parameters that must be available
+* @param vecMeteo chunk of data, one vector per station
+* @param mapIDs index of each station that has valid data in the output, updated with the new stations
+*/
+static void qaMeteoData(const std::vector<std::string>& enforce_variables, std::vector< std::vector<MeteoData> >& vecMeteo, std::map<std::string, size_t>& mapIDs)
+{
+	std::vector< std::vector<MeteoData> > vecValid( mapIDs.size() );
+	for (auto& station_data : vecMeteo) {
+		for (const MeteoData& md : station_data) validMeteoData( enforce_variables, md ); //check that we have everything we need
+		station_data.erase( std::remove_if(station_data.begin(), station_data.end(), [](const MeteoData& md) {return md.isNodata();}), station_data.end() );
+		if (station_data.empty()) continue;
+
+		const std::string stationID( station_data.front().meta->stationID );
+		const std::map<std::string, size_t>::const_iterator it = mapIDs.find( stationID );
+		const size_t idx = (it!=mapIDs.end())? it->second : mapIDs.size();
+		if (it==mapIDs.end()) { //first valid data for this station
+			mapIDs[ stationID ] = idx;
+			vecValid.push_back( std::vector<MeteoData>() );
+		}
+		vecValid[idx].swap( station_data );
+	}
+	vecMeteo.swap( vecValid );
+}
+
+/**
+* @brief Merge the outputs of time shards (as generated with --shard-by=time) into the output METEOPATH
+* @details Each shard is read back with the output plugin and the shards are written in chronological order, so only
+* one shard at a time is kept in memory if the output plugin can append data.
+*/
+static void mergeShards(const Config& cfg, const Date& dateBegin, const Date& dateEnd)
+{
+	const std::string outpath = cfg.get("METEOPATH", "Output");
+	IOHandler output(cfg);
+	const bool streaming = output.canAppendMeteoData();
+	
+	std::map<std::string, size_t> mapIDs; //so each station keeps the same index in all shards
+	std::vector< std::vector<MeteoData> > vecMerged;
+	for (size_t kk=1; kk<=merge_shards; kk++) {
+		const std::string shard_path( getShardPath(outpath, kk) );
+		if (!FileUtils::directoryExists(shard_path))
+			throw NotFoundException("Could not find the outputs of shard "+IOUtils::toString(kk)+" in '"+shard_path+"'", AT);
+		std::cout << "Merging shard " << kk << "/" << merge_shards << " from " << shard_path << "\n";
+		
+		Config shard_cfg;
+		shard_cfg.addKey("METEO", "Input", cfg.get("METEO", "Output", std::string()));
+		shard_cfg.addKey("METEOPATH", "Input", shard_path);
+		for (const std::string key : {"TIME_ZONE", "COORDSYS", "COORDPARAM"}) {
+			if (cfg.keyExists(key, "Output")) shard_cfg.addKey(key, "Input", cfg.get(key, "Output", std::string()));
+		}
+		IOHandler input(shard_cfg);
+		std::vector< std::vector<MeteoData> > vecShard;
+		input.readMeteoData(dateBegin, dateEnd, vecShard);
+		
+		if (streaming) vecMerged.assign(mapIDs.size(), std::vector<MeteoData>());
+		for (std::vector<MeteoData>& station : vecShard) {
+			if (station.empty()) continue;
+			const std::string stationHash( station.front().meta->stationID );
+			const std::map<std::string, size_t>::const_iterator it = mapIDs.find( stationHash );
+			const size_t idx = (it!=mapIDs.end())? it->second : mapIDs.size();
+			if (it==mapIDs.end()) mapIDs[ stationHash ] = idx;
+			if (idx>=vecMerged.size()) vecMerged.resize( idx+1 );
+			vecMerged[idx].insert(vecMerged[idx].end(), station.begin(), station.end());
+		}
+		
+		if (streaming) {
+			for (std::vector<MeteoData>& station : vecMerged) MeteoData::unifyMeteoData( station );
+			if (kk==1) output.writeMeteoData( vecMerged );
+			else output.appendMeteoData( vecMerged );
+		}
+	}
+	
+	if (!streaming) {
+		for (std::vector<MeteoData>& station : vecMerged) MeteoData::unifyMeteoData( station );
+		output.writeMeteoData( vecMerged );
+	}
+}
+
+static void printProgress(const Date& date)
+{
+	std::cout << date.toString(Date::ISO) << "\n";
+}
+
 static void real_main(int argc, char* argv[])
 {
 	bool showProgress = false;
@@ -357,6 +556,13 @@ static void real_main(int argc, char* argv[])
 	parseCmdLine(argc, argv, cfg, dateBegin, dateEnd, showProgress);
 	if (timeout_secs!=0) WatchDog watchdog(timeout_secs); //set to kill itself after that many seconds
 	
+	if (merge_shards>0) {
+		std::cout << "Powered by MeteoIO " << getLibVersion() << "\n";
+		mergeShards(cfg, dateBegin, dateEnd);
+		std::cout << "Done!!" << std::endl;
+		return;
+	}
+	
 	IOManager io(cfg);
 	const bool data_qa = cfg.get("DATA_QA_LOGS", "General", false);
 	if (data_qa) cfg.getValue("QA_CHECK_MISSING", "General", enforce_variables, IOUtils::nothrow);
@@ -367,41 +573,28 @@ static void real_main(int argc, char* argv[])
 	Timer timer;
 	timer.start();
 
-	std::map<std::string, size_t> mapIDs; //over a large time range, the number of stations might change... this is the way to make it work
-	std::vector<MeteoData> Meteo; //we need some intermediate storage, for storing data sets for 1 timestep
-	std::vector< std::vector<MeteoData> > vecMeteo; //so we can keep and output the data that has been read
+	//the data is read and written by chunks, so the memory usage does not depend on the length of the period. If the output
+	//plugin can not append chunks, everything is written at once (or at each chunk with the legacy "-o" option)
+	const bool streaming = io.canAppendMeteoData();
+	const size_t chunkSize = (outputBufferSize>0)? outputBufferSize : (streaming)? dflt_chunk_size : 0;
+	MeteoDataStream stream(io, dateBegin, dateEnd, samplingRate, chunkSize);
+	stream.setKeepNodata( data_qa ); //so the QA also reports the timesteps where all the data is missing
+	if (showProgress) stream.setProgressCallback( printProgress );
+	std::vector< std::vector<MeteoData> > vecMeteo; //data for the current chunk
+	std::map<std::string, size_t> mapIDs; //with DATA_QA, the stations that have valid data
 
-	size_t insert_position = 0;
-	size_t count = 0;
-	for (Date d=dateBegin; d<=dateEnd; d+=samplingRate) { //time loop
-		if (showProgress) std::cout << d.toString(Date::ISO) << "\n";
-		count++;
-		io.getMeteoData(d, Meteo); //read 1 timestep at once, forcing resampling to the timestep
-		
-		for (const MeteoData& md : Meteo) {
-			if (data_qa) validMeteoData( enforce_variables, md ); //check that we have everything we need
-			if (md.isNodata()) continue;
-			
-			const std::string stationID( md.meta.stationID );
-			if (mapIDs.count( stationID )==0) { //if this is the first time we encounter this station, save where it should be inserted
-				mapIDs[ stationID ] = insert_position++;
-				vecMeteo.push_back( std::vector<MeteoData>() ); //allocating the new station
-				const size_t nr_samples = static_cast<size_t>(Optim::ceil( (dateEnd.getJulian() - d.getJulian()) / samplingRate ) + 1);
-				const size_t nr_samples_buffered = (outputBufferSize > 0) ? (outputBufferSize) : (nr_samples);
-				vecMeteo[ mapIDs[stationID] ].reserve( std::min(nr_samples, nr_samples_buffered) ); //to avoid memory re-allocations with push_back()
-			}
-			vecMeteo[ mapIDs[stationID] ].push_back(md); //fill the data manually into the vector of vectors
-		}
-		
-		if (outputBufferSize > 0 && count%outputBufferSize == 0) {	// Check for buffered output
-			std::cout << "Writing output data and clearing buffer" << std::endl;
-			//handle extra parameters changing over time
-			for (auto& station_data : vecMeteo) MeteoData::unifyMeteoData( station_data );
+	bool firstChunk = true;
+	while (stream.next(vecMeteo)) {
+
+		if (data_qa) qaMeteoData(enforce_variables, vecMeteo, mapIDs);
+
+		if (firstChunk || !streaming) {
+			if (stream.getNextDate().isUndef()) std::cout << "Writing output data" << std::endl;
+			else std::cout << "Writing output data and clearing buffer" << std::endl;
 			io.writeMeteoData(vecMeteo);
-			for (const MeteoData& md : Meteo) {
-				const std::string stationID( md.meta.stationID );
-				vecMeteo[ mapIDs[stationID] ].clear();
-			}
+			firstChunk = false;
+		} else {
+			io.appendMeteoData(vecMeteo);
 		}
 	}
 
@@ -409,16 +602,12 @@ static void real_main(int argc, char* argv[])
 		std::map<std::string, size_t>::const_iterator it_stats;
 		for (it_stats=mapIDs.begin(); it_stats != mapIDs.end(); ++it_stats) std::cout << "[DATA_QA] Processing " << it_stats->first << "\n";
 	}
-	
-	//In any case, we write the data out
-	std::cout << "Writing output data" << std::endl;
-	//handle extra parameters changing over time
-	for(size_t ii=0; ii<vecMeteo.size(); ii++) MeteoData::unifyMeteoData( vecMeteo[ii] );
-	io.writeMeteoData(vecMeteo);
+	const size_t count = stream.getNrOfTimesteps();
 
 	timer.stop();
 	std::cout << "Number of timesteps: " << count << "\n";
 	std::cout << "Done!! in " << timer.getElapsed() << " s" << std::endl;
+	if (profile) std::cout << "\n" << IOManager::getPerformanceReport(profile_json);
 }
 
 int main(int argc, char** argv)
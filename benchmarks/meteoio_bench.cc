@@ -0,0 +1,973 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/*
+ *  meteoio_bench
+ *
+ *  Copyright WSL Institute for Snow and Avalanche Research SLF, DAVOS, SWITZERLAND
+*/
+/*  This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <limits>
+#include <algorithm>
+#include <meteoio/MeteoIO.h>
+
+#ifdef _MSC_VER
+	#include "getopt.h"
+#else
+	#include <getopt.h> //for getopt_long
+#endif
+
+using namespace mio; //The MeteoIO namespace is called mio
+
+/**
+ * @page meteoio_bench Benchmarks
+ * When MeteoIO is compiled with the BUILD_BENCHMARKS option, the meteoio_bench program is built in the "bin"
+ * sub-directory. It generates synthetic inputs (meteorological time series through the \ref synthio "SYNTH" plugin and
+ * a DEM of configurable size) and measures the throughput of the most performance critical parts of MeteoIO:
+ *    * parsing and writing SMET, CSV and ARC files;
+ *    * applying a stack of common filters;
+ *    * temporal resampling;
+ *    * each spatial interpolation algorithm;
+ *    * computing the DEM properties (slope, azimuth, curvature, normals);
+ *    * computing horizons;
+ *    * spatially resampling grids (the outputs are also compared with a straightforward per-pixel implementation);
+ *    * fitting the 1D regression models (the coefficients are also compared with finite differences Gauss-Newton iterations);
+ *    * reading and writing NetCDF grids (when the NetCDF plugin has been compiled).
+ *
+ * Each benchmark is repeated a few times and the best and mean timings are reported as JSON, so the results can
+ * be archived and compared between versions:
+ * @code
+ * meteoio_bench --dem-size=500 --stations=50 --days=30 --output=bench.json
+ * @endcode
+ */
+
+static const double TZ = 1.;
+static const double cellsize = 100.;
+static const double x_origin = 700000., y_origin = 150000.;
+
+struct BenchParams {
+	BenchParams() : workdir("./meteoio_bench_data"), output(), filter(), dem_size(200), nr_stations(30), nr_days(30), sampling(1800.), repeat(3) {}
+	std::string workdir, output, filter;
+	size_t dem_size, nr_stations, nr_days;
+	double sampling; ///< time series sampling rate in seconds
+	unsigned int repeat;
+};
+
+struct BenchResult {
+	BenchResult() : name(), unit(), skipped(), check(), items(0), best(0.), mean(0.), runs(0) {}
+	std::string name, unit, skipped;
+	std::string check; ///< outcome of the comparison with a reference implementation, if any
+	size_t items; ///< number of items processed in one run
+	double best, mean; ///< timings in seconds
+	unsigned int runs;
+};
+
+static std::vector<BenchResult> results;
+
+inline void Version()
+{
+	std::cout << "MeteoIO version " << mio::getLibVersion() << std::endl;
+}
+
+inline void Usage(const std::string& programname)
+{
+	Version();
+
+	std::cout << "Usage: " << programname << std::endl
+		<< "\t[-g, --dem-size=<number of cells along each side of the DEM>] (default: 200)\n"
+		<< "\t[-n, --stations=<number of stations>] (default: 30)\n"
+		<< "\t[-d, --days=<duration of the time series in days>] (default: 30)\n"
+		<< "\t[-s, --sampling-rate=<sampling rate in minutes>] (default: 30)\n"
+		<< "\t[-r, --repeat=<number of runs of each benchmark>] (default: 3)\n"
+		<< "\t[-w, --workdir=<directory for the generated files>] (default: ./meteoio_bench_data)\n"
+		<< "\t[-f, --filter=<only run the benchmarks whose name contains this string>]\n"
+		<< "\t[-o, --output=<JSON output file>] (default: print to the screen)\n"
+		<< "\t[-v, --version] Print the version number\n"
+		<< "\t[-h, --help] Print help message and version information\n\n";
+	std::cout << "Example use:\n\t" << programname << " --dem-size=500 --stations=50 --output=bench.json\n\n";
+}
+
+template <class T> void parseArg(const char* arg, const std::string& name, T& value)
+{
+	if (!IOUtils::convertString(value, std::string(arg)))
+		throw ConversionFailedException("Could not parse the "+name+" argument '"+std::string(arg)+"'", AT);
+}
+
+inline void parseCmdLine(int argc, char **argv, BenchParams& params)
+{
+	int longindex=0, opt=-1;
+
+	const struct option long_options[] =
+	{
+		{"dem-size", required_argument, nullptr, 'g'},
+		{"stations", required_argument, nullptr, 'n'},
+		{"days", required_argument, nullptr, 'd'},
+		{"sampling-rate", required_argument, nullptr, 's'},
+		{"repeat", required_argument, nullptr, 'r'},
+		{"workdir", required_argument, nullptr, 'w'},
+		{"filter", required_argument, nullptr, 'f'},
+		{"output", required_argument, nullptr, 'o'},
+		{"version", no_argument, nullptr, 'v'},
+		{"help", no_argument, nullptr, 'h'},
+		{nullptr, 0, nullptr, 0}
+	};
+
+	while ((opt=getopt_long( argc, argv, "g:n:d:s:r:w:f:o:vh", long_options, &longindex)) != -1) {
+		switch (opt) {
+		case 'g':
+			parseArg(optarg, "dem-size", params.dem_size);
+			break;
+		case 'n':
+			parseArg(optarg, "stations", params.nr_stations);
+			break;
+		case 'd':
+			parseArg(optarg, "days", params.nr_days);
+			break;
+		case 's':
+			parseArg(optarg, "sampling-rate", params.sampling);
+			params.sampling *= 60.;
+			break;
+		case 'r':
+			parseArg(optarg, "repeat", params.repeat);
+			break;
+		case 'w':
+			params.workdir = std::string(optarg);
+			break;
+		case 'f':
+			params.filter = std::string(optarg);
+			break;
+		case 'o':
+			params.output = std::string(optarg);
+			break;
+		case 'v':
+			Version();
+			exit(0);
+		case 'h':
+			Usage(std::string(argv[0]));
+			exit(0);
+		default:
+			std::cerr << std::endl << "[E] Unknown argument detected" << std::endl;
+			Usage(std::string(argv[0]));
+			exit(1);
+		}
+	}
+
+	if (params.dem_size<10) throw InvalidArgumentException("The DEM must be at least 10 cells wide", AT);
+	if (params.nr_stations<2) throw InvalidArgumentException("At least 2 stations are required", AT);
+	if (params.nr_days<2) throw InvalidArgumentException("At least 2 days of data are required", AT);
+	if (params.sampling<=0.) throw InvalidArgumentException("The sampling rate must be strictly positive", AT);
+	if (params.repeat==0) params.repeat = 1;
+}
+
+//only keep the last line of the exception message (without any backtrace) and remove the terminal color codes
+static std::string getMessage(const std::exception& e)
+{
+	const std::string full_msg( e.what() );
+	std::string msg;
+	size_t end = full_msg.find_last_not_of(" \n\r\t");
+	if (end!=std::string::npos) {
+		const size_t start = full_msg.find_last_of('\n', end);
+		msg = full_msg.substr((start==std::string::npos)? 0 : start+1, end - ((start==std::string::npos)? 0 : start+1) + 1);
+	}
+
+	std::string out;
+	for (size_t ii=0; ii<msg.size(); ii++) {
+		if (msg[ii]=='\033') { //skip the escape sequence up to its final 'm'
+			while (ii<msg.size() && msg[ii]!='m') ii++;
+			continue;
+		}
+		out.push_back( msg[ii] );
+	}
+	return (out.empty())? "unknown error" : out;
+}
+
+/**
+ * @brief Run a benchmark and record its timings
+ * @param[in] params benchmark parameters
+ * @param[in] name benchmark name
+ * @param[in] unit what is counted as an item (for the throughput)
+ * @param[in] items number of items processed by one run
+ * @param[in] setup function called before each run, outside of the timed section (can be empty)
+ * @param[in] run function to benchmark
+ */
+static void runBench(const BenchParams& params, const std::string& name, const std::string& unit, const size_t& items,
+                     const std::function<void()>& setup, const std::function<void()>& run)
+{
+	if (!params.filter.empty() && name.find(params.filter)==std::string::npos) return;
+
+	BenchResult res;
+	res.name = name;
+	res.unit = unit;
+	res.items = items;
+	std::cerr << std::left << std::setw(40) << name << std::flush;
+
+	try {
+		double sum = 0.;
+		Timer timer;
+		for (unsigned int ii=0; ii<params.repeat; ii++) {
+			if (setup) setup();
+			timer.reset();
+			timer.start();
+			run();
+			timer.stop();
+			const double elapsed = timer.getElapsed();
+			sum += elapsed;
+			if (ii==0 || elapsed<res.best) res.best = elapsed;
+			res.runs++;
+		}
+		res.mean = sum / static_cast<double>(res.runs);
+		std::cerr << std::right << std::setw(12) << std::fixed << std::setprecision(4) << res.best << " s";
+		if (res.best>0.) std::cerr << std::setw(16) << std::setprecision(1) << static_cast<double>(items)/res.best << " " << unit << "/s";
+		std::cerr << std::endl;
+	} catch (const std::exception& e) {
+		res.skipped = getMessage( e );
+		std::cerr << "skipped: " << res.skipped << std::endl;
+	}
+
+	results.push_back( res );
+}
+
+static std::string jsonEscape(const std::string& str)
+{
+	std::string out;
+	for (const char c : str) {
+		if (c=='"' || c=='\\') {
+			out.push_back('\\');
+			out.push_back(c);
+		} else if (static_cast<unsigned char>(c)<0x20) {
+			out.push_back(' ');
+		} else {
+			out.push_back(c);
+		}
+	}
+	return out;
+}
+
+static std::string toJSON(const BenchParams& params)
+{
+	std::ostringstream os;
+	os << std::setprecision(9);
+	os << "{\n";
+	os << "\t\"meteoio_version\": \"" << jsonEscape(getLibVersion()) << "\",\n";
+	os << "\t\"parameters\": {\"dem_size\": " << params.dem_size << ", \"cellsize\": " << cellsize;
+	os << ", \"stations\": " << params.nr_stations << ", \"days\": " << params.nr_days;
+	os << ", \"sampling_rate\": " << params.sampling << ", \"repeat\": " << params.repeat << "},\n";
+	os << "\t\"benchmarks\": [";
+	for (size_t ii=0; ii<results.size(); ii++) {
+		const BenchResult& res = results[ii];
+		os << ((ii>0)? ",\n" : "\n");
+		os << "\t\t{\"name\": \"" << jsonEscape(res.name) << "\", \"unit\": \"" << jsonEscape(res.unit) << "\", \"items\": " << res.items;
+		if (!res.skipped.empty()) {
+			os << ", \"skipped\": \"" << jsonEscape(res.skipped) << "\"}";
+			continue;
+		}
+		os << ", \"runs\": " << res.runs << ", \"best\": " << res.best << ", \"mean\": " << res.mean;
+		os << ", \"throughput\": " << ((res.best>0.)? static_cast<double>(res.items)/res.best : 0.);
+		if (!res.check.empty()) os << ", \"check\": \"" << jsonEscape(res.check) << "\"";
+		os << "}";
+	}
+	os << "\n\t]\n}\n";
+	return os.str();
+}
+
+/////////////////////////////////////////////////////////////
+// synthetic inputs generation
+
+//a smooth terrain with a main valley, a few ridges and some roughness, between about 500 and 3500 m
+static DEMObject generateDEM(const BenchParams& params)
+{
+	const size_t nx = params.dem_size, ny = params.dem_size;
+	Coords llcorner("CH1903", "");
+	llcorner.setXY(x_origin, y_origin, IOUtils::nodata);
+
+	DEMObject dem(nx, ny, cellsize, llcorner);
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> noise(-5., 5.);
+	const double length = static_cast<double>(nx) * cellsize;
+
+	for (size_t jj=0; jj<ny; jj++) {
+		for (size_t ii=0; ii<nx; ii++) {
+			const double x = static_cast<double>(ii) * cellsize / length;
+			const double y = static_cast<double>(jj) * cellsize / length;
+			const double valley = 1200. * std::fabs(x - 0.5 - 0.1*sin(2.*Cst::PI*y));
+			const double ridges = 400. * sin(6.*Cst::PI*x) * cos(4.*Cst::PI*y) + 200. * sin(17.*x + 11.*y);
+			dem.grid2D(ii,jj) = 1500. + valley + ridges + noise(gen);
+		}
+	}
+	dem.update();
+	return dem;
+}
+
+//stations randomly spread over the DEM, with their altitude taken from the DEM
+static std::vector<Coords> generateStations(const BenchParams& params, const DEMObject& dem)
+{
+	std::mt19937 gen(1234);
+	std::uniform_int_distribution<size_t> cells(1, params.dem_size-2);
+	std::vector<Coords> vecPositions;
+
+	for (size_t st=0; st<params.nr_stations; st++) {
+		const size_t ii = cells(gen), jj = cells(gen);
+		Coords point(dem.llcorner);
+		point.setXY(x_origin + (static_cast<double>(ii)+.5)*cellsize, y_origin + (static_cast<double>(jj)+.5)*cellsize, dem.grid2D(ii,jj));
+		vecPositions.push_back( point );
+	}
+	return vecPositions;
+}
+
+static std::string getStationID(const size_t& st)
+{
+	return "BENCH" + IOUtils::toString(st+1);
+}
+
+static void setBaseConfig(Config& cfg)
+{
+	cfg.addKey("BUFFER_SIZE", "General", "370");
+	cfg.addKey("BUFF_BEFORE", "General", "1.5");
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", IOUtils::toString(TZ));
+	cfg.addKey("COORDSYS", "Output", "CH1903");
+	cfg.addKey("TIME_ZONE", "Output", IOUtils::toString(TZ));
+}
+
+static void addSine(Config& cfg, const std::string& root, const std::string& param, const double& value, const double& amplitude, const double& phase)
+{
+	cfg.addKey(root+"::"+param+"::TYPE", "Input", "SINE");
+	cfg.addKey(root+"::"+param+"::VALUE", "Input", IOUtils::toString(value));
+	cfg.addKey(root+"::"+param+"::AMPLITUDE", "Input", IOUtils::toString(amplitude));
+	cfg.addKey(root+"::"+param+"::PHASE", "Input", IOUtils::toString(phase));
+}
+
+//realistic daily cycles, with a temperature lapse rate and some station to station variability
+static Config getSynthConfig(const BenchParams& params, const std::vector<Coords>& vecPositions)
+{
+	Config cfg;
+	setBaseConfig(cfg);
+	cfg.addKey("METEO", "Input", "SYNTH");
+	cfg.addKey("SYNTH_SAMPLING", "Input", IOUtils::toString(params.sampling));
+
+	for (size_t st=0; st<vecPositions.size(); st++) {
+		const std::string root( "STATION" + IOUtils::toString(st+1) );
+		const double altitude = vecPositions[st].getAltitude();
+		const double shift = static_cast<double>(st % 7) / 7.;
+		std::ostringstream position;
+		position << std::fixed << std::setprecision(1) << "xy(" << vecPositions[st].getEasting() << ", " << vecPositions[st].getNorthing() << ", " << altitude << ")";
+		cfg.addKey(root, "Input", position.str());
+		cfg.addKey("ID"+IOUtils::toString(st+1), "Input", getStationID(st));
+
+		addSine(cfg, root, "TA", 285. - 0.0065*altitude + 2.*shift, 6. + shift, 14.);
+		addSine(cfg, root, "RH", 0.7 - 0.1*shift, 0.2, 5.);
+		addSine(cfg, root, "VW", 3. + 2.*shift, 2., 15.);
+		addSine(cfg, root, "DW", 180. + 40.*shift, 90., 12.);
+		addSine(cfg, root, "ISWR", 250. + 20.*shift, 350., 12.); //the negative values are left for the filters
+		addSine(cfg, root, "ILWR", 290. + 5.*shift, 20., 16.);
+		addSine(cfg, root, "TSS", 270. - 0.004*altitude + shift, 5., 13.);
+		addSine(cfg, root, "PSUM", 0.2 + 0.1*shift, 0.3, 18.);
+		cfg.addKey(root+"::P::TYPE", "Input", "STDPRESS");
+	}
+	return cfg;
+}
+
+static size_t countRecords(const std::vector< std::vector<MeteoData> >& vecMeteo)
+{
+	size_t count = 0;
+	for (const auto& station : vecMeteo) count += station.size();
+	return count;
+}
+
+//the CSV plugin can not write data, so the CSV files are written directly
+static void writeCSV(const std::string& path, const std::vector< std::vector<MeteoData> >& vecMeteo)
+{
+	const std::vector<std::string> fields = {"TA", "RH", "VW", "DW", "ISWR", "ILWR", "PSUM"};
+	for (const auto& station : vecMeteo) {
+		if (station.empty()) continue;
+		ofilestream fout(path + "/" + station.front().meta->getStationID() + ".csv");
+		fout << "timestamp";
+		for (const auto& field : fields) fout << "," << field;
+		fout << "\n" << std::fixed << std::setprecision(3);
+		for (const auto& md : station) {
+			fout << md.date.toString(Date::ISO);
+			for (const auto& field : fields) fout << "," << md(field);
+			fout << "\n";
+		}
+		fout.close();
+	}
+}
+
+static void prepareDirectory(const std::string& path)
+{
+	if (!FileUtils::directoryExists(path)) FileUtils::createDirectories(path);
+}
+
+/////////////////////////////////////////////////////////////
+// benchmarks
+
+static void benchTimeSeries(const BenchParams& params, const std::vector<Coords>& vecPositions, const Date& dateStart, const Date& dateEnd)
+{
+	const Config synthCfg( getSynthConfig(params, vecPositions) );
+	std::vector< std::vector<MeteoData> > vecMeteo;
+	{
+		IOManager io(synthCfg);
+		io.getMeteoData(dateStart, dateEnd, vecMeteo);
+	}
+	const size_t nr_records = countRecords(vecMeteo);
+
+	runBench(params, "synth::read", "records", nr_records, nullptr, [&]() {
+		IOManager io(synthCfg);
+		std::vector< std::vector<MeteoData> > vecTmp;
+		io.getMeteoData(dateStart, dateEnd, vecTmp);
+	});
+
+	//SMET writing and parsing
+	const std::string smet_path( params.workdir + "/smet" );
+	prepareDirectory( smet_path );
+	Config smetOutCfg; //the SMET plugin opens its input files when it is created, so the output must be configured separately
+	setBaseConfig(smetOutCfg);
+	smetOutCfg.addKey("METEO", "Output", "SMET");
+	smetOutCfg.addKey("METEOPATH", "Output", smet_path);
+	Config smetInCfg;
+	setBaseConfig(smetInCfg);
+	smetInCfg.addKey("METEO", "Input", "SMET");
+	smetInCfg.addKey("METEOPATH", "Input", smet_path);
+	for (size_t st=0; st<vecPositions.size(); st++)
+		smetInCfg.addKey("STATION"+IOUtils::toString(st+1), "Input", getStationID(st));
+
+	runBench(params, "smet::write", "records", nr_records, nullptr, [&]() {
+		IOManager io(smetOutCfg);
+		io.writeMeteoData(vecMeteo);
+	});
+	runBench(params, "smet::read", "records", nr_records, nullptr, [&]() {
+		IOManager io(smetInCfg);
+		std::vector< std::vector<MeteoData> > vecTmp;
+		io.getMeteoData(dateStart, dateEnd, vecTmp);
+	});
+
+	//CSV parsing
+	const std::string csv_path( params.workdir + "/csv" );
+	prepareDirectory( csv_path );
+	writeCSV(csv_path, vecMeteo);
+	Config csvCfg;
+	setBaseConfig(csvCfg);
+	csvCfg.addKey("METEO", "Input", "CSV");
+	csvCfg.addKey("METEOPATH", "Input", csv_path);
+	csvCfg.addKey("CSV_DELIMITER", "Input", ",");
+	csvCfg.addKey("CSV_NR_HEADERS", "Input", "1");
+	csvCfg.addKey("CSV_COLUMNS_HEADERS", "Input", "1");
+	csvCfg.addKey("CSV_DATETIME_SPEC", "Input", "YYYY-MM-DDTHH24:MI:SS");
+	for (size_t st=0; st<vecMeteo.size(); st++) {
+		if (vecMeteo[st].empty()) continue;
+		const StationData& sd = vecMeteo[st].front().meta;
+		const std::string idx( IOUtils::toString(st+1) );
+		std::ostringstream position;
+		position << std::fixed << std::setprecision(1) << "xy(" << sd.position.getEasting() << ", " << sd.position.getNorthing() << ", " << sd.position.getAltitude() << ")";
+		csvCfg.addKey("STATION"+idx, "Input", sd.getStationID()+".csv");
+		csvCfg.addKey("POSITION"+idx, "Input", position.str());
+		csvCfg.addKey("CSV"+idx+"_ID", "Input", sd.getStationID());
+	}
+
+	runBench(params, "csv::read", "records", nr_records, nullptr, [&]() {
+		IOManager io(csvCfg);
+		std::vector< std::vector<MeteoData> > vecTmp;
+		io.getMeteoData(dateStart, dateEnd, vecTmp);
+	});
+
+	//a stack of commonly used filters
+	Config filtersCfg;
+	setBaseConfig(filtersCfg);
+	filtersCfg.addKey("TA::filter1", "Filters", "min_max");
+	filtersCfg.addKey("TA::arg1::min", "Filters", "230");
+	filtersCfg.addKey("TA::arg1::max", "Filters", "330");
+	filtersCfg.addKey("TA::filter2", "Filters", "rate");
+	filtersCfg.addKey("TA::arg2::max", "Filters", "0.01");
+	filtersCfg.addKey("TA::filter3", "Filters", "mad");
+	filtersCfg.addKey("TA::arg3::soft", "Filters", "true");
+	filtersCfg.addKey("TA::arg3::centering", "Filters", "left");
+	filtersCfg.addKey("TA::arg3::min_pts", "Filters", "10");
+	filtersCfg.addKey("TA::arg3::min_span", "Filters", "21600");
+	filtersCfg.addKey("RH::filter1", "Filters", "min_max");
+	filtersCfg.addKey("RH::arg1::soft", "Filters", "true");
+	filtersCfg.addKey("RH::arg1::min", "Filters", "0.05");
+	filtersCfg.addKey("RH::arg1::max", "Filters", "1.");
+	filtersCfg.addKey("ISWR::filter1", "Filters", "min");
+	filtersCfg.addKey("ISWR::arg1::soft", "Filters", "true");
+	filtersCfg.addKey("ISWR::arg1::min", "Filters", "0.");
+	filtersCfg.addKey("VW::filter1", "Filters", "min_max");
+	filtersCfg.addKey("VW::arg1::min", "Filters", "-2");
+	filtersCfg.addKey("VW::arg1::max", "Filters", "70");
+	filtersCfg.addKey("VW::filter2", "Filters", "std_dev");
+	filtersCfg.addKey("VW::arg2::soft", "Filters", "true");
+	filtersCfg.addKey("VW::arg2::centering", "Filters", "center");
+	filtersCfg.addKey("VW::arg2::min_pts", "Filters", "6");
+	filtersCfg.addKey("VW::arg2::min_span", "Filters", "21600");
+	filtersCfg.addKey("TSS::filter1", "Filters", "exp_smoothing");
+	filtersCfg.addKey("TSS::arg1::centering", "Filters", "right");
+	filtersCfg.addKey("TSS::arg1::min_pts", "Filters", "3");
+	filtersCfg.addKey("TSS::arg1::min_span", "Filters", "3600");
+	filtersCfg.addKey("TSS::arg1::alpha", "Filters", "0.8");
+	filtersCfg.addKey("PSUM::filter1", "Filters", "min");
+	filtersCfg.addKey("PSUM::arg1::soft", "Filters", "true");
+	filtersCfg.addKey("PSUM::arg1::min", "Filters", "0.");
+
+	std::vector< std::vector<MeteoData> > vecIn, vecOut;
+	runBench(params, "processing_stack::filters", "records", nr_records, [&]() {
+		vecIn = vecMeteo;
+	}, [&]() {
+		MeteoProcessor processor(filtersCfg);
+		processor.process(vecIn, vecOut);
+	});
+
+	//temporal resampling, in the middle of each timestep
+	Config resamplingCfg;
+	setBaseConfig(resamplingCfg);
+	resamplingCfg.addKey("WINDOW_SIZE", "Interpolations1D", "86400");
+	resamplingCfg.addKey("TA::resample", "Interpolations1D", "linear");
+	resamplingCfg.addKey("RH::resample", "Interpolations1D", "linear");
+	resamplingCfg.addKey("VW::resample", "Interpolations1D", "nearest");
+	resamplingCfg.addKey("PSUM::resample", "Interpolations1D", "accumulate");
+	resamplingCfg.addKey("PSUM::accumulate::period", "Interpolations1D", IOUtils::toString(params.sampling));
+
+	const double half_step = params.sampling / (2.*24.*3600.);
+	size_t nr_resampled = 0;
+	for (const auto& station : vecMeteo) nr_resampled += (station.size()<2)? 0 : station.size()-2;
+	runBench(params, "resampling::meteo1d", "points", nr_resampled, nullptr, [&]() {
+		Meteo1DInterpolator interpolator(resamplingCfg);
+		for (size_t st=0; st<vecMeteo.size(); st++) {
+			if (vecMeteo[st].empty()) continue;
+			const std::string stationHash( IOUtils::toString(st)+"-"+vecMeteo[st].front().meta->getHash() );
+			for (size_t ii=1; ii<vecMeteo[st].size()-1; ii++) { //the first point has no accumulation period
+				MeteoData md;
+				interpolator.resampleData(vecMeteo[st][ii].date + half_step, stationHash, vecMeteo[st], md);
+			}
+		}
+	});
+}
+
+static void benchInterpolations(const BenchParams& params, const std::vector<Coords>& vecPositions, const DEMObject& dem, const Date& dateStart)
+{
+	struct algo_spec {
+		std::string param, algorithm;
+		std::vector< std::pair<std::string, std::string> > args;
+	};
+	const std::vector<algo_spec> algorithms = {
+		{"TA", "NEAREST", {}},
+		{"TA", "AVG", {}},
+		{"TA", "AVG_LAPSE", {}},
+		{"TA", "IDW", {}},
+		{"TA", "IDW_LAPSE", {}},
+		{"TA", "LIDW_LAPSE", {{"NEIGHBORS", "6"}}},
+		{"TA", "ODKRIG", {}},
+		{"TA", "ODKRIG_LAPSE", {}},
+		{"RH", "LISTON_RH", {}},
+		{"VW", "LISTON_WIND", {}},
+		{"DW", "RYAN", {}},
+		{"ILWR", "ILWR_EPS", {}},
+		{"ISWR", "SWRAD", {}},
+		{"P", "STD_PRESS", {}},
+		{"PSUM", "PSUM_SNOW", {{"BASE", "AVG_LAPSE"}}},
+		{"PSUM", "WINSTRAL", {{"BASE", "AVG_LAPSE"}}}
+	};
+
+	const Config synthCfg( getSynthConfig(params, vecPositions) );
+	const size_t nr_cells = dem.getNx() * dem.getNy();
+	const double one_hour = 1./24.;
+
+	for (const auto& spec : algorithms) {
+		Config cfg( synthCfg );
+		cfg.addKey(spec.param+"::algorithms", "Interpolations2D", spec.algorithm);
+		for (const auto& arg : spec.args)
+			cfg.addKey(spec.param+"::"+spec.algorithm+"::"+arg.first, "Interpolations2D", arg.second);
+		//some algorithms rely on other parameters
+		cfg.addKey("TA::algorithms", "Interpolations2D", (spec.param=="TA")? spec.algorithm : "IDW_LAPSE");
+		if (spec.param!="RH") cfg.addKey("RH::algorithms", "Interpolations2D", "IDW_LAPSE");
+		if (spec.param!="VW") cfg.addKey("VW::algorithms", "Interpolations2D", "IDW");
+		if (spec.param!="DW") cfg.addKey("DW::algorithms", "Interpolations2D", "IDW");
+		if (spec.param!="P") cfg.addKey("P::algorithms", "Interpolations2D", "STD_PRESS");
+
+		IOManager io(cfg);
+		Grid2DObject grid;
+		std::string info;
+		std::vector<MeteoData> vecMeteo;
+		Date date( dateStart + 1. + 12.*one_hour ); //the data must be buffered before the timing starts
+		runBench(params, "interpol2d::"+spec.param+"::"+spec.algorithm, "cells", nr_cells, [&]() {
+			date += one_hour; //make sure that no cached grid is used
+			io.getMeteoData(date, vecMeteo); //fill the buffers outside of the timed section
+		}, [&]() {
+			io.getMeteoData(date, dem, spec.param, grid, info); //retrieving the info string prevents it from being printed
+		});
+	}
+}
+
+static void benchGrids(const BenchParams& params, const DEMObject& dem, const Date& dateStart)
+{
+	const size_t nr_cells = dem.getNx() * dem.getNy();
+
+	runBench(params, "dem::update", "cells", nr_cells, nullptr, [&]() {
+		DEMObject tmp( dem, false );
+		tmp.update();
+	});
+
+	const size_t nr_points = 10;
+	const double increment = 5.;
+	std::vector<Coords> vecPoints;
+	for (size_t ii=0; ii<nr_points; ii++) {
+		const size_t idx = (ii+1) * (params.dem_size-1) / (nr_points+1);
+		Coords point(dem.llcorner);
+		point.setGridIndex(static_cast<int>(idx), static_cast<int>(params.dem_size-1-idx), IOUtils::inodata, true);
+		dem.gridify(point);
+		vecPoints.push_back( point );
+	}
+	runBench(params, "dem::horizons", "points", nr_points, nullptr, [&]() {
+		for (const auto& point : vecPoints) DEMAlgorithms::getHorizonScan(dem, point, increment);
+	});
+
+	//ARC writing and parsing
+	const std::string arc_path( params.workdir + "/arc" );
+	prepareDirectory( arc_path );
+	Config arcCfg;
+	setBaseConfig(arcCfg);
+	arcCfg.addKey("GRID2D", "Input", "ARC");
+	arcCfg.addKey("GRID2DPATH", "Input", arc_path);
+	arcCfg.addKey("GRID2D", "Output", "ARC");
+	arcCfg.addKey("GRID2DPATH", "Output", arc_path);
+	arcCfg.addKey("DEM", "Input", "ARC");
+	arcCfg.addKey("DEMFILE", "Input", arc_path+"/dem.asc");
+
+	const Grid2DObject grid( dem );
+	runBench(params, "arc::write", "cells", nr_cells, nullptr, [&]() {
+		IOManager io(arcCfg);
+		io.write2DGrid(grid, "dem");
+	});
+	runBench(params, "arc::read", "cells", nr_cells, nullptr, [&]() {
+		IOManager io(arcCfg);
+		Grid2DObject tmp;
+		io.read2DGrid(tmp, "dem.asc");
+	});
+	runBench(params, "arc::read_dem", "cells", nr_cells, nullptr, [&]() {
+		IOManager io(arcCfg);
+		DEMObject tmp;
+		io.readDEM(tmp);
+	});
+
+	//NetCDF writing and parsing (only if the plugin is available)
+	const std::string nc_path( params.workdir + "/netcdf" );
+	prepareDirectory( nc_path );
+	Config ncCfg;
+	setBaseConfig(ncCfg);
+	ncCfg.addKey("GRID2D", "Input", "NETCDF");
+	ncCfg.addKey("GRID2DPATH", "Input", nc_path);
+	ncCfg.addKey("GRID2DFILE", "Input", "bench.nc");
+	ncCfg.addKey("GRID2D", "Output", "NETCDF");
+	ncCfg.addKey("GRID2DPATH", "Output", nc_path);
+	ncCfg.addKey("GRID2DFILE", "Output", "bench.nc");
+
+	const Date date( dateStart + 1. );
+	Grid2DObject ta( grid );
+	for (size_t ii=0; ii<ta.size(); ii++) ta.grid2D(ii) = 285. - 0.0065*grid.grid2D(ii);
+	runBench(params, "netcdf::write", "cells", nr_cells, [&]() {
+		const std::string filename( nc_path + "/bench.nc" );
+		if (FileUtils::fileExists(filename)) std::remove( filename.c_str() );
+	}, [&]() {
+		IOManager io(ncCfg);
+		io.write2DGrid(ta, MeteoGrids::TA, date);
+	});
+	runBench(params, "netcdf::read", "cells", nr_cells, nullptr, [&]() {
+		IOManager io(ncCfg);
+		Grid2DObject tmp;
+		io.read2DGrid(tmp, MeteoGrids::TA, date);
+	});
+}
+
+/////////////////////////////////////////////////////////////
+// reference implementation of the spatial resampling (computing everything for each pixel), to check LibResampling2D against
+
+static double refBilinearPixel(const Array2D<double> &i_grid, const size_t &org_ii, const size_t &org_jj, const size_t &org_nx, const size_t &org_ny, const double &x, const double &y)
+{
+	if (org_jj>=(org_ny-1) || org_ii>=(org_nx-1)) return i_grid(org_ii, org_jj);
+
+	const double f_0_0 = i_grid(org_ii, org_jj);
+	const double f_1_0 = i_grid(org_ii+1, org_jj);
+	const double f_0_1 = i_grid(org_ii, org_jj+1);
+	const double f_1_1 = i_grid(org_ii+1, org_jj+1);
+
+	double avg_value = 0.;
+	unsigned int avg_count = 0;
+	for (const double f : {f_0_0, f_1_0, f_0_1, f_1_1}) {
+		if (f==IOUtils::nodata) continue;
+		avg_value += f;
+		avg_count++;
+	}
+	if (avg_count==4) return f_0_0 * (1.-x)*(1.-y) + f_1_0 * x*(1.-y) + f_0_1 * (1.-x)*y + f_1_1 *x*y;
+	if (avg_count<=2) return IOUtils::nodata;
+
+	const double avg = avg_value/(double)avg_count;
+	double value = 0.;
+	value += ((f_0_0!=IOUtils::nodata)? f_0_0 : avg) * (1.-x)*(1.-y);
+	value += ((f_1_0!=IOUtils::nodata)? f_1_0 : avg) * x*(1.-y);
+	value += ((f_0_1!=IOUtils::nodata)? f_0_1 : avg) * (1.-x)*y;
+	value += ((f_1_1!=IOUtils::nodata)? f_1_1 : avg) *x*y;
+	return value;
+}
+
+static double refBSplineWeight(const double &x)
+{
+	double R = 0.;
+	if ((x+2.)>0.) R += Optim::pow3(x+2.);
+	if ((x+1.)>0.) R += -4.*Optim::pow3(x+1.);
+	if ((x)>0.) R += 6.*Optim::pow3(x);
+	if ((x-1.)>0.) R += -4.*Optim::pow3(x-1.);
+	return 1./6.*R;
+}
+
+static Array2D<double> refResampling(const Array2D<double> &i_grid, const double &factor, const std::string& algo)
+{
+	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
+	const size_t dest_nx = static_cast<size_t>(Optim::round( static_cast<double>(org_nx)*factor ));
+	const size_t dest_ny = static_cast<size_t>(Optim::round( static_cast<double>(org_ny)*factor ));
+	const double scale_x = (double)dest_nx / (double)org_nx;
+	const double scale_y = (double)dest_ny / (double)org_ny;
+	Array2D<double> o_grid(dest_nx, dest_ny);
+
+	for (size_t jj=0; jj<dest_ny; jj++) {
+		const double org_y = (double)jj/scale_y;
+		const size_t org_jj = static_cast<size_t>( org_y );
+		const double dy = org_y - (double)org_jj;
+		for (size_t ii=0; ii<dest_nx; ii++) {
+			const double org_x = (double)ii/scale_x;
+			const size_t org_ii = static_cast<size_t>( org_x );
+			const double dx = org_x - (double)org_ii;
+
+			if (algo=="nearest") {
+				o_grid(ii,jj) = i_grid(std::min( (size_t) Optim::floor( (double)ii/scale_x ) , org_nx-1 ), std::min( (size_t) Optim::floor( (double)jj/scale_y ) , org_ny-1 ));
+			} else if (algo=="bilinear") {
+				o_grid(ii,jj) = refBilinearPixel(i_grid, org_ii, org_jj, org_nx, org_ny, dx, dy);
+			} else {
+				double F = 0., max=-std::numeric_limits<double>::max(), min=std::numeric_limits<double>::max();
+				unsigned int avg_count = 0;
+				for (int n=-1; n<=2; n++) {
+					for (int m=-1; m<=2; m++) {
+						if (((signed)org_ii+m)<0 || ((signed)org_ii+m)>=(signed)org_nx || ((signed)org_jj+n)<0 || ((signed)org_jj+n)>=(signed)org_ny) continue;
+						const double pixel = i_grid(static_cast<size_t>((signed)org_ii+m), static_cast<size_t>((signed)org_jj+n));
+						if (pixel==IOUtils::nodata) continue;
+						F += pixel * refBSplineWeight(m-dx) * refBSplineWeight(dy-n);
+						avg_count++;
+						if (pixel>max) max=pixel;
+						if (pixel<min) min=pixel;
+					}
+				}
+				if (avg_count==16) o_grid(ii,jj) = std::min(max, std::max(min, F));
+				else if (avg_count==0) o_grid(ii,jj) = IOUtils::nodata;
+				else o_grid(ii,jj) = refBilinearPixel(i_grid, org_ii, org_jj, org_nx, org_ny, dx, dy);
+			}
+		}
+	}
+	return o_grid;
+}
+
+//compare a resampled grid with the reference and store the outcome in the last benchmark result
+static void checkResampling(const std::string& name, const Array2D<double>& result, const Array2D<double>& reference)
+{
+	if (results.empty() || results.back().name!=name || !results.back().skipped.empty()) return;
+
+	std::ostringstream os;
+	if (result.getNx()!=reference.getNx() || result.getNy()!=reference.getNy()) {
+		os << "different dimensions than the reference";
+	} else {
+		double max_diff = 0.;
+		size_t nr_diffs = 0;
+		for (size_t ii=0; ii<result.size(); ii++) {
+			if (result(ii)==reference(ii)) continue;
+			nr_diffs++;
+			if (result(ii)==IOUtils::nodata || reference(ii)==IOUtils::nodata) max_diff = std::numeric_limits<double>::infinity();
+			else max_diff = std::max(max_diff, std::abs(result(ii) - reference(ii)));
+		}
+		if (nr_diffs==0) os << "bitwise identical to the reference";
+		else os << nr_diffs << " cells differ from the reference, max difference " << max_diff;
+	}
+	results.back().check = os.str();
+	std::cerr << "\t-> " << results.back().check << std::endl;
+}
+
+static void benchResampling(const BenchParams& params, const DEMObject& dem)
+{
+	//some holes, to also check the nodata handling
+	Array2D<double> grid( dem.grid2D );
+	for (size_t ii=0; ii<grid.size(); ii+=97) grid(ii) = IOUtils::nodata;
+
+	const double factor = 2.5;
+	const size_t nr_cells = static_cast<size_t>(Optim::round( static_cast<double>(grid.getNx())*factor )) * static_cast<size_t>(Optim::round( static_cast<double>(grid.getNy())*factor ));
+	const std::vector<std::string> algorithms = {"nearest", "bilinear", "bspline"};
+	for (const std::string& algo : algorithms) {
+		Array2D<double> reference, result;
+		runBench(params, "resampling2D::"+algo+"_reference", "cells", nr_cells, nullptr, [&]() {
+			reference = refResampling(grid, factor, algo);
+		});
+		runBench(params, "resampling2D::"+algo, "cells", nr_cells, nullptr, [&]() {
+			if (algo=="nearest") result = LibResampling2D::Nearest(grid, factor, factor);
+			else if (algo=="bilinear") result = LibResampling2D::Bilinear(grid, factor, factor);
+			else result = LibResampling2D::cubicBSpline(grid, factor, factor);
+		});
+		if (reference.empty()) reference = refResampling(grid, factor, algo); //the reference run might have been filtered out
+		checkResampling("resampling2D::"+algo, result, reference);
+	}
+}
+
+/////////////////////////////////////////////////////////////
+// reference implementation of the least square fits (Gauss-Newton iterations with finite differences derivatives), to check libfit1D against
+
+static bool refLeastSquareFit(Fit1D& model, const std::vector<double>& X, const std::vector<double>& Y, std::vector<double> lambda)
+{
+	static const double eps_conv = 1e-6;
+	static const unsigned int max_iter = 50;
+	const size_t nPts = X.size(), nParam = lambda.size();
+	Matrix A(nPts, nParam), dBeta(nPts, (size_t)1), dLambda;
+
+	double max_delta;
+	unsigned int iter = 0;
+	do {
+		iter++;
+		model.setGuess(lambda);
+		for (size_t m=1; m<=nPts; m++) dBeta(m,1) = Y[m-1] - model.f(X[m-1]);
+		for (size_t n=1; n<=nParam; n++) {
+			const double var = lambda[n-1];
+			const double delta = (var==0)? 0.5 : 0.2*var*0.5;
+			std::vector<double> lambda1( lambda ), lambda2( lambda );
+			lambda1[n-1] = var - delta;
+			lambda2[n-1] = var + delta;
+			for (size_t m=1; m<=nPts; m++) {
+				model.setGuess(lambda1);
+				const double y1 = model.f(X[m-1]);
+				model.setGuess(lambda2);
+				const double y2 = model.f(X[m-1]);
+				A(m,n) = (y2-y1)/(2.*delta);
+			}
+		}
+		if (!Matrix::solve(A.getT()*A, A.getT()*dBeta, dLambda)) return false;
+		max_delta = 0.;
+		for (size_t n=1; n<=nParam; n++) {
+			lambda[n-1] += dLambda(n,1);
+			max_delta = std::max(max_delta, std::abs(dLambda(n,1)));
+		}
+	} while (max_delta>eps_conv && iter<max_iter);
+
+	model.setGuess(lambda);
+	return (max_delta<=eps_conv);
+}
+
+static void benchFit1D(const BenchParams& params)
+{
+	static const size_t nr_fits = 500, nr_pts = 40;
+	const std::vector<std::string> models = {"LINEARLS", "QUADRATIC", "LINVARIO", "SPHERICVARIO", "EXPVARIO", "RATQUADVARIO"};
+	const std::vector<double> guess = {0.1, 1., 40.}; //starting point of the non-linear fits
+
+	std::mt19937 gen(42);
+	std::normal_distribution<double> noise(0., 0.02);
+	for (const std::string& model : models) {
+		//variogram-like data sets
+		std::vector< std::vector<double> > vecX(nr_fits), vecY(nr_fits);
+		for (size_t ff=0; ff<nr_fits; ff++) {
+			const double range = 20. + static_cast<double>(ff % 40);
+			for (size_t ii=0; ii<nr_pts; ii++) {
+				const double x = 2.5 * static_cast<double>(ii+1);
+				vecX[ff].push_back( x );
+				vecY[ff].push_back( 0.05 + 0.7*(1. - exp(-x/range)) + noise(gen) );
+			}
+		}
+		const size_t nParam = (model=="LINEARLS" || model=="LINVARIO")? 2 : 3;
+		const std::vector<double> model_guess( guess.end()-static_cast<std::ptrdiff_t>(nParam), guess.end() );
+
+		std::vector< std::vector<double> > reference(nr_fits), result(nr_fits);
+		const auto runFits = [&](const bool& ref, std::vector< std::vector<double> >& coeffs) {
+			for (size_t ff=0; ff<nr_fits; ff++) {
+				Fit1D fit(model, vecX[ff], vecY[ff], false);
+				fit.setGuess( model_guess );
+				const bool status = (ref)? refLeastSquareFit(fit, vecX[ff], vecY[ff], model_guess) : fit.fit();
+				coeffs[ff] = (status)? fit.getParams() : std::vector<double>();
+			}
+		};
+		const std::string name( "fit1D::"+IOUtils::strToLower(model) );
+		runBench(params, name+"_reference", "fits", nr_fits, nullptr, [&]() { runFits(true, reference); });
+		runBench(params, name, "fits", nr_fits, nullptr, [&]() { runFits(false, result); });
+		if (results.empty() || results.back().name!=name || !results.back().skipped.empty()) continue;
+		if (reference.front().empty() && reference.back().empty()) runFits(true, reference); //the reference run might have been filtered out
+
+		//compare the coefficients and the sums of squared residuals when both converged
+		size_t nr_converged = 0, nr_ref_converged = 0, nr_both = 0, nr_worse = 0;
+		double max_diff = 0.;
+		for (size_t ff=0; ff<nr_fits; ff++) {
+			if (!result[ff].empty()) nr_converged++;
+			if (!reference[ff].empty()) nr_ref_converged++;
+			if (reference[ff].empty() || result[ff].empty()) continue;
+			nr_both++;
+			for (size_t pp=0; pp<nParam; pp++)
+				max_diff = std::max(max_diff, std::abs(result[ff][pp]-reference[ff][pp]) / std::max(1., std::abs(reference[ff][pp])));
+
+			Fit1D fit(model, vecX[ff], vecY[ff], false);
+			double ssr = 0., ref_ssr = 0.;
+			fit.setGuess( result[ff] );
+			for (size_t ii=0; ii<nr_pts; ii++) ssr += Optim::pow2( vecY[ff][ii] - fit.f(vecX[ff][ii]) );
+			fit.setGuess( reference[ff] );
+			for (size_t ii=0; ii<nr_pts; ii++) ref_ssr += Optim::pow2( vecY[ff][ii] - fit.f(vecX[ff][ii]) );
+			if (ssr > ref_ssr*(1.+1e-9)) nr_worse++;
+		}
+		std::ostringstream os;
+		os << nr_converged << "/" << nr_fits << " fits converged (reference: " << nr_ref_converged << "), ";
+		os << "max relative difference of the coefficients " << max_diff << ", ";
+		os << nr_worse << "/" << nr_both << " with larger residuals than the reference";
+		results.back().check = os.str();
+		std::cerr << "\t-> " << results.back().check << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try {
+		BenchParams params;
+		parseCmdLine(argc, argv, params);
+		prepareDirectory( params.workdir );
+		params.workdir = FileUtils::cleanPath(params.workdir, true);
+
+		Date dateStart(2024, 1, 15, 0, 0, TZ);
+		const Date dateEnd( dateStart + static_cast<double>(params.nr_days) );
+
+		const DEMObject dem( generateDEM(params) );
+		const std::vector<Coords> vecPositions( generateStations(params, dem) );
+
+		benchTimeSeries(params, vecPositions, dateStart, dateEnd);
+		benchInterpolations(params, vecPositions, dem, dateStart);
+		benchGrids(params, dem, dateStart);
+		benchResampling(params, dem);
+		benchFit1D(params);
+
+		const std::string json( toJSON(params) );
+		if (params.output.empty()) {
+			std::cout << json;
+		} else {
+			ofilestream fout(params.output);
+			fout << json;
+			fout.close();
+			std::cerr << "Results written to " << params.output << std::endl;
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -44,7 +44,7 @@ static void real_main(int argc, char** argv)
 		io.getMeteoData(d, Meteo); //read 1 timestep at once, forcing resampling to the timestep
 		for(size_t ii=0; ii<Meteo.size(); ii++) { //loop over all stations
 			if (Meteo[ii].isNodata()) continue;
-			const std::string stationID( Meteo[ii].meta.stationID );
+			const std::string stationID( Meteo[ii].meta->stationID );
 			if (mapIDs.count( stationID )==0) { //if this is the first time we encounter this station, save where it should be inserted
 				mapIDs[ stationID ] = insert_position++;
 				vecMeteo.push_back( std::vector<MeteoData>() ); //allocating the new station
@@ -19,7 +19,7 @@
 #include <meteoio/Config.h>
 #include <meteoio/FileUtils.h>
 #include <meteoio/FStream.h>
-#include <meteoio/thirdParty/tinyexpr.h>
+#include <meteoio/Expression.h>
 
 #include <algorithm>
 #include <fstream>
@@ -34,13 +34,54 @@ static const char* defaultSection = "GENERAL";
 static const char NUM[] = "0123456789";
 
 //Constructors
-Config::Config() : properties(), sections(), sourcename(), configRootDir() {}
+Config::Config() : properties(), index(), sections(), sourcename(), configRootDir() {}
 
-Config::Config(const std::string& i_filename) : properties(), sections(), sourcename(i_filename), configRootDir(FileUtils::getPath(i_filename, true))
+Config::Config(const std::string& i_filename) : properties(), index(), sections(), sourcename(i_filename), configRootDir(FileUtils::getPath(i_filename, true))
 {
 	addFile(i_filename);
 }
 
+//the index points into properties, so it must be rebuilt for each copy
+Config::Config(const Config& c) : properties(c.properties), index(), sections(c.sections), sourcename(c.sourcename), configRootDir(c.configRootDir)
+{
+	rebuildIndex();
+}
+
+Config& Config::operator=(const Config& c)
+{
+	if (this != &c) {
+		properties = c.properties;
+		sections = c.sections;
+		sourcename = c.sourcename;
+		configRootDir = c.configRootDir;
+		rebuildIndex();
+	}
+	return *this;
+}
+
+void Config::rebuildIndex()
+{
+	index.clear();
+	index.reserve( properties.size() );
+	for (const auto& prop : properties) index[ prop.first ] = &prop.second;
+}
+
+const std::string* Config::findValue(const std::string& key, const std::string& section) const
+{
+	//the full key is built in a per-thread buffer, so once it has grown, lookups do not allocate anymore
+	thread_local std::string full_key;
+	full_key.assign( section ).append( "::" ).append( key );
+	IOUtils::toUpper( full_key );
+
+	const std::unordered_map<std::string, const std::string*>::const_iterator it( index.find(full_key) );
+	return (it!=index.end())? it->second : nullptr;
+}
+
+void Config::throwNoValue(const std::string& key, const std::string& section) const
+{
+	throw UnknownValueException("[E] Error in "+sourcename+": no value for key "+IOUtils::strToUpper(section)+"::"+IOUtils::strToUpper(key), AT);
+}
+
 const ConfigProxy Config::get(const std::string& key, const std::string& section) const
 {
 	return ConfigProxy(*this, key, section);
@@ -107,155 +148,139 @@ void Config::addFile(const std::string& i_filename)
 	if (configRootDir.empty()) configRootDir = FileUtils::getPath(i_filename, true);
 	sourcename = i_filename;
 	const ConfigParser parser( i_filename, properties, sections );
+	rebuildIndex();
 }
 
 void Config::addKey(std::string key, std::string section, const std::string& value)
 {
 	IOUtils::toUpper(section);
 	IOUtils::toUpper(key);
-	properties[ section + "::" + key ] = value;
+	const std::string full_key( section + "::" + key );
+	std::string& stored_value = properties[ full_key ];
+	stored_value = value;
+	index[ full_key ] = &stored_value;
+	sections.insert( section ); //so a Config built from scratch also knows its sections
 }
 
 void Config::deleteKey(std::string key, std::string section)
 {
 	IOUtils::toUpper(section);
 	IOUtils::toUpper(key);
-	properties.erase( section + "::" + key );
+	const std::string full_key( section + "::" + key );
+	index.erase( full_key );
+	properties.erase( full_key );
 }
 
 void Config::deleteKeys(std::string keymatch, std::string section, const bool& anywhere)
 {
 	IOUtils::toUpper(section);
 	IOUtils::toUpper(keymatch);
-	const size_t section_len = section.length();
-
-	//Loop through keys, look for match - delete matches
-	if (anywhere) {
-		std::map<std::string,std::string>::iterator it = properties.begin();
-		while (it != properties.end()) {
-			const size_t section_start = (it->first).find(section, 0);
-
-			if ( section_start==0 && (it->first).find(keymatch, section_len)!=string::npos )
-				properties.erase( it++ ); // advance before iterator become invalid
-			else //wrong section or no match
-				++it;
-		}
-
-	} else {
-		keymatch = section + "::" + keymatch;
-		std::map<std::string,std::string>::iterator it = properties.begin();
-		while (it != properties.end()) {
-			if ( (it->first).find(keymatch, 0)==0 ) //match found at start
-				properties.erase( it++ ); // advance before iterator become invalid
-			else
-				++it;
+	const std::string section_prefix( section + "::" );
+	const std::string prefix( (anywhere)? section_prefix : section_prefix + keymatch );
+
+	//Loop through the keys starting with prefix, look for match - delete matches
+	std::map<std::string,std::string>::iterator it( properties.lower_bound(prefix) );
+	while (it != properties.end() && it->first.compare(0, prefix.length(), prefix)==0) {
+		if (!anywhere || (it->first).find(keymatch, section.length())!=string::npos) {
+			index.erase( it->first );
+			properties.erase( it++ ); // advance before iterator become invalid
+		} else {
+			++it;
 		}
 	}
 }
 
 bool Config::keyExists(std::string key, std::string section) const
 {
-	IOUtils::toUpper(section);
-	IOUtils::toUpper(key);
-	const std::string full_key( section + "::" + key );
-	const std::map<string,string>::const_iterator it = properties.find(full_key);
-	return (it!=properties.end());
+	return (findValue(key, section)!=nullptr);
 }
 
 bool Config::sectionExists(std::string section) const
 {
 	IOUtils::toUpper( section );
-	std::set<std::string>::const_iterator it = sections.begin();
-
-	for (; it!=sections.end(); ++it) {
-		if (*it==section) return true;
-	}
-
-	return false;
+	return (sections.count(section)!=0);
 }
 
 void Config::moveSection(std::string org, std::string dest, const bool& overwrite)
 {
 	IOUtils::toUpper( org );
 	IOUtils::toUpper( dest );
-	std::map<string,string>::iterator it = properties.begin();
+	if (org == dest) return; //nothing to move and nothing to overwrite
+	const std::string org_prefix( org + "::" );
+	const std::string dest_prefix( dest + "::" );
 
 	//delete all current keys in "dest" if overwrite==true
 	if (overwrite) {
-		while (it != properties.end()) {
-			const std::string::size_type pos = it->first.find("::");
-			if (pos!=std::string::npos) {
-				const std::string sectionname( IOUtils::strToUpper(it->first.substr(0, pos)) );
-				if (sectionname==dest) properties.erase( it++ ); // advance before iterator become invalid
-				else ++it;
-			} else {
-				++it;
-			}
-		}
+		std::map<string,string>::iterator it( properties.lower_bound(dest_prefix) );
+		while (it != properties.end() && it->first.compare(0, dest_prefix.length(), dest_prefix)==0)
+			properties.erase( it++ ); // advance before iterator become invalid
 	}
 
 	//move the keys from org to dest
-	it = properties.begin();
-	while (it != properties.end()) {
-		const std::string::size_type pos = it->first.find("::");
-		if (pos!=std::string::npos) {
-			const std::string sectionname( IOUtils::strToUpper(it->first.substr(0, pos)) );
-			if (sectionname==org) {
-				const std::string key( it->first.substr(pos) );
-				properties[ dest+key ] = it->second;
-				properties.erase( it++ ); // advance before iterator become invalid
-			} else {
-				++it;
-			}
-		} else {
-			++it;
-		}
+	std::map<string,string>::iterator it( properties.lower_bound(org_prefix) );
+	while (it != properties.end() && it->first.compare(0, org_prefix.length(), org_prefix)==0) {
+		properties[ dest_prefix + it->first.substr(org_prefix.length()) ] = it->second;
+		properties.erase( it++ ); // advance before iterator become invalid
 	}
+
+	rebuildIndex();
 }
 
-std::vector< std::pair<std::string, std::string> > Config::getValuesRegex(const std::string& regex_str, std::string section) const
+/**
+ * @brief Split a key built as {root}{integral number}, the root not containing any digit
+ * @details This is used to sort keys such as STATION2 before STATION10.
+ * @param[in] key key to split
+ * @param[out] key_root the root of the key
+ * @param[out] key_index the index of the key
+ * @return true if the key could be split, false otherwise
+ */
+static bool splitIndexedKey(const std::string& key, std::string& key_root, int& key_index)
+{
+	const size_t root_end = key.find_last_not_of(NUM);
+	if (root_end==std::string::npos) return false; //empty root
+	const size_t nr_digits = key.length() - root_end - 1;
+	if (nr_digits==0 || nr_digits>9) return false; //limit the number of digits so it fits within an "int" for the call to atoi()
+	if (key.find_first_of(NUM) < root_end) return false; //the root must not contain any digit
+
+	key_root = key.substr(0, root_end+1);
+	key_index = atoi( key.c_str() + root_end + 1 );
+	return true;
+}
+
+/**
+ * @brief Sort the matching keys by their index if they are all indexed, ie like {some prefix}{some integral number}
+ * @param[in] vecMatches matching (key, value) pairs, in alphabetical order
+ * @return the matching pairs, sorted
+ */
+static std::vector< std::pair<std::string, std::string> > sortIndexedKeys(const std::vector< std::pair<std::string, std::string> >& vecMatches)
 {
-	//regex for selecting the keys
-	static const std::regex user_regex(regex_str);
-	//regex to try sorting the keys by numerical order of their index, so STATION2 comes before STATION10
-	static const std::regex index_regex("([^0-9]+)([0-9]{1,9})$"); //limit the number of digits so it fits within an "int" for the call to atoi()
-	std::smatch index_matches;
-	
-	IOUtils::toUpper(section);
 	std::vector< std::pair<std::string, std::string> > vecResult;
+	//stores (index, key_root) as map index and (key, value) as map value
+	//although the key could be rebuilt from (index, key_root), storing it makes conversion 
+	//to the vector of pair to be returned easier and robust
 	std::map< std::pair<int, std::string>, std::pair<std::string, std::string> > keyMap;
 	bool indexed_keys = true;
-	
-	for (const auto& prop : properties) {
-		const size_t section_start = (prop.first).find(section, 0);
-		if (section_start==0) { //found the section!
-			const size_t section_len = section.length();
-			const std::string key_no_section( prop.first.substr(section_len+2) ); //account for "::" between section and key
-			
-			if (std::regex_match(key_no_section, user_regex)) {
-				//we want to figure out of the keys are all indexed, ie like {some prefix}{some integral number}
-				if (indexed_keys) {
-					if (std::regex_match(key_no_section, index_matches, index_regex)) { //retrieve the key index
-						const std::string key_root( index_matches.str(1) );
-						const int index = atoi( index_matches.str(2).c_str() ); //we take the first capture group, guaranteed to fit in an int
-						keyMap[ make_pair(index, key_root) ] = make_pair(key_no_section, prop.second);
-					} else {
-						indexed_keys = false;
-					}
-				}
-				
-				//keys are not indexed, store them directly in the results vector
-				//if indexed_keys just got toggled above, we recover already processed keys
-				if (!indexed_keys) {
-					//the keys are not indexed, move the processed keys into the results vector
-					for (const auto& key_record : keyMap) vecResult.push_back( key_record.second );
-					keyMap.clear();
-					vecResult.push_back( make_pair(key_no_section, prop.second) ); //push the current, unprocessed key
-				}
-			}
+	std::string key_root;
+	int key_index;
+
+	for (const auto& match : vecMatches) {
+		if (indexed_keys) {
+			if (splitIndexedKey(match.first, key_root, key_index))
+				keyMap[ make_pair(key_index, key_root) ] = match;
+			else
+				indexed_keys = false;
+		}
+
+		//keys are not indexed, store them directly in the results vector
+		//if indexed_keys just got toggled above, we recover already processed keys
+		if (!indexed_keys) {
+			//the keys are not indexed, move the processed keys into the results vector
+			for (const auto& key_record : keyMap) vecResult.push_back( key_record.second );
+			keyMap.clear();
+			vecResult.push_back( match ); //push the current, unprocessed key
 		}
 	}
-	
+
 	if (indexed_keys && !keyMap.empty()) {
 		for (const auto& key_record : keyMap) {
 			vecResult.push_back( key_record.second );
@@ -265,93 +290,52 @@ std::vector< std::pair<std::string, std::string> > Config::getValuesRegex(const
 	return vecResult;
 }
 
+std::vector< std::pair<std::string, std::string> > Config::getValuesRegex(const std::string& regex_str, std::string section) const
+{
+	//compiling a regex is expensive, so the most recent ones are kept per thread
+	thread_local std::map<std::string, std::regex> regex_cache;
+	std::map<std::string, std::regex>::const_iterator regex_it( regex_cache.find(regex_str) );
+	if (regex_it==regex_cache.end()) {
+		if (regex_cache.size()>=32) regex_cache.clear();
+		regex_it = regex_cache.insert( make_pair(regex_str, std::regex(regex_str)) ).first;
+	}
+	const std::regex& user_regex = regex_it->second;
+	
+	IOUtils::toUpper(section);
+	const std::string section_prefix( section + "::" );
+	std::vector< std::pair<std::string, std::string> > vecMatches;
+	
+	//keys are sorted, so all the keys of a section are contiguous
+	for (std::map<std::string,std::string>::const_iterator it( properties.lower_bound(section_prefix) ); it != properties.end(); ++it) {
+		if (it->first.compare(0, section_prefix.length(), section_prefix)!=0) break;
+		
+		const std::string key_no_section( it->first.substr(section_prefix.length()) );
+		if (std::regex_match(key_no_section, user_regex))
+			vecMatches.push_back( make_pair(key_no_section, it->second) );
+	}
+
+	return sortIndexedKeys( vecMatches );
+}
+
 std::vector< std::pair<std::string, std::string> > Config::getValues(std::string keymatch, std::string section, const bool& anywhere) const
 {
-	static const std::regex index_regex("([^0-9]+)([0-9]{1,9})"); //limit the number of digits so it fits within an "int" for the call to atoi()
-	std::smatch index_matches;
 	IOUtils::toUpper(section);
 	IOUtils::toUpper(keymatch);
-	
-	std::vector< std::pair<std::string, std::string> > vecResult;
-	//stores (index, key_root) as map index and (key, value) as map value
-	//although the key could be rebuilt from (index, key_root), storing it makes conversion 
-	//to the vector of pair to be returned easier and robust
-	std::map< std::pair<int, std::string>, std::pair<std::string, std::string> > keyMap;
-	bool indexed_keys = true;
+	const std::string section_prefix( section + "::" );
+	const std::string prefix( (anywhere)? section_prefix : section_prefix + keymatch );
+	std::vector< std::pair<std::string, std::string> > vecMatches;
 
-	//Loop through keys, look for match - push it into vecResult
-	if (anywhere) {
-		for (const auto& prop : properties) {
-			const size_t section_start = (prop.first).find(section, 0);
-			if (section_start==0) { //found the section!
-				const size_t section_len = section.length();
-				const size_t found_pos = (prop.first).find(keymatch, section_len);
-				if (found_pos!=string::npos) { //found it!
-					const std::string key( (prop.first).substr(section_len + 2) ); //from pos to the end
-					
-					//we want to figure out of the keys are all indexed, ie like {some prefix}{some integral number}
-					if (indexed_keys) {
-						if (std::regex_match(key, index_matches, index_regex)) { //retrieve the key index
-							const std::string key_root( index_matches.str(1) );
-							const int index = atoi( index_matches.str(2).c_str() ); //we take the first capture group, guaranteed to fit in an int
-							keyMap[ make_pair(index, key_root) ] = make_pair(key, prop.second);
-						} else {
-							indexed_keys = false;
-						}
-					}
-					
-					//keys are not indexed, store them directly in the results vector
-					//if indexed_keys just got toggled above, we recover already processed keys
-					if (!indexed_keys) {
-						//the keys are not indexed, move the processed keys into the results vector
-						for (const auto& key_record : keyMap) vecResult.push_back( key_record.second );
-						keyMap.clear();
-						vecResult.push_back( make_pair(key, prop.second) ); //push the current, unprocessed key
-					}
-				}
-			}
-		}
-	} else {
-		keymatch = section + "::" + keymatch;
-		for (const auto& prop : properties) {
-			const size_t found_pos = (prop.first).find(keymatch, 0);
-			if (found_pos==0) { //found it starting at the begining
-				const size_t section_len = section.length();
-				const std::string key( (prop.first).substr(section_len + 2) ); //from pos to the end
-				
-				//we want to figure out of the keys are all indexed, ie like {some prefix}{some integral number}
-				if (indexed_keys) {
-					if (std::regex_match(key, index_matches, index_regex)) { //retrieve the key index
-						const std::string key_root( index_matches.str(1) );
-						const int index = atoi( index_matches.str(2).c_str() ); //we take the first capture group, guaranteed to fit in an int
-						keyMap[ make_pair(index, key_root) ] = make_pair(key, prop.second);
-					} else {
-						indexed_keys = false;
-					}
-				}
-				
-				//keys are not indexed, store them directly in the results vector
-				//if indexed_keys just got toggled above, we recover already processed keys
-				if (!indexed_keys) {
-					//the keys are not indexed, move the processed keys into the results vector
-					for (const auto& key_record : keyMap) vecResult.push_back( key_record.second );
-					keyMap.clear();
-					vecResult.push_back( make_pair(key, prop.second) ); //push the current, unprocessed key
-				}
-			}
-		}
-	}
-	
-	if (indexed_keys && !keyMap.empty()) {
-		for (const auto& key_record : keyMap) {
-			vecResult.push_back( key_record.second );
-		}
+	//keys are sorted, so all the keys starting with prefix are contiguous
+	for (std::map<std::string,std::string>::const_iterator it( properties.lower_bound(prefix) ); it != properties.end(); ++it) {
+		if (it->first.compare(0, prefix.length(), prefix)!=0) break;
+		if (anywhere && (it->first).find(keymatch, section.length())==string::npos) continue;
+
+		vecMatches.push_back( make_pair(it->first.substr(section_prefix.length()), it->second) );
 	}
 
-	return vecResult;
+	return sortIndexedKeys( vecMatches );
 }
 
-
 std::vector<std::string> Config::getKeysRegex(const std::string& regex_str, std::string section) const
 {
 	const std::vector< std::pair<std::string, std::string> > vecKeys( getValuesRegex(regex_str, section) );
@@ -506,6 +490,7 @@ std::istream& operator>>(std::istream& is, Config& cfg) {
 
 		cfg.sections.insert( value );
 	}
+	cfg.rebuildIndex();
 	return is;
 }
 
@@ -719,11 +704,12 @@ void ConfigParser::processExpr(std::string& value)
 		
 		const size_t len = pos_end - (pos_start+len_expr_marker); //we have tested above that this is >=1
 		const std::string expression( value.substr(pos_start+len_expr_marker, len ) );
-		int status_code;
-		const double val = te_interp(expression.c_str(), &status_code);
-		
-		if (status_code!=0)
+		double val;
+		try {
+			val = Expression::evaluate(expression);
+		} catch (const InvalidFormatException&) {
 			throw InvalidNameException("Arithmetic expression '"+expression+"' declared in ini file could not be evaluated", AT);
+		}
 		
 		value.replace(pos_start, pos_end+2, IOUtils::toString(val));  //we also replace the closing "))"
 	}
@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <typeinfo> //for typeid()
 
@@ -48,6 +49,10 @@ namespace mio {
  * @note The arithemic expressions are evaluated thanks to the <A HREF="https://codeplea.com/tinyexpr">tinyexpr</A> math library (under the 
  * <A HREF="https://opensource.org/licenses/Zlib">zlib license</A>) and can use standard operators (including "^"), 
  * standard functions (such as "sin", "sqrt", "ln", "log", "exp", "floor"...) as well as the "pi" and "e" constants.
+ *
+ * @note The values are kept as strings and converted at each getValue() call. The key lookups are hashed, but the converted
+ * values are not cached: such a cache would have to be keyed by both the key and the requested type and be invalidated at
+ * every change of the configuration, while converting a single value is cheap compared to the lookup itself.
  * 
  * @section config_import Imports
  * It is possible to import another ini file, by specifying as many of the keys listed below as necessary.
@@ -89,6 +94,9 @@ class Config {
 		 */
 		Config(const std::string& filename_in);
 
+		Config(const Config& c);
+		Config& operator=(const Config& c);
+
 		/**
 		 * @brief Write the Config object to a file
 		 * @param filename The filename including the path, e.g. "/tmp/test.ini"
@@ -201,17 +209,24 @@ class Config {
 		 * @param[out] vecT a variable of class vector<T> into which the values for the corresponding key are saved
 		 * @param[in] opt indicating whether an exception should be raised, when key is not present
 		 */
-		template <typename T> void getValue(std::string key, std::string section,
+		template <typename T> void getValue(const std::string& key, const std::string& section,
 		                                    std::vector<T>& vecT, const IOUtils::ThrowOptions& opt=IOUtils::dothrow) const
 		{
 			vecT.clear();
-			IOUtils::toUpper(key);
-			IOUtils::toUpper(section);
+			const std::string* value = findValue(key, section);
+			if (value==nullptr) {
+				if (opt==IOUtils::nothrow) return;
+				throwNoValue(key, section);
+			}
 
-			try {
-				IOUtils::getValueForKey<T>(properties, section + "::" + key, vecT, opt);
-			} catch(const std::exception&){
-				throw UnknownValueException("[E] Error in "+sourcename+": no value for key "+section+"::"+key, AT);
+			std::vector<std::string> vecUnconvertedValues;
+			const size_t counter = IOUtils::readLineToVec(*value, vecUnconvertedValues);
+			vecT.resize( counter );
+			for (size_t ii=0; ii<counter; ii++) {
+				try { //some conversions throw, even with nothrow
+					if (IOUtils::convertString<T>(vecT[ii], vecUnconvertedValues[ii], std::dec) || opt==IOUtils::nothrow) continue;
+				} catch(const std::exception&) {}
+				throwNoValue(key, section);
 			}
 		}
 
@@ -287,17 +302,19 @@ class Config {
 		 * @param[out] t a variable of class T into which the value for the corresponding key is saved (e.g. double, int, std::string)
 		 * @param[in] opt indicating whether an exception should be raised, when key is not present
 		 */
-		template <typename T> void getValue(std::string key, std::string section, T& t,
+		template <typename T> void getValue(const std::string& key, const std::string& section, T& t,
                                               const IOUtils::ThrowOptions& opt=IOUtils::dothrow) const
 		{
-			IOUtils::toUpper(key);
-			IOUtils::toUpper(section);
-
-			try {
-				IOUtils::getValueForKey<T>(properties, section + "::" + key, t, opt);
-			} catch(const std::exception&){
-				throw UnknownValueException("[E] Error in "+sourcename+": no value for key "+section+"::"+key, AT);
+			const std::string* value = findValue(key, section);
+			if (value==nullptr) {
+				if (opt==IOUtils::nothrow) return;
+				throwNoValue(key, section);
 			}
+
+			try { //some conversions throw, even with nothrow
+				if (IOUtils::convertString<T>(t, *value, std::dec) || opt==IOUtils::nothrow) return;
+			} catch(const std::exception&) {}
+			throwNoValue(key, section);
 		}
 		
 		/**
@@ -308,28 +325,24 @@ class Config {
 		 * @param[out] time_zone timezone for the date (if the date provides its own timezone, it will be ignored)
 		 * @param[in] opt indicating whether an exception should be raised, when key is not present
 		 */
-		void getValue(std::string key, std::string section, Date& t, const double& time_zone, 
+		void getValue(const std::string& key, const std::string& section, Date& t, const double& time_zone, 
                                               const IOUtils::ThrowOptions& opt=IOUtils::dothrow) const
 		{
 			t.setUndef(true);
-			IOUtils::toUpper(key);
-			IOUtils::toUpper(section);
-			std::string tmp;
-			
-			try {
-				IOUtils::getValueForKey<std::string>(properties, section + "::" + key, tmp, opt);
-			} catch(const std::exception&){
-				throw UnknownValueException("[E] Error in "+sourcename+": no value for key "+section+"::"+key, AT);
+			const std::string* value = findValue(key, section);
+			if (value==nullptr) {
+				if (opt==IOUtils::nothrow) return;
+				throwNoValue(key, section);
 			}
 			
 			bool parse_ok = false;
 			try {
-				parse_ok = IOUtils::convertString(t, tmp, time_zone);
+				parse_ok = IOUtils::convertString(t, *value, time_zone);
 			} catch(const std::exception&){
 				parse_ok = false;
 			}
 			if (!parse_ok && opt==IOUtils::dothrow)
-				throw InvalidFormatException("Could not parse date '"+tmp+"' in "+sourcename+"for key "+section+"::"+key, AT);
+				throw InvalidFormatException("Could not parse date '"+*value+"' in "+sourcename+"for key "+IOUtils::strToUpper(section)+"::"+IOUtils::strToUpper(key), AT);
 		}
 		
 		/**
@@ -348,14 +361,16 @@ class Config {
 			IOUtils::toUpper(section);
 			const std::vector< std::string > vecKeys( getKeys(keymatch, section) );
 
+			vecT.reserve( vecKeys.size() );
 			for (const std::string& key : vecKeys) {
-				const std::string full_key( section + "::" + key );
+				const std::string* value = findValue(key, section);
 				T tmp;
+				bool converted = false;
 				try {
-					IOUtils::getValueForKey<T>(properties, full_key, tmp, IOUtils::dothrow);
-				} catch(const std::exception&){
-					throw UnknownValueException("[E] Error in "+sourcename+" reading key "+full_key, AT);
-				}
+					converted = (value!=nullptr && IOUtils::convertString<T>(tmp, *value, std::dec));
+				} catch(const std::exception&) {}
+				if (!converted)
+					throw UnknownValueException("[E] Error in "+sourcename+" reading key "+section+"::"+key, AT);
 				vecT.push_back( tmp );
 			}
 		}
@@ -367,14 +382,16 @@ class Config {
 			IOUtils::toUpper(section);
 			vecKeys = getKeys(keymatch, section);
 
+			vecT.reserve( vecKeys.size() );
 			for (const std::string& key : vecKeys) {
-				const std::string full_key = section + "::" + key;
+				const std::string* value = findValue(key, section);
 				T tmp;
+				bool converted = false;
 				try {
-					IOUtils::getValueForKey<T>(properties, full_key, tmp, IOUtils::dothrow);
-				} catch(const std::exception&){
-					throw UnknownValueException("[E] Error in "+sourcename+" reading key "+full_key, AT);
-				}
+					converted = (value!=nullptr && IOUtils::convertString<T>(tmp, *value, std::dec));
+				} catch(const std::exception&) {}
+				if (!converted)
+					throw UnknownValueException("[E] Error in "+sourcename+" reading key "+section+"::"+key, AT);
 				vecT.push_back( tmp );
 			}
 		}
@@ -466,7 +483,12 @@ class Config {
 
 
 	private:
+		const std::string* findValue(const std::string& key, const std::string& section) const;
+		[[noreturn]] void throwNoValue(const std::string& key, const std::string& section) const;
+		void rebuildIndex();
+
 		std::map<std::string, std::string> properties; ///< Save key value pairs
+		std::unordered_map<std::string, const std::string*> index; ///< hashed "SECTION::KEY" lookups into the values of properties
  		std::set<std::string> sections; ///< list of all the sections that have been found
 		std::string sourcename; ///< description of the data source for the key/value pair
 		std::string configRootDir; ///< directory of the root config file
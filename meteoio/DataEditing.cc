@@ -20,6 +20,7 @@
 #include <meteoio/IOExceptions.h>
 #include <meteoio/IOUtils.h>
 #include <meteoio/FileUtils.h>
+#include <meteoio/Timer.h>
 #include <meteoio/dataClasses/MeteoData.h> //needed for the merge strategies
 
 #include <algorithm>
@@ -258,6 +259,7 @@ void DataEditing::editTimeSeries(STATIONS_SET& vecStation)
 void DataEditing::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 {
 	if (!enable_ts_editing) return;
+	const ProfilerScope profile( "editing" );
 	
 	const std::map< std::string, std::set<std::string> > dependencies( getDependencies() );
 	const std::vector<std::string> processing_order( getProcessingOrder(dependencies) );
@@ -287,7 +289,7 @@ void DataEditing::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 	const std::set<std::string> mergedFromIDs( getMergedFromIDs() );
 	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
 		if (vecMeteo[ii].empty())  continue;
-		const std::string stationID( IOUtils::strToUpper(vecMeteo[ii][0].meta.stationID) );
+		const std::string stationID( IOUtils::strToUpper(vecMeteo[ii][0].meta->stationID) );
 		if (mergedFromIDs.count( stationID ) >  0) {
 			std::swap( vecMeteo[ii], vecMeteo.back() );
 			vecMeteo.pop_back();
@@ -27,6 +27,7 @@
 #include <meteoio/meteoStats/libfit1D.h>
 
 #include <algorithm>
+#include <set>
 #include <fstream>
 
 using namespace std;
@@ -111,7 +112,7 @@ bool EditingBlock::skipStation(const std::vector<MeteoData>& vecMeteo) const
 {
 	if (vecMeteo.empty()) return true;
 	
-	const std::string currentID( IOUtils::strToUpper( vecMeteo.front().meta.stationID ) );
+	const std::string currentID( IOUtils::strToUpper( vecMeteo.front().meta->stationID ) );
 	if (stationID!="*" && stationID!=currentID) return true; //not the station this EditingBlock has been configured for
 	if (excluded_stations.count(currentID)!=0) return true; //the station is in the excluded list -> skip
 	if (kept_stations.empty()) return false; //there are no kept stations -> do not skip
@@ -412,27 +413,81 @@ void EditingAutoMerge::parse_args(const std::vector< std::pair<std::string, std:
 	}
 }
 
-void EditingAutoMerge::mergeStations(const size_t& toStationIdx, STATIONS_SET& vecStation)
+/**
+ * @brief Positions of the stations sharing the same (case insensitive) station ID
+ * @details The station IDs are normalized and hashed only once. When a station is merged into another one, it is
+ * swapped with the last station of the vector that is then popped. This class mirrors these moves, so the stations
+ * are still merged in the very same order as when scanning all the following stations for each station, but
+ * without comparing each station with all the others.
+ */
+class EditingAutoMerge::StationGroups {
+	public:
+		StationGroups() : group(), positions(), groups_index() {}
+
+		/** @brief Register the next station, the stations without ID (such as empty timeseries) are never merged */
+		void push_back(const std::string& stationID, const bool& has_id=true)
+		{
+			if (!has_id) {
+				group.push_back( IOUtils::npos );
+				return;
+			}
+
+			const std::pair<std::unordered_map<std::string, size_t>::iterator, bool> ins( groups_index.insert( std::make_pair(IOUtils::strToUpper(stationID), positions.size()) ) );
+			if (ins.second) positions.push_back( std::set<size_t>() );
+			group.push_back( ins.first->second );
+			positions[ ins.first->second ].insert( group.size()-1 );
+		}
+
+		/** @brief First position after toStationIdx holding a station with the same ID, IOUtils::npos if there is none */
+		size_t next(const size_t& toStationIdx) const
+		{
+			const size_t grp = group[toStationIdx];
+			if (grp==IOUtils::npos) return IOUtils::npos;
+			const std::set<size_t>::const_iterator it( positions[grp].upper_bound(toStationIdx) );
+			return (it!=positions[grp].end())? *it : IOUtils::npos;
+		}
+
+		/** @brief Forget the station at position idx, after it has been swapped with the last station and popped */
+		void remove(const size_t& idx)
+		{
+			const size_t last = group.size() - 1;
+			if (group[idx]!=IOUtils::npos) positions[ group[idx] ].erase( idx );
+			if (idx!=last) {
+				const size_t last_grp = group[last];
+				if (last_grp!=IOUtils::npos) {
+					positions[last_grp].erase( last );
+					positions[last_grp].insert( idx );
+				}
+				group[idx] = last_grp;
+			}
+			group.pop_back();
+		}
+
+	private:
+		std::vector<size_t> group; ///< group of each station, by position
+		std::vector< std::set<size_t> > positions; ///< sorted positions of the stations of each group
+		std::unordered_map<std::string, size_t> groups_index; ///< group of each normalized station ID
+};
+
+void EditingAutoMerge::mergeStations(const size_t& toStationIdx, STATIONS_SET& vecStation, StationGroups& groups)
 {
-	const std::string toStationID( IOUtils::strToUpper(vecStation[toStationIdx].stationID) );
-	
 	//stations before toStationIdx are not == stationID both for the "*" station and for any specific stationID
-	for (size_t jj=toStationIdx+1; jj<vecStation.size(); jj++) { //loop over the stations
-		const std::string fromStationID( IOUtils::strToUpper(vecStation[jj].stationID) );
-		if (fromStationID==toStationID) {
-			vecStation[toStationIdx].merge( vecStation[jj] );
-			std::swap( vecStation[jj], vecStation.back() );
-			vecStation.pop_back();
-			jj--; //we need to redo the current jj, because it contains another station
-		}
+	for (size_t jj=groups.next(toStationIdx); jj!=IOUtils::npos; jj=groups.next(toStationIdx)) {
+		vecStation[toStationIdx].merge( vecStation[jj] );
+		std::swap( vecStation[jj], vecStation.back() );
+		vecStation.pop_back();
+		groups.remove( jj );
 	}
 }
 
 void EditingAutoMerge::editTimeSeries(STATIONS_SET& vecStation)
 {
+	StationGroups groups;
+	for (size_t ii=0; ii<vecStation.size(); ii++) groups.push_back( vecStation[ii].stationID );
+
 	if (stationID=="*") {
 		for (size_t ii=0; ii<vecStation.size(); ii++) {
-			mergeStations(ii, vecStation);
+			mergeStations(ii, vecStation, groups);
 		}
 	} else {
 		//find our current station in vecStation
@@ -445,41 +500,41 @@ void EditingAutoMerge::editTimeSeries(STATIONS_SET& vecStation)
 		}
 		
 		if (toStationIdx==IOUtils::npos) return;
-		mergeStations(toStationIdx, vecStation);
+		mergeStations(toStationIdx, vecStation, groups);
 	}
 }
 
-void EditingAutoMerge::mergeMeteo(const size_t& toStationIdx, std::vector<METEO_SET>& vecMeteo) const
+void EditingAutoMerge::mergeMeteo(const size_t& toStationIdx, std::vector<METEO_SET>& vecMeteo, StationGroups& groups) const
 {
-	const std::string toStationID( IOUtils::strToUpper(vecMeteo[toStationIdx].front().getStationID()) );
 	size_t nr_conflicts = 0;
 	
-	for (size_t jj=toStationIdx+1; jj<vecMeteo.size(); jj++) { //loop over the stations
-		if (vecMeteo[jj].empty())  continue;
-		
-		const std::string fromStationID( IOUtils::strToUpper(vecMeteo[jj].front().getStationID()) );
-		if (fromStationID==toStationID) {
-			if (time_restrictions.empty()) {
-				nr_conflicts += MeteoData::mergeTimeSeries(vecMeteo[toStationIdx], vecMeteo[jj], merge_strategy, merge_conflicts); //merge timeseries for the two stations
-			} else {
-				std::vector<MeteoData> tmp_meteo( timeFilterFromStation(vecMeteo[jj]) );
-				nr_conflicts += MeteoData::mergeTimeSeries(vecMeteo[toStationIdx], tmp_meteo, merge_strategy, merge_conflicts); //merge timeseries for the two stations
-			}
-			std::swap( vecMeteo[jj], vecMeteo.back() );
-			vecMeteo.pop_back();
-			jj--; //we need to redo the current jj, because it contains another station
+	for (size_t jj=groups.next(toStationIdx); jj!=IOUtils::npos; jj=groups.next(toStationIdx)) { //loop over the stations sharing the same ID
+		if (time_restrictions.empty()) {
+			nr_conflicts += MeteoData::mergeTimeSeries(vecMeteo[toStationIdx], vecMeteo[jj], merge_strategy, merge_conflicts); //merge timeseries for the two stations
+		} else {
+			std::vector<MeteoData> tmp_meteo( timeFilterFromStation(vecMeteo[jj]) );
+			nr_conflicts += MeteoData::mergeTimeSeries(vecMeteo[toStationIdx], tmp_meteo, merge_strategy, merge_conflicts); //merge timeseries for the two stations
 		}
+		std::swap( vecMeteo[jj], vecMeteo.back() );
+		vecMeteo.pop_back();
+		groups.remove( jj );
 	}
 	
-	if (nr_conflicts>0) std::cerr << "[E] " << nr_conflicts << " automerge conflicts on station " <<  toStationID << "\n";
+	if (nr_conflicts>0) std::cerr << "[E] " << nr_conflicts << " automerge conflicts on station " <<  IOUtils::strToUpper(vecMeteo[toStationIdx].front().getStationID()) << "\n";
 }
 
 void EditingAutoMerge::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 {
+	StationGroups groups;
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (vecMeteo[ii].empty()) groups.push_back( "", false );
+		else groups.push_back( vecMeteo[ii].front().getStationID() );
+	}
+
 	if (stationID=="*") {
 		for (size_t ii=0; ii<vecMeteo.size(); ii++) {
 			if (skipStation(vecMeteo[ii])) continue;
-			mergeMeteo(ii, vecMeteo);
+			mergeMeteo(ii, vecMeteo, groups);
 		}
 	} else {
 		//find our current station in vecMeteo
@@ -494,7 +549,7 @@ void EditingAutoMerge::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 		
 		if (toStationIdx==IOUtils::npos) return;
 		//stations before toStationIdx are not == stationID, see above
-		mergeMeteo(toStationIdx, vecMeteo);
+		mergeMeteo(toStationIdx, vecMeteo, groups);
 	}
 }
 
@@ -574,13 +629,18 @@ void EditingMerge::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 	
 	if (toStationIdx == IOUtils::npos) return;
 	
+	//normalize the station IDs only once, keeping the stations in their original order within each ID
+	std::unordered_map< std::string, std::vector<size_t> > stationsIdx;
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (vecMeteo[ii].empty()) continue;
+		stationsIdx[ IOUtils::strToUpper(vecMeteo[ii].front().getStationID()) ].push_back( ii );
+	}
+	
 	for (size_t jj=0; jj<merged_stations.size(); jj++) {
-		const std::string fromStationID( IOUtils::strToUpper( merged_stations[jj] ) );
+		const std::unordered_map< std::string, std::vector<size_t> >::const_iterator it( stationsIdx.find( IOUtils::strToUpper(merged_stations[jj]) ) );
+		if (it==stationsIdx.end()) continue;
 
-		for (size_t ii=0; ii<vecMeteo.size(); ii++) {
-			if (vecMeteo[ii].empty()) continue;
-			if (IOUtils::strToUpper(vecMeteo[ii].front().getStationID()) != fromStationID) continue;
-			
+		for (const size_t ii : it->second) {
 			if (merged_params.empty()) { //merge all parameters
 				if (time_restrictions.empty()) {
 					MeteoData::mergeTimeSeries( vecMeteo[toStationIdx], vecMeteo[ii], merge_strategy, merge_conflicts );
@@ -808,6 +868,10 @@ void EditingMetadata::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 		if (!edit_in_place) vecTmp.push_back( std::vector<MeteoData>() );
 		if (skipStation(vecMeteo[station])) continue;
 		
+		//the timesteps mostly share the same metadata, so the last edition is reused when possible
+		const StationData *last_original = nullptr;
+		SharedStationData last_edited;
+		
 		//the next two lines are required to offer time restrictions
 		for (RestrictionsIdx editPeriod(vecMeteo[station], time_restrictions); editPeriod.isValid(); ++editPeriod) {
 			for (size_t jj = editPeriod.getStart(); jj < editPeriod.getEnd(); ++jj) { //loop over the timesteps
@@ -815,13 +879,19 @@ void EditingMetadata::editTimeSeries(std::vector<METEO_SET>& vecMeteo)
 					vecTmp[station].push_back( vecMeteo[station][jj] );
 					vecMeteo[station][jj].reset();
 				}
-				StationData &sd = (!edit_in_place)? vecTmp[station].back().meta : vecMeteo[station][jj].meta;
-				
-				if (!new_name.empty()) sd.stationName = new_name;
-				if (!new_id.empty()) sd.stationID = new_id;
-				if (lat!=IOUtils::nodata) sd.position.setLatLon(lat, lon, sd.getAltitude());
-				if (alt!=IOUtils::nodata) sd.position.setAltitude(alt, false);
-				if (slope!=IOUtils::nodata) sd.setSlope(slope, azi);
+				MeteoData &md = (!edit_in_place)? vecTmp[station].back() : vecMeteo[station][jj];
+				if (md.meta.get()!=last_original) {
+					last_original = md.meta.get();
+					StationData sd( md.meta );
+					
+					if (!new_name.empty()) sd.stationName = new_name;
+					if (!new_id.empty()) sd.stationID = new_id;
+					if (lat!=IOUtils::nodata) sd.position.setLatLon(lat, lon, sd.getAltitude());
+					if (alt!=IOUtils::nodata) sd.position.setAltitude(alt, false);
+					if (slope!=IOUtils::nodata) sd.setSlope(slope, azi);
+					last_edited = sd;
+				}
+				md.meta = last_edited;
 			}
 		}
 	}
@@ -300,9 +300,10 @@ class EditingAutoMerge : public EditingBlock {
 		virtual void editTimeSeries(STATIONS_SET& vecStation);
 		
 	private:
+		class StationGroups;
 		void parse_args(const std::vector< std::pair<std::string, std::string> >& vecArgs);
-		static void mergeStations(const size_t& toStationIdx, STATIONS_SET& vecStation);
-		void mergeMeteo(const size_t& toStationIdx, std::vector<METEO_SET>& vecMeteo) const;
+		static void mergeStations(const size_t& toStationIdx, STATIONS_SET& vecStation, StationGroups& groups);
+		void mergeMeteo(const size_t& toStationIdx, std::vector<METEO_SET>& vecMeteo, StationGroups& groups) const;
 		MeteoData::Merge_Type merge_strategy;
 		MeteoData::MERGE_CONFLICTS merge_conflicts;
 };
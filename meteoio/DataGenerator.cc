@@ -19,7 +19,9 @@
 
 #include <meteoio/DataGenerator.h>
 #include <meteoio/MeteoProcessor.h> //required to provide RestrictionsIdx
+#include <meteoio/Timer.h>
 
+#include <exception>
 #include <set>
 #include <regex>
 
@@ -31,9 +33,10 @@ const std::string DataGenerator::cmd_pattern( "::GENERATOR" );
 const std::string DataGenerator::arg_pattern( "::ARG" );
 
 DataGenerator::DataGenerator(const Config& cfg, const std::set<std::string>& params_to_generate)
-              : mapAlgorithms(), data_qa_logs(false)
+              : mapAlgorithms(), data_qa_logs(false), parallel(false)
 {
 	cfg.getValue("DATA_QA_LOGS", "GENERAL", data_qa_logs, IOUtils::nothrow);
+	cfg.getValue("PARALLEL", cmd_section, parallel, IOUtils::nothrow);
 	
 	const std::set<std::string> set_of_ini_parameters( getParameters(cfg) );
 	
@@ -65,6 +68,7 @@ DataGenerator& DataGenerator::operator=(const DataGenerator& source)
 	if (this != &source) {
 		mapAlgorithms = source.mapAlgorithms;
 		data_qa_logs = source.data_qa_logs;
+		parallel = source.parallel;
 	}
 	return *this;
 }
@@ -89,51 +93,56 @@ void DataGenerator::fillMissing(METEO_SET& vecMeteo) const
  * have been successfully replaced.
  * @param vecMeteo vector containing one point for each station (stations that don't have anything are excluded)
  * @param fullDataset full dataset for all stations, for generators that might need to look at data before/after
- * @param stations_idx mapping of the indices between vecMeteo (only relevant stations) and fullDataset (all stations)
+ * @param stations_idx mapping of the indices between fullDataset (all stations) and vecMeteo (only relevant stations)
  */
 void DataGenerator::fillMissing(METEO_SET& vecMeteo, const std::vector<METEO_SET>& fullDataset, const std::vector<size_t>& stations_idx) const
 {
-	if (mapAlgorithms.empty()) return; //no generators defined by the end user
-	const bool has_fullDataset = (!fullDataset.empty() && !stations_idx.empty());
+	if (mapAlgorithms.empty() || vecMeteo.empty()) return; //no generators defined by the end user
+	const ProfilerScope profile( "generators" );
+	const size_t nr_stations = vecMeteo.size();
+	const Date date( vecMeteo.front().date );
+
+	//the station IDs and the position of the stations within fullDataset are only resolved once
+	std::vector<std::string> vecIDs( nr_stations );
+	for (size_t ii=0; ii<nr_stations; ii++) vecIDs[ii] = vecMeteo[ii].meta->getStationID();
+	std::vector<size_t> dataset_idx( nr_stations, IOUtils::npos ); //reverse mapping of stations_idx
+	if (!fullDataset.empty()) {
+		for (size_t kk=0; kk<stations_idx.size(); kk++) {
+			if (stations_idx[kk]<nr_stations) dataset_idx[ stations_idx[kk] ] = kk;
+		}
+	}
+	const std::vector<MeteoData> no_data;
 
 	for (auto const& it : mapAlgorithms) { //map< paraname, algorithms_stack>
-		const std::vector<GeneratorAlgorithm*> vecGenerators( it.second );
-
-		for (size_t ii=0; ii<vecMeteo.size(); ii++) {
-			MeteoData& station( vecMeteo[ii] );
-			size_t param = station.getParameterIndex( it.first );
-			if (param==IOUtils::npos) param = station.addParameter( it.first );
-
-			const std::string statID( station.meta.getStationID() );
-			//these are only required by data_qa_logs
-			const double old_val = station(param);
-			const std::string statName( station.meta.getStationName() );
-			const std::string stat = (!statID.empty())? statID : statName;
-
-			bool status = false;
-			size_t jj=0;
-			while (jj<vecGenerators.size() && status != true) { //loop over the generators
-				if (!vecGenerators[jj]->skipStation( statID ) && !vecGenerators[jj]->skipTimeStep( vecMeteo.front().date ) ) {
-					const size_t station_idx = (has_fullDataset)? stations_idx[ii] : IOUtils::npos;
-
-					if (station_idx!=IOUtils::npos)
-						status = vecGenerators[jj]->generate(param, station, fullDataset[ stations_idx[ii] ]);
-					else
-						status = vecGenerators[jj]->generate(param, station, std::vector<MeteoData>());
-
-					if (station(param) != old_val) {
-						station.setGenerated(param);
-						if (data_qa_logs) {
-							const std::string parname( it.first );
-							const std::string algo_name( vecGenerators[jj]->getAlgo() );
-							const Date date( station.date );
-							cout << "[DATA_QA] Generating " << stat << "::" << parname << "::" << algo_name << " " << date.toString(Date::ISO_TZ) << " [" << date.toString(Date::ISO_WEEK) << "]\n";
-						}
-					} //endif new=old
-				}
-				jj++;
+		//only keep the generators that apply to this timestep
+		std::vector<GeneratorAlgorithm*> vecGenerators;
+		vecGenerators.reserve( it.second.size() );
+		for (GeneratorAlgorithm* generator : it.second) {
+			if (!generator->skipTimeStep( date )) vecGenerators.push_back( generator );
+		}
+		const bool run_parallel = parallel && !data_qa_logs && nr_stations>1 && isThreadSafe(vecGenerators);
+
+		if (!run_parallel) {
+			for (size_t ii=0; ii<nr_stations; ii++) {
+				const std::vector<MeteoData>& vecStation = (dataset_idx[ii]!=IOUtils::npos)? fullDataset[ dataset_idx[ii] ] : no_data;
+				fillPoint(it.first, vecGenerators, vecIDs[ii], vecMeteo[ii], vecStation);
 			}
+			continue;
 		}
+
+		const int nr_points = static_cast<int>( nr_stations );
+		std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+		for (int ii=0; ii<nr_points; ii++) {
+			try {
+				const std::vector<MeteoData>& vecStation = (dataset_idx[ii]!=IOUtils::npos)? fullDataset[ dataset_idx[ii] ] : no_data;
+				fillPoint(it.first, vecGenerators, vecIDs[ii], vecMeteo[ii], vecStation);
+			} catch (...) { //exceptions can not cross the parallel region
+#pragma omp critical(datagenerator_error)
+				if (!error) error = std::current_exception();
+			}
+		}
+		if (error) std::rethrow_exception( error );
 	}
 }
 
@@ -147,48 +156,131 @@ void DataGenerator::fillMissing(METEO_SET& vecMeteo, const std::vector<METEO_SET
 void DataGenerator::fillMissing(std::vector<METEO_SET>& vecVecMeteo) const
 {
 	if (mapAlgorithms.empty()) return; //no generators defined by the end user
+	const ProfilerScope profile( "generators" );
+	const size_t nr_stations = vecVecMeteo.size();
+
+	//the station IDs are only resolved once
+	std::vector<std::string> vecIDs( nr_stations );
+	for (size_t ii=0; ii<nr_stations; ii++) {
+		if (!vecVecMeteo[ii].empty()) vecIDs[ii] = vecVecMeteo[ii].front().meta->getStationID();
+	}
 
 	for (auto const& it : mapAlgorithms) {
-		const std::vector<GeneratorAlgorithm*> vecGenerators( it.second );
+		const std::vector<GeneratorAlgorithm*>& vecGenerators( it.second );
+		const bool run_parallel = parallel && !data_qa_logs && nr_stations>1 && isThreadSafe(vecGenerators);
+
+		if (!run_parallel) { //process this parameter on all stations
+			for (size_t ii=0; ii<nr_stations; ii++)
+				fillSeries(it.first, vecGenerators, vecIDs[ii], vecVecMeteo[ii]);
+			continue;
+		}
+
+		const int nr_series = static_cast<int>( nr_stations );
+		std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+		for (int ii=0; ii<nr_series; ii++) {
+			try {
+				fillSeries(it.first, vecGenerators, vecIDs[ii], vecVecMeteo[ii]);
+			} catch (...) { //exceptions can not cross the parallel region
+#pragma omp critical(datagenerator_error)
+				if (!error) error = std::current_exception();
+			}
+		}
+		if (error) std::rethrow_exception( error );
+	}
+}
+
+//fill one parameter at one point in time for one station with the (already time filtered) stack of generators
+void DataGenerator::fillPoint(const std::string& parname, const std::vector<GeneratorAlgorithm*>& vecGenerators, const std::string& statID, MeteoData& station, const std::vector<MeteoData>& vecStation) const
+{
+	size_t param = station.getParameterIndex( parname );
+	if (param==IOUtils::npos) param = station.addParameter( parname );
+
+	const double old_val = station(param);
+	if (old_val!=IOUtils::nodata) return; //generate() only replaces nodata values
 
-		for (std::vector<MeteoData>& vecMeteo : vecVecMeteo) { //process this parameter on all stations
-			if (vecMeteo.empty()) continue; //the station does not have any data
+	bool status = false;
+	size_t jj=0;
+	while (jj<vecGenerators.size() && status != true) { //loop over the generators
+		if (!vecGenerators[jj]->skipStation( statID )) {
+			status = vecGenerators[jj]->generate(param, station, vecStation);
+
+			if (station(param) != old_val) {
+				station.setGenerated(param);
+				if (data_qa_logs) {
+					const std::string stat = (!statID.empty())? statID : station.meta->getStationName();
+					const std::string algo_name( vecGenerators[jj]->getAlgo() );
+					const Date date( station.date );
+					cout << "[DATA_QA] Generating " << stat << "::" << parname << "::" << algo_name << " " << date.toString(Date::ISO_TZ) << " [" << date.toString(Date::ISO_WEEK) << "]\n";
+				}
+			} //endif new=old
+		}
+		jj++;
+	}
+}
+
+//fill one parameter over the whole time series of one station with the stack of generators
+void DataGenerator::fillSeries(const std::string& parname, const std::vector<GeneratorAlgorithm*>& vecGenerators, const std::string& statID, METEO_SET& vecMeteo) const
+{
+	if (vecMeteo.empty()) return; //the station does not have any data
+	const size_t nr_pts = vecMeteo.size();
+
+	size_t param = vecMeteo.front().getParameterIndex( parname );
+	if (param==IOUtils::npos) {
+		param = vecMeteo.front().addParameter( parname );
+		for (size_t kk=1; kk<nr_pts; kk++) vecMeteo[kk].addParameter( parname );
+	}
+
+	//keep a copy of this parameter only, in order to detect the generated points
+	std::vector<double> old_val( nr_pts );
+	bool has_missing = false;
+	for (size_t kk=0; kk<nr_pts; kk++) {
+		old_val[kk] = vecMeteo[kk](param);
+		if (old_val[kk]==IOUtils::nodata) has_missing = true;
+	}
+	if (!has_missing && onlyFillsMissing(vecGenerators)) return; //nothing to do
+
+	bool status = false;
+	size_t jj=0;
+	while (jj<vecGenerators.size() && status != true) { //loop over the generators
+		if (!vecGenerators[jj]->skipStation( statID )) {
+			
+			//loop over time restrictions periods
+			status = true; //so if any time restriction period returns false, status will be set to false
+			for (RestrictionsIdx editPeriod(vecMeteo, vecGenerators[jj]->getTimeRestrictions()); editPeriod.isValid(); ++editPeriod) 
+				status &= vecGenerators[jj]->create(param, editPeriod.getStart(), editPeriod.getEnd(), vecMeteo);
 			
-			size_t param = vecMeteo[0].getParameterIndex( it.first );
-			if (param==IOUtils::npos) param = vecMeteo[0].addParameter( it.first );
-
-			const std::string statID( vecMeteo[0].meta.getStationID() );
-			//these are only required by data_qa_logs
-			const METEO_SET old_val( vecMeteo );
-			const std::string statName( old_val[0].meta.getStationName() );
-			const std::string stat = (!statID.empty())? statID : statName;
-
-			bool status = false;
-			size_t jj=0;
-			while (jj<vecGenerators.size() && status != true) { //loop over the generators
-				if (!vecGenerators[jj]->skipStation( statID )) {
-					
-					//loop over time restrictions periods
-					status = true; //so if any time restriction period returns false, status will be set to false
-					for (RestrictionsIdx editPeriod(vecMeteo, vecGenerators[jj]->getTimeRestrictions()); editPeriod.isValid(); ++editPeriod) 
-						status &= vecGenerators[jj]->create(param, editPeriod.getStart(), editPeriod.getEnd(), vecMeteo);
-					
-					//compare the resulting data with the original copy to see if there are some changes for DATA_QA
-					for (size_t kk=0; kk<old_val.size(); kk++) {
-						if (old_val[kk](param) != vecMeteo[kk](param)) {
-							vecMeteo[kk].setGenerated(param);
-							if (data_qa_logs) {
-								const std::string parname( it.first );
-								const std::string algo_name( vecGenerators[jj]->getAlgo() );
-								cout << "[DATA_QA] Generating " << stat << "::" << parname << "::" << algo_name << " " << old_val[kk].date.toString(Date::ISO_TZ) << "\n";
-							}
-						}
+			//compare the resulting data with the original copy to see if there are some changes for DATA_QA
+			for (size_t kk=0; kk<nr_pts; kk++) {
+				const double new_val = vecMeteo[kk](param);
+				if (old_val[kk] != new_val) {
+					vecMeteo[kk].setGenerated(param);
+					if (data_qa_logs) {
+						const std::string stat = (!statID.empty())? statID : vecMeteo[kk].meta->getStationName();
+						const std::string algo_name( vecGenerators[jj]->getAlgo() );
+						cout << "[DATA_QA] Generating " << stat << "::" << parname << "::" << algo_name << " " << vecMeteo[kk].date.toString(Date::ISO_TZ) << "\n";
 					}
 				}
-				jj++;
 			}
 		}
+		jj++;
+	}
+}
+
+bool DataGenerator::isThreadSafe(const std::vector<GeneratorAlgorithm*>& vecGenerators)
+{
+	for (const GeneratorAlgorithm* generator : vecGenerators) {
+		if (!generator->isThreadSafe()) return false;
+	}
+	return true;
+}
+
+bool DataGenerator::onlyFillsMissing(const std::vector<GeneratorAlgorithm*>& vecGenerators)
+{
+	for (const GeneratorAlgorithm* generator : vecGenerators) {
+		if (!generator->onlyFillsMissing()) return false;
 	}
+	return true;
 }
 
 /**
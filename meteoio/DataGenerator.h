@@ -36,6 +36,8 @@ namespace mio {
  * This class sits in between the actual implementation of the various methods and the IOManager in
  * order to offer some high level interface. It basically reads the arguments and creates the objects for
  * the various data generators in its constructor and loop through the parameters and stations when called to fill the data.
+ * The parameter indices and station restrictions are resolved once per station and the points or time series that have
+ * nothing missing are not given to the generators at all.
  *
  * @ingroup meteoLaws
  * @author Mathias Bavay
@@ -43,7 +45,7 @@ namespace mio {
 class DataGenerator {
 	public:
 		DataGenerator(const Config& cfg, const std::set<std::string>& params_to_generate = std::set<std::string>());
-		DataGenerator(const DataGenerator& c) : mapAlgorithms(c.mapAlgorithms), data_qa_logs(c.data_qa_logs)  {}
+		DataGenerator(const DataGenerator& c) : mapAlgorithms(c.mapAlgorithms), data_qa_logs(c.data_qa_logs), parallel(c.parallel)  {}
 		virtual ~DataGenerator();
 
 		void fillMissing(METEO_SET& vecMeteo, const std::vector<METEO_SET>& fullDataset, const std::vector<size_t>& stations_idx) const;
@@ -56,10 +58,15 @@ class DataGenerator {
 	private:
 		static std::set<std::string> getParameters(const Config& cfg);
 		static std::vector< GeneratorAlgorithm* > buildStack(const Config& cfg, const std::string& parname);
+		static bool isThreadSafe(const std::vector<GeneratorAlgorithm*>& vecGenerators);
+		static bool onlyFillsMissing(const std::vector<GeneratorAlgorithm*>& vecGenerators);
+		void fillPoint(const std::string& parname, const std::vector<GeneratorAlgorithm*>& vecGenerators, const std::string& statID, MeteoData& station, const std::vector<MeteoData>& vecStation) const;
+		void fillSeries(const std::string& parname, const std::vector<GeneratorAlgorithm*>& vecGenerators, const std::string& statID, METEO_SET& vecMeteo) const;
 		
 		std::map< std::string, std::vector<GeneratorAlgorithm*> > mapAlgorithms; //per parameter data creators algorithms
 		static const std::string cmd_section, cmd_pattern, arg_pattern;
 		bool data_qa_logs;
+		bool parallel; ///< process the stations in parallel (if MeteoIO has been compiled with OpenMP)
 };
 
 } //end namespace
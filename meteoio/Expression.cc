@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/Expression.h>
+#include <meteoio/IOUtils.h>
+#include <meteoio/IOExceptions.h>
+#include <meteoio/thirdParty/tinyexpr.h>
+
+#include <algorithm>
+
+namespace mio {
+
+Expression::Expression()
+           : expression_str(), where_str(), names(), slots(), expr(nullptr)
+{}
+
+Expression::Expression(const std::string& expression, const std::vector<std::string>& variables, const std::string& where)
+           : expression_str(), where_str(), names(), slots(), expr(nullptr)
+{
+	compile(expression, variables, where);
+}
+
+Expression::Expression(const Expression& source)
+           : expression_str(), where_str(), names(), slots(), expr(nullptr)
+{
+	if (source.isCompiled()) {
+		compile(source.expression_str, source.names, source.where_str);
+		std::copy(source.slots.begin(), source.slots.end(), slots.begin()); //keep the memory the expression points to
+	}
+}
+
+Expression& Expression::operator=(const Expression& source)
+{
+	if (this != &source) {
+		cleanup();
+		if (source.isCompiled()) {
+			compile(source.expression_str, source.names, source.where_str);
+			std::copy(source.slots.begin(), source.slots.end(), slots.begin());
+		}
+	}
+	return *this;
+}
+
+Expression::~Expression()
+{
+	cleanup();
+}
+
+void Expression::cleanup() noexcept
+{
+	te_free(expr);
+	expr = nullptr;
+	expression_str.clear();
+	where_str.clear();
+	names.clear();
+	slots.clear();
+}
+
+void Expression::compile(const std::string& expression, const std::vector<std::string>& variables, const std::string& where)
+{
+	cleanup();
+	names = variables;
+	slots.assign(names.size(), IOUtils::nodata);
+
+	//the slots will never be resized, so their addresses can be bound once and for all
+	std::vector<te_variable> te_vars( names.size() );
+	for (size_t ii=0; ii<names.size(); ii++) {
+		te_vars[ii].name = names[ii].c_str();
+		te_vars[ii].address = &slots[ii];
+		te_vars[ii].type = 0;
+		te_vars[ii].context = nullptr;
+	}
+
+	int te_err;
+	expr = te_compile(expression.c_str(), (te_vars.empty())? nullptr : &te_vars[0], static_cast<int>(te_vars.size()), &te_err);
+	if (!expr) {
+		const std::string msg( "Arithmetic expression \"" + expression + "\" could not be evaluated" + ((where.empty())? "" : " for "+where) + "; parse error at " + IOUtils::toString(te_err) );
+		names.clear();
+		slots.clear();
+		throw InvalidFormatException(msg, AT);
+	}
+	expression_str = expression;
+	where_str = where;
+}
+
+size_t Expression::getVariableIndex(const std::string& name) const
+{
+	for (size_t ii=0; ii<names.size(); ii++) {
+		if (names[ii]==name) return ii;
+	}
+	return IOUtils::npos;
+}
+
+double Expression::evaluate() const
+{
+	return te_eval(expr);
+}
+
+double Expression::evaluate(const double* values)
+{
+	for (size_t ii=0; ii<slots.size(); ii++) slots[ii] = values[ii];
+	return te_eval(expr);
+}
+
+void Expression::evaluate(const std::vector<const double*>& columns, const size_t& nr_values, double* results)
+{
+	if (columns.size() != slots.size())
+		throw InvalidArgumentException("Wrong number of data columns provided for evaluating expression \"" + expression_str + "\"", AT);
+
+	//only keep the columns that change between evaluations
+	std::vector<size_t> active;
+	for (size_t jj=0; jj<columns.size(); jj++) {
+		if (columns[jj]!=nullptr) active.push_back( jj );
+	}
+
+	const size_t nr_active = active.size();
+	for (size_t ii=0; ii<nr_values; ii++) {
+		for (size_t jj=0; jj<nr_active; jj++) {
+			const size_t col = active[jj];
+			slots[col] = columns[col][ii];
+		}
+		results[ii] = te_eval(expr);
+	}
+}
+
+double Expression::evaluate(const std::string& expression, const std::string& where)
+{
+	const Expression tmp(expression, std::vector<std::string>(), where);
+	return tmp.evaluate();
+}
+
+} //namespace
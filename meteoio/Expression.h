@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <string>
+#include <vector>
+
+struct te_expr; //forward declaration, so tinyexpr does not leak into the public headers
+
+namespace mio {
+
+/**
+ * @class Expression
+ * @brief A compiled arithmetic expression.
+ * @details The expression is parsed and compiled (with the <A HREF="https://codeplea.com/tinyexpr">tinyexpr</A> math library)
+ * only once, when the object is built. Its variables are bound to internal slots that are then filled either one by one
+ * or from contiguous columns of values, so a whole time series or a whole grid can be evaluated in a tight loop
+ * without any lookup or memory allocation.
+ *
+ * Since the variables values are stored within the object, a given Expression object must not be evaluated
+ * concurrently by several threads (but it can be copied, each copy being independent).
+ * @code
+ * const std::vector<std::string> vars = {"altitude", "snowline"};
+ * Expression expr("(altitude - snowline) / 100", vars);
+ * expr.setVariable(1, 1500.); //the snowline is the same for all points
+ * std::vector<const double*> columns = {&altitudes[0], nullptr}; //a nullptr keeps the current value of the variable
+ * expr.evaluate(columns, altitudes.size(), &results[0]);
+ * @endcode
+ *
+ * @date   2026-10-18
+ */
+class Expression {
+	public:
+		Expression();
+
+		/**
+		 * @brief Compile an expression
+		 * @param[in] expression arithmetic expression to compile
+		 * @param[in] variables names of the variables that can be used in the expression (the order matters since they
+		 * will then be referred to by their index)
+		 * @param[in] where string describing where the expression comes from (for the error messages)
+		 */
+		Expression(const std::string& expression, const std::vector<std::string>& variables, const std::string& where="");
+		Expression(const Expression& source);
+		Expression& operator=(const Expression& source);
+		~Expression();
+
+		void compile(const std::string& expression, const std::vector<std::string>& variables, const std::string& where="");
+		bool isCompiled() const {return (expr!=nullptr);}
+		const std::string& getExpression() const {return expression_str;}
+		size_t getNrOfVariables() const {return names.size();}
+
+		/**
+		 * @brief Get the index of a variable
+		 * @param[in] name variable name
+		 * @return index of the variable or IOUtils::npos if this variable is not declared
+		 */
+		size_t getVariableIndex(const std::string& name) const;
+		void setVariable(const size_t& idx, const double& value) {slots[idx] = value;}
+
+		/**
+		 * @brief Evaluate the expression with the current values of the variables
+		 * @return result of the expression (NaN if the result is undefined)
+		 */
+		double evaluate() const;
+
+		/**
+		 * @brief Evaluate the expression for the given values
+		 * @param[in] values values of all the variables, in the same order as they have been declared
+		 * @return result of the expression (NaN if the result is undefined)
+		 */
+		double evaluate(const double* values);
+
+		/**
+		 * @brief Evaluate the expression over columns of data
+		 * @param[in] columns one pointer per variable, in the same order as they have been declared, to contiguous arrays
+		 * of at least nr_values elements. A nullptr keeps the current value of the variable for all evaluations.
+		 * @param[in] nr_values number of values to compute
+		 * @param[out] results pre-allocated array of at least nr_values elements
+		 */
+		void evaluate(const std::vector<const double*>& columns, const size_t& nr_values, double* results);
+
+		/**
+		 * @brief Compile and evaluate an expression that does not contain any variable
+		 * @param[in] expression arithmetic expression to evaluate
+		 * @param[in] where string describing where the expression comes from (for the error messages)
+		 * @return result of the expression
+		 */
+		static double evaluate(const std::string& expression, const std::string& where="");
+
+	private:
+		void cleanup() noexcept;
+
+		std::string expression_str;
+		std::string where_str;
+		std::vector<std::string> names;
+		std::vector<double> slots; //fixed memory the compiled expression points to, never resized after compilation
+		te_expr *expr;
+};
+
+} //end namespace
+
+#endif
@@ -21,20 +21,31 @@
 #include <meteoio/dataClasses/Coords.h>
 #include <meteoio/meteoLaws/Atmosphere.h>
 #include <meteoio/MathOptim.h>
+#include <meteoio/Timer.h>
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
 namespace mio {
 
 GridsManager::GridsManager(IOHandler& in_iohandler, const Config& in_cfg)
-             : iohandler(in_iohandler), cfg(in_cfg), buffer(0), gridprocessor(cfg), grids2d_list(), grids2d_start(), grids2d_end(),
-               grid2d_list_buffer_size(370.), processing_level(IOUtils::filtered | IOUtils::resampled | IOUtils::generated), dem_altimeter(false)
+             : iohandler(in_iohandler), cfg(in_cfg), buffer(0), gridprocessor(cfg), grids2d_list(), grids2d_start(), grids2d_end(), resampling_grids(),
+               reprojection_maps(), reprojection_method(Grid2DObject::BILINEAR), grid2d_list_buffer_size(370.), processing_level(IOUtils::filtered | IOUtils::resampled | IOUtils::generated), dem_altimeter(false)
 {
 	size_t max_grids = 10;
 	cfg.getValue("BUFF_GRIDS", "General", max_grids, IOUtils::nothrow);  //HACK document it!
 	buffer.setMaxGrids(max_grids);
 	cfg.getValue("BUFFER_SIZE", "General", grid2d_list_buffer_size, IOUtils::nothrow);
 	cfg.getValue("DEM_FROM_PRESSURE", "Input", dem_altimeter, IOUtils::nothrow); //HACK document it! if no dem is found but local and sea level pressure grids are found, use them to rebuild a DEM; [Input] section
+
+	const std::string reprojection( IOUtils::strToUpper(cfg.get("GRID2D_REPROJECTION", "Input", "BILINEAR")) ); //how to reproject lat/lon grids onto cartesian grids
+	if (reprojection=="NEAREST") reprojection_method = Grid2DObject::NEAREST;
+	else if (reprojection=="BILINEAR") reprojection_method = Grid2DObject::BILINEAR;
+	else if (reprojection=="CONSERVATIVE") reprojection_method = Grid2DObject::CONSERVATIVE;
+	else throw InvalidArgumentException("Unknown GRID2D_REPROJECTION '"+reprojection+"', please use either NEAREST, BILINEAR or CONSERVATIVE", AT);
 }
 
 /**
@@ -106,8 +117,10 @@ void GridsManager::readDEM(DEMObject& grid2D)
 	}
 
 	//reproject grid if it is lat/lon
-	if (grid2D.isLatlon())
-		grid2D.reproject(); //this is currently very, very primitive
+	if (grid2D.isLatlon()) {
+		reprojectGrid(grid2D);
+		grid2D.update(); //the slopes, curvatures, etc must be recomputed on the new grid
+	}
 }
 
 void GridsManager::readLanduse(Grid2DObject& grid2D)
@@ -386,6 +399,13 @@ bool GridsManager::isAvailable(const std::set<size_t>& available_params, const M
 	return in_raw;
 }
 
+void GridsManager::clear_cache()
+{
+	buffer.clear();
+	grids2d_list.clear(); //so the available grids will be listed again
+	resampling_grids.clear();
+}
+
 /**
 * @brief Check if the grids2d_list "buffer" covers the proper range and rebuffer if not.
 * @details This does not mean that the requested date is in the buffer, but that the range covered by the buffer contains this date.
@@ -398,6 +418,7 @@ bool GridsManager::setGrids2d_list(const Date& date)
 		grids2d_start = date - 1.;
 		grids2d_end = date + grid2d_list_buffer_size;
 
+		resampling_grids.clear(); //these grids have been chosen from the previous list
 		const bool status = iohandler.list2DGrids(grids2d_start, grids2d_end, grids2d_list);
 		if (status) {
 			//the plugin might have returned a range larger than requested, so adjust the min/max dates if necessary
@@ -417,6 +438,7 @@ bool GridsManager::setGrids2d_list(const Date& dateStart, const Date& dateEnd)
 	if (grids2d_list.empty() || dateStart<grids2d_start || dateEnd>grids2d_end) {
 		grids2d_start = dateStart;
 		grids2d_end = dateEnd;
+		resampling_grids.clear(); //these grids have been chosen from the previous list
 		const bool status = iohandler.list2DGrids(grids2d_start, grids2d_end, grids2d_list);
 		if (status) {
 			//the plugin might have returned a range larger than requested, so adjust the min/max dates if necessary
@@ -448,6 +470,28 @@ Grid2DObject GridsManager::getRawGrid(const MeteoGrids::Parameters& parameter, c
 	return grid2D;
 }
 
+/**
+* @brief Reproject a lat/lon grid onto a cartesian grid
+* @details The reprojection map (which source cells contribute to each target cell) only depends on the geometry
+* of the source grid, so it is computed once per geometry and reused for all the grids sharing it (the hits and misses
+* of this cache are reported by the Profiler).
+* @param grid2D grid to reproject
+*/
+void GridsManager::reprojectGrid(Grid2DObject& grid2D)
+{
+	std::string proj_type, proj_args;
+	grid2D.llcorner.getProj(proj_type, proj_args);
+	std::ostringstream key;
+	key << std::setprecision(12) << grid2D.getNx() << "x" << grid2D.getNy() << " " << grid2D.llcorner.getLat() << "," << grid2D.llcorner.getLon();
+	key << " " << grid2D.ur_lat << "," << grid2D.ur_lon << " " << proj_type << ":" << proj_args;
+
+	auto it = reprojection_maps.find( key.str() );
+	Profiler::addCacheAccess("cache::reprojection", it != reprojection_maps.end());
+	if (it == reprojection_maps.end())
+		it = reprojection_maps.insert( std::make_pair(key.str(), Grid2DObject::computeReprojectionMap(grid2D, reprojection_method)) ).first;
+	grid2D.reproject( it->second );
+}
+
 /**
 * @brief Get the requested grid, according to the configured processing level
 * @details If the grid has been buffered, it will be returned from the buffer. If it is not available but can be generated, it will
@@ -486,7 +530,7 @@ Grid2DObject GridsManager::getGrid(const MeteoGrids::Parameters& parameter, cons
 						const bool status_all = setGrids2d_list(sdate, edate); //rebuffer the grid list if necessary
 						if (!status_all)
 							throw InvalidArgumentException("The data input plugin does not support the necessary call to query all available grids.", AT);
-						const std::map<Date, Grid2DObject> all_grids( getAllGridsForParameter(parameter) );
+						const std::map<Date, Grid2DObject>& all_grids = getAllGridsForParameter(parameter, sdate, edate);
 						gridprocessor.resample(date, parameter, all_grids, grid2D);
 						buffer.push(grid2D, parameter, date);
 					} else {
@@ -503,7 +547,7 @@ Grid2DObject GridsManager::getGrid(const MeteoGrids::Parameters& parameter, cons
 
 	 //reproject grid if it is lat/lon
 	if (enforce_cartesian && grid2D.isLatlon())
-		grid2D.reproject(); //HACK this is currently very, very primitive
+		reprojectGrid(grid2D);
 
 	return grid2D;
 }
@@ -513,33 +557,187 @@ Grid2DObject GridsManager::getGrid(const MeteoGrids::Parameters& parameter, cons
  * @details This function queries the input plugin for grids that are available for a specific
  * parameter. If gridded data is available from which the parameter can losslessly be generated
  * this is treated as equal and also returned.
+ *
+ * Only the grids within the resampling window are returned, as well as the closest grid on each side of
+ * the window (so the grids bracketing the requested date are always available). The grids are kept between
+ * calls and only the grids that were not already loaded for a previous request are read (or generated).
  * @param[in] parameter The meteo parameter to go look for.
- * @return A list of available grids and their dates.
+ * @param[in] dateStart Start of the resampling window.
+ * @param[in] dateEnd End of the resampling window.
+ * @return A list of available grids and their dates (valid until the next call for the same parameter).
  */
-std::map<Date, Grid2DObject> GridsManager::getAllGridsForParameter(const MeteoGrids::Parameters& parameter)
+const std::map<Date, Grid2DObject>& GridsManager::getAllGridsForParameter(const MeteoGrids::Parameters& parameter, const Date& dateStart, const Date& dateEnd)
 {
-	std::map<Date, Grid2DObject> all_grids;
-	for (auto it = grids2d_list.begin(); it != grids2d_list.end(); ++it) {
+	std::map<Date, Grid2DObject>& all_grids = resampling_grids[parameter];
+	if (grids2d_list.empty()) {
+		all_grids.clear();
+		return all_grids;
+	}
+
+	auto it_start = grids2d_list.lower_bound(dateStart);
+	if (it_start != grids2d_list.begin()) --it_start;
+	auto it_end = grids2d_list.upper_bound(dateEnd);
+	if (it_end != grids2d_list.end()) ++it_end;
+
+	//forget the grids that are now out of the window
+	for (auto it = all_grids.begin(); it != all_grids.end(); ) {
+		const bool before = (it->first < it_start->first);
+		const bool after = (it_end != grids2d_list.end() && it->first >= it_end->first);
+		if (before || after)
+			it = all_grids.erase(it);
+		else
+			++it;
+	}
+
+	for (auto it = it_start; it != it_end; ++it) {
+		if (all_grids.find(it->first) != all_grids.end()) continue; //already loaded by a previous request
+
 		if (isAvailable(it->second, parameter, it->first)) {
-			const auto pair( std::make_pair(it->first, getRawGrid(parameter, it->first)) );
-			all_grids.insert(pair);
+			all_grids[ it->first ] = getRawGrid(parameter, it->first);
 		} else {
 			Grid2DObject generated;
-			if (generateGrid(generated, it->second, parameter, it->first)) {
-				const auto pair( std::make_pair(it->first, generated) );
-				all_grids.insert(pair);
-			}
+			if (generateGrid(generated, it->second, parameter, it->first))
+				all_grids[ it->first ] = generated;
 		}
 	} //endfor
 	return all_grids;
 }
 
+//the derived grids are computed by kernels that process a range of cells of the source grids at once, so that
+//several derived grids using the same sources can be generated in a single pass (see GridsManager::generateGrid())
+typedef void (*GridKernel)(const double* const* in, const size_t& n, double* out);
+
+static void demKernel(const double* const* in, const size_t& n, double* out) //P, TA, P_SEA
+{
+	static const double k = Cst::gravity / (Cst::mean_adiabatique_lapse_rate * Cst::gaz_constant_dry_air);
+	static const double k_inv = 1./k;
+	const double *p = in[0], *ta = in[1], *p_sea = in[2];
+	for (size_t ii=0; ii<n; ii++) {
+		if (p[ii]==IOUtils::nodata || ta[ii]==IOUtils::nodata || p_sea[ii]==IOUtils::nodata) {
+			out[ii] = IOUtils::nodata;
+			continue;
+		}
+		const double K = pow(p[ii]/p_sea[ii], k_inv);
+		out[ii] = ta[ii]*Cst::earth_R0*(1.-K) / (Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 - ta[ii]*(1.-K));
+	}
+}
+
+static void vwKernel(const double* const* in, const size_t& n, double* out) //U, V
+{
+	const double *U = in[0], *V = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (U[ii]!=IOUtils::nodata && V[ii]!=IOUtils::nodata)? sqrt( Optim::pow2(U[ii]) + Optim::pow2(V[ii]) ) : IOUtils::nodata;
+}
+
+static void dwKernel(const double* const* in, const size_t& n, double* out) //U, V
+{
+	const double *U = in[0], *V = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = IOUtils::UV_TO_DW(U[ii], V[ii]); // turn into degrees [0;360)
+}
+
+static void rhFromTdKernel(const double* const* in, const size_t& n, double* out) //TD, TA
+{
+	Atmosphere::DewPointtoRh(in[0], in[1], n, false, out);
+}
+
+static void rhFromQiKernel(const double* const* in, const size_t& n, double* out) //QI, TA, DEM
+{
+	Atmosphere::specToRelHumidity(in[2], in[1], in[0], n, out);
+}
+
+static void sumKernel(const double* const* in, const size_t& n, double* out)
+{
+	const double *a = in[0], *b = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (a[ii]!=IOUtils::nodata && b[ii]!=IOUtils::nodata)? a[ii] + b[ii] : IOUtils::nodata;
+}
+
+static void productKernel(const double* const* in, const size_t& n, double* out)
+{
+	const double *a = in[0], *b = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (a[ii]!=IOUtils::nodata && b[ii]!=IOUtils::nodata)? a[ii] * b[ii] : IOUtils::nodata;
+}
+
+static void ratioKernel(const double* const* in, const size_t& n, double* out)
+{
+	const double *a = in[0], *b = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (a[ii]!=IOUtils::nodata && b[ii]!=IOUtils::nodata)? a[ii] / b[ii] : IOUtils::nodata;
+}
+
+static void rswrKernel(const double* const* in, const size_t& n, double* out) //ISWR_DIR, ISWR_DIFF, ALB
+{
+	const double *dir = in[0], *diff = in[1], *alb = in[2];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (dir[ii]!=IOUtils::nodata && diff[ii]!=IOUtils::nodata && alb[ii]!=IOUtils::nodata)? (dir[ii] + diff[ii]) * alb[ii] : IOUtils::nodata;
+}
+
+static void hsKernel(const double* const* in, const size_t& n, double* out) //SWE, RSNO
+{
+	const double *swe = in[0], *rsno = in[1];
+	for (size_t ii=0; ii<n; ii++)
+		out[ii] = (swe[ii]!=IOUtils::nodata && rsno[ii]!=IOUtils::nodata)? (swe[ii] * 1000.) / rsno[ii] : IOUtils::nodata; //convert mm=kg/m^3 into kg
+}
+
+static void psumPhKernel(const double* const* in, const size_t& n, double* out) //PSUM_S, PSUM_L
+{
+	const double *psum_s = in[0], *psum_l = in[1];
+	for (size_t ii=0; ii<n; ii++) {
+		const double psum = (psum_s[ii]!=IOUtils::nodata && psum_l[ii]!=IOUtils::nodata)? psum_s[ii] + psum_l[ii] : IOUtils::nodata;
+		out[ii] = (psum!=IOUtils::nodata && psum>0)? psum_l[ii] / psum : psum;
+	}
+}
+
+struct DerivedGridRecipe {
+	MeteoGrids::Parameters parameter; ///< the generated parameter
+	std::vector<MeteoGrids::Parameters> sources; ///< the (at most three) parameters it is computed from, the first one provides the geolocalization
+	GridKernel kernel;
+};
+
+//for each parameter, the recipes are listed by order of preference
+static const std::vector<DerivedGridRecipe> derived_grids = {
+	{MeteoGrids::DEM, {MeteoGrids::P, MeteoGrids::TA, MeteoGrids::P_SEA}, &demKernel},
+	{MeteoGrids::VW, {MeteoGrids::U, MeteoGrids::V}, &vwKernel},
+	{MeteoGrids::DW, {MeteoGrids::U, MeteoGrids::V}, &dwKernel},
+	{MeteoGrids::RH, {MeteoGrids::TD, MeteoGrids::TA}, &rhFromTdKernel},
+	{MeteoGrids::RH, {MeteoGrids::QI, MeteoGrids::TA, MeteoGrids::DEM}, &rhFromQiKernel},
+	{MeteoGrids::ISWR, {MeteoGrids::ISWR_DIR, MeteoGrids::ISWR_DIFF}, &sumKernel},
+	{MeteoGrids::ISWR, {MeteoGrids::RSWR, MeteoGrids::ALB}, &ratioKernel},
+	{MeteoGrids::RSWR, {MeteoGrids::ISWR, MeteoGrids::ALB}, &productKernel},
+	{MeteoGrids::RSWR, {MeteoGrids::ISWR_DIR, MeteoGrids::ISWR_DIFF, MeteoGrids::ALB}, &rswrKernel},
+	{MeteoGrids::HS, {MeteoGrids::SWE, MeteoGrids::RSNO}, &hsKernel},
+	{MeteoGrids::PSUM, {MeteoGrids::PSUM_S, MeteoGrids::PSUM_L}, &sumKernel},
+	{MeteoGrids::PSUM_PH, {MeteoGrids::PSUM_S, MeteoGrids::PSUM_L}, &psumPhKernel}
+};
+
+/**
+* @brief Find the preferred recipe to generate a given parameter
+* @param parameter the parameter to generate
+* @param is_available predicate telling if a given source parameter is available
+* @return the recipe to use or nullptr if the parameter can not be generated
+*/
+template <class AvailabilityPredicate>
+static const DerivedGridRecipe* findRecipe(const MeteoGrids::Parameters& parameter, const AvailabilityPredicate& is_available)
+{
+	for (const DerivedGridRecipe& recipe : derived_grids) {
+		if (recipe.parameter!=parameter) continue;
+		if (std::all_of(recipe.sources.begin(), recipe.sources.end(), is_available)) return &recipe;
+	}
+	return nullptr;
+}
+
 /**
 * @brief Generate a grid for a given parameter, based on the available parameters
 * @details Even if a given parameter is not available, it might be possible to generate it
 * on the fly based on the available data (for example, U and V wind components can be used to generate
 * the VW and DW vector wind components).
 *
+* The other parameters that can be generated from the same source grids (and are not available otherwise) are
+* generated in the same pass over the source grids, so for example requesting VW also generates DW. The source grids
+* are used directly from the buffer and all the generated grids are pushed into the buffer.
+*
 * It is assumed that the meteo parameters are coming out of models, so the available_params are
 * all available at all the timesteps, so we don't need to search a combination of parameters and timesteps
 *
@@ -553,176 +751,71 @@ std::map<Date, Grid2DObject> GridsManager::getAllGridsForParameter(const MeteoGr
 */
 bool GridsManager::generateGrid(Grid2DObject& grid2D, const std::set<size_t>& available_params, const MeteoGrids::Parameters& parameter, const Date& date)
 {
-	if (parameter==MeteoGrids::DEM) {
-		if (!dem_altimeter) return false;
-		const bool hasTA = isAvailable(available_params, MeteoGrids::TA, date);
-		const bool hasP = isAvailable(available_params, MeteoGrids::P, date);
-		const bool hasP_sea = isAvailable(available_params, MeteoGrids::P_SEA, date);
-		if (!hasTA || !hasP || !hasP_sea) return false;
-
-		const Grid2DObject ta( getRawGrid(MeteoGrids::TA, date) );
-		const Grid2DObject p( getRawGrid(MeteoGrids::P, date) );
-		const Grid2DObject p_sea( getRawGrid(MeteoGrids::P_SEA, date) );
-
-		static const double k = Cst::gravity / (Cst::mean_adiabatique_lapse_rate * Cst::gaz_constant_dry_air);
-		static const double k_inv = 1./k;
-		grid2D.set(p, IOUtils::nodata);
-		for (size_t ii=0; ii<grid2D.size(); ii++) {
-			if (grid2D(ii)==IOUtils::nodata || ta(ii)==IOUtils::nodata || p_sea(ii)==IOUtils::nodata) continue;
-			const double K = pow(grid2D(ii)/p_sea(ii), k_inv); //because grid2D has been initialized with P
-			grid2D(ii) = ta(ii)*Cst::earth_R0*(1.-K) / (Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 - ta(ii)*(1.-K));
-		}
-		buffer.push(grid2D, parameter, date);
-		return true;
-	}
-
-	if (parameter==MeteoGrids::VW || parameter==MeteoGrids::DW) {
-		const bool hasU = isAvailable(available_params, MeteoGrids::U, date);
-		const bool hasV = isAvailable(available_params, MeteoGrids::V, date);
-		if (!hasU || !hasV) return false;
-
-		const Grid2DObject V( getRawGrid(MeteoGrids::V, date) );
-		Grid2DObject U( getRawGrid(MeteoGrids::U, date) );
-
-		grid2D.set(U, IOUtils::nodata);
-		if (parameter==MeteoGrids::VW) {
-			for (size_t ii=0; ii<grid2D.size(); ii++)
-				grid2D(ii) = sqrt( Optim::pow2(U(ii)) + Optim::pow2(V(ii)) );
-		} else {
-			for (size_t ii=0; ii<grid2D.size(); ii++)
-				grid2D(ii) = IOUtils::UV_TO_DW(U(ii), V(ii)); // turn into degrees [0;360)
-		}
-
-		buffer.push(grid2D, parameter, date);
-		return true;
+	if (parameter==MeteoGrids::DEM && !dem_altimeter) return false;
+	const auto is_available = [&](const MeteoGrids::Parameters& param) { return isAvailable(available_params, param, date); };
+	const DerivedGridRecipe* recipe = findRecipe(parameter, is_available);
+	if (recipe==nullptr) return false;
+	const std::vector<MeteoGrids::Parameters>& sources( recipe->sources );
+
+	//other parameters that can be generated from (some of) the same sources
+	std::vector<const DerivedGridRecipe*> recipes( 1, recipe );
+	for (const DerivedGridRecipe& candidate : derived_grids) {
+		if (candidate.parameter==parameter || candidate.parameter==MeteoGrids::DEM || is_available(candidate.parameter)) continue;
+		const DerivedGridRecipe* sibling = findRecipe(candidate.parameter, is_available);
+		if (sibling!=&candidate) continue;
+		bool shared_sources = true;
+		for (const MeteoGrids::Parameters& source : sibling->sources)
+			if (std::find(sources.begin(), sources.end(), source)==sources.end()) shared_sources = false;
+		if (shared_sources) recipes.push_back( sibling );
 	}
 
-	if (parameter==MeteoGrids::RH) {
-		const bool hasTA = isAvailable(available_params, MeteoGrids::TA, date);
-		if (!hasTA) return false;
-		const Grid2DObject TA( getRawGrid(MeteoGrids::TA, date) );
-
-		const bool hasDEM = isAvailable(available_params, MeteoGrids::DEM, date);
-		const bool hasQI = isAvailable(available_params, MeteoGrids::QI, date);
-		const bool hasTD = isAvailable(available_params, MeteoGrids::TD, date);
-
-		if (hasTD) {
-			grid2D = getRawGrid(MeteoGrids::TD, date);
-
-			for (size_t ii=0; ii<grid2D.size(); ii++)
-				grid2D(ii) = Atmosphere::DewPointtoRh(grid2D(ii), TA(ii), false);
-			return true;
-		} else if (hasQI && hasDEM) {
-			const Grid2DObject dem( getRawGrid(MeteoGrids::DEM, date) ); //HACK use readDEM instead?
-			grid2D = getRawGrid(MeteoGrids::QI, date);
-			for (size_t ii=0; ii<grid2D.size(); ii++)
-				grid2D(ii) = Atmosphere::specToRelHumidity(dem(ii), TA(ii), grid2D(ii));
-			return true;
+	//the source grids are used from the buffer when possible, the others are read (and buffered at the end)
+	std::map<MeteoGrids::Parameters, Grid2DObject> read_grids;
+	std::map<MeteoGrids::Parameters, const Grid2DObject*> source_grids;
+	for (const MeteoGrids::Parameters& source : sources) {
+		const Grid2DObject* buffered = buffer.find(source, date);
+		if (buffered==nullptr) {
+			iohandler.read2DGrid(read_grids[source], source, date);
+			buffered = &read_grids[source];
 		}
-
-		return false;
+		source_grids[source] = buffered;
 	}
 
-	if (parameter==MeteoGrids::ISWR) {
-		const bool hasISWR_DIFF = isAvailable(available_params, MeteoGrids::ISWR_DIFF, date);
-		const bool hasISWR_DIR = isAvailable(available_params, MeteoGrids::ISWR_DIR, date);
-
-		if (hasISWR_DIFF && hasISWR_DIR) {
-			const Grid2DObject iswr_diff( getRawGrid(MeteoGrids::ISWR_DIFF, date) );
-			grid2D = getRawGrid(MeteoGrids::ISWR_DIR, date);
-			grid2D += iswr_diff;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
-			return true;
-		}
-
-		const bool hasALB = isAvailable(available_params, MeteoGrids::ALB, date);
-		const bool hasRSWR = isAvailable(available_params, MeteoGrids::ISWR, date);
-		if (hasRSWR && hasALB) {
-			const Grid2DObject alb( getRawGrid(MeteoGrids::ALB, date) );
-			grid2D = getRawGrid(MeteoGrids::RSWR, date);
-			grid2D /= alb;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
-			return true;
-		}
-
-		return false;
+	const Grid2DObject& reference( *source_grids[ sources.front() ] );
+	for (const auto& source : source_grids) {
+		if (source.second->getNx()!=reference.getNx() || source.second->getNy()!=reference.getNy())
+			throw InvalidArgumentException("Can not generate "+MeteoGrids::getParameterName(parameter)+" from grids of different sizes", AT);
 	}
 
-	if (parameter==MeteoGrids::RSWR) {
-		const bool hasALB = isAvailable(available_params, MeteoGrids::ALB, date);
-		if (!hasALB) return false;
-		const bool hasISWR = isAvailable(available_params, MeteoGrids::ISWR, date);
-
-		if (!hasISWR) {
-			const bool hasISWR_DIFF = isAvailable(available_params, MeteoGrids::ISWR_DIFF, date);
-			const bool hasISWR_DIR = isAvailable(available_params, MeteoGrids::ISWR_DIR, date);
-			if (!hasISWR_DIFF || !hasISWR_DIR) return false;
-
-			const Grid2DObject iswr_diff( getRawGrid(MeteoGrids::ISWR_DIFF, date) );
-			grid2D = getRawGrid(MeteoGrids::ISWR_DIR, date);
-			grid2D += iswr_diff;
-			buffer.push(grid2D, MeteoGrids::ISWR, date);
-		} else {
-			grid2D = getRawGrid(MeteoGrids::ISWR, date);
+	std::vector<Grid2DObject> generated( recipes.size() );
+	generated[0].set(reference, IOUtils::nodata);
+	for (size_t rr=1; rr<recipes.size(); rr++)
+		generated[rr].set(*source_grids[ recipes[rr]->sources.front() ], IOUtils::nodata);
+
+	//single pass over the source grids, by blocks of cells that remain in cache for all the kernels
+	static const size_t block_size = 4096;
+	const size_t nr_cells = reference.size();
+	const size_t nr_blocks = (nr_cells + block_size - 1) / block_size;
+	#pragma omp parallel for schedule(static)
+	for (size_t block=0; block<nr_blocks; block++) {
+		const size_t start = block * block_size;
+		const size_t n = std::min(block_size, nr_cells - start);
+		const double* in[3];
+		for (size_t rr=0; rr<recipes.size(); rr++) {
+			for (size_t ss=0; ss<recipes[rr]->sources.size(); ss++)
+				in[ss] = source_grids.at( recipes[rr]->sources[ss] )->grid2D.data() + start;
+			recipes[rr]->kernel(in, n, generated[rr].grid2D.data() + start);
 		}
-
-		const Grid2DObject alb( getRawGrid(MeteoGrids::ALB, date) );
-
-		grid2D *= alb;
-		buffer.push(grid2D, MeteoGrids::RSWR, date);
-		return true;
 	}
 
-	if (parameter==MeteoGrids::HS) {
-		const bool hasRSNO = isAvailable(available_params, MeteoGrids::RSNO, date);
-		const bool hasSWE = isAvailable(available_params, MeteoGrids::SWE, date);
-
-		if (hasRSNO && hasSWE) {
-			const Grid2DObject rsno( getRawGrid(MeteoGrids::RSNO, date) );
-			grid2D = getRawGrid(MeteoGrids::SWE, date);
-			grid2D *= 1000.0; //convert mm=kg/m^3 into kg
-			grid2D /= rsno;
-			buffer.push(grid2D, MeteoGrids::HS, date);
-			return true;
-		}
-		return false;
-	}
+	//nothing must be pushed into the buffer before the source grids are not needed anymore
+	for (const auto& read_grid : read_grids)
+		buffer.push(read_grid.second, read_grid.first, date);
+	for (size_t rr=0; rr<recipes.size(); rr++)
+		buffer.push(generated[rr], recipes[rr]->parameter, date);
 
-	if (parameter==MeteoGrids::PSUM) {
-		const bool hasPSUM_S = isAvailable(available_params, MeteoGrids::PSUM_S, date);
-		const bool hasPSUM_L = isAvailable(available_params, MeteoGrids::PSUM_L, date);
-
-		if (hasPSUM_S && hasPSUM_L) {
-			const Grid2DObject psum_l( getRawGrid(MeteoGrids::PSUM_L, date) );
-			grid2D = getRawGrid(MeteoGrids::PSUM_S, date);
-			grid2D += psum_l;
-			buffer.push(grid2D, MeteoGrids::PSUM, date);
-			return true;
-		}
-	}
-
-	if (parameter==MeteoGrids::PSUM_PH) {
-		const bool hasPSUM_S = isAvailable(available_params, MeteoGrids::PSUM_S, date);
-		const bool hasPSUM_L = isAvailable(available_params, MeteoGrids::PSUM_L, date);
-
-		if (hasPSUM_S && hasPSUM_L) {
-			const Grid2DObject psum_l( getRawGrid(MeteoGrids::PSUM_L, date) );
-			grid2D = getRawGrid(MeteoGrids::PSUM_S, date);
-			grid2D += psum_l;
-			buffer.push(grid2D, MeteoGrids::PSUM, date);
-
-			for (size_t ii=0; ii<grid2D.size(); ii++) {
-				const double psum = grid2D(ii);
-				if (psum!=IOUtils::nodata && psum>0)
-					grid2D(ii) = psum_l(ii) / psum;
-			}
-			return true;
-		}
-
-		return false;
-	}
-
-	return false;
+	grid2D = generated[0];
+	return true;
 }
 
 /**
@@ -54,7 +54,7 @@ class GridsManager {
 		//end legacy support
 
 		void setProcessingLevel(const unsigned int& i_level);
-		void clear_cache() {buffer.clear();}
+		void clear_cache();
 
 		/**
 		 * @brief Returns a copy of the internal Config object.
@@ -78,12 +78,13 @@ class GridsManager {
 		const std::string toString() const;
 
 	private:
+		void reprojectGrid(Grid2DObject& grid2D);
 		bool isAvailable(const std::set<size_t>& available_params, const MeteoGrids::Parameters& parameter, const Date& date) const;
 		bool setGrids2d_list(const Date& date);
 		bool setGrids2d_list(const Date& dateStart, const Date& dateEnd);
 		Grid2DObject getRawGrid(const MeteoGrids::Parameters& parameter, const Date& date);
 		Grid2DObject getGrid(const MeteoGrids::Parameters& parameter, const Date& date, const bool& enforce_cartesian=true, const bool& enable_grid_1dresampling=true);
-		std::map<Date, Grid2DObject> getAllGridsForParameter(const MeteoGrids::Parameters& parameter);
+		const std::map<Date, Grid2DObject>& getAllGridsForParameter(const MeteoGrids::Parameters& parameter, const Date& dateStart, const Date& dateEnd);
 		bool generateGrid(Grid2DObject& grid2D, const std::set<size_t>& available_params, const MeteoGrids::Parameters& parameter, const Date& date);
 		std::vector < double > getPtsfromGrid(const MeteoGrids::Parameters& parameter, const Date& date, const std::vector< std::pair<size_t, size_t> >& Pts);
 		bool getPtsfromgenerateGrid(std::vector<double>& Vec, const std::set<size_t>& available_params, const MeteoGrids::Parameters& parameter, const Date& date, const std::vector< std::pair<size_t, size_t> >& Pts);
@@ -94,6 +95,9 @@ class GridsManager {
 		GridProcessor gridprocessor;
 		std::map<Date, std::set<size_t> > grids2d_list; ///< list of available 2d grids
 		Date grids2d_start, grids2d_end; ///< validity range of the grids2d_list
+		std::map< MeteoGrids::Parameters, std::map<Date, Grid2DObject> > resampling_grids; ///< grids currently used for temporal resampling, per parameter
+		std::map<std::string, Grid2DObject::ReprojectionMap> reprojection_maps; ///< reprojection maps of the lat/lon grids, per geometry
+		Grid2DObject::ReprojectionMethod reprojection_method; ///< how to reproject lat/lon grids
 
 		double grid2d_list_buffer_size; ///< how many days to read the list of grids2d for?
 		unsigned int processing_level;
@@ -20,9 +20,11 @@
 #include <meteoio/IOExceptions.h>
 #include <meteoio/IOUtils.h>
 #include <meteoio/MathOptim.h>
+#include <meteoio/Timer.h>
 #include <meteoio/dataClasses/MeteoData.h> //needed for the merge strategies
 
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 
 //in alphabetical order
@@ -244,6 +246,22 @@ namespace mio {
  * the EditingAutoMerge feature to merge all streams belonging to a station into one single stream. In this case, the data coming from [Input]
  * has priority over the various [Input#] data sources.
  *
+ * @subsection Stations_shards Splitting the stations into shards
+ * In order to process a very large number of stations with several independent processes (or on several computers), it is possible to only
+ * keep the stations belonging to a given shard by setting the \em SHARD key in the [Input] section to "k/N" (shard k out of N shards,
+ * with 1 <= k <= N). Each station is deterministically attributed to a shard based on a hash of its station ID and name,
+ * so running all the shards from 1 to N processes each station exactly once. The stations of the other shards are removed after
+ * all the input data editing has been performed (so they are still available for merging, etc) but they are not available for
+ * any further processing (such as spatial interpolations). This is what meteoio_timeseries uses with its "--shard" option.
+ *
+ * @subsection Grids_reprojection Reprojection of lat/lon grids
+ * When a plugin delivers gridded data in lat/lon coordinates (and a cartesian grid is required, such as for DEMs or
+ * for spatial interpolations), the grid is reprojected onto a cartesian grid in the coordinate system of its lower left corner.
+ * The method can be chosen with the \em GRID2D_REPROJECTION key in the [Input] section: either NEAREST (nearest source cell),
+ * BILINEAR (bilinear interpolation of the four surrounding source cells, default) or CONSERVATIVE (average of the
+ * source cells covered by each target cell, weighted by their coverage). Which source cells contribute to each target cell
+ * is only computed once for each grid geometry, so reprojecting a series of grids sharing the same geometry remains cheap.
+ *
  */
 
 IOInterface* IOHandler::getPlugin(std::string plugin_name, const Config& i_cfg) const
@@ -374,12 +392,15 @@ IOInterface* IOHandler::getPlugin(const std::string& cfgkey, const std::string&
 
 //Copy constructor
 IOHandler::IOHandler(const IOHandler& aio)
-           : IOInterface(), cfg(aio.cfg), preProcessor(aio.cfg), mapPlugins(aio.mapPlugins)
+           : IOInterface(), cfg(aio.cfg), preProcessor(aio.cfg), mapPlugins(aio.mapPlugins), shard_idx(aio.shard_idx), nr_shards(aio.nr_shards)
 {}
 
 IOHandler::IOHandler(const Config& cfgreader)
-           : IOInterface(), cfg(cfgreader), preProcessor(cfgreader), mapPlugins()
-{}
+           : IOInterface(), cfg(cfgreader), preProcessor(cfgreader), mapPlugins(), shard_idx(0), nr_shards(1)
+{
+	const std::string shard_str( cfg.get("SHARD", "Input", "") );
+	if (!shard_str.empty()) parseShard(shard_str, shard_idx, nr_shards);
+}
 
 IOHandler::~IOHandler() noexcept
 {
@@ -394,6 +415,8 @@ IOHandler& IOHandler::operator=(const IOHandler& source) {
 	if (this != &source) {
 		preProcessor = source.preProcessor;
 		mapPlugins = source.mapPlugins;
+		shard_idx = source.shard_idx;
+		nr_shards = source.nr_shards;
 	}
 	return *this;
 }
@@ -413,6 +436,50 @@ std::vector<std::string> IOHandler::getListOfSources(const std::string& plugin_k
 	return results;
 }
 
+//name of the profiling stage for a given plugin, such as "io::INPUT::METEO::SMET"
+std::string IOHandler::getProfilingStage(const std::string& cfgkey, const std::string& cfgsection) const
+{
+	std::string plugin_name;
+	cfg.getValue(cfgkey, cfgsection, plugin_name);
+	return "io::" + cfgsection + "::" + cfgkey + "::" + plugin_name;
+}
+
+//in memory size of the data, as an estimate of the volume that has been read
+static size_t getDataSize(const std::vector<METEO_SET>& vecMeteo)
+{
+	size_t nr_values = 0;
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (vecMeteo[ii].empty()) continue;
+		nr_values += vecMeteo[ii].size() * vecMeteo[ii].front().getNrOfParameters();
+	}
+	return nr_values * sizeof(double);
+}
+
+void IOHandler::parseShard(const std::string& shard_str, size_t& o_shard_idx, size_t& o_nr_shards)
+{
+	const size_t pos = shard_str.find('/');
+	size_t shard_nr = 0, nr = 0;
+	if (pos==std::string::npos || pos==0 || pos+1==shard_str.size()
+	    || !IOUtils::convertString(shard_nr, shard_str.substr(0, pos)) || !IOUtils::convertString(nr, shard_str.substr(pos+1)))
+		throw InvalidFormatException("Could not parse shard '"+shard_str+"', it should be given as k/N", AT);
+	if (nr==0 || shard_nr==0 || shard_nr>nr)
+		throw InvalidArgumentException("Invalid shard '"+shard_str+"', it should be given as k/N with 1 <= k <= N", AT);
+
+	o_shard_idx = shard_nr - 1;
+	o_nr_shards = nr;
+}
+
+size_t IOHandler::getShard(const std::string& station_hash, const size_t& nr_shards)
+{
+	//FNV-1a, so the shards are the same on all platforms and compilers
+	uint64_t hash = 14695981039346656037ULL;
+	for (const char& c : station_hash) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ULL;
+	}
+	return static_cast<size_t>(hash % static_cast<uint64_t>(nr_shards));
+}
+
 bool IOHandler::list2DGrids(const Date& start, const Date& end, std::map<Date, std::set<size_t> > &list)
 {
 	IOInterface *plugin = getPlugin("GRID2D", "Input");
@@ -422,13 +489,19 @@ bool IOHandler::list2DGrids(const Date& start, const Date& end, std::map<Date, s
 void IOHandler::read2DGrid(Grid2DObject& grid_out, const std::string& i_filename)
 {
 	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("GRID2D", "Input") );
 	plugin->read2DGrid(grid_out, i_filename);
+	if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("GRID2D", "Input"), grid_out.size()*sizeof(double));
 }
 
 void IOHandler::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
 	IOInterface *plugin = getPlugin("GRID2D", "Input");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("GRID2D", "Input") );
 	plugin->read2DGrid(grid_out, parameter, date);
+	if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("GRID2D", "Input"), grid_out.size()*sizeof(double));
 }
 
 void IOHandler::readPointsIn2DGrid(std::vector<double>& data, const MeteoGrids::Parameters& parameter, const Date& date, const std::vector< std::pair<size_t, size_t> >& Pts)
@@ -440,19 +513,28 @@ void IOHandler::readPointsIn2DGrid(std::vector<double>& data, const MeteoGrids::
 void IOHandler::read3DGrid(Grid3DObject& grid_out, const std::string& i_filename)
 {
 	IOInterface *plugin = getPlugin("GRID3D", "Input");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("GRID3D", "Input") );
 	plugin->read3DGrid(grid_out, i_filename);
+	if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("GRID3D", "Input"), grid_out.size()*sizeof(double));
 }
 
 void IOHandler::read3DGrid(Grid3DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
 {
 	IOInterface *plugin = getPlugin("GRID3D", "Input");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("GRID3D", "Input") );
 	plugin->read3DGrid(grid_out, parameter, date);
+	if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("GRID3D", "Input"), grid_out.size()*sizeof(double));
 }
 
 void IOHandler::readDEM(DEMObject& dem_out)
 {
 	IOInterface *plugin = getPlugin("DEM", "Input");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("DEM", "Input") );
 	plugin->readDEM(dem_out);
+	if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("DEM", "Input"), dem_out.size()*sizeof(double));
 	dem_out.update();
 }
 
@@ -486,6 +568,11 @@ void IOHandler::readStationData(const Date& date, STATIONS_SET& vecStation)
 	}
 	
 	preProcessor.editTimeSeries( vecStation );
+
+	if (nr_shards>1) {
+		const size_t nr_shards_ = nr_shards, shard_idx_ = shard_idx;
+		vecStation.erase( std::remove_if(vecStation.begin(), vecStation.end(), [nr_shards_, shard_idx_](const StationData& sd) {return getShard(sd.getHash(), nr_shards_)!=shard_idx_;}), vecStation.end() );
+	}
 }
 
 void IOHandler::readMeteoData(const Date& dateStart, const Date& dateEnd,
@@ -500,26 +587,54 @@ void IOHandler::readMeteoData(const Date& dateStart, const Date& dateEnd,
 
 	for (size_t ii=0; ii<sources.size(); ii++) {
 		IOInterface *plugin = getPlugin("METEO", sources[ii], "INPUT");
+		ProfilerScope profile;
+		if (Profiler::isEnabled()) profile.start( getProfilingStage("METEO", sources[ii]) );
 
 		if (ii==0) {
 			plugin->readMeteoData(fakeStart, fakeEnd, vecMeteo);
+			if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("METEO", sources[ii]), getDataSize(vecMeteo));
 		} else  {
 			std::vector<METEO_SET> vectmp;
 			plugin->readMeteoData(fakeStart, fakeEnd, vectmp);
+			if (Profiler::isEnabled()) Profiler::addBytes(getProfilingStage("METEO", sources[ii]), getDataSize(vectmp));
 			for (size_t jj=0; jj<vectmp.size(); jj++) vecMeteo.push_back( vectmp[jj] );
 		}
 	}
 
 	preProcessor.editTimeSeries( vecMeteo );
+
+	//the stations from other shards are emptied rather than removed, so the stations keep the same index
+	if (nr_shards>1) {
+		for (METEO_SET& station : vecMeteo) {
+			if (!station.empty() && getShard(station.front().meta->getHash(), nr_shards)!=shard_idx) METEO_SET().swap( station );
+		}
+	}
 }
 
 void IOHandler::writeMeteoData(const std::vector<METEO_SET>& vecMeteo,
                                const std::string& name)
 {
 	IOInterface *plugin = getPlugin("METEO", "Output");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("METEO", "Output") );
 	plugin->writeMeteoData(vecMeteo, name);
 }
 
+bool IOHandler::canAppendMeteoData()
+{
+	IOInterface *plugin = getPlugin("METEO", "Output");
+	return plugin->canAppendMeteoData();
+}
+
+void IOHandler::appendMeteoData(const std::vector<METEO_SET>& vecMeteo,
+                                const std::string& name)
+{
+	IOInterface *plugin = getPlugin("METEO", "Output");
+	ProfilerScope profile;
+	if (Profiler::isEnabled()) profile.start( getProfilingStage("METEO", "Output") );
+	plugin->appendMeteoData(vecMeteo, name);
+}
+
 void IOHandler::readAssimilationData(const Date& date_in, Grid2DObject& da_out)
 {
 	IOInterface *plugin = getPlugin("DA", "Input");
@@ -60,6 +60,9 @@ class IOHandler : public IOInterface {
 
 		virtual void writeMeteoData(const std::vector<METEO_SET>& vecMeteo,
 		                            const std::string& name="");
+		virtual bool canAppendMeteoData();
+		virtual void appendMeteoData(const std::vector<METEO_SET>& vecMeteo,
+		                             const std::string& name="");
 		virtual void readMeteoData(const Date& dateStart, const Date& dateEnd,
 		                           std::vector<METEO_SET>& vecMeteo);
 
@@ -72,14 +75,33 @@ class IOHandler : public IOInterface {
 
 		const std::string toString() const;
 
+		/**
+		 * @brief Parse a shard specification
+		 * @param[in] shard_str shard given as "k/N" (shard k out of N shards, with 1 <= k <= N)
+		 * @param[out] o_shard_idx index of the shard, starting at 0
+		 * @param[out] o_nr_shards number of shards
+		 */
+		static void parseShard(const std::string& shard_str, size_t& o_shard_idx, size_t& o_nr_shards);
+
+		/**
+		 * @brief Return the shard a station belongs to
+		 * @details This is deterministic, so the same station always belongs to the same shard on all platforms
+		 * @param[in] station_hash station hash, as returned by StationData::getHash()
+		 * @param[in] nr_shards number of shards
+		 * @return shard index, between 0 and nr_shards-1
+		 */
+		static size_t getShard(const std::string& station_hash, const size_t& nr_shards);
+
 	private:
 		IOInterface* getPlugin(std::string plugin_name, const Config& i_cfg) const;
 		IOInterface* getPlugin(const std::string& cfgkey, const std::string& cfgsection, const std::string& sec_rename="");
 		std::vector<std::string> getListOfSources(const std::string& plugin_key, const std::string& sec_pattern) const;
+		std::string getProfilingStage(const std::string& cfgkey, const std::string& cfgsection) const;
 
 		const Config& cfg;
 		DataEditing preProcessor;
 		std::map<std::string, IOInterface*> mapPlugins;
+		size_t shard_idx, nr_shards; ///< only the stations of this shard are returned (see SHARD)
 };
 
 } //namespace
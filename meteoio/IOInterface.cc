@@ -133,6 +133,17 @@ void IOInterface::writeMeteoData(const std::vector< std::vector<MeteoData> >& /*
 	 throw IOException("Nothing implemented here", AT);
 }
 
+bool IOInterface::canAppendMeteoData()
+{
+	return false;
+}
+
+void IOInterface::appendMeteoData(const std::vector< std::vector<MeteoData> >& /*vecMeteo*/,
+		                            const std::string& /*name=""*/)
+{
+	 throw IOException("Nothing implemented here", AT);
+}
+
 void IOInterface::readAssimilationData(const Date& /*date_in*/, Grid2DObject& /*da_out*/)
 {
 	throw IOException("Nothing implemented here", AT);
@@ -260,6 +260,31 @@ class IOInterface {
 		virtual void writeMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo,
 		                            const std::string& name="");
 
+		/**
+		* @brief Can the time series written by writeMeteoData() be continued with appendMeteoData()?
+		* @details This depends on the plugin and on its configuration (for example, file versioning based on the data
+		* dates requires to know the whole dataset before writing it).
+		* @return true if appendMeteoData() is supported
+		*/
+		virtual bool canAppendMeteoData();
+
+		/**
+		* @brief Write the continuation of the time series written by the previous call to writeMeteoData()
+		* @details This makes it possible to write very long time series by chunks, keeping only one chunk in memory at
+		* any time. The chunks must be chronologically ordered and each station must keep the same index in vecMeteo
+		* over all the chunks (stations appearing later on are appended at the end of vecMeteo, stations without data in
+		* a chunk have an empty vector). This is only supported if canAppendMeteoData() returns true.
+		* @code
+		* io1.writeMeteoData(vecMeteo_chunk1);
+		* io1.appendMeteoData(vecMeteo_chunk2);
+		* io1.appendMeteoData(vecMeteo_chunk3);
+		* @endcode
+		* @param vecMeteo    A vector of vector<MeteoData> objects containing the next chunk of data
+		* @param name        (optional string) Identifier useful for the output plugin, it must be the same as for writeMeteoData()
+		*/
+		virtual void appendMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo,
+		                             const std::string& name="");
+
 		/**
 		* @brief Parse the assimilation data into a Grid2DObject for a certain date represented by the Date object
 		*
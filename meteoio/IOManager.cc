@@ -239,6 +239,8 @@ IOManager::IOManager(const Config& i_cfg) : cfg(i_cfg), ts_mode(getIOManagerTSMo
 
 void IOManager::initIOManager()
 {
+	if (cfg.get("PROFILING", "General", false)) Profiler::setEnabled(true);
+
 	//TODO support extra parameters by getting the param index from vecTrueMeteo[0]
 	if (ts_mode>=IOUtils::GRID_EXTRACT) {
 		std::vector<std::string> vecStr;
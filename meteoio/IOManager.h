@@ -24,6 +24,7 @@
 #include <meteoio/dataClasses/MeteoData.h>
 #include <meteoio/TimeSeriesManager.h>
 #include <meteoio/GridsManager.h>
+#include <meteoio/Timer.h>
 
 namespace mio {
 
@@ -200,6 +201,20 @@ class IOManager {
 
 		void writeMeteoData(const std::vector< METEO_SET >& vecMeteo, const std::string& option="") {tsm1.writeMeteoData(vecMeteo, option);}
 
+		/**
+		 * @brief Write the next chunk of the time series previously written by writeMeteoData()
+		 * @details See IOInterface::appendMeteoData(). This is only available if canAppendMeteoData() returns true.
+		 * @param vecMeteo next chunk of data, each station keeping the same index as in the previous chunks
+		 * @param option same option as given to writeMeteoData()
+		 */
+		void appendMeteoData(const std::vector< METEO_SET >& vecMeteo, const std::string& option="") {tsm1.appendMeteoData(vecMeteo, option);}
+
+		/**
+		 * @brief Does the output plugin support writing the time series by chunks with appendMeteoData()?
+		 * @return true if appendMeteoData() can be used
+		 */
+		bool canAppendMeteoData() {return tsm1.canAppendMeteoData();}
+
 		/**
 		 * @brief Returns a copy of the internal Config object.
 		 * This is convenient to clone an iomanager
@@ -209,6 +224,19 @@ class IOManager {
 
 		const std::string toString() const;
 
+		/**
+		 * @brief Returns the performance counters that have been recorded so far.
+		 * @details The instrumentation is enabled by setting the PROFILING key to true in the [General] section
+		 * (or by calling Profiler::setEnabled()). For each processing stage (raw I/O per plugin, data editing, time filters,
+		 * each filter of each parameter, resampling, data generators, each spatial interpolation algorithm) the cumulative
+		 * wall clock and CPU times and the number of calls are reported, as well as the number of bytes read by each plugin and
+		 * the hits and misses of the point cache, raw and filtered buffers and grids buffer.
+		 * The counters are shared by all IOManager objects of the process, see Profiler.
+		 * @param as_json if true, the report is formatted as JSON, otherwise as a human readable table
+		 * @return performance report
+		 */
+		static std::string getPerformanceReport(const bool& as_json=false) {return Profiler::getReport(as_json);}
+
 		/**
 		 * @brief Add a METEO_SET for a specific instance to the point cache. This is a way to manipulate
 		 * MeteoData variables and be sure that the manipulated values are later used for requests
@@ -641,18 +641,130 @@ template<> bool convertString<unsigned int>(unsigned int& t, std::string str, st
 	}
 }
 
+static inline bool isDateWhitespace(const char& c)
+{
+	return (c==' ' || c=='\t' || c=='\f' || c=='\v' || c=='\n' || c=='\r');
+}
+
+//read a run of digits (at most 9 of them) as an unsigned integer, return its number of digits (0 if it is not a number)
+static inline size_t readDigits(const char*& pos, const char* end, unsigned int& value, const size_t& max_digits=9)
+{
+	const char *start = pos;
+	value = 0;
+	while (pos<end && *pos>='0' && *pos<='9' && static_cast<size_t>(pos-start)<max_digits) {
+		value = value*10 + static_cast<unsigned int>(*pos - '0');
+		pos++;
+	}
+	if (pos<end && *pos>='0' && *pos<='9') return 0; //too many digits
+	return static_cast<size_t>(pos - start);
+}
+
+//check that the end of a date string is a numeric time zone (such as +01:00) and parse it
+static inline bool readNumericTimeZone(const char* pos, const char* end, double& tz)
+{
+	if (*pos!='+' && *pos!='-') return false;
+	for (const char *c=pos+1; c<end; c++)
+		if ((*c<'0' || *c>'9') && *c!=':') return false;
+	tz = Date::parseTimeZone( std::string(pos, end) ); //a few characters only, so this does not allocate
+	return (tz!=IOUtils::nodata);
+}
+
+/**
+* @brief Parse the most common date representations without building any temporary string or stream
+* @details This handles YYYY-MM-DD, YYYY-MM-DD{T| }hh:mm{:ss{.sss}}{TZ} and YYYYMMDDHH{mm{ss}}{TZ} (with TZ being either Z or numeric)
+* and returns false for anything else (so the generic parser can then process it). When it returns true,
+* the result is the same as what the generic parser would produce.
+*/
+static bool parseDateFast(Date& t, const std::string& str, const double& time_zone)
+{
+	const char *pos = str.c_str();
+	const char *end = pos + str.size();
+	while (pos<end && isDateWhitespace(*pos)) pos++;
+	while (end>pos && isDateWhitespace(*(end-1))) end--;
+
+	const char *start = pos;
+	while (pos<end && *pos>='0' && *pos<='9') pos++;
+	const size_t nr_digits = static_cast<size_t>(pos - start);
+	pos = start;
+
+	unsigned int year, month, day, hour, minute;
+	double tz = time_zone;
+	if (nr_digits==10 || nr_digits==12 || nr_digits==14) { //numeric date
+		unsigned int second = 0;
+		minute = 0;
+		readDigits(pos, end, year, 4);
+		readDigits(pos, end, month, 2);
+		readDigits(pos, end, day, 2);
+		readDigits(pos, end, hour, 2);
+		if (nr_digits>=12) readDigits(pos, end, minute, 2);
+		if (nr_digits==14) readDigits(pos, end, second, 2);
+		if (pos<end && !readNumericTimeZone(pos, end, tz)) return false;
+		t.setDate(static_cast<int>(year), month, day, hour, minute, static_cast<double>(second), tz);
+		return true;
+	}
+
+	//ISO date
+	if (readDigits(pos, end, year)==0 || pos==end || *pos!='-') return false;
+	pos++;
+	if (readDigits(pos, end, month)==0 || pos==end || *pos!='-') return false;
+	pos++;
+	if (readDigits(pos, end, day)==0) return false;
+	if (pos==end) { //date without time
+		t.setDate(static_cast<int>(year), month, day, static_cast<unsigned>(0), static_cast<unsigned>(0), static_cast<unsigned>(0), time_zone);
+		return true;
+	}
+	if (*pos!='T' && *pos!=' ') return false;
+	pos++;
+	if (readDigits(pos, end, hour)==0 || pos==end || *pos!=':') return false;
+	pos++;
+	if (readDigits(pos, end, minute)==0) return false;
+
+	double second = 0.;
+	bool has_seconds = false;
+	if (pos<end && *pos==':') { //seconds, maybe with a fractional part
+		pos++;
+		const char *sec_start = pos;
+		while (pos<end && *pos>='0' && *pos<='9') pos++;
+		if (pos==sec_start) return false;
+		if (pos<end && *pos=='.') {
+			pos++;
+			while (pos<end && *pos>='0' && *pos<='9') pos++;
+		}
+		char *sec_end;
+		second = strtod(sec_start, &sec_end);
+		if (sec_end!=pos) return false;
+		has_seconds = true;
+	}
+
+	//optional time zone, possibly after some whitespaces
+	while (pos<end && isDateWhitespace(*pos)) pos++;
+	if (pos<end) {
+		if (*pos=='Z' && pos+1==end) tz = 0.;
+		else if (!readNumericTimeZone(pos, end, tz)) return false;
+	}
+
+	if (has_seconds)
+		t.setDate(static_cast<int>(year), month, day, hour, minute, second, tz);
+	else
+		t.setDate(static_cast<int>(year), month, day, hour, minute, static_cast<unsigned>(0), tz);
+	return true;
+}
+
 /**
 * @brief Convert a string to a date (template specialization of convertString)
 * @details The date formats that are recognized are described in the \ref date_formats "Date class".
 * @param[out] t   The value converted to a Date object.
-* @param[in] str    The input string to convert; trailling whitespaces are ignored,
+* @param[in] in_str The input string to convert; trailling whitespaces are ignored,
 *              comment after non-string values are allowed, but multiple values are not allowed.
 * @param[in] time_zone The timezone the provided date is into
 * @param[in] f  The radix for reading numbers, such as std::dec or std::oct; default is std::dec.
 * @return true if everything went fine, false otherwise
 */
-bool convertString(Date& t, std::string str, const double& time_zone, std::ios_base& (*f)(std::ios_base&))
+bool convertString(Date& t, const std::string& in_str, const double& time_zone, std::ios_base& (*f)(std::ios_base&))
 {
+	if (parseDateFast(t, in_str, time_zone)) return true;
+
+	std::string str( in_str );
 	trim(str); //delete trailing and leading whitespaces and tabs
 	stripComments(str);
 
@@ -167,8 +167,8 @@ namespace mio {
                 md.setResampledParam(ii);
                 if (data_qa_logs) {
                     const std::map<std::string, ResamplingStack>::const_iterator it2 = mapAlgorithms.find(parname); // we have to re-find it in order to handle extra parameters
-                    const std::string statName(md.meta.getStationName());
-                    const std::string statID(md.meta.getStationID());
+                    const std::string statName(md.meta->getStationName());
+                    const std::string statID(md.meta->getStationID());
                     const std::string stat = (!statID.empty()) ? statID : statName;
                     const std::string algo_name(it2->second.getStackStr());
                     cout << "[DATA_QA] Resampling " << stat << "::" << parname << "::" << algo_name << " " << md.date.toString(Date::ISO_TZ) << " [" << md.date.toString(Date::ISO_WEEK) << "]\n";
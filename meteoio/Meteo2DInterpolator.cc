@@ -196,7 +196,11 @@ std::string Meteo2DInterpolator::interpolate(const Date& date, const DEMObject&
 			return msg;
 		} else throw IOException(msg, AT);
 	}
-	vecAlgs[bestalgorithm]->calculate(dem, result);
+	{
+		ProfilerScope profile;
+		if (Profiler::isEnabled()) profile.start( "interpol2d::" + param_name + "::" + vecAlgs[bestalgorithm]->algo );
+		vecAlgs[bestalgorithm]->calculate(dem, result);
+	}
 	InfoString = vecAlgs[bestalgorithm]->getInfo();
 
 	//Run soft min/max filter for RH, PSUM and HS
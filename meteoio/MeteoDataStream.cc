@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <meteoio/MeteoDataStream.h>
+#include <meteoio/IOExceptions.h>
+#include <meteoio/MathOptim.h>
+
+#include <algorithm>
+
+namespace mio {
+
+MeteoDataStream::MeteoDataStream(IOManager& i_io, const Date& i_start, const Date& i_end, const double& i_sampling_rate, const size_t& i_chunk_size)
+                : io(i_io), mapIDs(), Meteo(), end(i_end), current(i_start), sampling_rate(i_sampling_rate), chunk_size(i_chunk_size),
+                  nr_timesteps(0), progress(nullptr), keep_nodata(false)
+{
+	if (sampling_rate<=0.)
+		throw InvalidArgumentException("The sampling rate of a MeteoDataStream must be > 0", AT);
+	if (i_start.isUndef() || i_end.isUndef())
+		throw InvalidArgumentException("Please provide a valid period for the MeteoDataStream", AT);
+}
+
+bool MeteoDataStream::next(std::vector< METEO_SET >& vecMeteo)
+{
+	vecMeteo.clear();
+	if (current>end) return false;
+
+	//to avoid memory re-allocations with push_back()
+	const size_t nr_remaining = static_cast<size_t>(Optim::floor( (end.getJulian() - current.getJulian()) / sampling_rate + 1e-6 ) + 1);
+	const size_t nr_samples = (chunk_size>0)? std::min(chunk_size, nr_remaining) : nr_remaining;
+	vecMeteo.resize( mapIDs.size() );
+	for (METEO_SET& station : vecMeteo) station.reserve( nr_samples );
+
+	for (size_t count=0; current<=end && (chunk_size==0 || count<chunk_size); count++) {
+		if (progress) progress( current );
+		io.getMeteoData(current, Meteo); //read 1 timestep at once, forcing resampling to the timestep
+		nr_timesteps++;
+		current += sampling_rate;
+
+		for (const MeteoData& md : Meteo) {
+			if (!keep_nodata && md.isNodata()) continue;
+
+			const std::map<std::string, size_t>::const_iterator it( mapIDs.find(md.meta->stationID) );
+			size_t idx;
+			if (it==mapIDs.end()) { //if this is the first time we encounter this station, save where it should be inserted
+				idx = mapIDs.size();
+				mapIDs[ md.meta->stationID ] = idx;
+				vecMeteo.push_back( METEO_SET() );
+				vecMeteo.back().reserve( nr_samples );
+			} else {
+				idx = it->second;
+			}
+			vecMeteo[idx].push_back( md );
+		}
+	}
+
+	//handle extra parameters changing over time
+	for (METEO_SET& station : vecMeteo) MeteoData::unifyMeteoData( station );
+	return true;
+}
+
+} //namespace
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+/***********************************************************************************/
+/*  Copyright 2026 WSL Institute for Snow and Avalanche Research    SLF-DAVOS      */
+/***********************************************************************************/
+/* This file is part of MeteoIO.
+    MeteoIO is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    MeteoIO is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef METEODATASTREAM_H
+#define METEODATASTREAM_H
+
+#include <meteoio/IOManager.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mio {
+
+/**
+ * @class MeteoDataStream
+ * @brief Read resampled time series by chunks, with a bounded memory usage.
+ * @details Contrary to IOManager::getMeteoData(const Date&, const Date&, std::vector< METEO_SET >&) that returns the
+ * whole period at once, this returns the data at a given sampling rate chunk after chunk, each chunk containing
+ * at most a given number of timesteps. Each station keeps the same index in all the chunks (stations that appear later
+ * on are added at the end and stations that have no data in a chunk get an empty vector), so the chunks can directly be
+ * written out with IOManager::writeMeteoData() for the first one and IOManager::appendMeteoData() for the next ones.
+ * @code
+ * MeteoDataStream stream(io, dateBegin, dateEnd, 1./24., 1000); //hourly data, 1000 timesteps at a time
+ * std::vector<METEO_SET> vecMeteo;
+ * bool first_chunk = true;
+ * while (stream.next(vecMeteo)) {
+ * 	if (first_chunk) io.writeMeteoData(vecMeteo);
+ * 	else io.appendMeteoData(vecMeteo);
+ * 	first_chunk = false;
+ * }
+ * @endcode
+ *
+ * @date   2026-10-18
+ */
+class MeteoDataStream {
+	public:
+		typedef void (*ProgressCallback)(const Date& date); ///< called with the date of each timestep before it is read
+
+		/**
+		 * @brief Prepare the stream
+		 * @param[in] i_io IOManager to get the data from
+		 * @param[in] i_start first timestep
+		 * @param[in] i_end last timestep (inclusive)
+		 * @param[in] i_sampling_rate time step, in days
+		 * @param[in] i_chunk_size maximum number of timesteps per chunk (0 means all the timesteps in one chunk)
+		 */
+		MeteoDataStream(IOManager& i_io, const Date& i_start, const Date& i_end, const double& i_sampling_rate, const size_t& i_chunk_size);
+
+		/**
+		 * @brief Get the next chunk of data
+		 * @param[out] vecMeteo data for the next chunk of timesteps, one vector per station
+		 * @return false if there is no data left (vecMeteo is then empty)
+		 */
+		bool next(std::vector< METEO_SET >& vecMeteo);
+
+		/**
+		 * @brief Should the timesteps where all parameters are nodata be kept? (default: false)
+		 * @param[in] keep set to true to keep them
+		 */
+		void setKeepNodata(const bool& keep) {keep_nodata = keep;}
+
+		/**
+		 * @brief Report the progress at each timestep (and not only at each chunk)
+		 * @param[in] callback function to call with the date of each timestep before it is read (nullptr to disable)
+		 */
+		void setProgressCallback(ProgressCallback callback) {progress = callback;}
+
+		/**
+		 * @brief Date of the timestep that will be read next
+		 * @return next date or undefined Date if the whole period has been read
+		 */
+		Date getNextDate() const {return (current<=end)? current : Date();}
+
+		/** @brief Number of timesteps that have been read so far */
+		size_t getNrOfTimesteps() const {return nr_timesteps;}
+
+		/** @brief Station IDs that have been found so far, with their index in the chunks */
+		const std::map<std::string, size_t>& getStationsIndex() const {return mapIDs;}
+
+	private:
+		IOManager& io;
+		std::map<std::string, size_t> mapIDs; ///< over a large time range, the number of stations might change
+		METEO_SET Meteo; ///< intermediate storage for 1 timestep
+		const Date end;
+		Date current;
+		const double sampling_rate;
+		const size_t chunk_size;
+		size_t nr_timesteps;
+		ProgressCallback progress;
+		bool keep_nodata;
+};
+
+} //end namespace
+
+#endif
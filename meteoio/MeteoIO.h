@@ -46,6 +46,7 @@
 #include <meteoio/dataClasses/StationData.h>
 #include <meteoio/dataClasses/Buffer.h>
 
+#include <meteoio/Expression.h>
 #include <meteoio/DataGenerator.h>
 #include <meteoio/FileUtils.h>
 #include <meteoio/dataGenerators/GeneratorAlgorithms.h>
@@ -57,6 +58,7 @@
 #include <meteoio/TimeSeriesManager.h>
 #include <meteoio/GridsManager.h>
 #include <meteoio/IOManager.h>
+#include <meteoio/MeteoDataStream.h>
 #include <meteoio/IOUtils.h>
 //#include <meteoio/MainPage.h> //only for doxygen
 #include <meteoio/MathOptim.h>
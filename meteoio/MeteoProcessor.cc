@@ -18,6 +18,7 @@
 */
 #include <meteoio/MeteoProcessor.h>
 #include <meteoio/meteoFilters/TimeFilters.h>
+#include <meteoio/Timer.h>
 #include <algorithm>
 
 using namespace std;
@@ -98,6 +99,7 @@ void MeteoProcessor::process(std::vector< std::vector<MeteoData> >& ivec,
 {
 	std::swap(ivec, ovec);
 	if (processing_stack.empty() || !enable_meteo_filtering) return;
+	const ProfilerScope profile( "filtering" );
 	
 	for (std::map<std::string, ProcessingStack*>::const_iterator it=processing_stack.begin(); it != processing_stack.end(); ++it) {
 		std::swap(ovec, ivec);
@@ -18,6 +18,7 @@
 */
 
 #include <meteoio/TimeSeriesManager.h>
+#include <meteoio/Timer.h>
 
 #include <algorithm>
 
@@ -231,10 +232,12 @@ size_t TimeSeriesManager::getMeteoData(const Date& dateStart, const Date& dateEn
 		iohandler.readMeteoData(dateStart, dateEnd, vecVecMeteo);
 	} else {
 		const bool success = filtered_cache.get(dateStart, dateEnd, vecVecMeteo);
+		Profiler::addCacheAccess("cache::filtered", success);
 
 		if (!success) {
 			std::vector< std::vector<MeteoData> > tmp_meteo;
 			const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > dateStart) || (raw_buffer.getBufferEnd() < dateEnd);
+			Profiler::addCacheAccess("cache::raw", !rebuffer_raw);
 			if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) fillRawBuffer(dateStart, dateEnd);
 			raw_buffer.get(dateStart, dateEnd, tmp_meteo);
 
@@ -274,6 +277,7 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 
 	//2.  Check which data point is available, buffered locally
 	const map<Date, vector<MeteoData> >::const_iterator it = point_cache.find(i_date);
+	Profiler::addCacheAccess("cache::points", it != point_cache.end());
 	if (it != point_cache.end()) {
 		vecMeteo = it->second;
 		return vecMeteo.size();
@@ -292,11 +296,13 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 	std::vector< vector<MeteoData> >* data = nullptr; //reference to either filtered_cache or raw_buffer
 	if ((IOUtils::filtered & processing_level) == IOUtils::filtered) {
 		const bool rebuffer_filtered = filtered_cache.empty() || (filtered_cache.getBufferStart() > buffer_start) || (filtered_cache.getBufferEnd() < buffer_end);
+		Profiler::addCacheAccess("cache::filtered", !rebuffer_filtered);
 		if (rebuffer_filtered) { //explicit caching, rebuffer if necessary
 			if (!filtered_cache.empty())  //invalidate cached values in the resampling algorithms if necessary
 				meteoprocessor.resetResampling();
 				
 			const bool rebuffer_raw = raw_buffer.empty() || (raw_buffer.getBufferStart() > buffer_start) || (raw_buffer.getBufferEnd() < buffer_end);
+			Profiler::addCacheAccess("cache::raw", !rebuffer_raw);
 			if (rebuffer_raw && (IOUtils::raw & processing_level) == IOUtils::raw) {
 				fillRawBuffer(buffer_start, buffer_end);
 			}
@@ -312,9 +318,10 @@ size_t TimeSeriesManager::getMeteoData(const Date& i_date, METEO_SET& vecMeteo)
 	std::vector<size_t> stations_idx((*data).size(), IOUtils::npos);
 
 	if ((IOUtils::resampled & processing_level) == IOUtils::resampled) { //resampling required
+		const ProfilerScope profile( "resampling" );
 		for (size_t ii=0; ii<(*data).size(); ii++) { //for every station
 			if ((*data)[ii].empty()) continue;
-			const std::string stationHash( IOUtils::toString(ii)+"-"+(*data)[ii].front().meta.getHash() );
+			const std::string stationHash( IOUtils::toString(ii)+"-"+(*data)[ii].front().meta->getHash() );
 			MeteoData md;
 			const bool success = meteoprocessor.resample(i_date, stationHash, (*data)[ii], md);
 			if (success) {
@@ -345,6 +352,11 @@ void TimeSeriesManager::writeMeteoData(const std::vector< METEO_SET >& vecMeteo,
 	iohandler.writeMeteoData(vecMeteo, name);
 }
 
+void TimeSeriesManager::appendMeteoData(const std::vector< METEO_SET >& vecMeteo, const std::string& name)
+{
+	iohandler.appendMeteoData(vecMeteo, name);
+}
+
 /**
  * @brief Filter the whole raw meteo data buffer
  */
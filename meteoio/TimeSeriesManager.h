@@ -149,6 +149,8 @@ class TimeSeriesManager {
 		double getAvgSamplingRate() const;
 
 		void writeMeteoData(const std::vector< METEO_SET >& vecMeteo, const std::string& name="");
+		void appendMeteoData(const std::vector< METEO_SET >& vecMeteo, const std::string& name="");
+		bool canAppendMeteoData() {return iohandler.canAppendMeteoData();}
 
 		const std::string toString() const;
 
@@ -33,6 +33,11 @@
 #include <meteoio/Timer.h>
 #include <meteoio/IOUtils.h>
 
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
 namespace mio {
 
 /**
@@ -199,6 +204,106 @@ void UsageTimer::getElapsedTimes()
 #endif
 
 
+std::atomic<bool> Profiler::enabled( false );
+static std::mutex profiler_mutex;
+static std::map<std::string, Profiler::StageStats> profiler_stats;
+
+void Profiler::addTime(const std::string& stage, const double& wall_time, const double& cpu_time)
+{
+	const std::lock_guard<std::mutex> lock( profiler_mutex );
+	StageStats &stats = profiler_stats[ stage ];
+	stats.wall_time += wall_time;
+	stats.cpu_time += cpu_time;
+	stats.calls++;
+}
+
+void Profiler::recordBytes(const std::string& stage, const size_t& bytes)
+{
+	const std::lock_guard<std::mutex> lock( profiler_mutex );
+	profiler_stats[ stage ].bytes += bytes;
+}
+
+void Profiler::recordCacheAccess(const std::string& stage, const bool& hit)
+{
+	const std::lock_guard<std::mutex> lock( profiler_mutex );
+	StageStats &stats = profiler_stats[ stage ];
+	if (hit) stats.hits++;
+	else stats.misses++;
+}
+
+void Profiler::reset()
+{
+	const std::lock_guard<std::mutex> lock( profiler_mutex );
+	profiler_stats.clear();
+}
+
+std::map<std::string, Profiler::StageStats> Profiler::getStats()
+{
+	const std::lock_guard<std::mutex> lock( profiler_mutex );
+	return profiler_stats;
+}
+
+std::string Profiler::getReport(const bool& as_json)
+{
+	const std::map<std::string, StageStats> stats( getStats() );
+	std::ostringstream os;
+
+	if (as_json) {
+		os << "{\"profiling\": " << (isEnabled()? "true" : "false") << ", \"stages\": [";
+		for (std::map<std::string, StageStats>::const_iterator it=stats.begin(); it!=stats.end(); ++it) {
+			std::string name; //the stage name, escaped for JSON
+			for (const char c : it->first) {
+				if (c=='"' || c=='\\') name.push_back('\\');
+				name.push_back( c );
+			}
+			if (it!=stats.begin()) os << ",";
+			os << "\n\t{\"name\": \"" << name << "\", \"calls\": " << it->second.calls;
+			os << ", \"wall_time\": " << it->second.wall_time << ", \"cpu_time\": " << it->second.cpu_time;
+			os << ", \"bytes\": " << it->second.bytes << ", \"cache_hits\": " << it->second.hits << ", \"cache_misses\": " << it->second.misses << "}";
+		}
+		os << "\n]}\n";
+		return os.str();
+	}
+
+	size_t width = 5;
+	for (std::map<std::string, StageStats>::const_iterator it=stats.begin(); it!=stats.end(); ++it)
+		width = std::max(width, it->first.length());
+
+	os << std::left << std::setw(static_cast<int>(width)) << "stage" << std::right;
+	os << std::setw(10) << "calls" << std::setw(12) << "wall [s]" << std::setw(12) << "cpu [s]";
+	os << std::setw(14) << "bytes" << std::setw(10) << "hits" << std::setw(10) << "misses" << std::setw(10) << "hit rate" << "\n";
+	os << std::fixed << std::setprecision(3);
+	for (std::map<std::string, StageStats>::const_iterator it=stats.begin(); it!=stats.end(); ++it) {
+		const StageStats &st = it->second;
+		os << std::left << std::setw(static_cast<int>(width)) << it->first << std::right;
+		os << std::setw(10) << st.calls << std::setw(12) << st.wall_time << std::setw(12) << st.cpu_time;
+		os << std::setw(14) << st.bytes << std::setw(10) << st.hits << std::setw(10) << st.misses;
+		if (st.hits+st.misses>0)
+			os << std::setw(9) << std::setprecision(1) << 100. * static_cast<double>(st.hits) / static_cast<double>(st.hits+st.misses) << "%" << std::setprecision(3);
+		else
+			os << std::setw(10) << "-";
+		os << "\n";
+	}
+	return os.str();
+}
+
+void ProfilerScope::start(const std::string& i_stage)
+{
+	stage = i_stage;
+	start_wall = Timer::getCurrentTime();
+	start_cpu = std::clock();
+	active = true;
+}
+
+void ProfilerScope::stop()
+{
+	if (!active) return;
+	const double wall_time = static_cast<double>( Timer::getCurrentTime() - start_wall );
+	const double cpu_time = static_cast<double>( std::clock() - start_cpu ) / CLOCKS_PER_SEC;
+	Profiler::addTime(stage, wall_time, cpu_time);
+	active = false;
+}
+
 #ifdef _WIN32
 /* function called when the timer expires */
 void CALLBACK TimerProc(void* /*parameters*/, BOOLEAN /*timerCalled*/)
@@ -27,6 +27,11 @@
 
 #include <meteoio/IOExceptions.h>
 
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <string>
+
 namespace mio {
 
 /**
@@ -83,6 +88,83 @@ class UsageTimer {
 };
 #endif
 
+/**
+ * @class Profiler
+ * @brief Process-wide performance counters, kept per named processing stage.
+ * @details For each stage (for example "io::INPUT::METEO::SMET", "editing" or "filter::TA::MIN"), the cumulative
+ * wall clock time, CPU time, number of calls, number of bytes read as well as cache hits and misses are recorded.
+ * The times of nested stages are inclusive (the time spent in each filter is also counted in "filtering").
+ * The CPU time is the process CPU time, so it includes all threads when running in parallel.
+ *
+ * Recording is disabled by default and can be enabled at runtime (for example with the PROFILING key in the [General]
+ * section, see IOManager::getPerformanceReport()). When disabled, recording only costs the test of a boolean.
+ * @code
+ * Profiler::setEnabled(true);
+ * {
+ * 	const ProfilerScope profile("my_stage");
+ * 	//do some work
+ * }
+ * std::cout << Profiler::getReport();
+ * @endcode
+ * @date   2026-10-18
+ */
+class Profiler {
+	public:
+		typedef struct STAGE_STATS {
+			STAGE_STATS() : wall_time(0.), cpu_time(0.), calls(0), bytes(0), hits(0), misses(0) {}
+			double wall_time, cpu_time; ///< cumulative times, in seconds
+			size_t calls, bytes, hits, misses;
+		} StageStats;
+
+		static void setEnabled(const bool& enable) {enabled.store(enable, std::memory_order_relaxed);}
+		static bool isEnabled() {return enabled.load(std::memory_order_relaxed);}
+
+		static void addTime(const std::string& stage, const double& wall_time, const double& cpu_time);
+		static void addBytes(const std::string& stage, const size_t& bytes) {if (isEnabled()) recordBytes(stage, bytes);}
+		static void addCacheAccess(const char* stage, const bool& hit) {if (isEnabled()) recordCacheAccess(stage, hit);}
+
+		static void reset();
+		static std::map<std::string, StageStats> getStats();
+
+		/**
+		 * @brief Format the recorded statistics
+		 * @param[in] as_json if true, the report is formatted as JSON, otherwise as a human readable table
+		 * @return report
+		 */
+		static std::string getReport(const bool& as_json=false);
+
+	private:
+		static void recordBytes(const std::string& stage, const size_t& bytes);
+		static void recordCacheAccess(const std::string& stage, const bool& hit);
+
+		static std::atomic<bool> enabled; ///< only a switch, the statistics themselves are protected by a mutex
+};
+
+/**
+ * @class ProfilerScope
+ * @brief Time a processing stage from the object's construction until its destruction (see Profiler)
+ * @details If the Profiler is disabled, nothing is done (and the stage name is not even built)
+ */
+class ProfilerScope {
+	public:
+		ProfilerScope() : stage(), start_wall(0.L), start_cpu(0), active(false) {}
+		ProfilerScope(const char* i_stage) : stage(), start_wall(0.L), start_cpu(0), active(false) {if (Profiler::isEnabled()) start(i_stage);}
+		ProfilerScope(const char* prefix, const std::string& name) : stage(), start_wall(0.L), start_cpu(0), active(false) {if (Profiler::isEnabled()) start(prefix+name);}
+		~ProfilerScope() {if (active) stop();}
+
+		void start(const std::string& i_stage);
+		void stop();
+
+	private:
+		ProfilerScope(const ProfilerScope&);
+		ProfilerScope& operator=(const ProfilerScope&);
+
+		std::string stage;
+		long double start_wall;
+		std::clock_t start_cpu;
+		bool active;
+};
+
 /**
  * @class WatchDog
  * @brief A software watchdog, killing the current process after the given number of seconds
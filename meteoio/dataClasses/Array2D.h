@@ -152,6 +152,13 @@ template<class T> class Array2D {
 		void clear();
 		bool empty() const;
 
+		/**
+		* @brief direct access to the data, stored row after row (ie the element (x,y) is at x + y*nx)
+		* @return pointer to the first element
+		*/
+		T* data() {return vecData.data();}
+		const T* data() const {return vecData.data();}
+
 		/**
 		* @brief returns the minimum value contained in the grid
 		* @return minimum value
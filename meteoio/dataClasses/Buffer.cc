@@ -18,6 +18,7 @@
 */
 
 #include <meteoio/dataClasses/Buffer.h>
+#include <meteoio/Timer.h>
 
 #include <limits.h>
 #include <algorithm>
@@ -115,8 +116,9 @@ void MeteoBuffer::push(const Date& date_start, const Date& date_end, const std::
 
 		for (size_t ii=0; ii<nrStationsPush; ii++) { //for all stations
 			if (ts_buffer[ii].empty()) continue;
-			if (ts_buffer[ii].front().meta.getHash()!=vecMeteo[ii].meta.getHash())
-				throw IOException("A station changed over time from "+ts_buffer[ii].front().meta.getHash()+" to "+vecMeteo[ii].meta.getHash(), AT);
+			const SharedStationData& buffered_meta( ts_buffer[ii].front().meta );
+			if (buffered_meta.get()!=vecMeteo[ii].meta.get() && buffered_meta->getHash()!=vecMeteo[ii].meta->getHash())
+				throw IOException("A station changed over time from "+ts_buffer[ii].front().meta->getHash()+" to "+vecMeteo[ii].meta->getHash(), AT);
 		}
 	}
 
@@ -173,9 +175,10 @@ void MeteoBuffer::push(const Date& date_start, const Date& date_end, const std::
 	for (size_t ii=0; ii<nrStationsPush; ii++) { //for all stations
 		if (ts_buffer[ii].empty() || vecMeteo[ii].empty())
 			continue;
-		if (ts_buffer[ii].front().meta.getHash()!=vecMeteo[ii].front().meta.getHash()) {
+		const SharedStationData& buffered_meta( ts_buffer[ii].front().meta );
+		if (buffered_meta.get()!=vecMeteo[ii].front().meta.get() && buffered_meta->getHash()!=vecMeteo[ii].front().meta->getHash()) {
 			ostringstream ss;
-			ss << "The stations changed over time from " << ts_buffer[ii].front().meta.getHash() << " to " << vecMeteo[ii].front().meta.getHash() << ", ";
+			ss << "The stations changed over time from " << ts_buffer[ii].front().meta->getHash() << " to " << vecMeteo[ii].front().meta->getHash() << ", ";
 			ss << "this is not handled yet!";
 			throw IOException(ss.str(), AT);
 		}
@@ -303,8 +306,8 @@ const std::string MeteoBuffer::toString() const
 	os << "Buffer content (" << ts_buffer.size() << " stations)\n";
 	for (size_t ii=0; ii<ts_buffer.size(); ii++) {
 		if (!ts_buffer[ii].empty()){
-			os << std::setw(10) << ts_buffer[ii].front().meta.stationID << " ("
-			   << ts_buffer[ii].front().meta.getAltitude() << ") = "
+			os << std::setw(10) << ts_buffer[ii].front().meta->stationID << " ("
+			   << ts_buffer[ii].front().meta->getAltitude() << ") = "
 			   << ts_buffer[ii].front().date.toString(Date::ISO) << " - "
 			   << ts_buffer[ii].back().date.toString(Date::ISO) << ", "
 			   << ts_buffer[ii].size() << " timesteps" << endl;
@@ -326,14 +329,19 @@ GridBuffer::GridBuffer(const size_t& in_max_grids)
 
 bool GridBuffer::get(Grid2DObject& grid, const std::string& grid_hash) const
 {
-	if (IndexBufferedGrids.empty()) return false;
+	if (IndexBufferedGrids.empty()) {
+		Profiler::addCacheAccess("cache::grids", false);
+		return false;
+	}
 
 	const std::map<std::string, Grid2DObject>::const_iterator it = mapBufferedGrids.find( grid_hash );
 	if (it != mapBufferedGrids.end()) { //already in map
+		Profiler::addCacheAccess("cache::grids", true);
 		grid = (*it).second;
 		return true;
 	}
 
+	Profiler::addCacheAccess("cache::grids", false);
 	return false;
 }
 
@@ -359,6 +367,25 @@ bool GridBuffer::get(Grid2DObject& grid, const MeteoGrids::Parameters& parameter
 	return get(grid, grid_hash);
 }
 
+/**
+* @brief Access a buffered grid without copying it
+* @param parameter the parameter to look for
+* @param date the date of the grid
+* @return pointer to the buffered grid or nullptr if it is not buffered. It is only valid until the next push().
+*/
+const Grid2DObject* GridBuffer::find(const MeteoGrids::Parameters& parameter, const Date& date) const
+{
+	if (IndexBufferedGrids.empty()) {
+		Profiler::addCacheAccess("cache::grids", false);
+		return nullptr;
+	}
+
+	const std::string grid_hash( date.toString(Date::ISO)+"::"+MeteoGrids::getParameterName(parameter) );
+	const std::map<std::string, Grid2DObject>::const_iterator it = mapBufferedGrids.find( grid_hash );
+	Profiler::addCacheAccess("cache::grids", it != mapBufferedGrids.end());
+	return (it != mapBufferedGrids.end())? &it->second : nullptr;
+}
+
 bool GridBuffer::has(const std::string& grid_hash) const
 {
 	if (IndexBufferedGrids.empty()) return false;
@@ -374,10 +401,8 @@ bool GridBuffer::has(const MeteoGrids::Parameters& parameter, const Date& date)
 
 bool GridBuffer::get(DEMObject& grid, const std::string& grid_hash) const
 {
-	if (IndexBufferedDEMs.empty())
-		return false;
-
 	const std::map<std::string, DEMObject>::const_iterator it = mapBufferedDEMs.find( grid_hash );
+	Profiler::addCacheAccess("cache::dems", it != mapBufferedDEMs.end());
 	if (it != mapBufferedDEMs.end()) { //already in map
 		//properties of the passed dem
 		const DEMObject::update_type in_ppt = (DEMObject::update_type)grid.getUpdatePpt();
@@ -168,6 +168,7 @@ class GridBuffer {
 		bool get(Grid2DObject& grid, const std::string& grid_hash) const;
 		bool get(Grid2DObject& grid, const std::string& grid_hash, std::string& grid_info) const;
 		bool get(Grid2DObject& grid, const MeteoGrids::Parameters& parameter, const Date& date) const;
+		const Grid2DObject* find(const MeteoGrids::Parameters& parameter, const Date& date) const;
 		
 		bool has(const std::string& grid_hash) const;
 		bool has(const MeteoGrids::Parameters& parameter, const Date& date) const;
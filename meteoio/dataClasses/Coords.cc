@@ -109,6 +109,21 @@ bool Coords::operator!=(const Coords& in) const {
 	return !(*this==in);
 }
 
+/**
+* @brief Strict comparison of all the fields.
+* @details Contrary to the equality operator that checks if both objects represent the same location (within
+* the usual epsilons), this checks that every field (including the projection and the distance algorithm) is the same.
+* @param[in] in Coords to compare to
+* @return true if both objects are strictly identical
+*/
+bool Coords::isIdentical(const Coords& in) const {
+	return ( altitude==in.altitude && latitude==in.latitude && longitude==in.longitude &&
+	         easting==in.easting && northing==in.northing &&
+	         ref_latitude==in.ref_latitude && ref_longitude==in.ref_longitude &&
+	         grid_i==in.grid_i && grid_j==in.grid_j && grid_k==in.grid_k && validIndex==in.validIndex &&
+	         distance_algo==in.distance_algo && coordsystem==in.coordsystem && coordparam==in.coordparam );
+}
+
 Coords& Coords::operator=(const Coords& source) {
 	if (this != &source) {
 		altitude = source.altitude;
@@ -819,6 +834,82 @@ void Coords::setEPSG(const int& epsg) {
 	setProj(coord_sys, coord_param);
 }
 
+/**
+* @brief Convert many points from the projection of this object to WGS84 at once
+* @details This gives the same results as calling setXY() followed by getLat() / getLon() for each point, but
+* external projection libraries (such as PROJ) are only initialized once for all the points.
+* @param[in] vecEasting eastings of the points to convert
+* @param[in] vecNorthing northings of the points to convert
+* @param[out] vecLat latitudes of the points (nodata if the easting or northing is nodata)
+* @param[out] vecLon longitudes of the points (nodata if the easting or northing is nodata)
+*/
+void Coords::xyToLatLon(const std::vector<double>& vecEasting, const std::vector<double>& vecNorthing, std::vector<double>& vecLat, std::vector<double>& vecLon) const
+{
+	if (vecEasting.size()!=vecNorthing.size())
+		throw InvalidArgumentException("The eastings and northings must have the same number of points", AT);
+	const size_t nr_points = vecEasting.size();
+	vecLat.assign(nr_points, IOUtils::nodata);
+	vecLon.assign(nr_points, IOUtils::nodata);
+
+	if (coordsystem!="PROJ") {
+		for (size_t ii=0; ii<nr_points; ii++)
+			convert_to_WGS84(vecEasting[ii], vecNorthing[ii], vecLat[ii], vecLon[ii]);
+		return;
+	}
+
+	std::vector<size_t> valid;
+	std::vector<double> east, north, lat, lon;
+	for (size_t ii=0; ii<nr_points; ii++) {
+		if (vecEasting[ii]==IOUtils::nodata || vecNorthing[ii]==IOUtils::nodata) continue;
+		valid.push_back( ii );
+		east.push_back( vecEasting[ii] );
+		north.push_back( vecNorthing[ii] );
+	}
+	CoordsAlgorithms::PROJ_to_WGS84(east, north, coordparam, lat, lon);
+	for (size_t kk=0; kk<valid.size(); kk++) {
+		vecLat[ valid[kk] ] = lat[kk];
+		vecLon[ valid[kk] ] = lon[kk];
+	}
+}
+
+/**
+* @brief Convert many points from WGS84 to the projection of this object at once
+* @details This gives the same results as calling setLatLon() followed by getEasting() / getNorthing() for each point, but
+* external projection libraries (such as PROJ) are only initialized once for all the points.
+* @param[in] vecLat latitudes of the points to convert
+* @param[in] vecLon longitudes of the points to convert
+* @param[out] vecEasting eastings of the points (nodata if the latitude or longitude is nodata)
+* @param[out] vecNorthing northings of the points (nodata if the latitude or longitude is nodata)
+*/
+void Coords::latLonToXY(const std::vector<double>& vecLat, const std::vector<double>& vecLon, std::vector<double>& vecEasting, std::vector<double>& vecNorthing) const
+{
+	if (vecLat.size()!=vecLon.size())
+		throw InvalidArgumentException("The latitudes and longitudes must have the same number of points", AT);
+	const size_t nr_points = vecLat.size();
+	vecEasting.assign(nr_points, IOUtils::nodata);
+	vecNorthing.assign(nr_points, IOUtils::nodata);
+
+	if (coordsystem!="PROJ") {
+		for (size_t ii=0; ii<nr_points; ii++)
+			convert_from_WGS84(vecLat[ii], vecLon[ii], vecEasting[ii], vecNorthing[ii]);
+		return;
+	}
+
+	std::vector<size_t> valid;
+	std::vector<double> lat, lon, east, north;
+	for (size_t ii=0; ii<nr_points; ii++) {
+		if (vecLat[ii]==IOUtils::nodata || vecLon[ii]==IOUtils::nodata) continue;
+		valid.push_back( ii );
+		lat.push_back( vecLat[ii] );
+		lon.push_back( vecLon[ii] );
+	}
+	CoordsAlgorithms::WGS84_to_PROJ(lat, lon, coordparam, east, north);
+	for (size_t kk=0; kk<valid.size(); kk++) {
+		vecEasting[ valid[kk] ] = east[kk];
+		vecNorthing[ valid[kk] ] = north[kk];
+	}
+}
+
 /////////////////////////////////////////////////////private methods
 /**
 * @brief Method converting towards WGS84
@@ -22,6 +22,7 @@
 #include <string>
 #include <iostream>
 #include <set>
+#include <vector>
 
 namespace mio {
 /**
@@ -108,6 +109,7 @@ class Coords {
 		Coords& operator=(const Coords&); ///<Assignement operator
 		bool operator==(const Coords&) const; ///<Operator that tests for equality
 		bool operator!=(const Coords&) const; ///<Operator that tests for inequality
+		bool isIdentical(const Coords& in) const;
 		bool isNodata() const;
 		void moveByXY(const double& x_displacement, const double& y_displacement);
 		void moveByBearing(const double& i_bearing, const double& i_distance);
@@ -150,6 +152,8 @@ class Coords {
 		double distance(const Coords& destination) const;
 		bool isSameProj(const Coords& target) const;
 		void copyProj(const Coords& source, const bool i_update=true);
+		void xyToLatLon(const std::vector<double>& vecEasting, const std::vector<double>& vecNorthing, std::vector<double>& vecLat, std::vector<double>& vecLon) const;
+		void latLonToXY(const std::vector<double>& vecLat, const std::vector<double>& vecLon, std::vector<double>& vecEasting, std::vector<double>& vecNorthing) const;
 
 	private:
 		//Coordinates conversions
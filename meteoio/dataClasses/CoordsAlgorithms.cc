@@ -945,6 +945,108 @@ void CoordsAlgorithms::PROJ_to_WGS84(const double& east_in, const double& north_
 #endif
 }
 
+#if defined(PROJ4)
+//transform all the points at once (in place) between two proj4 definitions
+static void proj4Transform(const std::string& src_param, const std::string& dest_param, std::vector<double>& x, std::vector<double>& y)
+{
+	projPJ pj_src = pj_init_plus(src_param.c_str());
+	if (!pj_src) throw InvalidArgumentException("Failed to initalize Proj with given arguments: "+src_param, AT);
+	projPJ pj_dest = pj_init_plus(dest_param.c_str());
+	if (!pj_dest) {
+		pj_free(pj_src);
+		throw InvalidArgumentException("Failed to initalize Proj with given arguments: "+dest_param, AT);
+	}
+
+	const int p = pj_transform(pj_src, pj_dest, static_cast<long>(x.size()), 1, &x[0], &y[0], NULL );
+	pj_free(pj_src);
+	pj_free(pj_dest);
+	if (p!=0) throw ConversionFailedException("PROJ conversion failed: "+IOUtils::toString(p), AT);
+}
+#elif defined(PROJ)
+//transform all the points at once (in place) with a single PROJ context and transformation
+static void projTransform(const std::string& src_param, const std::string& dest_param, std::vector<double>& x, std::vector<double>& y)
+{
+	PJ_CONTEXT* pj_context = proj_context_create();
+	PJ* pj_trans = proj_create_crs_to_crs(pj_context, src_param.c_str(), dest_param.c_str(), NULL);
+	if (pj_trans == NULL) {
+		const std::string msg( proj_context_errno_string(pj_context, proj_context_errno(pj_context)) );
+		proj_context_destroy(pj_context);
+		throw ConversionFailedException("PROJ: Failed to create transform: " + msg, AT);
+	}
+
+	proj_trans_generic(pj_trans, PJ_FWD, &x[0], sizeof(double), x.size(), &y[0], sizeof(double), y.size(), 0, sizeof(double), 0, 0, sizeof(double), 0);
+	const int pj_errno = proj_errno(pj_trans);
+	const std::string msg( (pj_errno!=0)? proj_context_errno_string(pj_context, pj_errno) : "" );
+	proj_destroy(pj_trans);
+	proj_context_destroy(pj_context);
+	if (pj_errno != 0) throw ConversionFailedException("PROJ: Failed to transform coords: " + msg, AT);
+}
+#endif
+
+/**
+* @brief Coordinate conversion: from WGS84 Lat/Long to proj parameters, for many points at once
+* @details The projection is only initialized once for all the points, so this is much faster than converting
+* the points one by one.
+* @param[in] lat_in Decimal Latitudes
+* @param[in] long_in Decimal Longitudes
+* @param[in] coordparam Extra parameters necessary for the conversion (such as UTM zone, etc)
+* @param[out] east_out easting coordinates (target system)
+* @param[out] north_out northing coordinates (target system)
+*/
+void CoordsAlgorithms::WGS84_to_PROJ(const std::vector<double>& lat_in, const std::vector<double>& long_in, const std::string& coordparam, std::vector<double>& east_out, std::vector<double>& north_out)
+{
+	if (lat_in.size()!=long_in.size())
+		throw InvalidArgumentException("The latitudes and longitudes must have the same number of points", AT);
+	east_out = long_in;
+	north_out = lat_in;
+	if (east_out.empty()) return;
+
+#if defined(PROJ4)
+	for (size_t ii=0; ii<east_out.size(); ii++) {
+		east_out[ii] *= Cst::to_rad;
+		north_out[ii] *= Cst::to_rad;
+	}
+	proj4Transform("+proj=latlong +datum=WGS84 +ellps=WGS84", "+init=epsg:"+coordparam, east_out, north_out);
+#elif defined(PROJ)
+	projTransform("+proj=longlat +datum=WGS84 +no_defs", "EPSG:"+coordparam, east_out, north_out);
+#else
+	(void)coordparam;
+	throw IOException("Not compiled with PROJ support", AT);
+#endif
+}
+
+/**
+* @brief Coordinate conversion: from proj parameters to WGS84 Lat/Long, for many points at once
+* @details The projection is only initialized once for all the points, so this is much faster than converting
+* the points one by one.
+* @param[in] east_in easting coordinates
+* @param[in] north_in northing coordinates
+* @param[in] coordparam Extra parameters necessary for the conversion (such as UTM zone, etc)
+* @param[out] lat_out Decimal Latitudes
+* @param[out] long_out Decimal Longitudes
+*/
+void CoordsAlgorithms::PROJ_to_WGS84(const std::vector<double>& east_in, const std::vector<double>& north_in, const std::string& coordparam, std::vector<double>& lat_out, std::vector<double>& long_out)
+{
+	if (east_in.size()!=north_in.size())
+		throw InvalidArgumentException("The eastings and northings must have the same number of points", AT);
+	long_out = east_in;
+	lat_out = north_in;
+	if (long_out.empty()) return;
+
+#if defined(PROJ4)
+	proj4Transform("+init=epsg:"+coordparam, "+proj=latlong +datum=WGS84 +ellps=WGS84", long_out, lat_out);
+	for (size_t ii=0; ii<long_out.size(); ii++) {
+		long_out[ii] *= RAD_TO_DEG;
+		lat_out[ii] *= RAD_TO_DEG;
+	}
+#elif defined(PROJ)
+	projTransform("EPSG:"+coordparam, "+proj=longlat +datum=WGS84 +no_defs", long_out, lat_out);
+#else
+	(void)coordparam;
+	throw IOException("Not compiled with PROJ support", AT);
+#endif
+}
+
 /**
 * @brief Spherical law of cosine Distance calculation between points in WGS84 (decimal Lat/Long)
 * See http://www.movable-type.co.uk/scripts/latlong.html for more
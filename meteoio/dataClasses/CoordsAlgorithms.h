@@ -20,6 +20,7 @@
 #define COORDSALGORITHMS_H
 
 #include <string>
+#include <vector>
 
 namespace mio {
 /**
@@ -86,6 +87,8 @@ public:
 	static void UPS_to_WGS84(const double& east_in, const double& north_in, const std::string& coordparam, double& lat_out, double& long_out);
 	static void WGS84_to_PROJ(const double& lat_in, const double& long_in, const std::string& coordparam, double& east_out, double& north_out);
 	static void PROJ_to_WGS84(const double& east_in, const double& north_in, const std::string& coordparam, double& lat_out, double& long_out);
+	static void WGS84_to_PROJ(const std::vector<double>& lat_in, const std::vector<double>& long_in, const std::string& coordparam, std::vector<double>& east_out, std::vector<double>& north_out);
+	static void PROJ_to_WGS84(const std::vector<double>& east_in, const std::vector<double>& north_in, const std::string& coordparam, std::vector<double>& lat_out, std::vector<double>& long_out);
 
 	static int getUTMZone(const double& latitude, const double& longitude, std::string& zone_out);
 	static void parseUTMZone(const std::string& zone_info, char& zoneLetter, short int& zoneNumber);
@@ -22,6 +22,7 @@
 #include <iomanip>
 #include <iostream>
 #include <ctime>
+#include <limits>
 
 #include <meteoio/dataClasses/Date.h>
 #include <meteoio/IOUtils.h>
@@ -1123,8 +1124,14 @@ const string Date::toString(const FORMATS& type, const bool& gmt) const
 		throw UnknownValueException("Date object is undefined!", AT);
 		//return std::string("[Undef]"); //for debug purposes
 	
+	if (type!=FULL && type!=ISO_WEEK) {
+		char buffer[max_chars];
+		const size_t len = toChars(buffer, type, gmt);
+		return std::string(buffer, len);
+	}
+
 	//the date are displayed in LOCAL timezone (more user friendly)
-	const double julian_out = (gmt || (type==ISO_Z))? gmt_julian : GMTToLocal(gmt_julian);
+	const double julian_out = (gmt)? gmt_julian : GMTToLocal(gmt_julian);
 	int year_out, month_out, day_out, hour_out, minute_out;
 	double second_out;
 	calculateValues(julian_out, year_out, month_out, day_out, hour_out, minute_out, second_out);
@@ -1139,48 +1146,6 @@ const string Date::toString(const FORMATS& type, const bool& gmt) const
 
 	std::ostringstream tmpstr;
 	switch(type) {
-		case(ISO_TZ):
-		case(ISO_Z):
-		case(ISO):
-			tmpstr
-			<< ( (year_out < 0) ? ("-") : ("") ) << setw(4) << setfill('0') << abs(year_out) << "-"
-			<< setw(2) << setfill('0') << month_out << "-"
-			<< setw(2) << setfill('0') << day_out << "T"
-			<< setw(2) << setfill('0') << hour_out << ":"
-			<< setw(2) << setfill('0') << minute_out << ":"
-			<< setw(2) << setfill('0') << whole_sec << subsec_str;
-			if (type==ISO_Z) {
-				tmpstr << "Z";
-			} else if (type==ISO_TZ) {
-				int tz_h, tz_min;
-				if (timezone>=0.) {
-					tz_h = static_cast<int>(timezone);
-					tz_min = static_cast<int>( (timezone - (double)tz_h)*60. + .5 ); //round to closest
-					tmpstr << "+";
-				} else {
-					tz_h = -static_cast<int>(timezone);
-					tz_min = -static_cast<int>( (timezone + (double)tz_h)*60. + .5 ); //round to closest
-					tmpstr << "-";
-				}
-				tmpstr << setw(2) << setfill('0') << tz_h << ":"
-				<< setw(2) << setfill('0') << tz_min;
-			}
-			break;
-		case(ISO_DATE):
-			tmpstr
-			<< ( (year_out < 0) ? ("-") : ("") ) << setw(4) << setfill('0') << abs(year_out) << "-"
-			<< setw(2) << setfill('0') << month_out << "-"
-			<< setw(2) << setfill('0') << day_out;
-			break;
-		case(NUM):
-			tmpstr
-			<< ( (year_out < 0) ? ("-") : ("") ) << setw(4) << setfill('0') << abs(year_out)
-			<< setw(2) << setfill('0') << month_out
-			<< setw(2) << setfill('0') << day_out
-			<< setw(2) << setfill('0') << hour_out
-			<< setw(2) << setfill('0') << minute_out
-			<< setw(2) << setfill('0') << whole_sec;
-			break;
 		case(FULL):
 			tmpstr
 			<< ( (year_out < 0) ? ("-") : ("") ) << setw(4) << setfill('0') << abs(year_out) << "-"
@@ -1192,15 +1157,6 @@ const string Date::toString(const FORMATS& type, const bool& gmt) const
 			<< setprecision(10) << julian_out << ") GMT"
 			<< setw(2) << setfill('0') << showpos << timezone << noshowpos;
 			break;
-		case(DIN):
-			tmpstr
-			<< setw(2) << setfill('0') << day_out << "."
-			<< setw(2) << setfill('0') << month_out << "."
-			<< ( (year_out < 0) ? ("-") : ("") ) << setw(4) << setfill('0') << abs(year_out) << " "
-			<< setw(2) << setfill('0') << hour_out << ":"
-			<< setw(2) << setfill('0') << minute_out << ":"
-			<< setw(2) << setfill('0') << whole_sec << subsec_str;
-			break;
 		case(ISO_WEEK):
 		{
 			int ISO_year;
@@ -1218,6 +1174,123 @@ const string Date::toString(const FORMATS& type, const bool& gmt) const
 	return tmpstr.str();
 }
 
+//write a zero padded positive integer, return the position after its last character
+static char* writeInt(char* pos, long value, const int& width)
+{
+	char digits[24];
+	int nr_digits = 0;
+	do {
+		digits[nr_digits++] = static_cast<char>('0' + value%10);
+		value /= 10;
+	} while (value>0);
+	while (nr_digits<width) digits[nr_digits++] = '0';
+	while (nr_digits>0) *pos++ = digits[--nr_digits];
+	return pos;
+}
+
+static char* writeYear(char* pos, const int& year)
+{
+	if (year<0) *pos++ = '-';
+	return writeInt(pos, std::abs(static_cast<long>(year)), 4);
+}
+
+/**
+* @brief Write a formatted date into a buffer, without any memory allocation.
+* @details This produces exactly the same output as toString() but only supports the ISO, ISO_TZ, ISO_Z, ISO_DATE, NUM and DIN
+* formats. This is meant for writing large numbers of timestamps.
+* @param buffer buffer to write into, it must be at least Date::max_chars long. The string is null terminated.
+* @param type select the formating to apply (see the definition of Date::FORMATS)
+* @param gmt convert returned value to GMT? (default: false)
+* @return number of characters written (not counting the terminating null character)
+*/
+size_t Date::toChars(char* buffer, const FORMATS& type, const bool& gmt) const
+{
+	if (undef==true)
+		throw UnknownValueException("Date object is undefined!", AT);
+
+	//the date are displayed in LOCAL timezone (more user friendly)
+	const double julian_out = (gmt || (type==ISO_Z))? gmt_julian : GMTToLocal(gmt_julian);
+	int year_out, month_out, day_out, hour_out, minute_out;
+	double second_out;
+	calculateValues(julian_out, year_out, month_out, day_out, hour_out, minute_out, second_out);
+	double whole_sec;
+	const double subseconds = modf( second_out, &whole_sec);
+	const bool has_subsec = (subseconds>=5e-4); //to be consistent with the resolution below
+	const long sec_out = static_cast<long>(whole_sec);
+
+	char *pos = buffer;
+	switch(type) {
+		case(ISO_TZ):
+		case(ISO_Z):
+		case(ISO):
+		case(ISO_DATE):
+			pos = writeYear(pos, year_out);
+			*pos++ = '-';
+			pos = writeInt(pos, month_out, 2);
+			*pos++ = '-';
+			pos = writeInt(pos, day_out, 2);
+			if (type==ISO_DATE) break;
+			*pos++ = 'T';
+			pos = writeInt(pos, hour_out, 2);
+			*pos++ = ':';
+			pos = writeInt(pos, minute_out, 2);
+			*pos++ = ':';
+			pos = writeInt(pos, sec_out, 2);
+			if (has_subsec) {
+				*pos++ = '.';
+				pos = writeInt(pos, static_cast<int>(subseconds*1000. + .5), 3);
+			}
+			if (type==ISO_Z) {
+				*pos++ = 'Z';
+			} else if (type==ISO_TZ) {
+				int tz_h, tz_min;
+				if (timezone>=0.) {
+					tz_h = static_cast<int>(timezone);
+					tz_min = static_cast<int>( (timezone - (double)tz_h)*60. + .5 ); //round to closest
+					*pos++ = '+';
+				} else {
+					tz_h = -static_cast<int>(timezone);
+					tz_min = static_cast<int>( (-timezone - (double)tz_h)*60. + .5 ); //round to closest
+					*pos++ = '-';
+				}
+				pos = writeInt(pos, tz_h, 2);
+				*pos++ = ':';
+				pos = writeInt(pos, tz_min, 2);
+			}
+			break;
+		case(NUM):
+			pos = writeYear(pos, year_out);
+			pos = writeInt(pos, month_out, 2);
+			pos = writeInt(pos, day_out, 2);
+			pos = writeInt(pos, hour_out, 2);
+			pos = writeInt(pos, minute_out, 2);
+			pos = writeInt(pos, sec_out, 2);
+			break;
+		case(DIN):
+			pos = writeInt(pos, day_out, 2);
+			*pos++ = '.';
+			pos = writeInt(pos, month_out, 2);
+			*pos++ = '.';
+			pos = writeYear(pos, year_out);
+			*pos++ = ' ';
+			pos = writeInt(pos, hour_out, 2);
+			*pos++ = ':';
+			pos = writeInt(pos, minute_out, 2);
+			*pos++ = ':';
+			pos = writeInt(pos, sec_out, 2);
+			if (has_subsec) {
+				*pos++ = '.';
+				pos = writeInt(pos, static_cast<int>(subseconds*1000. + .5), 3);
+			}
+			break;
+		default:
+			throw InvalidFormatException("Unsupported time format", AT);
+	}
+
+	*pos = '\0';
+	return static_cast<size_t>(pos - buffer);
+}
+
 const std::string Date::toString() const {
 	std::ostringstream os;
 	os << "<date>\n";
@@ -1275,10 +1348,21 @@ double Date::calculateJulianDate(const int& i_year, const int& i_month, const in
  */
 void Date::calculateDate(const double& i_julian, int& o_year, int& o_month, int& o_day)
 {
+	//consecutive timestamps mostly fall on the same day, so the last conversion is kept (one per thread, so no locking is required)
+	static thread_local long cached_julday = std::numeric_limits<long>::min();
+	static thread_local int cached_year = 0, cached_month = 0, cached_day = 0;
+
 	//we round the given julian date to our current resolution
 	const double tmp_julian = rnd(i_julian, epsilon_sec);
 
 	const long julday = Optim::floor(tmp_julian+0.5);
+	if (julday==cached_julday) {
+		o_year = cached_year;
+		o_month = cached_month;
+		o_day = cached_day;
+		return;
+	}
+
 	long t1 = julday + 68569L;
 	const long t2 = 4L * t1 / 146097L;
 	t1 = t1 - ( 146097L * t2 + 3L ) / 4L;
@@ -1293,6 +1377,11 @@ void Date::calculateDate(const double& i_julian, int& o_year, int& o_month, int&
 
 	// Correct for BC years -> astronomical year, that is from year -1 to year 0
 	if ( o_year <= 0 ) o_year--;
+
+	cached_julday = julday;
+	cached_year = o_year;
+	cached_month = o_month;
+	cached_day = o_day;
 }
 
 /**
@@ -112,6 +112,7 @@ class Date {
 		static const double Excel_offset;
 		static const double Matlab_offset;
 		static const double epsilon_sec;
+		static const size_t max_chars = 80; ///< size of the buffers to provide to toChars()
 
 		Date();
 		Date(const double& in_timezone);
@@ -176,6 +177,7 @@ class Date {
 
 		static std::string printFractionalDay(const double& fractional);
 		const std::string toString(const FORMATS& type, const bool& gmt=false) const;
+		size_t toChars(char* buffer, const FORMATS& type, const bool& gmt=false) const;
 		const std::string toString() const;
 		friend std::ostream& operator<<(std::ostream& os, const Date& date);
 		friend std::istream& operator>>(std::istream& is, Date& date);
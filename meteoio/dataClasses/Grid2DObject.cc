@@ -21,8 +21,11 @@
 #include <meteoio/IOExceptions.h>
 #include <meteoio/IOUtils.h>
 #include <meteoio/MathOptim.h>
+#include <meteoio/meteoLaws/Meteoconst.h>
 #include <meteoio/meteoStats/libresampling2D.h>
 #include <cmath>
+#include <exception>
+#include <algorithm>
 
 using namespace std;
 
@@ -559,9 +562,207 @@ double Grid2DObject::calculate_cellsize(const double& i_ur_lat, const double& i_
 	return std::min(cellsize_x, cellsize_y);
 }
 
-void Grid2DObject::reproject()
+//fractional indices within a lat/lon grid of points given in the projection of ref, all converted at once (nodata if they can not be converted)
+static void latlonIndices(const Coords& ref, const std::vector<double>& vecEasting, const std::vector<double>& vecNorthing, const double& ll_lat, const double& ll_lon, const double& dlat, const double& dlon, std::vector<double>& fi, std::vector<double>& fj)
 {
-	cellsize = calculate_cellsize(ur_lat, ur_lon);
+	ref.xyToLatLon(vecEasting, vecNorthing, fj, fi);
+	for (size_t ii=0; ii<fi.size(); ii++) {
+		if (fi[ii]==IOUtils::nodata || fj[ii]==IOUtils::nodata) {
+			fi[ii] = fj[ii] = IOUtils::nodata;
+			continue;
+		}
+		fi[ii] = (fi[ii] - ll_lon) / dlon;
+		fj[ii] = (fj[ii] - ll_lat) / dlat;
+	}
+}
+
+/**
+* @brief Compute which cells of a lat/lon grid contribute to each cell of its cartesian counterpart
+* @details The cartesian grid is defined in the projection of the source grid's lower left corner, with the cell size
+* given by calculate_cellsize() and an extent that covers the whole source grid (the target cells that fall outside
+* of the source grid are set to nodata). All the coordinates are converted at once (see Coords::xyToLatLon()).
+* Since this only depends on the source grid's geometry, the result can be reused for all the grids sharing
+* this geometry (see reproject(const ReprojectionMap&)).
+* @param source lat/lon grid to reproject
+* @param method how to compute the values of the target cells
+* @return source cells and weights for each target cell
+*/
+Grid2DObject::ReprojectionMap Grid2DObject::computeReprojectionMap(const Grid2DObject& source, const ReprojectionMethod& method)
+{
+	if (!source.isLatLon || source.ur_lat==IOUtils::nodata || source.ur_lon==IOUtils::nodata)
+		throw InvalidArgumentException("Only lat/lon grids can be reprojected", AT);
+	const size_t src_nx = source.getNx(), src_ny = source.getNy();
+	if (src_nx<2 || src_ny<2)
+		throw InvalidArgumentException("Can not reproject a grid with less than two cells along each axis", AT);
+
+	const double ll_lat = source.llcorner.getLat();
+	const double ll_lon = source.llcorner.getLon();
+	const double dlat = (source.ur_lat - ll_lat) / static_cast<double>(src_ny-1);
+	const double dlon = (source.ur_lon - ll_lon) / static_cast<double>(src_nx-1);
+
+	ReprojectionMap rmap;
+	rmap.src_ncols = src_nx;
+	rmap.src_nrows = src_ny;
+	rmap.cellsize = source.calculate_cellsize(source.ur_lat, source.ur_lon);
+
+	//the extent of the target grid is given by the outline of the source grid (its edges are not straight once projected)
+	std::vector<double> vecLat, vecLon, vecX, vecY;
+	for (size_t kk=0; kk<2*(src_nx+src_ny); kk++) {
+		const size_t ii = (kk<2*src_nx)? kk/2 : ((kk-2*src_nx)%2)*(src_nx-1);
+		const size_t jj = (kk<2*src_nx)? (kk%2)*(src_ny-1) : (kk-2*src_nx)/2;
+		vecLat.push_back( ll_lat + static_cast<double>(jj)*dlat );
+		vecLon.push_back( ll_lon + static_cast<double>(ii)*dlon );
+	}
+	source.llcorner.latLonToXY(vecLat, vecLon, vecX, vecY);
+	double xmin = Cst::dbl_max, xmax = -Cst::dbl_max, ymin = Cst::dbl_max, ymax = -Cst::dbl_max;
+	for (size_t kk=0; kk<vecX.size(); kk++) {
+		if (vecX[kk]==IOUtils::nodata || vecY[kk]==IOUtils::nodata)
+			throw InvalidArgumentException("Could not project the outline of the lat/lon grid", AT);
+		xmin = std::min(xmin, vecX[kk]);
+		xmax = std::max(xmax, vecX[kk]);
+		ymin = std::min(ymin, vecY[kk]);
+		ymax = std::max(ymax, vecY[kk]);
+	}
+	rmap.ncols = static_cast<size_t>(Optim::floor( (xmax-xmin) / rmap.cellsize + 1e-6 )) + 1;
+	rmap.nrows = static_cast<size_t>(Optim::floor( (ymax-ymin) / rmap.cellsize + 1e-6 )) + 1;
+	rmap.llcorner = source.llcorner;
+	rmap.llcorner.setXY(xmin, ymin, source.llcorner.getAltitude());
+
+	//position of the target cells' centers (or corners for CONSERVATIVE) within the source grid, all converted at once
+	const bool use_corners = (method==CONSERVATIVE);
+	const size_t nr_pts_x = (use_corners)? rmap.ncols+1 : rmap.ncols;
+	const size_t nr_pts_y = (use_corners)? rmap.nrows+1 : rmap.nrows;
+	const double offset = (use_corners)? -.5*rmap.cellsize : 0.;
+	vecX.resize( nr_pts_x*nr_pts_y );
+	vecY.resize( nr_pts_x*nr_pts_y );
+	for (size_t jj=0; jj<nr_pts_y; jj++) {
+		for (size_t ii=0; ii<nr_pts_x; ii++) {
+			vecX[ii + jj*nr_pts_x] = xmin + offset + static_cast<double>(ii) * rmap.cellsize;
+			vecY[ii + jj*nr_pts_x] = ymin + offset + static_cast<double>(jj) * rmap.cellsize;
+		}
+	}
+	std::vector<double> vecFi, vecFj;
+	latlonIndices(source.llcorner, vecX, vecY, ll_lat, ll_lon, dlat, dlon, vecFi, vecFj);
+
+	//find the contributing source cells of each target cell
+	const size_t nr_cells = rmap.ncols * rmap.nrows;
+	std::vector< std::vector< std::pair<size_t, double> > > contributions( nr_cells );
+	const double max_fi = static_cast<double>(src_nx) - .5, max_fj = static_cast<double>(src_ny) - .5;
+	std::exception_ptr error;
+#pragma omp parallel for schedule(static)
+	for (int kk=0; kk<static_cast<int>(nr_cells); kk++) {
+		try {
+			const size_t col = static_cast<size_t>(kk) % rmap.ncols, row = static_cast<size_t>(kk) / rmap.ncols;
+			std::vector< std::pair<size_t, double> >& cell = contributions[kk];
+
+			if (method==CONSERVATIVE) {
+				//footprint of the target cell in the source grid, approximated by the bounding box of its corners
+				double fi_min = Cst::dbl_max, fi_max = -Cst::dbl_max, fj_min = Cst::dbl_max, fj_max = -Cst::dbl_max;
+				bool valid = true;
+				for (size_t corner=0; corner<4; corner++) {
+					const size_t idx = (col + corner%2) + (row + corner/2)*nr_pts_x;
+					if (vecFi[idx]==IOUtils::nodata) valid = false;
+					fi_min = std::min(fi_min, vecFi[idx]);
+					fi_max = std::max(fi_max, vecFi[idx]);
+					fj_min = std::min(fj_min, vecFj[idx]);
+					fj_max = std::max(fj_max, vecFj[idx]);
+				}
+				if (!valid || fi_max<=-.5 || fi_min>=max_fi || fj_max<=-.5 || fj_min>=max_fj) continue;
+				const size_t i_start = static_cast<size_t>(std::max(0L, Optim::floor(fi_min + .5)));
+				const size_t i_end = std::min(src_nx-1, static_cast<size_t>(Optim::floor(fi_max + .5)));
+				const size_t j_start = static_cast<size_t>(std::max(0L, Optim::floor(fj_min + .5)));
+				const size_t j_end = std::min(src_ny-1, static_cast<size_t>(Optim::floor(fj_max + .5)));
+				for (size_t jj=j_start; jj<=j_end; jj++) {
+					const double overlap_y = std::min(fj_max, static_cast<double>(jj)+.5) - std::max(fj_min, static_cast<double>(jj)-.5);
+					if (overlap_y<=0.) continue;
+					for (size_t ii=i_start; ii<=i_end; ii++) {
+						const double overlap_x = std::min(fi_max, static_cast<double>(ii)+.5) - std::max(fi_min, static_cast<double>(ii)-.5);
+						if (overlap_x>0.) cell.push_back( std::make_pair(ii + jj*src_nx, overlap_x*overlap_y) );
+					}
+				}
+				continue;
+			}
+
+			double fi = vecFi[kk], fj = vecFj[kk];
+			if (fi==IOUtils::nodata || fi<-.5 || fi>=max_fi || fj<-.5 || fj>=max_fj) continue; //outside of the source grid
+
+			if (method==NEAREST) {
+				const size_t ii = static_cast<size_t>(Optim::floor(fi + .5));
+				const size_t jj = static_cast<size_t>(Optim::floor(fj + .5));
+				cell.push_back( std::make_pair(ii + jj*src_nx, 1.) );
+			} else { //BILINEAR, the half cells along the edges get the values of the edges
+				fi = std::min(std::max(fi, 0.), static_cast<double>(src_nx-1));
+				fj = std::min(std::max(fj, 0.), static_cast<double>(src_ny-1));
+				const size_t i0 = std::min(static_cast<size_t>(fi), src_nx-2);
+				const size_t j0 = std::min(static_cast<size_t>(fj), src_ny-2);
+				const double wx = fi - static_cast<double>(i0);
+				const double wy = fj - static_cast<double>(j0);
+				const double weights[4] = {(1.-wx)*(1.-wy), wx*(1.-wy), (1.-wx)*wy, wx*wy};
+				for (size_t corner=0; corner<4; corner++) {
+					if (weights[corner]>0.) cell.push_back( std::make_pair((i0 + corner%2) + (j0 + corner/2)*src_nx, weights[corner]) );
+				}
+			}
+		} catch (...) { //exceptions can not cross the parallel region
+#pragma omp critical(reprojection_error)
+			if (!error) error = std::current_exception();
+		}
+	}
+	if (error) std::rethrow_exception( error );
+
+	rmap.offsets.resize(nr_cells + 1);
+	for (size_t kk=0; kk<nr_cells; kk++) {
+		rmap.offsets[kk] = rmap.indices.size();
+		for (const std::pair<size_t, double>& contribution : contributions[kk]) {
+			rmap.indices.push_back( contribution.first );
+			rmap.weights.push_back( contribution.second );
+		}
+	}
+	rmap.offsets[nr_cells] = rmap.indices.size();
+
+	return rmap;
+}
+
+/**
+* @brief Reproject a lat/lon grid onto a cartesian grid with a precomputed map
+* @details Each target cell is the weighted average of its contributing source cells, ignoring the nodata cells.
+* @param rmap source cells and weights for each target cell, as computed by computeReprojectionMap() on a grid with the same geometry
+*/
+void Grid2DObject::reproject(const ReprojectionMap& rmap)
+{
+	if (getNx()!=rmap.src_ncols || getNy()!=rmap.src_nrows)
+		throw InvalidArgumentException("The reprojection map does not match the grid's dimensions", AT);
+
+	Array2D<double> target(rmap.ncols, rmap.nrows, IOUtils::nodata);
+	const int nr_cells = static_cast<int>( target.size() );
+#pragma omp parallel for schedule(static)
+	for (int kk=0; kk<nr_cells; kk++) {
+		double sum = 0., sum_weights = 0.;
+		for (size_t ll=rmap.offsets[kk]; ll<rmap.offsets[kk+1]; ll++) {
+			const double value = grid2D(rmap.indices[ll]);
+			if (value==IOUtils::nodata) continue;
+			sum += rmap.weights[ll] * value;
+			sum_weights += rmap.weights[ll];
+		}
+		if (sum_weights>0.) target(static_cast<size_t>(kk)) = sum / sum_weights;
+	}
+
+	grid2D = target;
+	llcorner = rmap.llcorner;
+	cellsize = rmap.cellsize;
+	ur_lat = IOUtils::nodata;
+	ur_lon = IOUtils::nodata;
+	isLatLon = false;
+}
+
+/**
+* @brief Reproject a lat/lon grid onto a cartesian grid
+* @details When several grids share the same geometry, it is more efficient to compute the reprojection map once
+* with computeReprojectionMap() and then call reproject(const ReprojectionMap&) on each grid.
+* @param method how to compute the values of the target cells
+*/
+void Grid2DObject::reproject(const ReprojectionMethod& method)
+{
+	reproject( computeReprojectionMap(*this, method) );
 }
 
 double& Grid2DObject::operator()(const size_t& ix, const size_t& iy) {
@@ -50,6 +50,25 @@ class Grid2DObject {
 			size_t iy; ///<grid index along Y
 		} grid_point_2d;
 
+		///methods to reproject a lat/lon grid onto a cartesian grid
+		typedef enum REPROJECTION_METHOD {
+			NEAREST, ///< value of the source cell containing the target cell's center
+			BILINEAR, ///< bilinear interpolation between the four source cells surrounding the target cell's center
+			CONSERVATIVE ///< average of the source cells covered by the target cell, weighted by their coverage
+		} ReprojectionMethod;
+
+		///source cells (and their weights) contributing to each cell of a reprojected grid, see computeReprojectionMap()
+		typedef struct REPROJECTION_MAP {
+			REPROJECTION_MAP() : src_ncols(0), src_nrows(0), ncols(0), nrows(0), cellsize(0.), llcorner(), offsets(), indices(), weights() {}
+			size_t src_ncols, src_nrows; ///< dimensions of the source grid
+			size_t ncols, nrows; ///< dimensions of the target grid
+			double cellsize; ///< cell size of the target grid
+			Coords llcorner; ///< lower left corner of the target grid
+			std::vector<size_t> offsets; ///< for each target cell, start of its entries in indices and weights (plus one past the end)
+			std::vector<size_t> indices; ///< source cells indices
+			std::vector<double> weights; ///< source cells weights
+		} ReprojectionMap;
+
 		double& operator ()(const size_t& ix, const size_t& iy);
 		double operator ()(const size_t& ix, const size_t& iy) const;
 		double& operator ()(const size_t& i);
@@ -241,7 +260,9 @@ class Grid2DObject {
 		
 		bool isLatlon() const {return isLatLon;}
 		
-		void reproject();
+		static ReprojectionMap computeReprojectionMap(const Grid2DObject& source, const ReprojectionMethod& method);
+		void reproject(const ReprojectionMap& rmap);
+		void reproject(const ReprojectionMethod& method=BILINEAR);
 
 		static double calculate_XYcellsize(const std::vector<double>& vecX, const std::vector<double>& vecY);
 		double calculate_cellsize(const double& i_ur_lat, const double& i_ur_lon) const;
@@ -21,6 +21,8 @@
 #include <meteoio/IOUtils.h>
 #include <meteoio/IOExceptions.h>
 
+#include <Dense>
+
 #include <time.h> //needed for random()
 #include <cmath> //needed for std::abs()
 #include <iostream>
@@ -28,6 +30,24 @@
 
 namespace mio {
 
+//Eigen views on the Matrix storage, so its kernels work directly on our data without any copy
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMajorMatrix;
+typedef Eigen::Map<RowMajorMatrix> MatrixMap;
+typedef Eigen::Map<const RowMajorMatrix> ConstMatrixMap;
+
+static inline MatrixMap getMap(Matrix& m) { return MatrixMap(m.data(), static_cast<Eigen::Index>(m.getNy()), static_cast<Eigen::Index>(m.getNx())); }
+static inline ConstMatrixMap getMap(const Matrix& m) { return ConstMatrixMap(m.data(), static_cast<Eigen::Index>(m.getNy()), static_cast<Eigen::Index>(m.getNx())); }
+
+//the LU decomposition with partial pivoting fails if one of the pivots is (almost) zero
+static bool isSingular(const Eigen::PartialPivLU<RowMajorMatrix>& lu)
+{
+	const RowMajorMatrix& LU = lu.matrixLU();
+	for (Eigen::Index ii=0; ii<LU.rows(); ii++) {
+		if (IOUtils::checkEpsilonEquality(LU(ii,ii), 0., Matrix::epsilon)) return true;
+	}
+	return false;
+}
+
 /*
  * Sketch of the matrix class with proposed indexing:
  *
@@ -68,6 +88,17 @@ void Matrix::identity(const size_t& n, const double& init)
 	for (size_t ii=1; ii<=n; ii++) operator()(ii,ii) = init;
 }
 
+Matrix& Matrix::operator=(Matrix&& source) noexcept
+{
+	if (this != &source) {
+		vecData = std::move(source.vecData);
+		ncols = source.ncols;
+		nrows = source.nrows;
+		source.ncols = source.nrows = 0;
+	}
+	return *this;
+}
+
 void Matrix::resize(const size_t& rows, const size_t& cols)
 {
 	clear();
@@ -287,32 +318,45 @@ Matrix& Matrix::operator*=(const Matrix& rhs)
 		throw IOException(tmp.str(), AT);
 	}
 
-	//create new matrix
-	Matrix result(nrows, rhs.ncols);
-
-	//fill product matrix
-	for (size_t ii=1; ii<=result.nrows; ii++) {
-		for (size_t jj=1; jj<=result.ncols; jj++) {
-			double sum=0.;
-			for (size_t idx=1; idx<=ncols; idx++) {
-				sum += operator()(ii,idx) * rhs(idx,jj);
-			}
-			result(ii,jj) = sum;
-		}
-	}
-
-	*this = result;
+	Matrix result;
+	mult_into(*this, rhs, result);
+	*this = std::move(result);
 	return *this;
 }
 
 const Matrix Matrix::operator*(const Matrix& rhs) const
 {
-	Matrix result = *this;
-	result *= rhs; //already implemented
-
+	Matrix result;
+	mult_into(*this, rhs, result);
 	return result;
 }
 
+void Matrix::mult_into(const Matrix& A, const Matrix& B, Matrix& C, const bool& transpose_A, const bool& transpose_B)
+{
+	const size_t A_rows = (transpose_A)? A.ncols : A.nrows;
+	const size_t A_cols = (transpose_A)? A.nrows : A.ncols;
+	const size_t B_rows = (transpose_B)? B.ncols : B.nrows;
+	const size_t B_cols = (transpose_B)? B.nrows : B.ncols;
+	if (A_cols!=B_rows) {
+		std::ostringstream tmp;
+		tmp << "Trying to multiply two matrices with incompatible dimensions: ";
+		tmp << "(" << A_rows << "," << A_cols << ") * ";
+		tmp << "(" << B_rows << "," << B_cols << ")";
+		throw IOException(tmp.str(), AT);
+	}
+	if (&C==&A || &C==&B)
+		throw InvalidArgumentException("The result of a matrix product can not be written into one of its operands", AT);
+
+	if (C.nrows!=A_rows || C.ncols!=B_cols) C.resize(A_rows, B_cols);
+	MatrixMap result( getMap(C) );
+	const ConstMatrixMap lhs( getMap(A) ), rhs( getMap(B) );
+
+	if (!transpose_A && !transpose_B) result.noalias() = lhs * rhs;
+	else if (transpose_A && !transpose_B) result.noalias() = lhs.transpose() * rhs;
+	else if (!transpose_A && transpose_B) result.noalias() = lhs * rhs.transpose();
+	else result.noalias() = lhs.transpose() * rhs.transpose();
+}
+
 Matrix& Matrix::operator*=(const double& rhs)
 {
 	for (size_t ii=0; ii<vecData.size(); ii++)
@@ -380,12 +424,7 @@ double Matrix::dot(const Matrix& A, const Matrix& B)
 		throw IOException(tmp.str(), AT);
 	}
 
-	double sum=0.;
-	for (size_t ii=1; ii<=Arows; ii++) {
-		sum += A(ii,1)*B(ii,1);
-	}
-
-	return sum;
+	return getMap(A).col(0).dot( getMap(B).col(0) );
 }
 
 Matrix Matrix::T(const Matrix& m)
@@ -396,18 +435,34 @@ Matrix Matrix::T(const Matrix& m)
 Matrix Matrix::getT() const
 {
 	Matrix result(ncols, nrows);
-	for (size_t ii=1; ii<=result.nrows; ii++) {
-		for (size_t jj=1; jj<=result.ncols; jj++) {
-			result(ii,jj) = operator()(jj,ii);
-		}
-	}
+	getMap(result) = getMap(*this).transpose();
 	return result;
 }
 
 void Matrix::T()
 {
-	Matrix tmp(*this);
-	*this = tmp.getT();
+	if (nrows==ncols) {
+		getMap(*this).transposeInPlace();
+	} else {
+		*this = getT();
+	}
+}
+
+bool Matrix::LLT_solve(Matrix& A, Matrix& B)
+{ //in place Cholesky decomposition A = L·L^T, L being stored in the lower triangle of A
+	if (A.nrows!=A.ncols)
+		throw IOException("Trying to solve A·X=B for non-square matrix A.", AT);
+	if (A.nrows!=B.nrows)
+		throw IOException("Trying to solve A·X=B, but the dimensions of A and B do not match.", AT);
+
+	MatrixMap A_map( getMap(A) );
+	Eigen::Ref<RowMajorMatrix> A_ref( A_map );
+	const Eigen::LLT< Eigen::Ref<RowMajorMatrix> > llt( A_ref );
+	if (llt.info()!=Eigen::Success) return false; //A is not positive definite
+
+	MatrixMap X( getMap(B) );
+	llt.solveInPlace( X );
+	return true;
 }
 
 double Matrix::det() const
@@ -418,13 +473,9 @@ double Matrix::det() const
 		tmp << "(" << nrows << "," << ncols << ") !";
 		throw IOException(tmp.str(), AT);
 	}
-	Matrix L,U;
-	if (LU(L,U)==false) return 0.;
-
-	double product=1.;
-	for (size_t ii=1; ii<=nrows; ii++) product *= U(ii,ii);
+	if (nrows==0) return 1.;
 
-	return product;
+	return getMap(*this).partialPivLu().determinant();
 }
 
 bool Matrix::LU(Matrix& L, Matrix& U) const
@@ -469,54 +520,9 @@ Matrix Matrix::getInv() const
 {
 //This uses an LU decomposition followed by backward and forward solving for the inverse
 //See for example Press, William H.; Flannery, Brian P.; Teukolsky, Saul A.; Vetterling, William T. (1992), "LU Decomposition and Its Applications", Numerical Recipes in FORTRAN: The Art of Scientific Computing (2nd ed.), Cambridge University Press, pp. 34–42
-	if (nrows!=ncols) {
-		std::ostringstream tmp;
-		tmp << "Trying to invert a non-square matrix ";
-		tmp << "(" << nrows << "," << ncols << ") !";
-		throw IOException(tmp.str(), AT);
-	}
-	const size_t n = nrows;
-
-	Matrix U;
-	Matrix L;
-	if (LU(L, U)==false) {
-		throw IOException("LU decomposition of given matrix not possible", AT);
-	}
-
-	//we solve AX=I with X=A-1. Since A=LU, then LUX = I
-	//we start by forward solving LY=I with Y=UX
-	Matrix Y(n, n);
-	for (size_t ii=1; ii<=n; ii++) {
-		if (IOUtils::checkEpsilonEquality(L(ii,ii), 0., epsilon)) {
-			throw IOException("The given matrix can not be inverted", AT);
-		}
-		Y(ii,ii) = 1./L(ii,ii); //jj==ii
-		for (size_t jj=1; jj<ii; jj++) { //jj<ii
-			double sum=0.;
-			for (size_t kk=ii-1; kk>=1; kk--) { //equivalent to 1 -> ii-1
-				sum += L(ii,kk) * Y(kk,jj);
-			}
-			Y(ii,jj) = -1./L(ii,ii) * sum;
-		}
-		for (size_t jj=ii+1; jj<=n; jj++) { //jj>i
-			Y(ii,jj) = 0.;
-		}
-	}
-
-	//now, we backward solve UX=Y
-	Matrix X(n,n);
-	for (size_t ii=n; ii>=1; ii--) { //lines
-		if (IOUtils::checkEpsilonEquality(U(ii,ii), 0., epsilon)) { //HACK: actually, only U(n,n) needs checking
-			throw IOException("The given matrix is singular and can not be inverted", AT);
-		}
-		for (size_t jj=1; jj<=n; jj++) { //lines
-			double sum=0.;
-			for (size_t kk=ii+1; kk<=n; kk++) {
-				sum += U(ii,kk) * X(kk,jj);
-			}
-			X(ii,jj) = (Y(ii,jj) - sum) / U(ii,ii);
-		}
-	}
+	Matrix X( *this );
+	if (!X.inv())
+		throw IOException("The given matrix is singular and can not be inverted", AT);
 
 	return X;
 }
@@ -530,49 +536,12 @@ bool Matrix::inv()
 		tmp << "(" << nrows << "," << ncols << ") !";
 		throw IOException(tmp.str(), AT);
 	}
-	const size_t n = nrows;
 
-	Matrix U;
-	Matrix L;
-	if (LU(L, U)==false) {
-		return false;
-	}
-
-	//we solve AX=I with X=A-1. Since A=LU, then LUX = I
-	//we start by forward solving LY=I with Y=UX
-	Matrix Y(n, n);
-	for (size_t ii=1; ii<=n; ii++) {
-		if (IOUtils::checkEpsilonEquality(L(ii,ii), 0., epsilon)) {
-			return false;
-		}
-		Y(ii,ii) = 1./L(ii,ii); //jj==ii
-		for (size_t jj=1; jj<ii; jj++) { //jj<ii
-			double sum=0.;
-			for (size_t kk=ii-1; kk>=1; kk--) { //equivalent to 1 -> ii-1
-				sum += L(ii,kk) * Y(kk,jj);
-			}
-			Y(ii,jj) = -1./L(ii,ii) * sum;
-		}
-		for (size_t jj=ii+1; jj<=n; jj++) { //jj>ii
-			Y(ii,jj) = 0.;
-		}
-	}
-
-	//now, we backward solve UX=Y
-	Matrix& X = *this; //we write the solution over the input matrix
-	for (size_t ii=n; ii>=1; ii--) { //lines
-		if (IOUtils::checkEpsilonEquality(U(ii,ii), 0., epsilon)) { //actually, only U(n,n) needs checking
-			return false;
-		}
-		for (size_t jj=1; jj<=n; jj++) { //lines
-			double sum=0.;
-			for (size_t kk=ii+1; kk<=n; kk++) {
-				sum += U(ii,kk) * X(kk,jj);
-			}
-			X(ii,jj) = (Y(ii,jj) - sum) / U(ii,ii);
-		}
-	}
+	MatrixMap X( getMap(*this) );
+	const Eigen::PartialPivLU<RowMajorMatrix> lu( X );
+	if (isSingular(lu)) return false;
 
+	X = lu.inverse();
 	return true;
 }
 
@@ -587,7 +556,7 @@ Matrix Matrix::getRow(const size_t ii) const
 #endif
 	Matrix mRet((size_t)1, ncols);
 	for (size_t jj=0; jj<ncols; jj++) {
-		mRet(1, jj+1) = vecData[(ii-1)*nrows+jj];
+		mRet(1, jj+1) = vecData[(ii-1)*ncols+jj];
 	}
 	return mRet;
 }
@@ -607,7 +576,7 @@ void Matrix::setRow(const size_t ii, const Matrix& row)
 	}
 #endif
 	for (size_t jj=0; jj<ncols; jj++) {
-		vecData[(ii-1)*nrows+jj] = row(1, jj+1);
+		vecData[(ii-1)*ncols+jj] = row(1, jj+1);
 	}
 }
 
@@ -642,7 +611,7 @@ void Matrix::setCol(const size_t jj, const Matrix& col)
 	}
 #endif
 	for (size_t ii=0; ii<nrows; ii++) {
-		vecData[(jj-1)*ncols+ii] = col(ii+1, 1);
+		vecData[(jj-1)+ii*ncols] = col(ii+1, 1);
 	}
 }
 
@@ -679,7 +648,7 @@ Matrix Matrix::extract(size_t r_low, size_t r_high, size_t c_low, size_t c_high)
 	return mRet;
 }
 
-bool Matrix::solve(const Matrix& A, const Matrix& B, Matrix& X)
+bool Matrix::solve_into(const Matrix& A, const Matrix& B, Matrix& X)
 {
 //This uses an LU decomposition followed by backward and forward solving for A·X=B
 	size_t Anrows,Ancols, Bnrows, Bncols;
@@ -698,47 +667,14 @@ bool Matrix::solve(const Matrix& A, const Matrix& B, Matrix& X)
 		tmp << "(" << Bnrows << "," << Bncols << ") !";
 		throw IOException(tmp.str(), AT);
 	}
-	const size_t nn = Anrows;
-	const size_t mm = Bncols;
-
-	Matrix U;
-	Matrix L;
-	if (A.LU(L, U)==false) {
-		return false;
-	}
+	if (&X==&A || &X==&B)
+		throw InvalidArgumentException("The solution of A·X=B can not be written into A or B", AT);
 
-	//we solve AX=B. Since A=LU, then LUX = B
-	//we start by forward solving LY=B with Y=UX
-	Matrix Y(nn, mm);
-	for (size_t ii=1; ii<=nn; ii++) {
-		if (IOUtils::checkEpsilonEquality(L(ii,ii), 0., epsilon)) {
-			return false;
-		}
-		for (size_t jj=1; jj<=mm; jj++) {
-			double sum=0.;
-			for (size_t kk=1; kk<ii; kk++) {
-				sum += L(ii,kk) * Y(kk,jj);
-			}
-			Y(ii,jj) = (B(ii,jj) - sum) / L(ii,ii);
-		}
-	}
-
-	//now, we backward solve UX=Y
-	X.resize(nn,mm); //we need to ensure that X has the correct dimensions
-	for (size_t ii=nn; ii>=1; ii--) { //lines
-		if (IOUtils::checkEpsilonEquality(U(ii,ii), 0., epsilon)) { //actually, only U(n,n) needs checking
-			//singular matrix
-			return false;
-		}
-		for (size_t jj=1; jj<=mm; jj++) {
-			double sum = 0.;
-			for (size_t kk=ii+1; kk<=nn; kk++) {
-				sum += U(ii,kk) * X(kk,jj);
-			}
-			X(ii,jj) = (Y(ii,jj) - sum) / U(ii,ii);
-		}
-	}
+	const Eigen::PartialPivLU<RowMajorMatrix> lu( getMap(A) );
+	if (isSingular(lu)) return false;
 
+	if (X.nrows!=Anrows || X.ncols!=Bncols) X.resize(Anrows, Bncols); //we need to ensure that X has the correct dimensions
+	getMap(X) = lu.solve( getMap(B) );
 	return true;
 }
 
@@ -1060,8 +996,8 @@ double Matrix::maxCoeff(size_t& max_row, size_t& max_col) const
 	max_row=max_col=1;
 	for (size_t ii=0; ii<nrows; ++ii) {
 		for (size_t jj=0; jj<ncols; ++jj) {
-			if (vecData[ii*nrows+jj] > max) {
-				max = vecData[ii*nrows+jj];
+			if (vecData[ii*ncols+jj] > max) {
+				max = vecData[ii*ncols+jj];
 				max_row = ii+1;
 				max_col = jj+1;
 			}
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <iostream>
+#include <utility>
 
 namespace mio {
 
@@ -30,9 +31,11 @@ namespace mio {
  * Elements are access in matrix notation: that is A(1,2) represents the second element of the
  * first line. Index go from 1 to nrows/ncols.
  *
- * It might not be the best ever such implementation, but the goal is to provide a standalone matrix class.
- * It might be later possible to chose between using the embedded implementation or to act as a
- * front end to BLAS for those who have it installed on their system.
+ * The data is stored contiguously, row after row. The products, inversions and solvers are delegated to the
+ * bundled <a href="https://eigen.tuxfamily.org">Eigen</a> library (that is not exposed in this header), which
+ * provides cache-blocked and vectorized kernels. In performance critical loops, the in-place operations
+ * mult_into() and solve_into() should be preferred to the arithmetic operators, since they reuse the
+ * memory of their output matrix instead of allocating temporaries.
  *
  * If the compilation flag NOSAFECHECKS is used, bounds check is turned off (leading to increased performances).
  *
@@ -74,6 +77,11 @@ class Matrix {
 		*/
 		Matrix(const size_t& rows, const size_t& cols, const std::vector<double> data) : vecData(data), ncols(cols), nrows(rows) {}
 
+		Matrix(const Matrix&) = default;
+		Matrix(Matrix&& source) noexcept : vecData(std::move(source.vecData)), ncols(source.ncols), nrows(source.nrows) {source.ncols=source.nrows=0;}
+		Matrix& operator=(const Matrix&) = default;
+		Matrix& operator=(Matrix&& source) noexcept;
+
 		/**
 		* @brief Convert the current matrix to a identity matrix of size n
 		* @param n dimension of the new square matrix
@@ -95,6 +103,13 @@ class Matrix {
 		size_t getNx() const {return ncols;}
 		size_t getNy() const {return nrows;}
 
+		/**
+		* @brief direct access to the underlying storage
+		* @return pointer to the first element, the elements being stored row after row
+		*/
+		double* data() {return vecData.data();}
+		const double* data() const {return vecData.data();}
+
 		/**
 		* @brief free the memory and set the matrix dimensions to (0,0)
 		*/
@@ -132,7 +147,7 @@ class Matrix {
 
 		/**
 		* @brief matrix invert.
-		* It first performs LU decomposition (Dolittle algorithm) and then computes the inverse by
+		* It first performs LU decomposition with partial pivoting and then computes the inverse by
 		* backward and forward solving of LU * A-1 = I. This inversion is in O(n³).
 		* see Press, William H.; Flannery, Brian P.; Teukolsky, Saul A.; Vetterling, William T. (1992), "LU Decomposition and Its Applications", Numerical Recipes in FORTRAN: The Art of Scientific Computing (2nd ed.), Cambridge University Press, pp. 34–42
 		* \image html matrix_inv.png "matrix inversion performance with the matrix dimension (running on a single core of a Intel i7-9750H)"
@@ -199,7 +214,7 @@ class Matrix {
 
 		/**
 		* @brief matrix solving for A·X=B.
-		* It first performs LU decomposition and then solves A·X=B by
+		* It first performs LU decomposition (with partial pivoting) and then solves A·X=B by
 		* backward and forward solving of LU * X = B
 		* @param A A matrix
 		* @param B B matrix
@@ -209,14 +224,36 @@ class Matrix {
 
 		/**
 		* @brief matrix solving for A·X=B.
-		* It first performs LU decomposition and then solves A·X=B by
+		* It first performs LU decomposition (with partial pivoting) and then solves A·X=B by
 		* backward and forward solving of LU * X = B
 		* @param A A matrix
 		* @param B B matrix
 		* @param X solution matrix
 		* @return true is success
 		*/
-		static bool solve(const Matrix& A, const Matrix& B, Matrix& X);
+		static bool solve(const Matrix& A, const Matrix& B, Matrix& X) {return solve_into(A, B, X);}
+
+		/**
+		* @brief matrix solving for A·X=B, writing the solution into an existing matrix.
+		* X is only reallocated if it does not already have the right dimensions.
+		* @param A A matrix
+		* @param B B matrix
+		* @param X solution matrix (must not be A or B)
+		* @return false if A is singular
+		*/
+		static bool solve_into(const Matrix& A, const Matrix& B, Matrix& X);
+
+		/**
+		* @brief matrix product C = op(A)·op(B), writing the result into an existing matrix.
+		* C is only reallocated if it does not already have the right dimensions, so calling this
+		* repeatedly with the same output matrix does not allocate any memory.
+		* @param A A matrix
+		* @param B B matrix
+		* @param C result matrix (must not be A or B)
+		* @param transpose_A use the transpose of A instead of A
+		* @param transpose_B use the transpose of B instead of B
+		*/
+		static void mult_into(const Matrix& A, const Matrix& B, Matrix& C, const bool& transpose_A=false, const bool& transpose_B=false);
 
 		/**
 		* @brief Solving system of equations using Thomas Algorithm
@@ -243,6 +280,19 @@ class Matrix {
 		*/
 		static bool TDMA_solve(const Matrix& A, const Matrix& B, Matrix& X);
 
+		/**
+		* @brief In-place solver for A·X=B when A is symmetric and positive definite (such as a covariance matrix).
+		* A is factorized as L·L^T (Cholesky decomposition, only its lower triangle is read), then the solution
+		* is obtained by forward and backward substitution. Both are computed in place, so this is suitable for small
+		* systems that are solved many times over.
+		* Attention: The original matrices are destroyed!
+		* @param[in,out] A The matrix A in A·X=B, its lower triangle being replaced by the Cholesky factor L
+		* @param[in,out] B The right hand side (vector or matrix), replaced by the solution X
+		* @return False if A is not positive definite (B is then left untouched but A has been partly overwritten),
+		* solve_into() can then be used instead
+		*/
+		static bool LLT_solve(Matrix& A, Matrix& B);
+
 		/**
 		* @brief matrix determinant
 		* @return determinant
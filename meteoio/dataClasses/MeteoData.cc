@@ -25,6 +25,7 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm> //for set_difference
+#include <iterator>
 
 using namespace std;
 namespace mio {
@@ -244,12 +245,12 @@ MeteoData::MeteoData(const Date& date_in)
            resampled(false), flags(MeteoData::nrOfParameters, zero_flag)
 { }
 
-MeteoData::MeteoData(const StationData& meta_in)
+MeteoData::MeteoData(const SharedStationData& meta_in)
          : date(0.0, 0.), meta(meta_in), extra_param_name(), data(MeteoData::nrOfParameters, IOUtils::nodata), nrOfAllParameters(MeteoData::nrOfParameters),
            resampled(false), flags(MeteoData::nrOfParameters, zero_flag)
 { }
 
-MeteoData::MeteoData(const Date& date_in, const StationData& meta_in)
+MeteoData::MeteoData(const Date& date_in, const SharedStationData& meta_in)
          : date(date_in), meta(meta_in), extra_param_name(), data(MeteoData::nrOfParameters, IOUtils::nodata), nrOfAllParameters(MeteoData::nrOfParameters),
            resampled(false), flags(MeteoData::nrOfParameters, zero_flag)
 { }
@@ -384,7 +385,7 @@ const std::string MeteoData::toString(const FORMATS format) const {
 	
 	if (format==DFLT) {
 		os << "<meteo>\n";
-		os << meta.toString();
+		os << meta->toString();
 		os << date.toString(Date::FULL) << "\n";
 		os << setw(8) << nrOfAllParameters << " parameters\n";
 
@@ -396,7 +397,7 @@ const std::string MeteoData::toString(const FORMATS format) const {
 		os << "</meteo>\n";
 	} else if (format==FULL) {
 		os << "<meteo>\n";
-		os << meta.toString();
+		os << meta->toString();
 		os << date.toString(Date::FULL) << "\n";
 		os << setw(8) << nrOfAllParameters << " parameters\n";
 
@@ -406,7 +407,7 @@ const std::string MeteoData::toString(const FORMATS format) const {
 		os << "</meteo>\n";
 	} else if (format==COMPACT) {
 		os << "<meteo>\t";
-		os << meta.stationID << " @ " << date.toString(Date::ISO) << " -> ";
+		os << meta->stationID << " @ " << date.toString(Date::ISO) << " -> ";
 		for (size_t ii=0; ii<nrOfAllParameters; ii++) {
 			const double& value = operator()(ii);
 			if (value != IOUtils::nodata)
@@ -420,7 +421,7 @@ const std::string MeteoData::toString(const FORMATS format) const {
 
 std::ostream& operator<<(std::ostream& os, const MeteoData& data) {
 	os << data.date;
-	os << data.meta;
+	os << *data.meta;
 	const size_t s_vector = data.extra_param_name.size();
 	os.write(reinterpret_cast<const char*>(&s_vector), sizeof(size_t));
 	for (size_t ii=0; ii<s_vector; ii++) {
@@ -440,7 +441,9 @@ std::ostream& operator<<(std::ostream& os, const MeteoData& data) {
 
 std::istream& operator>>(std::istream& is, MeteoData& data) {
 	is >> data.date;
-	is >> data.meta;
+	StationData meta;
+	is >> meta;
+	data.meta = meta;
 	size_t s_vector;
 	is.read(reinterpret_cast<char*>(&s_vector), sizeof(size_t));
 	data.extra_param_name.resize(s_vector);
@@ -482,6 +485,11 @@ MeteoData::Merge_Conflicts MeteoData::getMergeConflicts(std::string merge_confli
 		throw UnknownValueException("Unknown merge conflicts type '"+merge_conflicts+"'", AT);
 }
 
+static bool isBeforeDate(const MeteoData& md, const Date& date)
+{
+	return md.date<date;
+}
+
 /*
  * In the cases != STRICT_MERGE, it matters if vec2 is bigger than vec1. So we define the following indices
  * in order to store the information about the insertion positions:
@@ -539,15 +547,22 @@ size_t MeteoData::mergeTimeSeries(std::vector<MeteoData>& vec1, const std::vecto
 
 	//general case: merge one timestamp at a time
 	if (strategy==FULL_MERGE || strategy==WINDOW_MERGE) {
-		std::vector<MeteoData> tmp;
-		tmp.reserve( vec1.size() + (vec2.size() - vec1_start)); //"worst case" scenario: all elements will be added
 		MeteoData md_pattern( vec1.front() ); //This assumes that station1 is not moving!
 		md_pattern.reset(); //keep metadata and extra params
 
 		size_t idx2 = vec1_start; //all previous elements were handled before
-		size_t last_v1 = vec1_start; //last element from vec1 that will have to be invalidated
-		for(size_t ii=vec1_start; ii<vec1.size(); ii++) {
-			const Date curr_date( vec1[ii].date );
+		//the elements of vec1 before the next date of vec2 are left untouched, so we only rebuild from there on
+		size_t ii_start = vec1.size();
+		if (idx2<vec2.size()) {
+			const std::vector<MeteoData>::const_iterator it = std::lower_bound(vec1.begin()+static_cast<std::ptrdiff_t>(vec1_start), vec1.end(), vec2[idx2].date, isBeforeDate);
+			ii_start = static_cast<size_t>( std::distance(vec1.cbegin(), it) );
+		}
+
+		std::vector<MeteoData> tmp; //the merged version of vec1[ii_start, ii_end[
+		tmp.reserve( (vec1.size() - ii_start) + (vec2.size() - idx2) ); //"worst case" scenario: all elements will be added
+		size_t ii_end = ii_start;
+		for (; ii_end<vec1.size(); ii_end++) {
+			const Date curr_date( vec1[ii_end].date );
 			while ((idx2<vec2.size()) && (curr_date>vec2[idx2].date)) {
 				tmp.push_back( md_pattern );
 				tmp.back().date = vec2[idx2].date;
@@ -556,20 +571,17 @@ size_t MeteoData::mergeTimeSeries(std::vector<MeteoData>& vec1, const std::vecto
 			}
 			if (idx2==vec2.size())  break; //nothing left to merge
 
+			tmp.push_back( std::move(vec1[ii_end]) ); //vec1[ii_end] will be overwritten below
 			if (curr_date==vec2[idx2].date) {
-				if (!vec1[ii].merge( vec2[idx2], conflicts_strategy )) nr_conflicts++;
+				if (!tmp.back().merge( vec2[idx2], conflicts_strategy )) nr_conflicts++;
 				idx2++;
 			}
-			tmp.push_back( vec1[ii] );
-			last_v1 = ii;
 		}
 
-		const size_t new_count = last_v1 - vec1_start + 1;
-		if (new_count<tmp.size())
-			vec1.insert( vec1.begin() + vec1_start, tmp.size()-new_count, tmp.front()); //so room for the extra params is allocated
-
-		for(size_t ii=0; ii<tmp.size(); ii++)
-			vec1[vec1_start+ii] = tmp[ii];
+		//move the merged elements back in place, the extra ones being inserted after the replaced range
+		const size_t nr_replaced = ii_end - ii_start;
+		std::move(tmp.begin(), tmp.begin()+static_cast<std::ptrdiff_t>(nr_replaced), vec1.begin()+static_cast<std::ptrdiff_t>(ii_start));
+		vec1.insert(vec1.begin()+static_cast<std::ptrdiff_t>(ii_end), std::make_move_iterator(tmp.begin()+static_cast<std::ptrdiff_t>(nr_replaced)), std::make_move_iterator(tmp.end()));
 
 		vec1_end = idx2;
 	} else {
@@ -619,7 +631,7 @@ void MeteoData::merge(std::vector<MeteoData>& vec, const MeteoData& meteo2, cons
 	if (!simple_merge) {
 		for (size_t ii=0; ii<vec.size(); ii++) {
 			//two stations are considered the same if they point to the same 3D position
-			if (vec[ii].meta.position==meteo2.meta.position) {
+			if (vec[ii].meta->position==meteo2.meta->position) {
 				vec[ii].merge(meteo2, conflicts_strategy);
 				return;
 			}
@@ -641,7 +653,7 @@ void MeteoData::merge(std::vector<MeteoData>& vec, const Merge_Conflicts& confli
 	for (size_t ii=0; ii<nElems; ii++) {
 		if (mergeIdx[ii]==IOUtils::npos) continue; //this element has already been merged, skip
 		for (size_t jj=ii+1; jj<nElems; jj++) {
-			if (vec[ii].meta.position==vec[jj].meta.position) {
+			if (vec[ii].meta->position==vec[jj].meta->position) {
 				vec[ii].merge( vec[jj], conflicts_strategy );
 				mergeIdx[jj]=IOUtils::npos; //this element will be skipped in the next loops
 			}
@@ -668,7 +680,7 @@ bool MeteoData::merge(const MeteoData& meteo2, const Merge_Conflicts& conflicts_
 		throw InvalidArgumentException(ss.str(), AT);
 	}
 	
-	meta.merge(meteo2.meta); //no brainer merging of metadata
+	if (meta.get()!=meteo2.meta.get()) meta = StationData::merge(*meta, meteo2.meta); //no brainer merging of metadata
 	if (date.isUndef()) date=meteo2.date; //we don't accept different dates, see above
 	if (meteo2.resampled==true ) resampled=true;
 	
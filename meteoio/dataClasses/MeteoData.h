@@ -176,16 +176,18 @@ class MeteoData {
 
 		/**
 		* @brief A constructor that sets the meta data and keeps julian ==0.0
-		* @param meta_in A StationData object containing the meta data
+		* @param meta_in A StationData object (or a handle on one) containing the meta data. A StationData is looked up in the
+		* shared registry at each call, so prefer passing a handle when building many data points of the same station
 		*/
-		MeteoData(const StationData& meta_in);
+		MeteoData(const SharedStationData& meta_in);
 		
 		/**
 		* @brief A constructor that sets the measurment time and meta data
 		* @param date_in A Date object representing the time of the measurement
-		* @param meta_in A StationData object containing the meta data
+		* @param meta_in A StationData object (or a handle on one) containing the meta data. A StationData is looked up in the
+		* shared registry at each call, so prefer passing a handle when building many data points of the same station
 		*/
-		MeteoData(const Date& date_in, const StationData& meta_in);
+		MeteoData(const Date& date_in, const SharedStationData& meta_in);
 
 		/**
 		* @brief A setter function for the measurement date
@@ -382,11 +384,11 @@ class MeteoData {
 
 		//direct access allowed
 		Date date; ///<Timestamp of the measurement
-		StationData meta; ///<The meta data of the measurement
+		SharedStationData meta; ///<The meta data of the measurement, shared with the other measurements of the station. It is read-only and its fields are read through getters, see SharedStationData
 
 		static const size_t nrOfParameters; ///<holds the number of meteo parameters stored in MeteoData
 
-		const std::string getStationID() const {return meta.stationID;}
+		const std::string getStationID() const {return meta->stationID;}
 
 	private:
 
@@ -20,6 +20,9 @@
 #include <meteoio/IOUtils.h>
 #include <cmath>
 #include <sstream>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
 
 using namespace std;
 
@@ -68,6 +71,15 @@ bool StationData::operator!=(const StationData& in) const {
 	return !(*this==in);
 }
 
+bool StationData::isIdentical(const StationData& in) const {
+	return ( (stationID == in.stationID) &&
+	         (stationName == in.stationName) &&
+	         (slope==in.slope) &&
+	         (azi==in.azi) &&
+	         position.isIdentical(in.position) &&
+	         (extra == in.extra) );
+}
+
 StationData StationData::merge(StationData sd1, const StationData& sd2) {
 	sd1.merge(sd2);
 	return sd1;
@@ -200,4 +212,72 @@ std::istream& operator>>(std::istream& is, StationData& station) {
 	return is;
 }
 
+///////////////////////////////////////////////////// SharedStationData
+static const size_t registry_min_purge = 256; ///< smallest registry size that triggers a purge
+
+//registry of the metadata currently in use. It only keeps weak references, so metadata that is not referenced
+//by any SharedStationData anymore is released and its (expired) entry is purged when the registry grows.
+class StationRegistry {
+	public:
+		StationRegistry() : registry_mutex(), registry(), next_purge(registry_min_purge) {}
+
+		std::shared_ptr<const StationData> intern(const StationData& sd)
+		{
+			const size_t key = getKey(sd);
+			const std::lock_guard<std::mutex> lock( registry_mutex );
+
+			const auto range( registry.equal_range(key) );
+			for (auto it=range.first; it!=range.second; ++it) {
+				std::shared_ptr<const StationData> candidate( it->second.lock() );
+				if (candidate && candidate->isIdentical(sd)) return candidate;
+			}
+
+			if (registry.size()>=next_purge) {
+				for (auto it=registry.begin(); it!=registry.end();) {
+					if (it->second.expired()) it = registry.erase(it);
+					else ++it;
+				}
+				next_purge = std::max(registry_min_purge, 2*registry.size());
+			}
+
+			const std::shared_ptr<const StationData> interned( std::make_shared<const StationData>(sd) );
+			registry.emplace(key, interned);
+			return interned;
+		}
+
+	private:
+		static size_t getKey(const StationData& sd)
+		{
+			const std::hash<std::string> hash_str;
+			const std::hash<double> hash_dbl;
+			size_t key = hash_str(sd.stationID);
+			key = key*31 + hash_str(sd.stationName);
+			key = key*31 + hash_dbl(sd.position.getLat());
+			key = key*31 + hash_dbl(sd.position.getLon());
+			key = key*31 + hash_dbl(sd.position.getAltitude());
+			return key;
+		}
+
+		std::mutex registry_mutex;
+		std::unordered_multimap< size_t, std::weak_ptr<const StationData> > registry;
+		size_t next_purge; ///< registry size that triggers the next purge of the expired entries
+};
+
+static StationRegistry& getStationRegistry()
+{
+	static StationRegistry registry;
+	return registry;
+}
+
+//all default constructed handles share the same metadata
+static const std::shared_ptr<const StationData>& getDefaultStation()
+{
+	static const std::shared_ptr<const StationData> default_station( getStationRegistry().intern(StationData()) );
+	return default_station;
+}
+
+SharedStationData::SharedStationData() : data( getDefaultStation() ) {}
+
+SharedStationData::SharedStationData(const StationData& sd) : data( getStationRegistry().intern(sd) ) {}
+
 } //end namespace
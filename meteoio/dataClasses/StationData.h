@@ -24,6 +24,7 @@
 #include <string>
 #include <iomanip>
 #include <vector>
+#include <memory>
 
 #include <map>
 
@@ -101,6 +102,14 @@ class StationData {
 		bool operator==(const StationData&) const;
 		bool operator!=(const StationData&) const; ///<Operator that tests for inequality
 
+		/**
+		* @brief Strict comparison of all the fields
+		* @details Contrary to the equality operator, this also checks the station name, the extra metadata
+		* and the exact coordinates.
+		* @return true if both objects are strictly identical
+		*/
+		bool isIdentical(const StationData&) const;
+
 		/**
 		* @brief Simple merge strategy.
 		* If some fields of the first argument are empty, they will be filled by the matching field from the
@@ -138,6 +147,68 @@ class StationData {
 		double azi; ///<Azimuth at the local slope at the station, in degrees, 0 at north, compass orientation
 };
 
+/**
+ * @class SharedStationData
+ * @brief A read-only handle on station metadata that is shared by all the data points of a station.
+ * @details Building a SharedStationData from a StationData looks it up in a registry of all the station metadata
+ * currently in use (so identical metadata is only stored once) and keeps a reference counted pointer to it. Copying
+ * a handle (for example when copying a MeteoData) therefore does not copy the metadata itself.
+ *
+ * The metadata is accessed through the "->" and "*" operators (or the usual StationData getters, such as getStationID())
+ * and the handle can be used wherever a const StationData& is expected. It can not be modified in place, a new
+ * StationData has to be assigned instead:
+ * @code
+ * StationData sd( md.meta );
+ * sd.stationName = "Weissfluhjoch";
+ * md.meta = sd;
+ * @endcode
+ *
+ * @note This is an API change: MeteoData::meta used to be a StationData, so its fields can not be accessed directly
+ * anymore. For example, `md.meta.stationID` becomes `md.meta.getStationID()` (or `md.meta->stationID`) and
+ * `md.meta.position` becomes `md.meta.getPosition()`. A non-const reference to these fields can not be obtained.
+ * @note Each conversion from a StationData is a lookup in the registry: it hashes the metadata and locks a global mutex.
+ * This also applies to the implicit conversions, for example when a StationData is given to a MeteoData constructor or
+ * assigned to MeteoData::meta. In loops, convert once per station and then copy the handle (or the MeteoData), since
+ * copies don't go through the registry.
+ *
+ * @ingroup data_str
+ * @date   2026-10-18
+ */
+class SharedStationData {
+	public:
+		SharedStationData();
+		SharedStationData(const StationData& sd);
+
+		const StationData& operator*() const {return *data;}
+		const StationData* operator->() const {return data.get();}
+		operator const StationData&() const {return *data;}
+		const StationData* get() const {return data.get();} ///< unique for all identical metadata, so it can be used as a key
+
+		//getters forwarded to the metadata, so the handle can be used as a const StationData
+		std::string getStationID() const {return data->getStationID();}
+		std::string getStationName() const {return data->getStationName();}
+		Coords getPosition() const {return data->getPosition();}
+		std::string getHash() const {return data->getHash();}
+		double getAltitude() const {return data->getAltitude();}
+		double getSlopeAngle() const {return data->getSlopeAngle();}
+		double getAzimuth() const {return data->getAzimuth();}
+		const std::string toString() const {return data->toString();}
+		bool isIdentical(const StationData& in) const {return data->isIdentical(in);}
+
+		/**
+		* @brief Equality %operator
+		* same semantics as StationData::operator==, but handles on the same metadata are immediately recognized as equal
+		* @return true or false
+		*/
+		bool operator==(const SharedStationData& in) const {return (data==in.data) || (*data==*in.data);}
+		bool operator!=(const SharedStationData& in) const {return !(*this==in);}
+		bool operator==(const StationData& in) const {return *data==in;}
+		bool operator!=(const StationData& in) const {return *data!=in;}
+
+	private:
+		std::shared_ptr<const StationData> data;
+};
+
 typedef std::vector<StationData> STATIONS_SET;
 
 } //end namespace
@@ -92,11 +92,47 @@ bool AllSkyLWGenerator::create(const size_t& param, const size_t& ii_min, const
 	if (vecMeteo.empty()) return true;
 
 	bool all_filled = true;
-	for (size_t ii=ii_min; ii<ii_max; ii++) {
-		const bool status = generate(param, vecMeteo[ii], vecMeteo);
-		if (status==false) all_filled=false;
+	if (model==LHOMME || model==UNSWORTH || model==CRAWFORD) { //these parametrizations rely on per timestep radiation data
+		for (size_t ii=ii_min; ii<ii_max; ii++) {
+			const bool status = generate(param, vecMeteo[ii], vecMeteo);
+			if (status==false) all_filled=false;
+		}
+		return all_filled;
 	}
 
+	//collect the timesteps to fill (in order, as the cloudiness is kept from one timestep to the next during the night)
+	std::vector<size_t> vecIdx;
+	std::vector<double> vecRH, vecTA, vecCloudiness;
+	for (size_t ii=ii_min; ii<ii_max; ii++) {
+		const MeteoData& md = vecMeteo[ii];
+		if (md(param)!=IOUtils::nodata) continue;
+		const double TA=md(MeteoData::TA), RH=md(MeteoData::RH);
+		if (TA==IOUtils::nodata || RH==IOUtils::nodata) {
+			all_filled = false;
+			continue;
+		}
+		const double cloudiness = TauCLDGenerator::getCloudiness(md);
+		if (cloudiness==IOUtils::nodata) {
+			all_filled = false;
+			continue;
+		}
+		vecIdx.push_back( ii );
+		vecRH.push_back( RH );
+		vecTA.push_back( TA );
+		vecCloudiness.push_back( cloudiness );
+	}
+	if (vecIdx.empty()) return all_filled;
+
+	const size_t n = vecIdx.size();
+	std::vector<double> vecILWR( n );
+	if (model==CARMONA)
+		Atmosphere::Carmona_ilwr(&vecRH[0], &vecTA[0], &vecCloudiness[0], n, &vecILWR[0]);
+	else if (model==OMSTEDT)
+		Atmosphere::Omstedt_ilwr(&vecRH[0], &vecTA[0], &vecCloudiness[0], n, &vecILWR[0]);
+	else if (model==KONZELMANN)
+		Atmosphere::Konzelmann_ilwr(&vecRH[0], &vecTA[0], &vecCloudiness[0], n, &vecILWR[0]);
+
+	for (size_t kk=0; kk<n; kk++) vecMeteo[ vecIdx[kk] ](param) = vecILWR[kk];
 	return all_filled;
 }
 
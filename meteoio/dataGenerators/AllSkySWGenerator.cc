@@ -30,9 +30,9 @@ bool AllSkySWGenerator::generate(const size_t& param, MeteoData& md, const std::
 		const double ISWR=md(MeteoData::ISWR), RSWR=md(MeteoData::RSWR), HS=md(MeteoData::HS), TAU_CLD=md(MeteoData::TAU_CLD);
 		double TA=md(MeteoData::TA), RH=md(MeteoData::RH), ILWR=md(MeteoData::ILWR);
 
-		const double lat = md.meta.position.getLat();
-		const double lon = md.meta.position.getLon();
-		const double alt = md.meta.position.getAltitude();
+		const double lat = md.meta->position.getLat();
+		const double lon = md.meta->position.getLon();
+		const double alt = md.meta->position.getAltitude();
 		if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return false;
 
 		double albedo = .5;
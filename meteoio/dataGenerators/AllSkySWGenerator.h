@@ -49,6 +49,7 @@ class AllSkySWGenerator : public GeneratorAlgorithm {
 			: GeneratorAlgorithm(vecArgs, i_algo, i_section, TZ), sun() { parse_args(vecArgs); }
 		bool generate(const size_t& param, MeteoData& md, const std::vector<MeteoData>& vecMeteo);
 		bool create(const size_t& param, const size_t& ii_min, const size_t& ii_max, std::vector<MeteoData>& vecMeteo);
+		bool isThreadSafe() const {return false;} //the sun position is kept between calls
 	private:
 		static double getSolarIndex(const double& ta, const double& rh, const double& ilwr);
 		SunObject sun;
@@ -75,12 +75,40 @@ bool ClearSkyLWGenerator::create(const size_t& param, const size_t& ii_min, cons
 {
 	if (vecMeteo.empty()) return true;
 
+	//collect the timesteps to fill, so the parametrization is computed on whole arrays
 	bool all_filled = true;
+	std::vector<size_t> vecIdx;
+	std::vector<double> vecRH, vecTA;
 	for (size_t ii=ii_min; ii<ii_max; ii++) {
-		const bool status = generate(param, vecMeteo[ii], vecMeteo);
-		if (status==false) all_filled=false;
+		const MeteoData& md = vecMeteo[ii];
+		if (md(param)!=IOUtils::nodata) continue;
+		const double TA=md(MeteoData::TA), RH=md(MeteoData::RH);
+		if (TA==IOUtils::nodata || RH==IOUtils::nodata) {
+			all_filled = false;
+			continue;
+		}
+		vecIdx.push_back( ii );
+		vecRH.push_back( RH );
+		vecTA.push_back( TA );
 	}
-
+	if (vecIdx.empty()) return all_filled;
+
+	const size_t n = vecIdx.size();
+	std::vector<double> vecILWR( n );
+	if (model==BRUTSAERT)
+		Atmosphere::Brutsaert_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+	else if (model==DILLEY)
+		Atmosphere::Dilley_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+	else if (model==PRATA)
+		Atmosphere::Prata_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+	else if (model==CLARK)
+		Atmosphere::Clark_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+	else if (model==TANG)
+		Atmosphere::Tang_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+	else if (model==IDSO)
+		Atmosphere::Idso_ilwr(&vecRH[0], &vecTA[0], n, &vecILWR[0]);
+
+	for (size_t kk=0; kk<n; kk++) vecMeteo[ vecIdx[kk] ](param) = vecILWR[kk];
 	return all_filled;
 }
 
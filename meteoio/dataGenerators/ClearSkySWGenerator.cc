@@ -30,9 +30,9 @@ bool ClearSkySWGenerator::generate(const size_t& param, MeteoData& md, const std
 		const double ISWR=md(MeteoData::ISWR), RSWR=md(MeteoData::RSWR), HS=md(MeteoData::HS), P=md(MeteoData::P);
 		double TA=md(MeteoData::TA), RH=md(MeteoData::RH);
 
-		const double lat = md.meta.position.getLat();
-		const double lon = md.meta.position.getLon();
-		const double alt = md.meta.position.getAltitude();
+		const double lat = md.meta->position.getLat();
+		const double lon = md.meta->position.getLon();
+		const double alt = md.meta->position.getAltitude();
 		if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return false;
 
 		double albedo = .5;
@@ -47,6 +47,7 @@ class ClearSkySWGenerator : public GeneratorAlgorithm {
 			: GeneratorAlgorithm(vecArgs, i_algo, i_section, TZ), sun() { parse_args(vecArgs); }
 		bool generate(const size_t& param, MeteoData& md, const std::vector<MeteoData>& vecMeteo);
 		bool create(const size_t& param, const size_t& ii_min, const size_t& ii_max, std::vector<MeteoData>& vecMeteo);
+		bool isThreadSafe() const {return false;} //the sun position is kept between calls
 	private:
 		SunObject sun;
 };
@@ -50,6 +50,7 @@ class ESOLIPGenerator : public GeneratorAlgorithm {
 			: GeneratorAlgorithm(vecArgs, i_algo, i_section, TZ) { parse_args(vecArgs); }
 		bool generate(const size_t& param, MeteoData& md, const std::vector<MeteoData>& vecMeteo);
 		bool create(const size_t& param, const size_t& ii_min, const size_t& ii_max, std::vector<MeteoData>& vecMeteo);
+		bool onlyFillsMissing() const {return false;} //the precipitation is redistributed over the whole period between two HS points
 
 	private:
 		static double newSnowDensity(const MeteoData& md);
@@ -60,6 +60,11 @@ namespace mio {
  * to specific time ranges using the **when** option followed by a comma delimited list of date intervals (represented by 
  * two ISO formatted dates seperated by ' - ').
  *
+ * If MeteoIO has been compiled with OpenMP (USE_OPENMP), the stations can be processed in parallel by setting <i>PARALLEL = true</i> in the
+ * [Generators] section. This only applies to the parameters whose generators do not keep any internal state between calls
+ * (so not to the generators relying on the Sun's position such as ALLSKY_SW, CLEARSKY_SW, TAU_CLD, ALLSKY_LW or METEOINDEX) and
+ * is disabled when DATA_QA_LOGS is set.
+ *
  * @note it is generally not advised to use data generators in combination with spatial interpolations as this would
  * potentially mix measured and generated values in the resulting grid. It is therefore advised to turn the data generators
  * off and let the spatial interpolations algorithms adjust to the amount of measured data.
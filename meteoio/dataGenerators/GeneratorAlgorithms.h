@@ -138,6 +138,20 @@ class GeneratorAlgorithm {
 		* @return true the provided timestep should be skipped
 		*/
 		bool skipTimeStep(const Date& dt) const;
+
+		/**
+		* @brief Can this generator process several stations concurrently?
+		* @details Generators that keep some internal state between calls (caches, sun position, etc) must return false.
+		* @return true if the generator can be called concurrently for different stations
+		*/
+		virtual bool isThreadSafe() const {return true;}
+
+		/**
+		* @brief Does create() only ever replace nodata values?
+		* @details If so, the time series that have no missing values are not given to this generator at all.
+		* @return true if create() leaves the valid data points untouched
+		*/
+		virtual bool onlyFillsMissing() const {return true;}
 		
 		std::vector<DateRange> getTimeRestrictions() const {return time_restrictions;}
 		std::string getAlgo() const {return algo;}
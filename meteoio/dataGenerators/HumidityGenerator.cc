@@ -89,7 +89,7 @@ bool HumidityGenerator::generateAH(double& value, MeteoData& md)
 	
 	if (md.param_exists("QI")) {
 		const double QI = md("QI");
-		const double altitude = md.meta.position.getAltitude();
+		const double altitude = md.meta->position.getAltitude();
 		if (QI!=IOUtils::nodata && altitude!=IOUtils::nodata) {
 			const double RH = Atmosphere::specToRelHumidity(altitude, TA, QI);
 			value = RH * Atmosphere::vaporSaturationPressure(TA) / (TA * Cst::gaz_constant_water_vapor);
@@ -104,7 +104,7 @@ bool HumidityGenerator::generateQI(double& value, MeteoData& md)
 {
 	const double TA = md(MeteoData::TA);
 	if (TA==IOUtils::nodata) return false;//nothing else we can do here
-	const double altitude = md.meta.position.getAltitude();
+	const double altitude = md.meta->position.getAltitude();
 	if (altitude==IOUtils::nodata) return false;
 	
 	if (md.param_exists("RH")) {
@@ -160,7 +160,7 @@ bool HumidityGenerator::generateTD(double& value, MeteoData& md)
 
 	if (md.param_exists("QI")) {
 		const double QI = md("QI");
-		const double altitude = md.meta.position.getAltitude();
+		const double altitude = md.meta->position.getAltitude();
 		if (QI!=IOUtils::nodata && altitude!=IOUtils::nodata) {
 			const double RH = Atmosphere::specToRelHumidity(altitude, TA, QI);
 			value = Atmosphere::RhtoDewPoint(RH, TA, false);
@@ -194,7 +194,7 @@ bool HumidityGenerator::generateRH(double& value, MeteoData& md)
 
 	if (md.param_exists("QI")) {
 		const double QI = md("QI");
-		const double altitude = md.meta.position.getAltitude();
+		const double altitude = md.meta->position.getAltitude();
 		if (QI!=IOUtils::nodata && altitude!=IOUtils::nodata) {
 			value = Atmosphere::specToRelHumidity(altitude, TA, QI);
 			return true;
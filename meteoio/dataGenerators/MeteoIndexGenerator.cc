@@ -79,7 +79,7 @@ bool MeteoIndex::wetBulbTemperature(const size_t& param, MeteoData& md)
 {
 	const double TA = md(MeteoData::TA);
 	const double RH = md(MeteoData::RH);
-	const double alt = md.meta.getAltitude();
+	const double alt = md.meta->getAltitude();
 	
 	if (TA!=IOUtils::nodata && RH!=IOUtils::nodata && alt!=IOUtils::nodata) {
 		md(param) = Atmosphere::wetBulbTemperature(TA, RH, alt);
@@ -96,9 +96,9 @@ bool MeteoIndex::WBGT_index(const size_t& param, MeteoData& md)
 	const double ISWR = md(MeteoData::ISWR);
 	if (TA==IOUtils::nodata || RH==IOUtils::nodata || VW==IOUtils::nodata || ISWR==IOUtils::nodata) return false;
 	
-	const double lat = md.meta.position.getLat();
-	const double lon = md.meta.position.getLon();
-	const double alt = md.meta.position.getAltitude();
+	const double lat = md.meta->position.getLat();
+	const double lon = md.meta->position.getLon();
+	const double alt = md.meta->position.getAltitude();
 	if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return false;
 	
 	const double julian_gmt = md.date.getJulian(true);
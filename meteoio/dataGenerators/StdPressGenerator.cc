@@ -26,7 +26,7 @@ bool StandardPressureGenerator::generate(const size_t& param, MeteoData& md, con
 {
 	double &value = md(param);
 	if (value == IOUtils::nodata) {
-		const double altitude = md.meta.position.getAltitude();
+		const double altitude = md.meta->position.getAltitude();
 		if (altitude==IOUtils::nodata) return false;
 		value = Atmosphere::stdAirPressure(altitude);
 	}
@@ -38,7 +38,7 @@ bool StandardPressureGenerator::create(const size_t& param, const size_t& ii_min
 {
 	if (vecMeteo.empty()) return true;
 
-	const double altitude = vecMeteo.front().meta.position.getAltitude(); //if the stations move, this has to be in the loop
+	const double altitude = vecMeteo.front().meta->position.getAltitude(); //if the stations move, this has to be in the loop
 	if (altitude==IOUtils::nodata) return false;
 
 	for (size_t ii=ii_min; ii<ii_max; ii++) {
@@ -180,14 +180,14 @@ double TauCLDGenerator::getCloudiness(const MeteoData& md)
 		cloudiness = std::max(std::min(CLD/8., 1.), 0.1);
 	}
 
-	const std::string station_hash( md.meta.stationID + ":" + md.meta.stationName );
+	const std::string station_hash( md.meta->stationID + ":" + md.meta->stationName );
 	const double julian_gmt = md.date.getJulian(true);
 
 	//try to get a cloudiness value
 	if (cloudiness==IOUtils::nodata) {
-		const double lat = md.meta.position.getLat();
-		const double lon = md.meta.position.getLon();
-		const double alt = md.meta.position.getAltitude();
+		const double lat = md.meta->position.getLat();
+		const double lon = md.meta->position.getLon();
+		const double alt = md.meta->position.getAltitude();
 		if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return IOUtils::nodata;
 
 		bool is_night;
@@ -97,6 +97,7 @@ class TauCLDGenerator : public GeneratorAlgorithm {
 		
 		bool generate(const size_t& param, MeteoData& md, const std::vector<MeteoData>& vecMeteo);
 		bool create(const size_t& param, const size_t& ii_min, const size_t& ii_max, std::vector<MeteoData>& vecMeteo);
+		bool isThreadSafe() const {return false;} //the sun position and the last cloudiness per station are kept between calls
 	protected:
 
 		typedef struct CLOUDCACHE {
@@ -19,10 +19,12 @@
 
 #include <meteoio/gridResampling/GridTimeseriesResampling.h>
 #include <meteoio/meteoResampling/ResamplingAlgorithms.h>
+#include <meteoio/meteoStats/libinterpol1D.h>
 #include <meteoio/GridProcessor.h>
 #include <meteoio/IOUtils.h>
 
 #include <sstream>
+#include <iterator>
 
 namespace mio {
 
@@ -38,12 +40,27 @@ namespace mio {
 GridTimeseriesResampling::GridTimeseriesResampling(const std::string& i_algoname, const std::string& i_parname,
 	const double& dflt_window_size, const std::vector< std::pair<std::string, std::string> >& vecArgs)
 	: GridResamplingAlgorithm(i_algoname, i_parname, dflt_window_size, vecArgs), vecArgs_(vecArgs),
-	base_algorithm_("LINEAR")
+	base_algorithm_("LINEAR"), base_algo_(OTHER), window_size_(86400.), extrapolate_(false)
 {
+	const std::string where( "GridInterpolations1D::" + i_parname + "::" + i_algoname );
 	for (size_t ii = 0; ii < vecArgs.size(); ++ii) {
-		if (vecArgs[ii].first == "ALGORITHM")
+		if (vecArgs[ii].first == "ALGORITHM") {
 			base_algorithm_ = vecArgs[ii].second;
+		} else if (vecArgs[ii].first == "WINDOW_SIZE") {
+			IOUtils::parseArg(vecArgs[ii], where, window_size_);
+			window_size_ /= 86400.; //user uses seconds, internally julian day is used
+			if (window_size_ <= 0.)
+				throw InvalidArgumentException("Invalid window size for \"" + where + "\"", AT);
+		} else if (vecArgs[ii].first == "EXTRAPOLATE") {
+			IOUtils::parseArg(vecArgs[ii], where, extrapolate_);
+		}
 	}
+
+	const std::string base_algo( IOUtils::strToUpper(base_algorithm_) );
+	if (base_algo == "LINEAR")
+		base_algo_ = LINEAR;
+	else if (base_algo == "NEAREST")
+		base_algo_ = NEAREST;
 }
 
 /**
@@ -67,6 +84,158 @@ std::string GridTimeseriesResampling::toString() const
  * @param[out] resampled_grid The temporally resampled grid.
  */
 void GridTimeseriesResampling::resample(const Date& date, const std::map<Date, Grid2DObject>& all_grids, Grid2DObject& resampled_grid)
+{
+	if (base_algo_ == OTHER)
+		resamplePoints(date, all_grids, resampled_grid);
+	else
+		resampleGrid(date, all_grids, resampled_grid);
+}
+
+/**
+ * @brief Temporal resampling on whole grids for the LINEAR and NEAREST algorithms.
+ * @details This reproduces what the time series algorithms do at each grid point: the
+ * nearest valid values before and after the requested date are searched within the window
+ * (and further away when extrapolating). Since the bracketing grids and their weights are the
+ * same for all cells, they are computed once and only the cells that are nodata in one of
+ * the bracketing grids need to search the other grids.
+ * @param[in] date Date to resample the data to.
+ * @param[in] all_grids List of all grids available to this resampling algorithm.
+ * @param[out] resampled_grid The temporally resampled grid.
+ */
+void GridTimeseriesResampling::resampleGrid(const Date& date, const std::map<Date, Grid2DObject>& all_grids, Grid2DObject& resampled_grid) const
+{
+	resampled_grid.set(all_grids.begin()->second, IOUtils::nodata);
+
+	std::vector<double> vecJul;
+	std::vector<const Array2D<double>*> vecPlanes;
+	vecJul.reserve(all_grids.size());
+	vecPlanes.reserve(all_grids.size());
+	for (auto it = all_grids.begin(); it != all_grids.end(); ++it) {
+		vecJul.push_back( it->first.getJulian(true) );
+		vecPlanes.push_back( &it->second.grid2D );
+	}
+
+	//the resampled point is considered to be just before the first grid that comes after the requested date
+	const size_t nr_grids = vecJul.size();
+	const size_t pos = static_cast<size_t>( std::distance(all_grids.begin(), all_grids.upper_bound(date)) );
+	if (!extrapolate_ && (pos == 0 || pos == nr_grids))
+		return; //the requested date is outside of the available time span
+
+	//weights for the cells that are valid in both bracketing grids
+	const double julian = date.getJulian(true);
+	const bool bracketed = (pos > 0 && pos < nr_grids && vecJul[pos-1] >= julian - window_size_ && vecJul[pos] <= vecJul[pos-1] + window_size_);
+	double weight = 0.; //weight of the grid after the requested date
+	if (bracketed) {
+		if (base_algo_ == LINEAR) {
+			weight = (julian - vecJul[pos-1]) / (vecJul[pos] - vecJul[pos-1]);
+		} else {
+			const double diff1 = julian - vecJul[pos-1];
+			const double diff2 = vecJul[pos] - julian;
+			if (IOUtils::checkEpsilonEquality(diff1, diff2, 0.1/1440.)) //within 6 seconds
+				weight = 0.5;
+			else
+				weight = (diff1 < diff2)? 0. : 1.;
+		}
+	}
+
+	const Array2D<double>* before = (bracketed)? vecPlanes[pos-1] : nullptr;
+	const Array2D<double>* after = (bracketed)? vecPlanes[pos] : nullptr;
+	const int nr_cells = static_cast<int>( resampled_grid.size() );
+#pragma omp parallel for schedule(static)
+	for (int ii = 0; ii < nr_cells; ++ii) {
+		const size_t jj = static_cast<size_t>(ii);
+		if (bracketed) {
+			const double y1 = (*before)(jj);
+			const double y2 = (*after)(jj);
+			if (y1 != IOUtils::nodata && y2 != IOUtils::nodata) {
+				resampled_grid(jj) = y1 + (y2 - y1) * weight;
+				continue;
+			}
+		}
+		resampled_grid(jj) = resampleCell(jj, pos, julian, vecJul, vecPlanes);
+	}
+}
+
+/**
+ * @brief Resample one cell by searching the nearest valid values in time.
+ * @param[in] jj Index of the cell.
+ * @param[in] pos Index of the first grid after the requested date.
+ * @param[in] julian Requested date (GMT julian).
+ * @param[in] vecJul Dates of all the grids (GMT julian).
+ * @param[in] vecPlanes Data of all the grids.
+ * @return Resampled value (or nodata).
+ */
+double GridTimeseriesResampling::resampleCell(const size_t& jj, const size_t& pos, const double& julian, const std::vector<double>& vecJul, const std::vector<const Array2D<double>*>& vecPlanes) const
+{
+	const size_t nr_grids = vecJul.size();
+	size_t idx1 = IOUtils::npos, idx2 = IOUtils::npos;
+	for (size_t ii = pos; ii-- > 0; ) {
+		if (vecJul[ii] < julian - window_size_) break;
+		if ((*vecPlanes[ii])(jj) != IOUtils::nodata) {
+			idx1 = ii;
+			break;
+		}
+	}
+	const double window_end = (idx1 != IOUtils::npos)? vecJul[idx1] + window_size_ : julian + window_size_;
+	for (size_t ii = pos; ii < nr_grids; ++ii) {
+		if (vecJul[ii] > window_end) break;
+		if ((*vecPlanes[ii])(jj) != IOUtils::nodata) {
+			idx2 = ii;
+			break;
+		}
+	}
+
+	if (base_algo_ == NEAREST) {
+		if (idx1 != IOUtils::npos && idx2 != IOUtils::npos) {
+			const double val1 = (*vecPlanes[idx1])(jj);
+			const double val2 = (*vecPlanes[idx2])(jj);
+			const double diff1 = julian - vecJul[idx1];
+			const double diff2 = vecJul[idx2] - julian;
+			if (IOUtils::checkEpsilonEquality(diff1, diff2, 0.1/1440.)) //within 6 seconds
+				return Interpol1D::weightedMean(val1, val2, 0.5);
+			return (diff1 < diff2)? val1 : val2;
+		}
+		if (!extrapolate_) return IOUtils::nodata;
+		if (idx1 != IOUtils::npos) return (*vecPlanes[idx1])(jj);
+		if (idx2 != IOUtils::npos) return (*vecPlanes[idx2])(jj);
+		return IOUtils::nodata;
+	}
+
+	//linear interpolation (or extrapolation from the two nearest valid points on the same side)
+	if (idx1 == IOUtils::npos && idx2 == IOUtils::npos) return IOUtils::nodata;
+	if (!extrapolate_ && (idx1 == IOUtils::npos || idx2 == IOUtils::npos)) return IOUtils::nodata;
+	if (idx1 == IOUtils::npos) {
+		for (size_t ii = idx2+1; ii < nr_grids; ++ii) {
+			if ((*vecPlanes[ii])(jj) != IOUtils::nodata) {
+				idx1 = ii;
+				break;
+			}
+		}
+	} else if (idx2 == IOUtils::npos) {
+		for (size_t ii = idx1; ii-- > 0; ) {
+			if ((*vecPlanes[ii])(jj) != IOUtils::nodata) {
+				idx2 = ii;
+				break;
+			}
+		}
+	}
+	if (idx1 == IOUtils::npos || idx2 == IOUtils::npos) return IOUtils::nodata;
+
+	const double x1 = vecJul[idx1], y1 = (*vecPlanes[idx1])(jj);
+	const double x2 = vecJul[idx2], y2 = (*vecPlanes[idx2])(jj);
+	const double aa = (y2 - y1) / (x2 - x1);
+	return y1 + aa * (julian - x1);
+}
+
+/**
+ * @brief Temporal resampling by building the time series at each grid point.
+ * @details This is used for all the algorithms that need the history at each point
+ * (such as ACCUMULATE or SOLAR).
+ * @param[in] date Date to resample the data to.
+ * @param[in] all_grids List of all grids available to this resampling algorithm.
+ * @param[out] resampled_grid The temporally resampled grid.
+ */
+void GridTimeseriesResampling::resamplePoints(const Date& date, const std::map<Date, Grid2DObject>& all_grids, Grid2DObject& resampled_grid) const
 {
 	//retrieve an algorithm from the time series resampling algorithm factory:
 	resampled_grid.set(all_grids.begin()->second, IOUtils::nodata);
@@ -111,6 +280,7 @@ void GridTimeseriesResampling::resample(const Date& date, const std::map<Date, G
 				pos = ResamplingAlgorithms::begin;
 			}
 
+			ts_interpolator->resetResampling(); //the known gaps of the previous grid point do not apply here
 			ts_interpolator->resample(point_meta.getHash(), index, pos,
 				resampled_pt.getParameterIndex(parname), vecM, resampled_pt);
 			resampled_grid(xx, yy) = resampled_pt(parname);
@@ -39,6 +39,9 @@ namespace mio {
  * TA::TIMESERIES::ALGORITHM = LINEAR
  * TA::TIMESERIES::EXTRAPOLATE = TRUE
  * @endcode
+ * The LINEAR and NEAREST algorithms are directly applied on whole grids: the grids bracketing the requested date and the
+ * interpolation weights are only computed once and then applied to all cells (only the cells that are nodata in the
+ * bracketing grids search further in time). All the other algorithms are applied on the time series built at each grid point.
  * @note Currently the algorithm has no knowledge of the used DEM (for solar resampling).
  * @author Michael Reisecker
  * @date 2021-09
@@ -51,8 +54,21 @@ class GridTimeseriesResampling : public GridResamplingAlgorithm {
 		std::string toString() const;
 
 	private:
+		typedef enum BASE_ALGO {
+			OTHER, ///< any algorithm that needs the time series at each grid point
+			LINEAR,
+			NEAREST
+		} BaseAlgo;
+
+		void resampleGrid(const Date& date, const std::map<Date, Grid2DObject>& all_grids, Grid2DObject& resampled_grid) const;
+		void resamplePoints(const Date& date, const std::map<Date, Grid2DObject>& all_grids, Grid2DObject& resampled_grid) const;
+		double resampleCell(const size_t& jj, const size_t& pos, const double& julian, const std::vector<double>& vecJul, const std::vector<const Array2D<double>*>& vecPlanes) const;
+
 		std::vector< std::pair<std::string, std::string> > vecArgs_;
 		std::string base_algorithm_; ///< Name of timeseries resampling algorithm to use
+		BaseAlgo base_algo_; ///< Base algorithm, if it can be applied on whole grids
+		double window_size_; ///< Search window for the whole grids algorithms, in days
+		bool extrapolate_; ///< Allow extrapolation for the whole grids algorithms
 };
 
 } //end namespace mio
@@ -64,6 +64,8 @@ void FilterKalman::process(const unsigned int& param, const std::vector<MeteoDat
 
 	Matrix xx( buildInitialStates(xx_str, meas_idx, ivec, nz) ); //once the observables are known, go back to parsing the initial states
 	const std::vector<std::string> AA_str( parseSystemMatrix(mat_in_AA, nx) ); //keep as strings so we can do substitutions
+	Matrix AA; //constant elements are set once and for all, the others are substituted at each time step
+	const std::vector<SystemElement> AA_var( compileSystemMatrix(AA_str, nx, ivec, AA) );
 
 	//Now that we know how many states and observables there are, we can size the rest of the matrices.
 	//We keep nz for clarity, but this implementation forces nz=nx (not all have to actually be used).
@@ -80,62 +82,129 @@ void FilterKalman::process(const unsigned int& param, const std::vector<MeteoDat
 	Matrix RR( bloatMatrix(mat_in_RR, nz, nz, "observation noise") ); //observation noise covariance
 	bool has_RR_params, has_QQ_params;
 	assertInputCovariances(ivec, nx, has_RR_params, has_QQ_params);
+	std::vector<size_t> RR_idx, QQ_idx; //if desired, RR and QQ are read from these parameters at each time step
+	if (has_RR_params) {
+		RR_idx = getInputIndices(RR_params, ivec.front());
+		RR.resize(nz, nz, 0.);
+	}
+	if (has_QQ_params) {
+		QQ_idx = getInputIndices(QQ_params, ivec.front());
+		QQ.resize(nx, nx, 0.);
+	}
 
 	//at last, we input an optional control signal, either as scalar, matrix, or "meteo" data:
 	Matrix BB( bloatMatrix(mat_in_BB, nx, nx, "control relation") ); //relates control input to state
-	Matrix uu( buildControlSignal(nx, TT, ivec) );
+	const Matrix uu( buildControlSignal(nx, TT, ivec) );
+	bool has_control(false); //skip the control signal when it has no effect on the states
+	for (size_t ii = 1; ii <= BB.getNy(); ++ii)
+		for (size_t jj = 1; jj <= BB.getNx(); ++jj)
+			if (BB(ii, jj) != 0.) has_control = true;
 
 	/* KALMAN FILTER */
-	Matrix KK; //Kalman gain
-	Matrix II;
-	II.identity(nx);
 	ovec = ivec; //copy with all special parameters etc.
 
 	for (size_t pp = 0; pp < error_params.size(); ++pp) //create parameters to output PP if they don't exist
 		for (size_t ii = 0; ii < ovec.size(); ++ii)
 			ovec[ii].addParameter(error_params[pp]);
+	std::vector<size_t> error_idx;
+	if (error_params.size() == nx) //output estimated error
+		error_idx = getInputIndices(error_params, ovec.front());
 
 	bool saw_nodata(false);
 	size_t last_valid_idx(0);
 
-	for (size_t kk = 0; kk < TT; ++kk) { //for each time step...
-		const double dt = (kk == 0)? 0 : vecT[kk] - vecT[last_valid_idx]; //initial state is at time of 1st measurement
-		const Matrix AA( buildSystemMatrix(AA_str, nx, dt, ivec, kk) );
-
-    	if (has_RR_params) //if desired, get RR and QQ from input data at each time step
-    		RR = extractInputMatrix(RR_params, ivec, kk);
-    	if (has_QQ_params)
-    		QQ = extractInputMatrix(QQ_params, ivec, kk);
-    	const bool has_nodata = checkNodata(zz.getCol(kk+1));
-
-    	if (!has_nodata) { //we can calculate
-
-    		//prediction:
-    		xx = ( AA * xx + BB * uu.getCol(kk+1) );
-    		PP = ( AA * PP * AA.getT() + QQ );
-
-    		//update:
-    		KK = PP * HH.getT() * (HH * PP * HH.getT() + RR).getInv();
-    		xx = ( xx + KK * (zz.getCol(kk+1) - HH * xx) );
-    		PP = ( (II - KK * HH) * PP );
-
-    		ovec[kk](param) = xx(1, 1); //filter the parameter the filter runs on
-    		if (filter_all_params) //the following will filter all specified parameters, not just param!
-    			for (size_t ii = 1; ii < nz; ++ii) //nx = nz, The user is responsible to provide enough output fields.
-    				ovec[kk](meas_idx[ii]) = xx(ii+1, 1);
-
-    		last_valid_idx = kk; //dt is calculated between valid data values
-
-    		if (error_params.size() == nx) //output estimated error
-    			for (size_t mm = 0; mm < nx; ++mm)
-    				ovec[kk](error_params[mm]) = out_error_stddev? sqrt(PP(mm+1, mm+1)) : PP(mm+1, mm+1); //save diagonal elements only
+	if (nx == 1) { //scalar fast path: all matrices are 1x1
+		double xs = xx(1, 1), ps = PP(1, 1);
+		const double hs = HH(1, 1), bs = has_control? BB(1, 1) : 0.;
+		for (size_t kk = 0; kk < TT; ++kk) {
+			const double zs = zz(1, kk+1);
+			if (zs == IOUtils::nodata) { //the state stays as if this time step wasn't encountered
+				saw_nodata = true;
+				continue;
+			}
+			const double dt = (kk == 0)? 0 : vecT[kk] - vecT[last_valid_idx]; //initial state is at time of 1st measurement
+			updateSystemMatrix(AA_var, dt, ivec[kk], AA);
+			if (has_RR_params) updateInputMatrix(RR_idx, ivec[kk], RR);
+			if (has_QQ_params) updateInputMatrix(QQ_idx, ivec[kk], QQ);
+			const double as = AA(1, 1);
+
+			//prediction:
+			xs = as * xs + bs * uu(1, kk+1);
+			ps = as * ps * as + QQ(1, 1);
+
+			//update:
+			const double ks = ps * hs / (hs * ps * hs + RR(1, 1));
+			xs += ks * (zs - hs * xs);
+			ps -= ks * hs * ps;
+
+			ovec[kk](param) = xs;
+			last_valid_idx = kk;
+			if (!error_idx.empty())
+				ovec[kk](error_idx.front()) = out_error_stddev? sqrt(ps) : ps;
+		}
+	} else {
+		//all working matrices are allocated once, the time loop then only computes in place
+		Matrix uk(nx, 1, 0.), Bu(nx, 1, 0.), Ax(nx, 1, 0.), AP(nx, nx), PPt(nx, nx), IKH(nx, nx);
+		Matrix HP(nz, nx), SS(nz, nz), KT(nz, nx), Hx(nz, 1, 0.), yy(nz, 1, 0.), Ky(nx, 1, 0.);
+
+		for (size_t kk = 0; kk < TT; ++kk) { //for each time step...
+			if (checkNodata(zz, kk)) { //all states stay as if this time step wasn't encountered
+				saw_nodata = true;
+				continue;
+			}
+			const double dt = (kk == 0)? 0 : vecT[kk] - vecT[last_valid_idx]; //initial state is at time of 1st measurement
+			updateSystemMatrix(AA_var, dt, ivec[kk], AA);
+			if (has_RR_params) updateInputMatrix(RR_idx, ivec[kk], RR);
+			if (has_QQ_params) updateInputMatrix(QQ_idx, ivec[kk], QQ);
+
+			//prediction: xx = AA·xx + BB·uu, PP = AA·PP·AA^T + QQ
+			Matrix::mult_into(AA, xx, Ax);
+			xx = Ax;
+			if (has_control) {
+				for (size_t ii = 1; ii <= nx; ++ii) uk(ii, 1) = uu(ii, kk+1);
+				Matrix::mult_into(BB, uk, Bu);
+				xx += Bu;
+			}
+			Matrix::mult_into(AA, PP, AP);
+			Matrix::mult_into(AP, AA, PPt, false, true);
+			PPt += QQ;
+
+			//update: the gain KK = PP·HH^T·SS^-1 is obtained by solving SS·KK^T = HH·PP (SS and PP being symmetric)
+			Matrix::mult_into(HH, PPt, HP);
+			Matrix::mult_into(HP, HH, SS, false, true);
+			SS += RR;
+			KT = HP;
+			if (!Matrix::LLT_solve(SS, KT)) { //SS is not positive definite (and has been overwritten), fall back to an LU decomposition
+				Matrix::mult_into(HP, HH, SS, false, true);
+				SS += RR;
+				if (!Matrix::solve_into(SS, HP, KT))
+					throw InvalidArgumentException("The Kalman filter's innovation covariance matrix is singular at " + ivec[kk].date.toString(Date::ISO)
+					        + "; please check the OBSERVATION_COVARIANCE.", AT);
+			}
 
-    	} else { //all states stay as if this time step wasn't encountered
-    		saw_nodata = true;
-    	} //endif nodata
-    } //endfor kk
+			Matrix::mult_into(HH, xx, Hx);
+			for (size_t ii = 1; ii <= nz; ++ii) yy(ii, 1) = zz(ii, kk+1) - Hx(ii, 1);
+			Matrix::mult_into(KT, yy, Ky, true);
+			xx += Ky; //xx = xx + KK·(zz - HH·xx)
+			Matrix::mult_into(KT, HH, IKH, true); //PP = (II - KK·HH)·PP
+			for (size_t ii = 1; ii <= nx; ++ii)
+				for (size_t jj = 1; jj <= nx; ++jj)
+					IKH(ii, jj) = (ii == jj)? 1. - IKH(ii, jj) : -IKH(ii, jj);
+			Matrix::mult_into(IKH, PPt, PP);
+
+			ovec[kk](param) = xx(1, 1); //filter the parameter the filter runs on
+			if (filter_all_params) //the following will filter all specified parameters, not just param!
+				for (size_t ii = 1; ii < nz; ++ii) //nx = nz, The user is responsible to provide enough output fields.
+					ovec[kk](meas_idx[ii]) = xx(ii+1, 1);
+
+			last_valid_idx = kk; //dt is calculated between valid data values
+
+			for (size_t mm = 0; mm < error_idx.size(); ++mm) //output estimated error
+				ovec[kk](error_idx[mm]) = out_error_stddev? sqrt(PP(mm+1, mm+1)) : PP(mm+1, mm+1); //save diagonal elements only
+		} //endfor kk
+	}
 
-    if (be_verbose && saw_nodata) std::cerr << "[W] Nodata value(s) or missing parameter encountered in Kalman filter; some values were ignored. You should probably resample beforehand.\n";
+	if (be_verbose && saw_nodata) std::cerr << "[W] Nodata value(s) or missing parameter encountered in Kalman filter; some values were ignored. You should probably resample beforehand.\n";
 }
 
 /**
@@ -329,67 +398,90 @@ std::vector<std::string> FilterKalman::parseSystemMatrix(const std::string& line
 }
 
 /**
- * @brief Construct a double-valued matrix from a string matrix with substitutions.
- * @details The system matrix is kept as strings until right before the calculation. At each time step, the strings are
- * then parsed and substitutions are performed to get the real arithmetic matrix.
+ * @brief Compile the system matrix from its string form.
+ * @details The system matrix is parsed only once: constant elements are directly written into the matrix while
+ * the elements that depend on the time step ("dt") or on meteo parameters (e. g. "meteo(TA)") are returned so that
+ * they can be substituted at each time step without parsing anything anymore.
  * @param[in] AA_str The system matrix in string form.
  * @param[in] sz Number of rows (= number of columns) of the system matrix.
- * @param[in] dt Current time delta between measurements, can be substituted for with "dt".
- * @param[in] ivec Meteo data set to get substitutions from.
- * @param[in] kk Current time step.
- * @return Double-valued system matrix with all substitutions in place.
+ * @param[in] ivec Meteo data set to get the indices of substituted parameters from.
+ * @param[out] AA System matrix with all constant elements in place.
+ * @return List of the elements to substitute at each time step.
  */
-Matrix FilterKalman::buildSystemMatrix(const std::vector<std::string>& AA_str, const size_t& sz, const double& dt,
-        const std::vector<MeteoData>& ivec, const size_t& kk) const
-{ //substitutions in system matrix
-	Matrix AA(sz, sz);
-	for (size_t ii = 0; ii < sz; ++ii)
-		for (size_t jj = 0; jj < sz; ++jj)
-			AA(ii+1, jj+1) = substitute(AA_str[ii*sz + jj], dt, ivec, kk);
-	return AA;
+std::vector<FilterKalman::SystemElement> FilterKalman::compileSystemMatrix(const std::vector<std::string>& AA_str, const size_t& sz,
+        const std::vector<MeteoData>& ivec, Matrix& AA) const
+{
+	std::vector<SystemElement> vecElements;
+	AA.resize(sz, sz, 0.);
+	for (size_t ii = 0; ii < sz; ++ii) {
+		for (size_t jj = 0; jj < sz; ++jj) {
+			const std::string texp( IOUtils::trim(AA_str[ii*sz + jj]) );
+			if (texp == "dt") { //current time step (time between measurements)
+				const SystemElement elem = {ii+1, jj+1, IOUtils::npos};
+				vecElements.push_back( elem );
+			} else if ( texp.size() > 6 && (texp.compare(0, 6, "meteo(") == 0) ) { //meteo parameters
+				const std::string param_name( texp.substr(6, texp.length()-7) );
+				const size_t param_idx = ivec.front().getParameterIndex(param_name);
+				if (param_idx == IOUtils::npos)
+					throw InvalidArgumentException("Parameter \"" + param_name + "\" used in the Kalman filter's system matrix not found.", AT);
+				const SystemElement elem = {ii+1, jj+1, param_idx};
+				vecElements.push_back( elem );
+			} else { //double values
+				std::istringstream ss(texp);
+				double aa;
+				ss >> aa;
+				if (ss.fail())
+					throw InvalidArgumentException("Unrecognized value in the Kalman filter's system matrix: \"" + texp + "\".", AT);
+				AA(ii+1, jj+1) = aa;
+			}
+		}
+	}
+	return vecElements;
 }
 
 /**
- * @brief Perform substitutions in the system matrix.
- * @details At each time step the user can substitute some values in the system matrix, e. g. the time step and meteo parameters.
- * Additionally, this function performs the conversion from string to double for the system matrix.
- * @param[in] dt Current time delta that will be replicated as return value when substituting "dt".
- * @param[in] ivec Meteo data to pull meteo value substitutions from.
- * @param[in] kk Current time step, i. e. index of the meteo data set used to pull substitution values from.
- * @return Double value for the current entry of the system matrix.
+ * @brief Perform the substitutions in the system matrix for the current time step.
+ * @param[in] vecElements Elements to substitute, as returned by compileSystemMatrix().
+ * @param[in] dt Current time delta between measurements, substituted for "dt".
+ * @param[in] md Meteo data of the current time step to pull substitution values from.
+ * @param[in,out] AA System matrix to update.
  */
-double FilterKalman::substitute(const std::string& expr, const double& dt, const std::vector<MeteoData>& ivec, const size_t& kk) const
+void FilterKalman::updateSystemMatrix(const std::vector<SystemElement>& vecElements, const double& dt, const MeteoData& md, Matrix& AA)
 {
-	const std::string texp( IOUtils::trim(expr) );
-	if (texp == "dt") { //current time step (time between measurements)
-		return dt;
-	} else if ( texp.size() > 6 && (texp.compare(0, 6, "meteo(") == 0) ) { //meteo parameters
-		return ivec[kk](texp.substr(6, texp.length()-7));
-	} else { //double values
-		std::istringstream ss(texp);
-		double aa;
-		ss >> aa;
-		if (ss.fail())
-			throw InvalidArgumentException("Unrecognized value in the Kalman filter's system matrix: \"" + texp + "\".", AT);
-		return aa;
+	for (size_t ii = 0; ii < vecElements.size(); ++ii) {
+		const SystemElement& elem = vecElements[ii];
+		AA(elem.row, elem.col) = (elem.param == IOUtils::npos)? dt : md(elem.param);
 	}
 }
 
 /**
- * @brief Read a number of meteo parameters and construct diagonal matrix from them.
- * @details This function searches a meteo data set for a list of given parameters and puts those at the diagonal of
- * an otherwise zero-valued matrix.
- * @param[in] vecParams Vector of parameter names (the matrix will be vecParams.size() x vecParams.size()).
- * @param[in] mvec Meteo data set the values are extracted from.
- * @return Matrix with the extracted meteo values on the diagonal.
+ * @brief Get the indices of a list of meteo parameters.
+ * @param[in] vecParams Vector of parameter names.
+ * @param[in] md Meteo data to look the parameters up in.
+ * @return Parameter indices, in the same order as the names.
  */
-Matrix FilterKalman::extractInputMatrix(const std::vector<std::string>& vecParams, const std::vector<MeteoData>& mvec,
-        const size_t& kk) const
-{ //read meteo parameters (given in a vector) to a diagonal matrix
-	Matrix dia(vecParams.size(), vecParams.size(), 0.);
-	for (size_t ii = 0; ii < vecParams.size(); ++ii)
-		dia(ii+1, ii+1) = mvec[kk](vecParams[ii]);
-	return dia;
+std::vector<size_t> FilterKalman::getInputIndices(const std::vector<std::string>& vecParams, const MeteoData& md) const
+{
+	std::vector<size_t> vecIdx( vecParams.size() );
+	for (size_t ii = 0; ii < vecParams.size(); ++ii) {
+		vecIdx[ii] = md.getParameterIndex(vecParams[ii]);
+		if (vecIdx[ii] == IOUtils::npos)
+			throw NoDataException("Parameter \"" + vecParams[ii] + "\" not found by the Kalman filter.", AT);
+	}
+	return vecIdx;
+}
+
+/**
+ * @brief Read a number of meteo parameters to the diagonal of a matrix.
+ * @details The off-diagonal elements are left untouched (they are expected to be zero).
+ * @param[in] vecIdx Indices of the parameters to read (the matrix must be vecIdx.size() x vecIdx.size()).
+ * @param[in] md Meteo data the values are extracted from.
+ * @param[in,out] dia Matrix to write the extracted meteo values on the diagonal of.
+ */
+void FilterKalman::updateInputMatrix(const std::vector<size_t>& vecIdx, const MeteoData& md, Matrix& dia)
+{
+	for (size_t ii = 0; ii < vecIdx.size(); ++ii)
+		dia(ii+1, ii+1) = md(vecIdx[ii]);
 }
 
 /**
@@ -496,14 +588,15 @@ std::vector<double> FilterKalman::buildTimeVector(const std::vector<MeteoData>&
 } //NOTE: this is duplicate code found in FilterParticle.cc as well
 
 /**
- * @brief Checks if any element in a vector is nodata.
- * @param[in] ivec Vector with values to look through.
+ * @brief Checks if any observation is nodata at a given time step.
+ * @param[in] zz Observations matrix (one column per time step).
+ * @param[in] kk Time step to look at.
  * @return True if any element is nodata, false if none of them are.
  */
-bool FilterKalman::checkNodata(const Matrix& ivec) const
+bool FilterKalman::checkNodata(const Matrix& zz, const size_t& kk)
 { //is any vector element nodata?
-	for (size_t ii = 1; ii <= ivec.getNx(); ++ii)
-		if (ivec(ii, 1) == IOUtils::nodata)
+	for (size_t ii = 1; ii <= zz.getNy(); ++ii)
+		if (zz(ii, kk+1) == IOUtils::nodata)
 			return true;
 	return false;
 }
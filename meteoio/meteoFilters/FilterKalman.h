@@ -398,6 +398,11 @@ namespace mio {
  * are nodata elements in there then even if they would be ignored for the output they would make the filters display warnings.
  * You have to be careful to either start your analytical model at the date `data window - buffer`, or ideally provide exactly
  * the same amount of data on the file system as you request MeteoIO to filter.
+ * - The system matrix is only parsed once; "dt" and "meteo(XX)" are then substituted at each time step. The Kalman gain is
+ * computed by solving for the innovation covariance (\f$H P H^T + R\f$) with a Cholesky (\f$L L^T\f$) decomposition rather than
+ * by inverting it. This requires this matrix to be symmetric and positive definite, which is the case for proper covariance
+ * matrices; otherwise the slower LU decomposition is used and the matrix only has to be non-singular. With a single state,
+ * all matrices are handled as scalars.
  *
  * @subsection kalmankeylist List of ini keys
  *  <table>
@@ -436,16 +441,20 @@ class FilterKalman : public ProcessingBlock {
 		Matrix parseMatrix(const std::string& line, const size_t& rows, const size_t& cols,
 		        const std::string& block) const;
 		std::vector<std::string> parseSystemMatrix(const std::string& line, const size_t& rows) const;
-		Matrix buildSystemMatrix(const std::vector<std::string>& AA_str, const size_t& sz, const double& dt,
-		        const std::vector<MeteoData>& ivec, const size_t& kk) const;
-		double substitute(const std::string& expr, const double& dt, const std::vector<MeteoData>& ivec, const size_t& kk) const;
-		Matrix extractInputMatrix(const std::vector<std::string>& vecParams, const std::vector<MeteoData>& mvec,
-		        const size_t& kk) const;
+		struct SystemElement { //system matrix element that varies between time steps
+			size_t row, col; //position in the matrix
+			size_t param; //meteo parameter index to substitute, IOUtils::npos for the time step
+		};
+		std::vector<SystemElement> compileSystemMatrix(const std::vector<std::string>& AA_str, const size_t& sz,
+		        const std::vector<MeteoData>& ivec, Matrix& AA) const;
+		static void updateSystemMatrix(const std::vector<SystemElement>& vecElements, const double& dt, const MeteoData& md, Matrix& AA);
+		std::vector<size_t> getInputIndices(const std::vector<std::string>& vecParams, const MeteoData& md) const;
+		static void updateInputMatrix(const std::vector<size_t>& vecIdx, const MeteoData& md, Matrix& dia);
 		void assertInputCovariances(const std::vector<MeteoData>& ivec, const size_t& nx, bool& has_RR_params,
 		        bool& has_QQ_params) const;
 		Matrix bloatMatrix(const std::string& line, const size_t& rows, const size_t& cols, const std::string& block) const;
 		std::vector<double> buildTimeVector(const std::vector<MeteoData>& ivec) const;
-		bool checkNodata(const Matrix& ivec) const;
+		static bool checkNodata(const Matrix& zz, const size_t& kk);
 		bool findFirstDatapoint(const std::vector<MeteoData>& ivec, const size_t& param, double& retval) const;
 		void parse_args(const std::vector< std::pair<std::string, std::string> >& vecArgs);
 		void cleanBrackets(std::string& iline) const;
@@ -21,17 +21,22 @@
 #include <meteoio/meteoLaws/Meteoconst.h>
 #include <meteoio/meteoFilters/FilterMaths.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace mio {
 
 FilterMaths::FilterMaths(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& name, const Config& cfg) :
         ProcessingBlock(vecArgs, name, cfg), logic_equations(), substitutions(),
+        var_names(), var_values(), date_vars(), meta_vars(), meteo_vars(), meteo_params(), conditions(),
+        expr_formula(), expr_formula_else(),
         formula(""), formula_else(""), connective("AND"), assign_param(""), skip_nodata(false)
 {
 	parse_args(vecArgs);
 	properties.stage = ProcessingProperties::first;
 	buildSubstitutions(); //collect all substitutions at the beginning
+	compileExpressions(); //and compile everything once and for all
 }
 
 /**
@@ -44,88 +49,61 @@ void FilterMaths::process(const unsigned int& param, const std::vector<MeteoData
     std::vector<MeteoData>& ovec)
 {
 	ovec = ivec;
-
-	//We init all of this not in the constructor but here to have more control over the memory management.
-	te_variable *te_vars = new te_variable[substitutions.size()]; //substitutions are built in constructor
-	initExpressionVars(te_vars); //build te_variables from substitution vectors
-	te_expr *expr_formula = compileExpression(formula, te_vars, substitutions.size()); //main formula
-	te_expr *expr_formula_else = nullptr; //only compile if available
-	if (!formula_else.empty()) {
-		try {
-			expr_formula_else = compileExpression(formula_else, te_vars, substitutions.size());
-		} catch (...) { //roll back main formula on error
-			te_free(expr_formula);
-			delete[] te_vars;
-			throw;
+	const size_t nr_values = ivec.size();
+	if (nr_values == 0)
+		return;
+	const bool is_or = (connective == "OR");
+
+	//the substitutions are built once for the whole time series, then each expression is evaluated over all of it
+	std::vector< std::vector<double> > var_columns;
+	std::vector<const double*> columns;
+	buildColumns(ivec, var_columns, columns);
+
+	//iterative result of AND resp. OR operations, no conditions --> always evaluate to true
+	std::vector<bool> logic(nr_values, conditions.empty() || !is_or);
+	std::vector<double> res_ex(nr_values), res_cond(nr_values);
+	for (size_t jj = 0; jj < conditions.size(); ++jj) {
+		condition& cc = conditions[jj];
+		const bool is_arithmetic = cc.expression.isCompiled();
+		if (is_arithmetic) {
+			cc.expression.evaluate(columns, nr_values, &res_ex[0]); //condition expression
+			cc.compare.evaluate(columns, nr_values, &res_cond[0]); //comparison expression
 		}
-	}
-
-	//logic_equations is input directly from the ini file. The following is storage for the same pairs of expressions in compiled
-	//form, where the index matches the one from logic_equations:
-	std::map< size_t, std::pair<te_expr*, te_expr*> > compiled_expressions;
-
-	std::map<size_t, logic_eq>::iterator it;
-	for (it = logic_equations.begin(); it != logic_equations.end(); ++it) {
-		if (it->second.op.substr(0, 3) != "STR") { //nothing to compile for string evaluations
-			bool arrived_at_second(false);
-			try {
-				compiled_expressions[it->first].first = compileExpression(it->second.expression, te_vars, substitutions.size());
-				arrived_at_second = true; //flag to check which compilation failed
-				compiled_expressions[it->first].second = compileExpression(it->second.compare, te_vars, substitutions.size());
-			} catch (...) { //unroll all previous expression compilations
-				if (arrived_at_second)
-					te_free(compiled_expressions[it->first].first); //.compare has an error -> clean .expression
-				for (; it-- != logic_equations.begin(); ) {
-					te_free(compiled_expressions[it->first].first);
-					te_free(compiled_expressions[it->first].second);
-				}
-				te_free(expr_formula);
-				if (!formula_else.empty())
-					te_free(expr_formula_else);
-				delete[] te_vars;
-				throw;
-			} //end try
-		} //endif STR
-	}
-
-	for (size_t ii = 0; ii < ivec.size(); ++ii) {
-		if (skip_nodata && ivec[ii](param) == IOUtils::nodata)
-			continue; //not even a comparison to nodata is evaluated with this key
-
-		doSubstitutions(ivec, ii); //do all substitutions
-		bool current_logic; //iterative result of AND resp. OR operations
-		if (logic_equations.empty())
-			current_logic = true; //no conditions --> always evaluate to true
-		else
-			current_logic = (connective == "OR"? false : true); //default: AND
 
-		for (it = logic_equations.begin(); it != logic_equations.end(); ++it) {
+		for (size_t ii = 0; ii < nr_values; ++ii) {
 			bool cond;
-			if (it->second.op.substr(0, 3) != "STR") { //arithmetic evaluation
-				double res_ex, res_cond;
-				res_ex = te_eval(compiled_expressions[it->first].first); //condition expression
-				res_cond = te_eval(compiled_expressions[it->first].second); //comparison expression
-				cond = assertCondition(res_ex, res_cond, it->second.op); //evaluate the complete condition
+			if (is_arithmetic) { //evaluate the complete condition
+				cond = assertCondition(res_ex[ii], res_cond[ii], cc.eq.op);
 			} else { //string evaluation
-				const std::string tmp_exp( doStringSubstitutions(it->second.expression, ivec[ii]) );
-				cond = assertStringCondition(tmp_exp, it->second.compare, it->second.op);
+				const std::string tmp_exp( doStringSubstitutions(cc.eq.expression, ivec[ii]) );
+				cond = assertStringCondition(tmp_exp, cc.eq.compare, cc.eq.op);
 			}
 
-			if (connective == "OR")
-				current_logic = current_logic || cond;
+			if (is_or)
+				logic[ii] = logic[ii] || cond;
 			else
-				current_logic = current_logic && cond;
+				logic[ii] = logic[ii] && cond;
 		}
+	}
+
+	std::vector<double> res_formula(nr_values), res_formula_else;
+	expr_formula.evaluate(columns, nr_values, &res_formula[0]);
+	if (expr_formula_else.isCompiled()) {
+		res_formula_else.resize(nr_values);
+		expr_formula_else.evaluate(columns, nr_values, &res_formula_else[0]);
+	}
+
+	for (size_t ii = 0; ii < nr_values; ++ii) {
+		if (skip_nodata && ivec[ii](param) == IOUtils::nodata)
+			continue; //nodata is kept as it is, whatever the conditions with this key
 
 		double result;
-		if (current_logic) { //conditions evaluated to true together
-			result = te_eval(expr_formula);
-		} else { //conditions evaluated to false together
-			if (!formula_else.empty())
-				result = te_eval(expr_formula_else);
-			else
-				result = ivec[ii](param); //default: unchanged
-		}
+		if (logic[ii]) //conditions evaluated to true together
+			result = res_formula[ii];
+		else if (!res_formula_else.empty()) //conditions evaluated to false together
+			result = res_formula_else[ii];
+		else
+			result = ivec[ii](param); //default: unchanged
 
 		if (assign_param.empty()) { //output to same parameter as the filter runs on
 			ovec[ii](param) = isNan(result)? IOUtils::nodata : result;
@@ -135,16 +113,6 @@ void FilterMaths::process(const unsigned int& param, const std::vector<MeteoData
 		}
 
 	} //endfor ii
-
-	std::map< size_t, std::pair<te_expr*, te_expr*> >::iterator it_expr; //cleanup
-	for (it_expr = compiled_expressions.begin(); it_expr != compiled_expressions.end(); ++it_expr) {
-		te_free(it_expr->second.first);
-		te_free(it_expr->second.second);
-	}
-	te_free(expr_formula);
-	if (!formula_else.empty())
-		te_free(expr_formula_else);
-	delete[] te_vars;
 }
 
 /**
@@ -283,37 +251,129 @@ void FilterMaths::buildSubstitutions()
 }
 
 /**
- * @brief Perform substitutions for all keys in the global map that do not have constant values.
+ * @brief Set the values of the substitutions in a compiled expression.
+ * @details Only the constants keep these values, all the other substitutions are given as columns when evaluating.
+ * @param[in,out] expr The compiled expression.
  */
-void FilterMaths::doSubstitutions(const std::vector<MeteoData>& ivec, const size_t& idx)
+void FilterMaths::setConstants(Expression& expr) const
 {
-	int year, month, day, hour, minute;
-	ivec[idx].date.getDate(year, month, day, hour, minute);
-	substitutions["year"] = (double)year;
-	substitutions["month"] = (double)month;
-	substitutions["day"] = (double)day;
-	substitutions["hour"] = (double)hour;
-	substitutions["minute"] = (double)minute;
-	substitutions["julian"] = ivec[idx].date.getJulian();
-	substitutions["altitude"] = ivec[idx].meta.getAltitude();
-	substitutions["azimuth"] = ivec[idx].meta.getAzimuth();
-	substitutions["slope"] = ivec[idx].meta.getSlopeAngle();
-	substitutions["latitude"] = ivec[idx].meta.getPosition().getLat();
-	substitutions["longitude"] = ivec[idx].meta.getPosition().getLon();
-	substitutions["easting"] = ivec[idx].meta.getPosition().getEasting();
-	substitutions["northing"] = ivec[idx].meta.getPosition().getNorthing();
-	//TODO: max, min?
-
-	std::map<std::string, double>::iterator it_sub;
+	for (size_t ii = 0; ii < var_values.size(); ++ii)
+		expr.setVariable(ii, var_values[ii]);
+}
+
+/**
+ * @brief Compile all arithmetic expressions and prepare the substitutions' memory.
+ * @details The substitutions are bound by index, so that the time steps can then be processed without any lookup.
+ */
+void FilterMaths::compileExpressions()
+{
+	const std::string where("Filters::" + block_name);
+
+	var_names.clear();
+	var_values.clear();
+	meteo_vars.clear();
+	std::map<std::string, double>::const_iterator it_sub;
 	for (it_sub = substitutions.begin(); it_sub != substitutions.end(); ++it_sub) {
-		if (it_sub->first.substr(0, 5) == "meteo") {
-			const size_t param_idx = ivec[idx].getParameterIndex( IOUtils::strToUpper(it_sub->first.substr(5)) );
-			if (param_idx == IOUtils::npos) //parameter unavailable, nodata instead of error
-				it_sub->second = IOUtils::nodata;
-			else
-				it_sub->second = ivec[idx](param_idx); //place values in tinyexpr memory location
-		} //endif "meteo"
-	} //endfor it_sub
+		if (it_sub->first.substr(0, 5) == "meteo")
+			meteo_vars.push_back( std::make_pair(var_names.size(), IOUtils::strToUpper(it_sub->first.substr(5))) );
+		var_names.push_back( it_sub->first );
+		var_values.push_back( it_sub->second ); //the constants are set here once and for all
+	}
+	meteo_params.assign(meteo_vars.size(), IOUtils::npos);
+
+	static const size_t nr_date = 6, nr_meta = 7;
+	static const std::string date_sub[nr_date] = {"year", "month", "day", "hour", "minute", "julian"};
+	static const std::string meta_sub[nr_meta] = {"altitude", "azimuth", "slope", "latitude", "longitude", "easting", "northing"};
+	date_vars.resize(nr_date);
+	for (size_t ii = 0; ii < nr_date; ++ii)
+		date_vars[ii] = static_cast<size_t>( std::find(var_names.begin(), var_names.end(), date_sub[ii]) - var_names.begin() );
+	meta_vars.resize(nr_meta);
+	for (size_t ii = 0; ii < nr_meta; ++ii)
+		meta_vars[ii] = static_cast<size_t>( std::find(var_names.begin(), var_names.end(), meta_sub[ii]) - var_names.begin() );
+
+	expr_formula.compile(formula, var_names, where); //main formula
+	setConstants(expr_formula);
+	if (!formula_else.empty()) {
+		expr_formula_else.compile(formula_else, var_names, where);
+		setConstants(expr_formula_else);
+	}
+
+	conditions.clear();
+	std::map<size_t, logic_eq>::const_iterator it;
+	for (it = logic_equations.begin(); it != logic_equations.end(); ++it) {
+		conditions.push_back( condition() );
+		condition& cc = conditions.back();
+		cc.eq = it->second;
+		if (it->second.op.substr(0, 3) != "STR") { //nothing to compile for string evaluations
+			cc.expression.compile(it->second.expression, var_names, where);
+			cc.compare.compile(it->second.compare, var_names, where);
+			setConstants(cc.expression);
+			setConstants(cc.compare);
+		}
+	}
+}
+
+/**
+ * @brief Build the values of all the substitutions that do not have constant values, for a whole time series.
+ * @param[in] ivec Meteo data to filter.
+ * @param[out] var_columns One vector of values per substitution, in the order of var_names (empty for the constants).
+ * @param[out] columns Pointers to these values as expected by Expression::evaluate() (nullptr for the constants).
+ */
+void FilterMaths::buildColumns(const std::vector<MeteoData>& ivec, std::vector< std::vector<double> >& var_columns,
+        std::vector<const double*>& columns)
+{
+	const size_t nr_values = ivec.size();
+	var_columns.assign(var_names.size(), std::vector<double>());
+	for (size_t jj = 0; jj < date_vars.size(); ++jj)
+		var_columns[ date_vars[jj] ].resize(nr_values);
+	for (size_t jj = 0; jj < meta_vars.size(); ++jj)
+		var_columns[ meta_vars[jj] ].resize(nr_values);
+	for (size_t jj = 0; jj < meteo_vars.size(); ++jj)
+		var_columns[ meteo_vars[jj].first ].resize(nr_values);
+
+	for (size_t ii = 0; ii < nr_values; ++ii) {
+		const MeteoData& md = ivec[ii];
+		int year, month, day, hour, minute;
+		md.date.getDate(year, month, day, hour, minute);
+		var_columns[ date_vars[0] ][ii] = (double)year;
+		var_columns[ date_vars[1] ][ii] = (double)month;
+		var_columns[ date_vars[2] ][ii] = (double)day;
+		var_columns[ date_vars[3] ][ii] = (double)hour;
+		var_columns[ date_vars[4] ][ii] = (double)minute;
+		var_columns[ date_vars[5] ][ii] = md.date.getJulian();
+
+		if (ii > 0 && md.meta.get() == ivec[ii-1].meta.get()) { //same (shared) metadata as the previous point
+			for (size_t jj = 0; jj < meta_vars.size(); ++jj)
+				var_columns[ meta_vars[jj] ][ii] = var_columns[ meta_vars[jj] ][ii-1];
+		} else {
+			const Coords pos( md.meta->getPosition() );
+			var_columns[ meta_vars[0] ][ii] = md.meta->getAltitude();
+			var_columns[ meta_vars[1] ][ii] = md.meta->getAzimuth();
+			var_columns[ meta_vars[2] ][ii] = md.meta->getSlopeAngle();
+			var_columns[ meta_vars[3] ][ii] = pos.getLat();
+			var_columns[ meta_vars[4] ][ii] = pos.getLon();
+			var_columns[ meta_vars[5] ][ii] = pos.getEasting();
+			var_columns[ meta_vars[6] ][ii] = pos.getNorthing();
+		}
+		//TODO: max, min?
+
+		for (size_t jj = 0; jj < meteo_vars.size(); ++jj) {
+			size_t& param_idx = meteo_params[jj];
+			const std::string& pname( meteo_vars[jj].second );
+			//the parameters indices are usually the same from one time step to the next, only look them up again if they changed
+			if (param_idx == IOUtils::npos || param_idx >= md.getNrOfParameters() || md.getNameForParameter(param_idx) != pname)
+				param_idx = md.getParameterIndex( pname );
+
+			//parameter unavailable, nodata instead of error
+			var_columns[ meteo_vars[jj].first ][ii] = (param_idx == IOUtils::npos)? IOUtils::nodata : md(param_idx);
+		}
+	}
+
+	columns.assign(var_names.size(), nullptr);
+	for (size_t jj = 0; jj < var_columns.size(); ++jj) {
+		if (!var_columns[jj].empty())
+			columns[jj] = &var_columns[jj][0];
+	}
 }
 
 /**
@@ -326,47 +386,10 @@ std::string FilterMaths::doStringSubstitutions(const std::string& line_in, const
 {
 	std::string line(line_in);
 	IOUtils::replace_all(line, "stationid", md.getStationID());
-	IOUtils::replace_all(line, "stationname", md.meta.stationName);
+	IOUtils::replace_all(line, "stationname", md.meta->stationName);
 	return line;
 }
 
-/**
- * @brief Helper function to call tinyexpr compilation and throw an error if this fails.
- * @param[in] expression The arithmetic equation to compile.
- * @param[in] te_vars Substitutions carried out in the model expression (variables).
- * @param[in] sz Number of substitutions.
- * @return The compiled tinyexpr expression ready to evaluate the function.
- */
-te_expr* FilterMaths::compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const
-{ //ready the lazy expressions (with syntax check)
-	const std::string where("Filters::" + block_name);
-	int te_err;
-	te_expr *expr = te_compile(expression.c_str(), te_vars, (int)sz, &te_err);
-	if (!expr)
-		throw InvalidFormatException("Arithmetic expression \"" + expression +
-		        "\" could not be evaluated for " + where + "; parse error at " + IOUtils::toString(te_err), AT);
-	return expr;
-}
-
-/**
- * @brief Helper function to put substitutions in tinyexpr's format.
- * @details This will iterate through the global substitutions map and put the substitutions in tinyexpr's format.
- * @param[out] vars Tinyexpr formatted substitutions.
- */
-void FilterMaths::initExpressionVars(te_variable* vars)
-{ //build a substitutions expression for tinyexpr
-
-	std::map<std::string, double>::iterator it;
-	size_t cc = 0;
-	for (it = substitutions.begin(); it != substitutions.end(); ++it) {
-		vars[cc].name = it->first.c_str();
-		vars[cc].address = &it->second;
-		vars[cc].type = 0;
-		vars[cc].context = nullptr;
-		cc++;
-	}
-}
-
 /**
  * @brief Called by the processing chain to read input settings.
  * @param[in] vecArgs Vector of string-pairs holding ini keys and values.
@@ -21,8 +21,8 @@
 #define FILTERMATHS_H
 
 #include <meteoio/meteoFilters/ProcessingBlock.h>
+#include <meteoio/Expression.h>
 
-#include <meteoio/thirdParty/tinyexpr.h>
 #include <map>
 
 namespace mio {
@@ -227,10 +227,11 @@ class FilterMaths : public ProcessingBlock {
 		bool assertStringCondition(const std::string& line1, const std::string& line2, const std::string& op);
 		std::map<std::string, double> parseBracketExpression(std::string& line);
 		void buildSubstitutions();
-		void doSubstitutions(const std::vector<MeteoData>& ivec, const size_t& idx);
+		void setConstants(Expression& expr) const;
+		void compileExpressions();
+		void buildColumns(const std::vector<MeteoData>& ivec, std::vector< std::vector<double> >& var_columns,
+		        std::vector<const double*>& columns);
 		std::string doStringSubstitutions(const std::string& line_in, const MeteoData& ielem) const;
-		te_expr* compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const;
-		void initExpressionVars(te_variable* vars);
 		void parse_args(const std::vector< std::pair<std::string, std::string> >& vecArgs);
 		bool isNan(const double& xx) const;
 		void checkOperator(const std::string& op);
@@ -241,8 +242,22 @@ class FilterMaths : public ProcessingBlock {
 			std::string compare;
 			logic_eq() : expression(""), op(""), compare("") {}
 		};
+		typedef struct CONDITION {
+			CONDITION() : expression(), compare(), eq() {}
+			Expression expression, compare; //compiled forms (only for arithmetic conditions)
+			logic_eq eq;
+		} condition;
 		std::map<size_t, logic_eq> logic_equations; //collection of conditions the user supplies
-		std::map<std::string, double> substitutions; //fixed memory for substitutions
+		std::map<std::string, double> substitutions; //all the substitutions found in the expressions, with the constant values
+
+		//everything below is built once in the constructor so process() does not need any lookup or compilation
+		std::vector<std::string> var_names; //names of the substitutions, in the order of var_values
+		std::vector<double> var_values; //values of the constant substitutions (nodata for the others)
+		std::vector<size_t> date_vars, meta_vars; //index in var_values of the date and metadata substitutions
+		std::vector< std::pair<size_t, std::string> > meteo_vars; //index in var_values and meteo parameter name
+		std::vector<size_t> meteo_params; //cached meteo parameter index for each meteo_vars (may change between stations)
+		std::vector<condition> conditions; //compiled logic_equations, in the same order
+		Expression expr_formula, expr_formula_else;
 
 		std::string formula; //calculation expression
 		std::string formula_else; //expression to use when evaluating to false
@@ -21,16 +21,22 @@
 #include <meteoio/meteoStats/libfit1D.h>
 
 #include <meteoio/FStream.h> //for the dump files
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <limits>
 #include <sstream> //for readLineToVec
 #include <cerrno>
 #include <cstring>
 
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
 namespace mio {
 
 FilterParticle::FilterParticle(const std::vector< std::pair<std::string, std::string> >& vecArgs, const std::string& name, const Config& cfg)
-        : ProcessingBlock(vecArgs, name, cfg), filter_alg(PF_SIR), resample_alg(PF_SYSTEMATIC), NN(500), path_resampling(true),
+        : ProcessingBlock(vecArgs, name, cfg), filter_alg(PF_SIR), resample_alg(PF_SYSTEMATIC), NN(500), path_resampling(true), parallel(false),
           model_expression(""), obs_model_expression(""), fit_expression(""), fit_param(""), fit_degree(3), model_x0(IOUtils::nodata),
 		  resample_percentile(0.5), estim_measure(PF_MEAN), rng_model(), rng_obs(), rng_prior(), resample_seed(),
           be_verbose(true), unrecognized_keys(""), dump_particles_file(""), dump_states_file(""), input_states_file("")
@@ -67,11 +73,10 @@ void FilterParticle::process(const unsigned int& param, const std::vector<MeteoD
 	RandomNumberGenerator RNU; //uniforms for resampling
 	seedGeneratorsFromIni(RNGU, RNGV, RNG0, RNU);
 
-	//init states:
-	Matrix xx(NN, TT); //particles
-	Matrix zz(TT, (size_t)1); //observations
-	vecMeteoToMatrix(ivec, zz, param);
-	Matrix ww(NN, TT); //weights of particles
+	//init states: only the particles of the previous and current time steps are kept, as contiguous arrays
+	std::vector<double> xx(NN), ww(NN); //particles and their weights at the current time step
+	std::vector<double> xx_prev(NN), ww_prev(NN); //same for the previous time step
+	std::vector<double> noise(NN), res_obs(NN), buffer(NN);
 	const std::vector<double> tVec = buildTimeVector(ivec);
 
 	bool instates_success(false);
@@ -79,23 +84,29 @@ void FilterParticle::process(const unsigned int& param, const std::vector<MeteoD
 	if (!input_states_file.empty()) //there is data saved from a previous run
 		instates_success = readInternalStates(xx, ww);  //online data aggregation	
 	if (!instates_success) { //start from the initial value
-		xx(1, 1) = model_x0;
-		ww(1, 1) = 1. / NN;
-		for (size_t nn = 1; nn < NN; ++nn) { //draw from prior pdf for initial state of particles at T=0
-			xx(nn+1, 1) = xx(1, 1) + RNG0.doub();
-			ww(nn+1, 1) = 1. / NN; //starting up, all particles have the same weight
+		xx[0] = model_x0;
+		ww[0] = 1. / NN;
+		if (NN > 1) RNG0.fill(&xx[1], NN-1); //draw from prior pdf for initial state of particles at T=0
+		for (size_t nn = 1; nn < NN; ++nn) {
+			xx[nn] += xx[0];
+			ww[nn] = 1. / NN; //starting up, all particles have the same weight
 		}
 	}
 
+	Matrix paths; //only kept if the particles have to be written out
+	if (!dump_particles_file.empty()) {
+		paths.resize(NN, TT);
+		for (size_t nn = 0; nn < NN; ++nn) paths(nn+1, 1) = xx[nn];
+	}
+
 	//prepare system model and observation model expressions:
 	std::vector<std::string> sub_expr, sub_params;
 	parseSubstitutionStrings(model_expression, obs_model_expression, sub_expr, sub_params); //get substitution strings and index map for the meteo parameters
 	std::vector<double> sub_values(sub_expr.size()); //empty so far but with reserved memory to point to
 
-	te_variable *te_vars = new te_variable[sub_expr.size()];
-	initFunctionVars(te_vars, sub_expr, sub_values); //build te_variables from substitution vectors
-	te_expr *expr_model = nullptr; //only compile if available
-	te_expr *expr_obs = compileExpression(obs_model_expression, te_vars, sub_expr.size());
+	static const std::string where( "particle filter" );
+	Expression expr_model; //only compile if available
+	Expression expr_obs(obs_model_expression, sub_expr, where);
 
 	/*
 	 * SUBSTITUTIONS:
@@ -111,7 +122,7 @@ void FilterParticle::process(const unsigned int& param, const std::vector<MeteoD
 	std::vector<double> model_data_points;
 
 	if (has_model) {
-		expr_model = compileExpression(model_expression, te_vars, sub_expr.size()); //empty string would fail
+		expr_model.compile(model_expression, sub_expr, where); //empty string would fail
 	} else { //prepare a fit ready to evaluate
 		model_data_points.resize(ivec.size());
 		for (size_t ii = 0; ii < ivec.size(); ++ii) //read the modeled data points
@@ -123,134 +134,169 @@ void FilterParticle::process(const unsigned int& param, const std::vector<MeteoD
 		model_fit.fit();
 	} //endif has_model
 
+	std::vector<size_t> sub_idx( sub_params.size() ); //meteo parameters indices
+	for (size_t jj = 0; jj < sub_params.size(); ++jj) {
+		sub_idx[jj] = ivec.front().getParameterIndex( sub_params[jj] );
+		if (sub_idx[jj] == IOUtils::npos)
+			throw InvalidArgumentException("Parameter \"" + sub_params[jj] + "\" used in the particle filter's model not found.", AT);
+	}
+
+	//the particles are split into contiguous blocks, each with its own copy of the expressions
+#ifdef _OPENMP
+	const size_t nr_blocks = (parallel)? std::min(static_cast<size_t>(omp_get_max_threads()), static_cast<size_t>(NN)) : 1;
+#else
+	const size_t nr_blocks = 1;
+#endif
+	std::vector<Expression> vec_model(nr_blocks, expr_model), vec_obs(nr_blocks, expr_obs);
+
 	/* PARTICLE FILTER */
 
+	std::vector<double> xx_meas(TT); //most probable particle
+	xx_meas[0] = estimateState(xx, ww);
 	bool saw_nodata(false);
-	try {
-		for (size_t kk = 1; kk < TT; ++kk) { //for each TIME STEP (starting at 2nd)...
-			double col_weight_sum(0.);
-			if (has_model) {
-				sub_values[0] = (double)kk; //this vector is linked to tinyexpr expression memory
-				sub_values[1] = tVec[kk];
-				for (size_t jj = 0; jj < sub_params.size(); ++jj) //fill current meteo parameters
-					sub_values[jj+nr_hardcoded_sub] = ivec[kk](IOUtils::strToUpper(sub_params[jj]));
-			} //endif has_model
-
-			if (ivec[kk](param) == IOUtils::nodata) {
-				xx.setCol(kk+1, xx.getCol(kk)); //repeat particles for nodata values
-				ww.setCol(kk+1, ww.getCol(kk)); //the mean gets skewed a little
-				saw_nodata = true;
-			} else {
-				if (filter_alg == PF_SIR) { //SIR algorithm, algorithm 4 of Ref. [AM+02]:
-					for (size_t nn = 0; nn < NN; ++nn) { //for each PARTICLE...
-						double res;
-						if (has_model) { //arithmetic equation
-							sub_values[3] = xx(nn+1, kk);
-							res = te_eval(expr_model); //evaluate expression with current substitution values
-						} else { //model data points
-							res = model_fit.f(tVec[kk]);
-						}
-						xx(nn+1, kk+1) = res + RNGU.doub(); //generate system noise
-						sub_values[2] = xx(nn+1, kk+1);
-						const double res_obs = te_eval(expr_obs);
-						ww(nn+1, kk+1) = ww(nn+1, kk) * RNGV.pdf( zz(kk+1, 1) - res_obs ); //Ref. [AM+02] Eq. (63)
-						col_weight_sum += ww(nn+1, kk+1);
-					} //endfor nn
-				} else { //should currently not be reachable since we don't yet read any ini key for this
-					throw InvalidArgumentException("This algorithm is not supported in the particle filter. Only SIR is available for now.", AT);
+	for (size_t kk = 1; kk < TT; ++kk) { //for each TIME STEP (starting at 2nd)...
+		xx.swap( xx_prev );
+		ww.swap( ww_prev );
+		const double zz = ivec[kk](param);
+
+		if (zz == IOUtils::nodata) {
+			xx = xx_prev; //repeat particles for nodata values
+			ww = ww_prev; //the mean gets skewed a little
+			saw_nodata = true;
+		} else {
+			if (filter_alg != PF_SIR) //should currently not be reachable since we don't yet read any ini key for this
+				throw InvalidArgumentException("This algorithm is not supported in the particle filter. Only SIR is available for now.", AT);
+
+			//SIR algorithm, algorithm 4 of Ref. [AM+02]
+			sub_values[0] = (double)kk;
+			sub_values[1] = tVec[kk];
+			for (size_t jj = 0; jj < sub_params.size(); ++jj) //fill current meteo parameters
+				sub_values[jj+nr_hardcoded_sub] = ivec[kk](sub_idx[jj]);
+			const double fit_value = (has_model)? IOUtils::nodata : model_fit.f(tVec[kk]); //model data points
+			RNGU.fill(&noise[0], NN); //draw the system noise, always in the same order
+
+			std::exception_ptr error;
+#pragma omp parallel for schedule(static) if(nr_blocks>1)
+			for (int bb = 0; bb < static_cast<int>(nr_blocks); ++bb) { //for each block of PARTICLES...
+				try {
+					const size_t start = (bb * NN) / nr_blocks;
+					const size_t count = ((bb + 1) * NN) / nr_blocks - start;
+					std::vector<const double*> columns(sub_values.size(), nullptr); //the other variables are constant over the particles
+					for (size_t jj = 0; jj < sub_values.size(); ++jj)
+						vec_obs[bb].setVariable(jj, sub_values[jj]);
+
+					if (has_model) { //arithmetic equation
+						for (size_t jj = 0; jj < sub_values.size(); ++jj)
+							vec_model[bb].setVariable(jj, sub_values[jj]);
+						columns[3] = &xx_prev[start];
+						vec_model[bb].evaluate(columns, count, &xx[start]);
+					} else {
+						std::fill(xx.begin() + start, xx.begin() + start + count, fit_value);
+					}
+					for (size_t nn = start; nn < start + count; ++nn)
+						xx[nn] += noise[nn]; //generate system noise
+
+					columns[2] = &xx[start];
+					columns[3] = &xx_prev[start];
+					vec_obs[bb].evaluate(columns, count, &res_obs[start]);
+					for (size_t nn = start; nn < start + count; ++nn)
+						ww[nn] = ww_prev[nn] * RNGV.pdf( zz - res_obs[nn] ); //Ref. [AM+02] Eq. (63)
+				} catch (...) { //exceptions can not cross the parallel region
+#pragma omp critical(particle_filter_error)
+					if (!error) error = std::current_exception();
 				}
-			} //endif nodata
+			} //endfor bb
+			if (error) std::rethrow_exception( error );
+		} //endif nodata
 
-			for (size_t ii = 0; ii < NN; ++ii)
-				ww(ii+1, kk+1) /= col_weight_sum;
-
-			if (path_resampling)
-				resamplePaths(xx, ww, kk, RNU);
+		double weight_sum(0.);
+		for (size_t nn = 0; nn < NN; ++nn)
+			weight_sum += ww[nn];
+		for (size_t nn = 0; nn < NN; ++nn)
+			ww[nn] /= weight_sum;
 
-		} //endfor kk
-	} catch (...) { //we could get a "nonexistent meteo parameter" error above
-		if (has_model)
-			te_free(expr_model);
-		te_free(expr_obs);
-		delete[] te_vars;
-		throw;
-	}
+		if (path_resampling)
+			resamplePaths(xx, ww, buffer, RNU);
 
-	Matrix xx_meas(TT, (size_t)1); //most probable particle
-	if (estim_measure == PF_MAX_WEIGHT) { //find the highest weight and pick this path
-		size_t max_row, max_col;
-		for (size_t kk = 0; kk < TT; ++kk) {
-			(void) ww.getCol(kk+1).maxCoeff(max_row, max_col);
-			xx_meas(kk+1, 1) = xx(max_row, max_col);
-		}
-	} else { //average by multiplying all particles with their weights
-		for (size_t kk = 0; kk < TT; ++kk) {
-			xx_meas(kk+1, 1) = 0.;
-			for (size_t nn = 0; nn < NN; ++nn)
-				xx_meas(kk+1, 1) += xx(nn+1, kk+1) * ww(nn+1, kk+1);
-		}
-	}
+		xx_meas[kk] = estimateState(xx, ww);
+		if (!dump_particles_file.empty())
+			for (size_t nn = 0; nn < NN; ++nn) paths(nn+1, kk+1) = xx[nn];
+	} //endfor kk
 
 	for (size_t kk = 0; kk < TT; ++kk) {
 		sub_values[0] = (double)kk;
 		sub_values[1] = tVec[kk];
-		sub_values[2] = xx_meas(kk+1, 1);
-		sub_values[3] = (kk == 0)? model_x0 : xx_meas(kk, 1); //somewhat arbitrary at T=0 - this substitution is meant for the system model
+		sub_values[2] = xx_meas[kk];
+		sub_values[3] = (kk == 0)? model_x0 : xx_meas[kk-1]; //somewhat arbitrary at T=0 - this substitution is meant for the system model
 		for (size_t jj = 0; jj < sub_params.size(); ++jj) //fill current meteo parameters
-			sub_values[jj+nr_hardcoded_sub] = ivec[kk](sub_params[jj]);
-		const double res = te_eval(expr_obs); //filtered observation (model function of mean state [= estimated likely state])
+			sub_values[jj+nr_hardcoded_sub] = ivec[kk](sub_idx[jj]);
+		const double res = expr_obs.evaluate( &sub_values[0] ); //filtered observation (model function of mean state [= estimated likely state])
 		ovec[kk](param) = isNan(res)? IOUtils::nodata : res; //NaN to nodata
 	}
 
-	if (has_model)
-		te_free(expr_model);
-	te_free(expr_obs);
-	delete[] te_vars;
-
 	if (be_verbose && saw_nodata) std::cerr << "[W] Nodata value(s) encountered in particle filter. For this, the previous particle was repeated. You should probably resample beforehand.\n";
 	if (!dump_states_file.empty())
 		dumpInternalStates(xx, ww);
 	if (!dump_particles_file.empty())
-		dumpParticlePaths(xx);
+		dumpParticlePaths(paths);
 
 }
 
+/**
+ * @brief Estimate the most likely state from the particles of a time step.
+ * @param[in] xx The particles.
+ * @param[in] ww The particles' weights.
+ * @return Mean of the particles weighted by their weights, or particle with the highest weight (cf. ESTIMATION_MEASURE).
+ */
+double FilterParticle::estimateState(const std::vector<double>& xx, const std::vector<double>& ww) const
+{
+	if (estim_measure == PF_MAX_WEIGHT) { //find the highest weight and pick this path
+		const size_t max_idx = static_cast<size_t>( std::max_element(ww.begin(), ww.end()) - ww.begin() );
+		return xx[max_idx];
+	}
+
+	double sum = 0.; //average by multiplying all particles with their weights
+	for (size_t nn = 0; nn < xx.size(); ++nn)
+		sum += xx[nn] * ww[nn];
+	return sum;
+}
+
 /**
  * @brief Particle path resampling to mitigate degeneracy problem.
  * @details The paths may lead to very low weights that will eat up a lot of computational power and not yield the most
  * usable results. Hence, the paths can be resampled (cf. main documentation).
  * @param[in,out] xx The particles to resample.
  * @param[in,out] ww The particles' weights.
+ * @param[in] buffer Work space of the same size as the particles.
  * @param[in] RNU A generator that we keep in scope that is used for uniform random numbers.
  */
-void FilterParticle::resamplePaths(Matrix& xx, Matrix& ww, const size_t& kk, RandomNumberGenerator& RNU) const
+void FilterParticle::resamplePaths(std::vector<double>& xx, std::vector<double>& ww, std::vector<double>& buffer, RandomNumberGenerator& RNU) const
 { //if a lot of computational power is devoted to particles with low contribution (low weight), resample the paths
 	if (resample_alg == PF_SYSTEMATIC) { //algorithm 2 of Ref. [AM+02]
 		double N_eff = 0.; //effective sample size, Ref. [AM+02] Eq. (50)
 		for (size_t nn = 0; nn < NN; ++nn)
-			N_eff += ww(nn+1, kk+1)*ww(nn+1, kk+1);
+			N_eff += ww[nn]*ww[nn];
 		N_eff = 1. / N_eff; //a small N_eff indicates severe degeneracy
 
 		if (N_eff < resample_percentile * (double)NN)
 		{ //Strictly, SIR resamples at each point. Practically, a simple heuristic is more suitable (e. g. Ref. [DJ09])
-			std::vector<double> cdf(NN);
-			cdf.front() = 0.;
+			std::vector<double>& cdf = ww; //construct cumulative density function in place (the weights are reset anyway)
 			for (size_t nn = 1; nn < NN; ++nn)
-				cdf[nn] = cdf[nn-1] + ww(nn+1, kk+1); //construct cumulative density function
+				cdf[nn] = cdf[nn-1] + cdf[nn]; //ww[nn] is still the weight at this point
 			cdf.back() = 1.0; //round-off protection
 
 			double rr = RNU.doub() / NN;
-
+			size_t jj = 0; //since rr only grows, the search can go on from the previous position: O(N)
 			for (size_t nn = 0; nn < NN; ++nn) //for each PARTICLE...
 			{ //at the selected index the cdf is likely to have jumped --> particle with high weight --> reuse that one
-				size_t jj = 0;
 				while (rr > cdf[jj])
 					++jj; //check which range in the cdf the random number belongs to...
-				xx(nn+1, kk+1) = xx(jj+1, kk+1); //... and use that index
-				ww(nn+1, kk+1) = 1. / NN; //all resampled particles have the same weight
+				buffer[nn] = xx[jj]; //... and use that index
 				rr += 1. / NN; //move along cdf
 			} //note: bottleneck for parallelization since all particles must be known at this point
 
+			xx.swap( buffer );
+			std::fill(ww.begin(), ww.end(), 1. / NN); //all resampled particles have the same weight
 		} //endif N_eff
 
 	} else {
@@ -282,42 +328,6 @@ bool FilterParticle::checkInitialState(const std::vector<MeteoData>& ivec, const
 	return true;
 }
 
-/**
- * @brief Helper function to put substitutions in tinyexpr's format.
- * @param[out] vars tinyexpr formatted substitutions.
- * @param[in] expr List of variable names to substitute.
- * @param[in] values List of variable values to substitute for.
- */
-void FilterParticle::initFunctionVars(te_variable* vars, const std::vector<std::string>& expr, const std::vector<double>& values) const
-{ //build a substitutions expression for tinyexpr
-	if (values.size() != expr.size())
-		throw InvalidArgumentException("Particle filter: error mapping meteo(param) fields to meteo values. Are all fields available?\n", AT);
-
-	for (size_t ii = 0; ii < expr.size(); ++ii) {
-		vars[ii].name = expr[ii].c_str();
-		vars[ii].address = &values.data()[ii];
-		vars[ii].type = 0;
-		vars[ii].context = nullptr;
-	}
-}
-
-/**
- * @brief Helper function to call tinyexpr compilation and throw an error if this fails.
- * @param[in] expression The model equation to compile.
- * @param[in] te_vars Substitutions carried out in the model expression (variables).
- * @param[in] sz Number of substitutions.
- * @return The compiled tinyexpr expression ready to evaluate the function.
- */
-te_expr* FilterParticle::compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const
-{ //ready the lazy expressions (with syntax check)
-	int te_err;
-	te_expr *expr = te_compile(expression.c_str(), te_vars, (int)sz, &te_err);
-	if (!expr)
-		throw InvalidFormatException("Arithmetic expression \"" + expression +
-		        "\" could not be evaluated for particle filter; parse error at " + IOUtils::toString(te_err), AT);
-	return expr;
-}
-
 /**
  * @brief Construct a mapping of currently used substitutions such as meteo(TA) to their respective parameter names (TA).
  * @details Substitutions can be done in the system and observation equations. This function parses them both for all
@@ -379,7 +389,7 @@ void FilterParticle::parseBracketExpression(std::string& line, std::vector<std::
  * @param[in] particles The particles matrix with particles as the rows, and time steps as the columns. Last column is output.
  * @param[in] weights The weights associated with the particles.
  */
-void FilterParticle::dumpInternalStates(Matrix& particles, Matrix& weights) const
+void FilterParticle::dumpInternalStates(const std::vector<double>& particles, const std::vector<double>& weights) const
 { //using this, we are able to resume our filter without having to recalculate the past if new data arrives
 	ofilestream oss(dump_states_file.c_str(), std::ofstream::out);
 	if (oss.fail()) {
@@ -393,9 +403,9 @@ void FilterParticle::dumpInternalStates(Matrix& particles, Matrix& weights) cons
 	static const int digits = std::numeric_limits<double>::digits10;
 	oss.precision(digits);
 	oss.setf(std::ios::fixed);
-	for (size_t ii = 0; ii < particles.getNy(); ++ii) {
-		oss << std::setw(digits) << particles(ii+1, particles.getNx()) << "   ";
-		oss << std::setw(digits) << weights(ii+1, weights.getNx()) << std::endl;
+	for (size_t ii = 0; ii < particles.size(); ++ii) {
+		oss << std::setw(digits) << particles[ii] << "   ";
+		oss << std::setw(digits) << weights[ii] << std::endl;
 	}
 	oss.close();
 }
@@ -408,7 +418,7 @@ void FilterParticle::dumpInternalStates(Matrix& particles, Matrix& weights) cons
  * @param[in] weights Same as for particles.
  * @return True if reading was successful (file exists and has particles that fit the current settings).
  */
-bool FilterParticle::readInternalStates(Matrix& particles, Matrix& weights) const
+bool FilterParticle::readInternalStates(std::vector<double>& particles, std::vector<double>& weights) const
 {
 	std::vector<double> xx, ww;
 	try {
@@ -417,15 +427,13 @@ bool FilterParticle::readInternalStates(Matrix& particles, Matrix& weights) cons
 		return false;
 	}
 
-	if ( (unsigned int)particles.getNy() != xx.size() || (unsigned int)weights.getNy() != ww.size() ) {
+	if ( particles.size() != xx.size() || weights.size() != ww.size() ) {
 		if (be_verbose) std::cerr << "[W] Particle filter file input via INPUT_STATES_FILE does not match the number of particles. Using INITIAL_STATE.\n";
 		return false;
 	}
 
-	for (size_t ii = 0; ii < particles.getNy(); ++ii) { //fill first columns
-		particles(ii+1, 1) = xx[ii];
-		weights(ii+1, 1) = ww[ii];
-	}
+	particles.swap( xx );
+	weights.swap( ww );
 
 	return true;
 }
@@ -437,7 +445,7 @@ bool FilterParticle::readInternalStates(Matrix& particles, Matrix& weights) cons
  * is a mini MATLAB routine hidden in a comment that visualizes the kernel density.
  * @param[in] particles Particle paths with rows denoting the particles, and columns the time steps.
  */
-void FilterParticle::dumpParticlePaths(Matrix& particles) const
+void FilterParticle::dumpParticlePaths(const Matrix& particles) const
 { //to plot paths and kernel density outside of MeteoIO
 	ofilestream oss(dump_particles_file.c_str(), std::ofstream::out);
 	if (oss.fail()) {
@@ -518,6 +526,8 @@ void FilterParticle::parse_args(const std::vector< std::pair<std::string, std::s
 			IOUtils::parseArg(vecArgs[ii], where, path_resampling);
 		} else if (vecArgs[ii].first == "RESAMPLE_PERCENTILE") {
 			IOUtils::parseArg(vecArgs[ii], where, resample_percentile);
+		} else if (vecArgs[ii].first == "PARALLEL") {
+			IOUtils::parseArg(vecArgs[ii], where, parallel);
 		}
 
 		/*** MISC settings ***/
@@ -616,20 +626,6 @@ void FilterParticle::seedGeneratorsFromIni(RandomNumberGenerator& RNGU, RandomNu
 		RNU.setState(resample_seed);
 }
 
-/**
- * @brief Copy data from a meteo set into a vector.
- * @details One specified parameter of the meteo data is extracted to a double vector.
- * @param[in] vec Vector holding the meteo data as given to .process().
- * @param[out] eig Output vector with only one parameter's values.
- * @param[in] param Index of the desired meteo parameter.
- */
-void FilterParticle::vecMeteoToMatrix(const std::vector<MeteoData>& vec, Matrix& mat, const unsigned int& param) const
-{ //naive copy of 1 meteo parameter in STL vector to Matrix class vector
-	mat.resize(vec.size(), 1);
-	for (size_t ii = 0; ii < vec.size(); ++ii)
-		mat(ii+1, 1) = vec[ii](param);
-}
-
 /**
  * @brief Read an ini line to a vector.
  * @details There are global versions of this in IOUtils, this one reads into an uint64_t vector and is used for
@@ -23,8 +23,7 @@
 #include <meteoio/dataClasses/Matrix.h>
 #include <meteoio/meteoFilters/ProcessingBlock.h>
 #include <meteoio/meteoStats/RandomNumberGenerator.h>
-
-#include <meteoio/thirdParty/tinyexpr.h>
+#include <meteoio/Expression.h>
 
 #include <inttypes.h> //for RNG int types
 #include <string>
@@ -166,6 +165,8 @@ namespace mio {
  * 4. <b>State at the previous time</b> step: "x_km1" (read: \f$x_{k-1}\f$)
  * 5. Any available <b>meteo parameter</b>: "meteo(PARAM)" <br>
  * Number 3 is only available for the observations model and number 4 picks the initial state for `T=0` for the observation model.
+ * While filtering, "x_km1" in the observation model is each particle's previous state, also when the system model is a data fit
+ * (MODEL_FUNCTION = FIT ...). Older versions left it at 0 in this case, so such setups give different results now.
  * @note The time vector `tt` is a normalized and shifted version of the date such that the time of the first measurement is at 0 and the
  * second one is at 1. Suppose you had measurements at 00:00, 01:00, and 01:30 then `kk` would be `[0, 1, 2]` and `tt` would be `[0, 1, 1.5]`.
  *
@@ -289,6 +290,8 @@ namespace mio {
  * weights in favor of more meaningful ones (algorithm 2 of Ref. [AM+02]). However, it does decrease diversity (by selecting
  * particles with high weight multiple times) and for very small process noise the particles collapse to a single point
  * within a couple of iterations ("sample impoverishment").
+ * The cumulative weights start with the first particle's weight (\f$c_1 = w_1\f$ as in the reference). Older versions started
+ * them at 0, which shifted the selection towards the next particle, so resampled results differ from theirs.
  *
  * @note Bruteforcing the particle number helps with the _degeneracy problem_.
  *
@@ -349,6 +352,17 @@ namespace mio {
  * @note The last one is an internal uniform generator needed by the particle filter itself (with fixed distribution parameters).
  * @note The number of seeds must match the one the RNG algorithm expects: cf. RandomNumberGenerator.
  *
+ * @subsubsection particleparallel Large numbers of particles
+ *
+ * Only the particles of the current time step are kept in memory (unless `DUMP_PARTICLES_FILE` is set) and the model and
+ * observation functions are evaluated over all particles at once. If MeteoIO has been compiled with OpenMP (USE_OPENMP), the
+ * particles can be split into one block per thread:
+ * @code
+ * PARALLEL = TRUE
+ * @endcode
+ * The random numbers are always drawn in bulk and in the same order as in a sequential run, so for given seeds the results
+ * do not depend on the number of threads.
+ *
  * @subsection particlekeys List of ini keys
  *  <table>
  *  <tr><th>Keyword</th><th>Meaning</th><th>Optional</th><th>Default Value</th></tr>
@@ -363,6 +377,7 @@ namespace mio {
  *  <tr><td>DUMP_PARTICLES_FILE</td><td>Output file path for the particles.</td><td>yes</td><td>empty</td></tr>
  *  <tr><td>DUMP_INTERNAL_STATES_FILE</td><td>Output file path for the internal states.</td><td>yes</td><td>empty</td></tr>
  *  <tr><td>INPUT_INTERNAL_STATES_FILE</td><td>Input file path for the internal states.</td><td>yes</td><td>empty</td></tr>
+ *  <tr><td>PARALLEL</td><td>Process the particles in parallel (requires OpenMP).</td><td>yes</td><td>FALSE</td></tr>
  *  <tr><td>VERBOSE</td><td>Output warnings to the console.</td><td>yes</td><td>TRUE, warnings should be mitigated</td></tr>
  *  <tr><td>MODEL_RNG_ALGORITHM</td><td>Random numbers generator function for the model.</td><td>yes</td><td>XOR</td></tr>
  *  <tr><td>MODEL_RNG_DISTRIBUTION</td><td>Random numbers distribution for the model.</td><td>yes</td><td>GAUSS</td></tr>
@@ -416,22 +431,20 @@ class FilterParticle : public ProcessingBlock {
 		        std::vector<MeteoData>& ovec);
 
 	private:
-		void resamplePaths(Matrix& xx, Matrix& ww, const size_t& kk, RandomNumberGenerator& RNU) const;
+		double estimateState(const std::vector<double>& xx, const std::vector<double>& ww) const;
+		void resamplePaths(std::vector<double>& xx, std::vector<double>& ww, std::vector<double>& buffer, RandomNumberGenerator& RNU) const;
 		bool checkInitialState(const std::vector<MeteoData>& ivec, const size_t& param);
-		void initFunctionVars(te_variable* vars, const std::vector<std::string>& names, const std::vector<double>& meteo) const;
-		te_expr* compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const;
 		void parseSubstitutionStrings(std::string& line_m, std::string& line_o, std::vector<std::string>& sub_expr,
 		        std::vector<std::string>& sub_params) const;
 		void parseBracketExpression(std::string& line, std::vector<std::string>& sub_expr,
 		        std::vector<std::string>& sub_params) const;
-		void dumpInternalStates(Matrix& particles, Matrix& weights) const;
-		bool readInternalStates(Matrix& particles, Matrix& weights) const;
-		void dumpParticlePaths(Matrix& particles) const;
+		void dumpInternalStates(const std::vector<double>& particles, const std::vector<double>& weights) const;
+		bool readInternalStates(std::vector<double>& particles, std::vector<double>& weights) const;
+		void dumpParticlePaths(const Matrix& particles) const;
 		std::vector<double> buildTimeVector(const std::vector<MeteoData>& ivec) const;
 		void parse_args(const std::vector< std::pair<std::string, std::string> >& vecArgs);
 		void seedGeneratorsFromIni(RandomNumberGenerator& RNGU, RandomNumberGenerator& RNGV, RandomNumberGenerator& RNG0,
 		        RandomNumberGenerator& RNU) const;
-		void vecMeteoToMatrix(const std::vector<MeteoData>& vec, Matrix& mat, const unsigned int& param) const;
 		void readLineToVec(const std::string& line_in, std::vector<uint64_t>& vec_out) const;
 		bool isNan(const double& xx) const;
 
@@ -453,6 +466,7 @@ class FilterParticle : public ProcessingBlock {
 
 		unsigned int NN; //number of particles
 		bool path_resampling; //has nothing to do with temporal or spatial meteo resampling
+		bool parallel; //process blocks of particles concurrently
 
 		std::string model_expression; //model formula
 		std::string obs_model_expression;
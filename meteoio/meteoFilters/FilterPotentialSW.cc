@@ -59,7 +59,7 @@ void FilterPotentialSW::process(const unsigned int& param, const std::vector<Met
 			RH = 0.666;
 		}
 
-		const Coords position( ovec[ii].meta.position );
+		const Coords position( ovec[ii].meta->position );
 		Sun.setLatLon(position.getLat(), position.getLon(), position.getAltitude()); //if they are constant, nothing will be recomputed
 		Sun.setDate(ovec[ii].date.getJulian(true), 0.); //quicker: we stick to gmt
 		double toa_h, direct_h, diffuse_h;
@@ -97,7 +97,7 @@ void FilterSuppr::process(const unsigned int& param, const std::vector<MeteoData
 //this assumes that the DATES_RANGEs in suppr_dates have been sorted by increasing starting dates
 void FilterSuppr::supprByDates(const unsigned int& param, std::vector<MeteoData>& ovec) const
 {
-	const std::string station_ID( ovec[0].meta.stationID ); //we know it is not empty
+	const std::string station_ID( ovec[0].meta->stationID ); //we know it is not empty
 	const std::map< std::string, std::vector<DateRange> >::const_iterator station_it( suppr_dates.find( station_ID ) );
 	if (station_it==suppr_dates.end()) return;
 
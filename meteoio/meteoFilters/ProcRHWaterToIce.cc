@@ -39,16 +39,24 @@ void ProcRHWaterToIce::process(const unsigned int& param, const std::vector<Mete
 		throw InvalidArgumentException("Trying to use "+getName()+" filter on " + MeteoData::getParameterName(param) + " but it can only be applied to RH!!" + getName(), AT);
 	ovec = ivec;
 
+	//collect the temperatures, so the saturation pressures are computed on whole arrays
+	std::vector<size_t> vecIdx;
+	std::vector<double> vecTA;
 	for (size_t ii=0; ii<ovec.size(); ii++) {
-		double& tmp = ovec[ii](param);
 		const double TA = ovec[ii](MeteoData::TA);
-
-		if (tmp == IOUtils::nodata || TA==IOUtils::nodata) {
+		if (ovec[ii](param) == IOUtils::nodata || TA==IOUtils::nodata) {
 			continue; //preserve nodata values and no precip
 		}
-
-		tmp *= Atmosphere::vaporSaturationPressureWater(TA) / Atmosphere::vaporSaturationPressure(TA);
+		vecIdx.push_back( ii );
+		vecTA.push_back( TA );
 	}
+	if (vecIdx.empty()) return;
+
+	const size_t n = vecIdx.size();
+	std::vector<double> psat_water( n ), psat( n );
+	Atmosphere::vaporSaturationPressureWater(&vecTA[0], n, &psat_water[0]);
+	Atmosphere::vaporSaturationPressure(&vecTA[0], n, &psat[0]);
+	for (size_t kk=0; kk<n; kk++) ovec[ vecIdx[kk] ](param) *= psat_water[kk] / psat[kk];
 }
 
 } //end namespace
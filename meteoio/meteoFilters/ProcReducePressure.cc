@@ -41,8 +41,8 @@ void ProcReducePressure::process(const unsigned int& param, const std::vector<Me
 		double& tmp = ovec[ii](param);
 		if (tmp==IOUtils::nodata) continue;
 		
-		const double lat = ovec[ii].meta.position.getLat();
-		const double alt = ovec[ii].meta.position.getAltitude();
+		const double lat = ovec[ii].meta->position.getLat();
+		const double alt = ovec[ii].meta->position.getAltitude();
 		
 		if (lat!=IOUtils::nodata && alt!=IOUtils::nodata) {
 			tmp = Atmosphere::reducedAirPressure(tmp, lat, alt);
@@ -70,7 +70,7 @@ void ProcShade::process(const unsigned int& param, const std::vector<MeteoData>&
 		if (tmp == IOUtils::nodata) continue; //preserve nodata values
 		if (tmp<diffuse_thresh) continue; //only diffuse radiation, there is nothing to correct
 
-		const Coords position( ovec[ii].meta.position );
+		const Coords position( ovec[ii].meta->position );
 		Sun.setLatLon(position.getLat(), position.getLon(), position.getAltitude()); //if they are constant, nothing will be recomputed
 		Sun.setDate(ovec[ii].date.getJulian(true), 0.); //quicker: we stick to gmt
 		double sun_azi, sun_elev;
@@ -253,8 +253,8 @@ void ProcTransformWindVector::process(const unsigned int& param, const std::vect
 		double vc = IOUtils::nodata;
 
 		// Get coordinates
-		const double lon = ivec[ii].meta.getPosition().getLon();
-		const double lat = ivec[ii].meta.getPosition().getLat();
+		const double lon = ivec[ii].meta->getPosition().getLon();
+		const double lat = ivec[ii].meta->getPosition().getLat();
 
 		// Check for wind speed components
 		const std::string U_param( findUComponent(ivec[ii]) );
@@ -304,7 +304,7 @@ void ProcTransformWindVector::process(const unsigned int& param, const std::vect
 
 		const double vw_old = u*u + v*v;	// For efficiency, we drop the sqrt.
 
-		// Get easting and northing of point in target coordinate system (given by ivec[ii].meta.getPosition())
+		// Get easting and northing of point in target coordinate system (given by ivec[ii].meta->getPosition())
 		double e0=0., n0=0.;
 		// Note that we do not use the easting and northing from getPosition, since those may be a different coordinate system.
 		TransformCoord(lon, lat, e0, n0);
@@ -324,7 +324,7 @@ void ProcTransformWindVector::process(const unsigned int& param, const std::vect
 		const double ratio = (et2!=e0 && nt2!=n0) ? (sqrt(  ((et1-e0)*(et1-e0) + (nt1-n0)*(nt1-n0)) / ((et2-e0)*(et2-e0) + (nt2-n0)*(nt2-n0))  )) : (1.);
 
 		// Transform wind speed vector
-		double e1, n1;		// end points of vector (start point is given by ivec[ii].meta.getPosition())
+		double e1, n1;		// end points of vector (start point is given by ivec[ii].meta->getPosition())
 		double u_new, v_new;	// transformed wind speed components
 		if (lat-(v*eps) >= -90. && lat-(v*eps) <= 90.) {
 			if (lon-(u*eps*ratio)>=-360. && lon-(u*eps*ratio)<=360.) {
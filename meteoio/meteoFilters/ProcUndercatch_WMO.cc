@@ -87,7 +87,7 @@ void ProcUndercatch_WMO::process(const unsigned int& param, const std::vector<Me
 		} else if (type==rt3_jp) {
 			if (VW==IOUtils::nodata) continue;
 			const double rh = ovec[ii](MeteoData::RH);
-			const double alt = ovec[ii].meta.position.getAltitude();
+			const double alt = ovec[ii].meta->position.getAltitude();
 			double k=100.;
 			if (rh!=IOUtils::nodata && alt!=IOUtils::nodata) {
 				const double t_wb = IOUtils::K_TO_C(Atmosphere::wetBulbTemperature(ovec[ii](MeteoData::TA), rh, alt));
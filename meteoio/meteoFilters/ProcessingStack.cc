@@ -17,6 +17,7 @@
     along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <meteoio/meteoFilters/ProcessingStack.h>
+#include <meteoio/Timer.h>
 
 #include <algorithm>
 
@@ -124,7 +125,7 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 	if (param == IOUtils::npos) return filterApplied;
 	
 	const size_t nr_of_filters = filter_stack.size();
-	const std::string statID( ivec.front().meta.getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
+	const std::string statID( ivec.front().meta->getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
 
 	//Now call the filters one after another for the current station and parameter
 	for (size_t jj=0; jj<nr_of_filters; jj++) {
@@ -138,7 +139,10 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 			continue;
 
 		//if the filter has not been applied (ie time restriction), move to the next one directly
+		ProfilerScope profile;
+		if (Profiler::isEnabled()) profile.start( "filter::" + param_name + "::" + filter_stack[jj]->getName() );
 		if (!applyFilter(param, jj, ivec, ovec[stat_idx])) continue;
+		profile.stop();
 		
 		filterApplied = true; //at least one filter has been applied in the whole stack
 		const size_t output_size = ovec[stat_idx].size();
@@ -150,7 +154,7 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 				if (orig!=filtered) {
 					ovec[stat_idx][kk].setFiltered(param);
 					if (data_qa_logs) {
-						const std::string statName( ovec[stat_idx][kk].meta.getStationName() );
+						const std::string statName( ovec[stat_idx][kk].meta->getStationName() );
 						const std::string stat = (!statID.empty())? statID : statName;
 						const std::string filtername( (*filter_stack[jj]).getName() );
 						cout << "[DATA_QA] Filtering " << stat << "::" << param_name << "::" << filtername << " " << ivec[kk].date.toString(Date::ISO_TZ) << " [" << ivec[kk].date.toString(Date::ISO_WEEK) << "]\n";
@@ -163,7 +167,7 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 				while (kk_out<output_size && ovec[stat_idx][kk_out].date < ivec[kk].date) { //new points inserted
 					ovec[stat_idx][kk_out].setFiltered(param);
 					if (data_qa_logs) {
-						const std::string statName( ovec[stat_idx][kk_out].meta.getStationName() );
+						const std::string statName( ovec[stat_idx][kk_out].meta->getStationName() );
 						const std::string stat = (!statID.empty())? statID : statName;
 						const std::string filtername( (*filter_stack[jj]).getName() );
 						cout << "[DATA_QA] Filtering " << stat << "::" << param_name << "::" << filtername << " " << ivec[kk].date.toString(Date::ISO_TZ) << " [" << ivec[kk].date.toString(Date::ISO_WEEK) << "]\n";
@@ -178,7 +182,7 @@ bool ProcessingStack::filterStation(std::vector<MeteoData> ivec,
 					if (orig!=filtered) {
 						ovec[stat_idx][kk_out].setFiltered(param);
 						if (data_qa_logs) {
-							const std::string statName( ovec[stat_idx][kk_out].meta.getStationName() );
+							const std::string statName( ovec[stat_idx][kk_out].meta->getStationName() );
 							const std::string stat = (!statID.empty())? statID : statName;
 							const std::string filtername( (*filter_stack[jj]).getName() );
 							cout << "[DATA_QA] Filtering " << stat << "::" << param_name << "::" << filtername << " " << ivec[kk].date.toString(Date::ISO_TZ) << " [" << ivec[kk].date.toString(Date::ISO_WEEK) << "]\n";
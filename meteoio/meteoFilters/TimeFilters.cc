@@ -26,6 +26,7 @@
 #include <meteoio/meteoFilters/TimeFilters.h>
 #include <meteoio/meteoFilters/ProcessingStack.h>
 #include <meteoio/FileUtils.h>
+#include <meteoio/Timer.h>
 
 using namespace std;
 
@@ -106,7 +107,7 @@ void TimeSuppr::process(const unsigned int& param, const std::vector<MeteoData>&
 //this assumes that the DateRange in suppr_dates have been sorted by increasing starting dates
 void TimeSuppr::supprByDates(std::vector<MeteoData>& ovec) const
 {
-	const std::string station_ID( ovec[0].meta.stationID ); //we know it is not empty
+	const std::string station_ID( ovec[0].meta->stationID ); //we know it is not empty
 	const std::map< std::string, std::vector<DateRange> >::const_iterator station_it( suppr_dates.find( station_ID ) );
 	if (station_it==suppr_dates.end()) return;
 
@@ -512,6 +513,7 @@ void TimeProcStack::process(Date &dateStart, Date &dateEnd)
 void TimeProcStack::process(std::vector< std::vector<MeteoData> >& ivec)
 {
 	if (!enable_time_filtering) return;
+	const ProfilerScope profile( "time_filters" );
 	
 	const size_t nr_of_filters = filter_stack.size();
 	const size_t nr_stations = ivec.size();
@@ -521,7 +523,7 @@ void TimeProcStack::process(std::vector< std::vector<MeteoData> >& ivec)
 	for (size_t ii=0; ii<nr_stations; ii++) { //for every station
 		if ( ivec[ii].empty() ) continue; //no data, nothing to do!
 		
-		const std::string statID( ivec[ii].front().meta.getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
+		const std::string statID( ivec[ii].front().meta->getStationID() ); //we know there is at least 1 element (we've already skipped empty vectors)
 		//Now call the filters one after another for the current station and parameter
 		for (size_t jj=0; jj<nr_of_filters; jj++) {
 			if (filter_stack[jj]->skipStation( statID ))
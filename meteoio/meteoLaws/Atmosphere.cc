@@ -1122,4 +1122,324 @@ double Atmosphere::relToSpecHumidity(const double& altitude, const double& TA, c
 	return 1./qi_inv;
 }
 
+// ------------------------------ Array versions ------------------------------
+
+/**
+* @brief Standard atmospheric pressure as a function of the altitude, for an array of altitudes.
+* @param[in] altitude altitudes above sea level (m)
+* @param[in] n number of values
+* @param[out] P standard pressures (Pa)
+*/
+void Atmosphere::stdAirPressure(const double* altitude, const size_t& n, double* P)
+{
+	static const double expo = Cst::gravity / (Cst::mean_adiabatique_lapse_rate * Cst::gaz_constant_dry_air);
+	static const double factor = Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 / Cst::std_temp;
+	for (size_t ii=0; ii<n; ii++) {
+		const double alt = altitude[ii];
+		const double p = Cst::std_press * pow( 1. - factor * alt / (Cst::earth_R0 + alt), expo );
+		P[ii] = (alt!=IOUtils::nodata)? p : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Standard water vapor saturation pressure, for an array of temperatures (see vaporSaturationPressure(const double&)).
+* @param[in] T air temperatures (K)
+* @param[in] n number of values
+* @param[out] Psat standard water vapor saturation pressures (Pa)
+*/
+void Atmosphere::vaporSaturationPressure(const double* T, const size_t& n, double* Psat)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double ta = T[ii];
+		const bool over_ice = (ta < Cst::t_water_triple_pt);
+		const double c2 = (over_ice)? 21.88 : 17.27;
+		const double c3 = (over_ice)? 7.66 : 35.86;
+		const double psat = Cst::p_water_triple_pt * exp( c2 * (ta - Cst::t_water_triple_pt) / (ta - c3) );
+		Psat[ii] = (ta!=IOUtils::nodata)? psat : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Standard water vapor saturation pressure over water, for an array of temperatures (see vaporSaturationPressureWater(const double&)).
+* @param[in] T air temperatures (K)
+* @param[in] n number of values
+* @param[out] Psat standard water vapor saturation pressures, assuming water surface (Pa)
+*/
+void Atmosphere::vaporSaturationPressureWater(const double* T, const size_t& n, double* Psat)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double ta = T[ii];
+		const double psat = Cst::p_water_triple_pt * exp( 17.27 * (ta - Cst::t_water_triple_pt) / (ta - 35.86) );
+		Psat[ii] = (ta!=IOUtils::nodata)? psat : IOUtils::nodata;
+	}
+}
+
+//Magnus formula coefficients for the dew point conversions, see RhtoDewPoint(double, double, const bool&)
+static const double Bw = 17.502, Cw = 240.97; //parameters for water
+static const double Bi = 22.452, Ci = 272.55; //parameters for ice
+static const double Tfreeze = 0.;                          //freezing temperature
+static const double Tnucl = -16.0;                         //nucleation temperature
+
+//weight of the water phase in the smooth transition between ice and water (TA in Celsius)
+static inline double waterWeight(const double& TA)
+{
+	if (TA>=Tfreeze) return 1.;
+	if (TA<Tnucl) return 0.;
+	const double di = 1. / ((TA - Tnucl) * (TA - Tnucl) + 1e-6);     //distance to pure ice
+	const double dw = 1. / ((Tfreeze - TA) * (Tfreeze - TA) + 1e-6); //distance to pure water
+	return dw / (di + dw);
+}
+
+/**
+* @brief Convert relative humidities to dew point temperatures (see RhtoDewPoint(double, double, const bool&)).
+* @details Since log(E/A) = log(RH) + B*TA/(C+TA), only one log() is required per value and phase.
+* @param[in] RH relative humidities between 0 and 1
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[in] force_water if set to true, compute over water. Otherwise, a smooth transition between over ice and over water is computed.
+* @param[out] TD dew point temperatures (K)
+*/
+void Atmosphere::RhtoDewPoint(const double* RH, const double* TA, const size_t& n, const bool& force_water, double* TD)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double rh = RH[ii], ta_k = TA[ii];
+		const double ta = IOUtils::K_TO_C(ta_k);
+		const double log_rh = log(rh + 0.0001); //in order to avoid getting NaN if RH=0
+
+		//the second phase is only computed within the transition between ice and water
+		const double w = (force_water)? 1. : waterWeight(ta);
+		const double B = (w>0.)? Bw : Bi;
+		const double C = (w>0.)? Cw : Ci;
+		const double x = log_rh + (B * ta) / (C + ta);
+		double Td = ( C * x ) / ( B - x );
+		if (w>0. && w<1.) {
+			const double xi = log_rh + (Bi * ta) / (Ci + ta);
+			const double Tdi = ( Ci * xi ) / ( Bi - xi );
+			Td = w * Td + (1. - w) * Tdi;
+		}
+		TD[ii] = (rh!=IOUtils::nodata && ta_k!=IOUtils::nodata)? IOUtils::C_TO_K(Td) : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Convert dew point temperatures to relative humidities (see DewPointtoRh(double, double, const bool&)).
+* @details Since E/Es = exp(B*TD/(C+TD) - B*TA/(C+TA)), only one exp() is required per value and phase.
+* @param[in] TD dew point temperatures (K)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[in] force_water if set to true, compute over water. Otherwise, a smooth transition between over ice and over water is computed.
+* @param[out] RH relative humidities between 0 and 1
+*/
+void Atmosphere::DewPointtoRh(const double* TD, const double* TA, const size_t& n, const bool& force_water, double* RH)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double td_k = TD[ii], ta_k = TA[ii];
+		const double ta = IOUtils::K_TO_C(ta_k);
+		const double td = IOUtils::K_TO_C(td_k);
+
+		//the second phase is only computed within the transition between ice and water
+		const double w = (force_water)? 1. : waterWeight(ta);
+		const double B = (w>0.)? Bw : Bi;
+		const double C = (w>0.)? Cw : Ci;
+		double Rh = exp( (B * td) / (C + td) - (B * ta) / (C + ta) );
+		if (w>0. && w<1.) {
+			const double Rhi = exp( (Bi * td) / (Ci + td) - (Bi * ta) / (Ci + ta) );
+			Rh = w * Rh + (1. - w) * Rhi;
+		}
+		RH[ii] = (td_k!=IOUtils::nodata && ta_k!=IOUtils::nodata)? std::min(Rh, 1.) : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Calculate the relative humidities from specific humidities (see specToRelHumidity(const double&, const double&, const double&)).
+* @param[in] altitude altitudes above sea level (m)
+* @param[in] TA air temperatures (K)
+* @param[in] qi specific humidities
+* @param[in] n number of values
+* @param[out] RH relative humidities between 0 and 1
+*/
+void Atmosphere::specToRelHumidity(const double* altitude, const double* TA, const double* qi, const size_t& n, double* RH)
+{
+	static const double expo = Cst::gravity / (Cst::mean_adiabatique_lapse_rate * Cst::gaz_constant_dry_air);
+	static const double factor = Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 / Cst::std_temp;
+	for (size_t ii=0; ii<n; ii++) {
+		const double alt = altitude[ii], ta = TA[ii], q = qi[ii];
+
+		const bool over_ice = (ta < Cst::t_water_triple_pt);
+		const double c2 = (over_ice)? 21.88 : 17.27;
+		const double c3 = (over_ice)? 7.66 : 35.86;
+		const double psat = Cst::p_water_triple_pt * exp( c2 * (ta - Cst::t_water_triple_pt) / (ta - c3) );
+		const double p = Cst::std_press * pow( 1. - factor * alt / (Cst::earth_R0 + alt), expo );
+		//the temperatures cancel out in the ratio of the dry air density to the saturated vapor density
+		const double density_ratio = (p * Cst::gaz_constant) / (Cst::gaz_constant_dry_air * Cst::water_molecular_mass * psat);
+		const double rh = std::min(q/(1.-q) * density_ratio, 1.);
+
+		RH[ii] = (alt!=IOUtils::nodata && ta!=IOUtils::nodata && q!=IOUtils::nodata)? rh : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Calculates the black body emissivities (see blkBody_Emissivity(const double&, const double&)).
+* @param[in] lwr longwave radiations emitted by the body (W m-2)
+* @param[in] T surface temperatures of the body (K)
+* @param[in] n number of values
+* @param[out] ea black body emissivities (0-1)
+*/
+void Atmosphere::blkBody_Emissivity(const double* lwr, const double* T, const size_t& n, double* ea)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double lw = lwr[ii], ta = T[ii];
+		const double T2 = ta*ta;
+		const double value = std::min(lw / (Cst::stefan_boltzmann * (T2*T2)), 1.);
+		ea[ii] = (lw!=IOUtils::nodata && ta!=IOUtils::nodata)? value : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Calculates the black body long wave radiations (see blkBody_Radiation(const double&, const double&)).
+* @param[in] ea emissivities of the body (0-1)
+* @param[in] T surface temperatures of the body (K)
+* @param[in] n number of values
+* @param[out] lwr black body radiations (W/m^2)
+*/
+void Atmosphere::blkBody_Radiation(const double* ea, const double* T, const size_t& n, double* lwr)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double e = ea[ii], ta = T[ii];
+		const double T2 = ta*ta;
+		const double value = e * (Cst::stefan_boltzmann * (T2*T2));
+		lwr[ii] = (e!=IOUtils::nodata && ta!=IOUtils::nodata)? value : IOUtils::nodata;
+	}
+}
+
+//apply a scalar ILWR parametrization on arrays, the nodata inputs leading to nodata
+template <double (*ilwr_law)(const double&, const double&)>
+static void clearSkyILWR(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double rh = RH[ii], ta = TA[ii];
+		ilwr[ii] = (rh!=IOUtils::nodata && ta!=IOUtils::nodata)? ilwr_law(rh, ta) : IOUtils::nodata;
+	}
+}
+
+template <double (*ilwr_law)(const double&, const double&, const double&)>
+static void cloudySkyILWR(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr)
+{
+	for (size_t ii=0; ii<n; ii++) {
+		const double rh = RH[ii], ta = TA[ii], cld = cloudiness[ii];
+		ilwr[ii] = (rh!=IOUtils::nodata && ta!=IOUtils::nodata && cld!=IOUtils::nodata)? ilwr_law(rh, ta, cld) : IOUtils::nodata;
+	}
+}
+
+/**
+* @brief Clear sky long wave radiations after Brutsaert (see Brutsaert_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Brutsaert_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Brutsaert_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief Clear sky long wave radiations after Dilley and O'Brien (see Dilley_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Dilley_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Dilley_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief Clear sky long wave radiations after Prata (see Prata_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Prata_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Prata_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief Clear sky long wave radiations after Clark & Allen (see Clark_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Clark_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Clark_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief Clear sky long wave radiations after Tang, Etzion and Meir (see Tang_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Tang_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Tang_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief Clear sky long wave radiations after Idso (see Idso_ilwr(const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Idso_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr)
+{
+	clearSkyILWR<&Atmosphere::Idso_ilwr>(RH, TA, n, ilwr);
+}
+
+/**
+* @brief All sky long wave radiations after Omstedt (see Omstedt_ilwr(const double&, const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] cloudiness cloudiness (between 0 and 1, 0 being clear sky)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Omstedt_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr)
+{
+	cloudySkyILWR<&Atmosphere::Omstedt_ilwr>(RH, TA, cloudiness, n, ilwr);
+}
+
+/**
+* @brief All sky long wave radiations after Konzelmann (see Konzelmann_ilwr(const double&, const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] cloudiness cloudiness (between 0 and 1, 0 being clear sky)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Konzelmann_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr)
+{
+	cloudySkyILWR<&Atmosphere::Konzelmann_ilwr>(RH, TA, cloudiness, n, ilwr);
+}
+
+/**
+* @brief All sky long wave radiations after Carmona, Rivas, and Caselles (see Carmona_ilwr(const double&, const double&, const double&)).
+* @param[in] RH relative humidities (between 0 and 1)
+* @param[in] TA air temperatures (K)
+* @param[in] cloudiness 1 - ratio of measured ISWR over potential ISWR (between 0 and 1, 0 being clear sky)
+* @param[in] n number of values
+* @param[out] ilwr long wave radiations (W/m^2)
+*/
+void Atmosphere::Carmona_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr)
+{
+	cloudySkyILWR<&Atmosphere::Carmona_ilwr>(RH, TA, cloudiness, n, ilwr);
+}
+
 } //namespace
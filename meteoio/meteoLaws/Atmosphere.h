@@ -27,6 +27,13 @@ namespace mio {
  * @class Atmosphere
  * @brief A class to calculate the atmosphere's parameters
  *
+ * @anchor atmosphere_arrays
+ * Some of the laws are also available for arrays of contiguous values (such as whole time series or the cells of a grid),
+ * with one pointer per input and one for the output, all of at least n elements (the output can be one of the inputs).
+ * Contrary to the scalar versions, any nodata input leads to a nodata output. The loops are kept as simple as possible so the compiler
+ * can vectorize what it is able to and the algebra has been rearranged so fewer exp() / log() are needed per value: the results are
+ * therefore the same as for the scalar versions up to rounding errors.
+ *
  * @ingroup meteoLaws
  * @author Mathias Bavay
  * @date   2010-06-10
@@ -97,6 +104,26 @@ class Atmosphere {
 
 		static double blkBody_Emissivity(const double& lwr, const double& T);
 		static double blkBody_Radiation(const double& ea, const double& T);
+
+		///array versions, for whole time series or grids (see \ref atmosphere_arrays "the notes about these versions")
+		static void stdAirPressure(const double* altitude, const size_t& n, double* P);
+		static void vaporSaturationPressure(const double* T, const size_t& n, double* Psat);
+		static void vaporSaturationPressureWater(const double* T, const size_t& n, double* Psat);
+		static void RhtoDewPoint(const double* RH, const double* TA, const size_t& n, const bool& force_water, double* TD);
+		static void DewPointtoRh(const double* TD, const double* TA, const size_t& n, const bool& force_water, double* RH);
+		static void specToRelHumidity(const double* altitude, const double* TA, const double* qi, const size_t& n, double* RH);
+		static void blkBody_Emissivity(const double* lwr, const double* T, const size_t& n, double* ea);
+		static void blkBody_Radiation(const double* ea, const double* T, const size_t& n, double* lwr);
+
+		static void Brutsaert_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Dilley_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Prata_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Clark_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Tang_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Idso_ilwr(const double* RH, const double* TA, const size_t& n, double* ilwr);
+		static void Omstedt_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr);
+		static void Konzelmann_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr);
+		static void Carmona_ilwr(const double* RH, const double* TA, const double* cloudiness, const size_t& n, double* ilwr);
 		
 		static const double day_iswr_thresh; //threhold on ISWR above which it is considered to be daylight
 };
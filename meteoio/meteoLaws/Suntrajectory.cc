@@ -20,6 +20,7 @@
 #include <string>
 #include <iomanip>
 #include <algorithm>
+#include <unordered_map>
 
 #include <meteoio/meteoLaws/Suntrajectory.h>
 #include <meteoio/meteoLaws/Meteoconst.h> //for math constants
@@ -30,6 +31,35 @@
 
 namespace mio {
 
+const size_t SolarEphemerisCache::max_size = 100000;
+
+namespace {
+	typedef std::unordered_map<double, SolarEphemerisCache::Ephemeris> EphemerisMap;
+
+	//one cache per thread, so no locking is required
+	EphemerisMap& ephemerisCache() {
+		static thread_local EphemerisMap cache;
+		return cache;
+	}
+}
+
+SolarEphemerisCache::Ephemeris SolarEphemerisCache::getEphemeris(const double& julian_gmt)
+{
+	EphemerisMap& cache = ephemerisCache();
+	const EphemerisMap::const_iterator it = cache.find(julian_gmt);
+	if (it!=cache.end()) return it->second;
+
+	const Ephemeris eph( SunMeeus::getEphemeris(julian_gmt) );
+	if (cache.size()>=max_size) cache.clear();
+	cache[julian_gmt] = eph;
+	return eph;
+}
+
+void SolarEphemerisCache::clear()
+{
+	ephemerisCache().clear();
+}
+
 SunTrajectory::SunTrajectory() : julian_gmt(IOUtils::nodata), TZ(IOUtils::nodata), latitude(IOUtils::nodata), longitude(IOUtils::nodata),
                                  SolarAzimuthAngle(IOUtils::nodata), SolarElevation(IOUtils::nodata),
                                  eccentricityEarth(IOUtils::nodata), SunRise(IOUtils::nodata), SunSet(IOUtils::nodata),
@@ -419,11 +449,13 @@ double SunMeeus::SideralToLocal(const double& JD)
 	return theta_0;
 }
 
-double SunMeeus::getEquationOfTime(const double& julian_century)
+SolarEphemerisCache::Ephemeris SunMeeus::getEphemeris(const double& julian_gmt)
 {
+	const double julian_century = (julian_gmt - 2451545.)/36525.;
+	SolarEphemerisCache::Ephemeris eph;
 	const double geomMeanLongSun = fmod( 280.46646 + julian_century*(36000.76983 + julian_century*0.0003032) , 360.);
 	const double geomMeanAnomSun = 357.52911 + julian_century*(35999.05029 - 0.0001537*julian_century);
-	eccentricityEarth = 0.016708634 - julian_century*(0.000042037 + 0.0000001267*julian_century);
+	const double eccentricityEarth = 0.016708634 - julian_century*(0.000042037 + 0.0000001267*julian_century);
 	const double SunEqOfCtr = sin(1.*geomMeanAnomSun*Cst::to_rad)*( 1.914602-julian_century*(0.004817+0.000014*julian_century))
 	             + sin(2.*geomMeanAnomSun*Cst::to_rad)*(0.019993 - 0.000101*julian_century)
 	             + sin(3.*geomMeanAnomSun*Cst::to_rad)*(0.000289);
@@ -441,23 +473,24 @@ double SunMeeus::getEquationOfTime(const double& julian_century)
 	const double ObliqueCorr = MeanObliqueEcl + 0.00256*cos( (125.04-1934.136*julian_century)*Cst::to_rad );
 
 	//Sun's position in the equatorial coordinate system
-	SunRightAscension = atan2(
+	eph.right_ascension = atan2(
 	                    cos(SunAppLong*Cst::to_rad) ,
 	                    cos(ObliqueCorr*Cst::to_rad) * sin(SunAppLong*Cst::to_rad)
 	                    ) * Cst::to_deg;
 
-	SunDeclination = asin( sin(ObliqueCorr*Cst::to_rad) * sin(SunAppLong*Cst::to_rad) ) * Cst::to_deg;
+	eph.declination = asin( sin(ObliqueCorr*Cst::to_rad) * sin(SunAppLong*Cst::to_rad) ) * Cst::to_deg;
 
 	//time calculations
 	const double var_y = tan( 0.5*ObliqueCorr*Cst::to_rad ) * tan( 0.5*ObliqueCorr*Cst::to_rad );
-	const double EquationOfTime = 4. * ( var_y*sin(2.*geomMeanLongSun*Cst::to_rad)
+	eph.equation_of_time = 4. * ( var_y*sin(2.*geomMeanLongSun*Cst::to_rad)
 	                 - 2.*eccentricityEarth*sin(geomMeanAnomSun*Cst::to_rad) +
 	                 4.*eccentricityEarth*var_y*sin(geomMeanAnomSun*Cst::to_rad) * cos(2.*geomMeanLongSun*Cst::to_rad)
 	                 - 0.5*var_y*var_y*sin(4.*geomMeanLongSun*Cst::to_rad)
 	                 - 1.25*eccentricityEarth*eccentricityEarth*sin(2.*geomMeanAnomSun*Cst::to_rad)
 	                 )*Cst::to_deg;
-	
-	return EquationOfTime;
+	eph.eccentricity = eccentricityEarth;
+
+	return eph;
 }
 
 void SunMeeus::update() 
@@ -467,13 +500,19 @@ void SunMeeus::update()
 	const double lst_TZ = longitude*1./15.;
 	const double gmt_time = ((julian + 0.5) - floor(julian + 0.5))*24.; //in hours
 	const double lst_hours=(gmt_time+longitude*1./15.); //Local Sidereal Time
-	const double julian_century = (julian - 2451545.)/36525.;
 	
-	const double EquationOfTime = getEquationOfTime(julian_century);
+	const SolarEphemerisCache::Ephemeris ephemeris( SolarEphemerisCache::getEphemeris(julian) );
+	SunRightAscension = ephemeris.right_ascension;
+	SunDeclination = ephemeris.declination;
+	eccentricityEarth = ephemeris.eccentricity;
+	const double EquationOfTime = ephemeris.equation_of_time;
+	const double sin_lat = sin(latitude*Cst::to_rad), cos_lat = cos(latitude*Cst::to_rad);
+	const double sin_decl = sin(SunDeclination*Cst::to_rad), cos_decl = cos(SunDeclination*Cst::to_rad);
 
 	SolarNoon = (720. - 4.*longitude - EquationOfTime + TZ*60.)/1440.; //in days, in LST time
 
-	const double cos_HAsunrise = cos(90.833*Cst::to_rad) / (cos(latitude*Cst::to_rad) * cos(SunDeclination*Cst::to_rad))
+	static const double cos_sunrise_zenith = cos(90.833*Cst::to_rad);
+	const double cos_HAsunrise = cos_sunrise_zenith / (cos_lat * cos_decl)
 	             - tan(latitude*Cst::to_rad)*tan(SunDeclination*Cst::to_rad);
 
 	if (cos_HAsunrise>=-1. && cos_HAsunrise<=1.) {
@@ -499,8 +538,8 @@ void SunMeeus::update()
 		HourAngle = TrueSolarTime/4.-180.;
 
 	const double SolarZenithAngle = acos(
-	                   sin(latitude*Cst::to_rad) * sin(SunDeclination*Cst::to_rad)
-	                   + cos(latitude*Cst::to_rad) * cos(SunDeclination*Cst::to_rad) * cos(HourAngle*Cst::to_rad)
+	                   sin_lat * sin_decl
+	                   + cos_lat * cos_decl * cos(HourAngle*Cst::to_rad)
 	                   )*Cst::to_deg;
 	
 	SolarElevation = 90. - SolarZenithAngle;
@@ -508,7 +547,9 @@ void SunMeeus::update()
 	double AtmosphericRefraction = 0.;
 	if ( SolarElevation<=85. ) {
 		if ( SolarElevation>5. ) {
-			AtmosphericRefraction = 58.1 / tan(SolarElevation*Cst::to_rad) - 0.07 / pow( tan(SolarElevation*Cst::to_rad) , 3 ) + 0.000086/pow( tan(SolarElevation*Cst::to_rad), 5);
+			const double tan_elev = tan(SolarElevation*Cst::to_rad);
+			const double tan_elev3 = tan_elev*tan_elev*tan_elev;
+			AtmosphericRefraction = 58.1 / tan_elev - 0.07 / tan_elev3 + 0.000086/(tan_elev3*tan_elev*tan_elev);
 		} else {
 			if ( SolarElevation>-0.575 ) {
 				AtmosphericRefraction = 1735. + SolarElevation*(-518.2 + SolarElevation*(103.4 + SolarElevation*(-12.79 + SolarElevation*0.711)));
@@ -520,8 +561,8 @@ void SunMeeus::update()
 	}
 
 	SolarElevationAtm = SolarElevation + AtmosphericRefraction; //correction for the effects of the atmosphere
-	const double cos_SAA = (sin(latitude*Cst::to_rad)*cos(SolarZenithAngle*Cst::to_rad) - sin(SunDeclination*Cst::to_rad)) /
-	                       (cos(latitude*Cst::to_rad)*sin(SolarZenithAngle*Cst::to_rad));
+	const double cos_SAA = (sin_lat*cos(SolarZenithAngle*Cst::to_rad) - sin_decl) /
+	                       (cos_lat*sin(SolarZenithAngle*Cst::to_rad));
 	if ( HourAngle>0. ) {
 		SolarAzimuthAngle = fmod( acos( std::min( 1., std::max(-1., cos_SAA) ) )*Cst::to_deg + 180., 360. );
 	} else {
@@ -21,6 +21,34 @@
 
 namespace mio {
 
+/**
+ * @class SolarEphemerisCache
+ * @brief Cache of the Sun's ephemeris, shared by all the SunMeeus objects.
+ * @details The Sun's position is computed in two steps: the ephemeris (declination, right ascension, equation of time and
+ * eccentricity) only depend on the date while the horizontal coordinates depend on both the date and the location. Since
+ * many modules (shading and potential radiation filters, solar resamplings, radiation generators, spatial interpolations, etc)
+ * compute the Sun's position for all the stations at the same timestamps, the ephemeris are cached per date and only
+ * the (cheaper) location dependent part is computed for each station.
+ *
+ * Each thread has its own cache, so no locking is necessary. When the cache reaches its maximum size, it is simply emptied.
+ * @ingroup meteoLaws
+ * @date   2026-10-18
+ */
+class SolarEphemerisCache {
+	public:
+		///Sun's parameters that only depend on the date
+		typedef struct EPHEMERIS {
+			double right_ascension, declination; ///< equatorial coordinates, in degrees
+			double equation_of_time; ///< in minutes
+			double eccentricity;
+		} Ephemeris;
+
+		static Ephemeris getEphemeris(const double& julian_gmt);
+		static void clear();
+
+		static const size_t max_size; ///< maximum number of dates in the cache
+};
+
 /**
  * @class SunTrajectory
  * @brief A class to calculate the Sun's position
@@ -125,9 +153,9 @@ class SunMeeus : public SunTrajectory {
 		void getEquatorialCoordinates(double& right_ascension, double& declination);
 		
 		static double SideralToLocal(const double& JD);
+		static SolarEphemerisCache::Ephemeris getEphemeris(const double& julian_gmt);
 	private:
 		void private_init();
-		double getEquationOfTime(const double& julian_century);
 		void update();
 
 	private:
@@ -18,16 +18,20 @@
 */
 
 #include <meteoio/meteoResampling/ARIMAResampling.h>
+#include <meteoio/FStream.h> //for the model store
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
+#include <fstream>
 #include <sstream>
 
 namespace mio {
 
     ARIMAResampling::ARIMAResampling(const std::string &i_algoname, const std::string &i_parname, const double &dflt_window_size,
                                      const std::vector<std::pair<std::string, std::string>> &vecArgs)
-        : ResamplingAlgorithms(i_algoname, i_parname, dflt_window_size, vecArgs), verbose(true), gap_data(), filled_data(), all_dates(), before_window(),
-          after_window(), is_valid_gap_data(), warned_about_gap(), newest_gap() {
+        : ResamplingAlgorithms(i_algoname, i_parname, dflt_window_size, vecArgs), verbose(true), gap_data(), gap_stations(), filled_data(), all_dates(), before_window(),
+          after_window(), model_store(), orders_before(), orders_after(), is_valid_gap_data(), warned_about_gap(), newest_gap() {
         const std::string where("Interpolations1D::" + i_parname + "::" + i_algoname);
         if (vecArgs.empty()) // incorrect arguments, throw an exception
             throw InvalidArgumentException("Wrong number of arguments for \"" + where + "\"", AT);
@@ -99,6 +103,10 @@ namespace mio {
                 IOUtils::parseArg(vecArgs[ii], where, stationary);
             } else if (vecArgs[ii].first == "VERBOSE") {
                 IOUtils::parseArg(vecArgs[ii], where, verbose);
+            } else if (vecArgs[ii].first == "PARALLEL") {
+                IOUtils::parseArg(vecArgs[ii], where, parallel);
+            } else if (vecArgs[ii].first == "MODEL_STORE") {
+                IOUtils::parseArg(vecArgs[ii], where, model_store);
             } else if (vecArgs[ii].first == "NORMALIZATION") {
                 std::string normalization_string;
                 IOUtils::parseArg(vecArgs[ii], where, normalization_string);
@@ -136,6 +144,9 @@ namespace mio {
             throw InvalidArgumentException("Please provide a ARIMA window for " + where, AT);
         if (before_window + after_window > window_size)
             throw InvalidArgumentException("The ARIMA window is larger than the resampling window for " + where, AT);
+
+        if (!model_store.empty())
+            readModelStore();
     }
 
 
@@ -163,14 +174,25 @@ namespace mio {
 
 
 
+    static ARIMA_ORDER findOrder(const std::map<std::string, ARIMA_ORDER> &orders, const std::string &stationHash) {
+        const std::map<std::string, ARIMA_ORDER>::const_iterator it = orders.find(stationHash);
+        return (it != orders.end()) ? it->second : ARIMA_ORDER();
+    }
+
     std::vector<double> ARIMAResampling::predictData(std::vector<double> &data, const std::string &direction, size_t startIdx_interpol,
-                                                     size_t length_gap_interpol, int sr_period) {
+                                                     size_t length_gap_interpol, int sr_period, const std::string &stationHash) {
 #ifdef DEBUG
         std::cout << "predicting " << direction << std::endl;
 #endif
         InterpolARIMA arima(data, startIdx_interpol, length_gap_interpol, direction, sr_period);
         setMetaData(arima);
+        // for a backward prediction the data after the gap is reversed and fitted by the forward model
+        std::map<std::string, ARIMA_ORDER> &orders = (direction == "forward") ? orders_before : orders_after;
+        if (!set_arima_manual)
+            arima.setStartOrders(findOrder(orders, stationHash), ARIMA_ORDER());
         std::vector<double> predictions = arima.predict();
+        if (!set_arima_manual && updateOrder(orders, stationHash, arima.getForwardOrder()) && !model_store.empty())
+            writeModelStore();
         if (verbose) infoARIMA(arima);
         std::copy(predictions.begin(), predictions.end(), data.begin() + startIdx_interpol);
         return predictions;
@@ -181,6 +203,7 @@ namespace mio {
         arima.setOptMetaData(method, opt_method, stepwise, approximation, num_models);
         arima.setVerbose(verbose);
         arima.setNormalizationMode(normalize);
+        arima.setParallel(parallel);
         if (set_arima_manual) {
             arima.setManualARIMA(p, d, q, P, D, Q, fill_backward_manual);
         }
@@ -188,6 +211,92 @@ namespace mio {
 
 
 
+    // keep the orders of a newly selected model, returns true if they changed
+    bool ARIMAResampling::updateOrder(std::map<std::string, ARIMA_ORDER> &orders, const std::string &stationHash,
+                                      const ARIMA_ORDER &order) const {
+        if (!order.isValid() || order.isRandomWalk()) // this would not be a useful starting point
+            return false;
+        std::map<std::string, ARIMA_ORDER>::iterator it = orders.find(stationHash);
+        if (it != orders.end() && it->second == order)
+            return false;
+        orders[stationHash] = order;
+        return true;
+    }
+
+    void ARIMAResampling::readModelStore() {
+        std::ifstream fin(model_store.c_str());
+        if (fin.fail()) // nothing has been stored yet
+            return;
+
+        const std::string where("Interpolations1D::" + parname + "::" + algo);
+        std::string line;
+        size_t lcount = 0;
+        while (std::getline(fin, line)) {
+            lcount++;
+            IOUtils::trim(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream iss(line);
+            std::string store_parname, side, stationHash;
+            ARIMA_ORDER order;
+            if (!(iss >> store_parname >> side >> order.p >> order.d >> order.q >> order.P >> order.D >> order.Q))
+                throw InvalidFormatException("Invalid line " + IOUtils::toString(lcount) + " in ARIMA model store \"" + model_store +
+                                                 "\" for " + where, AT);
+            std::getline(iss, stationHash); // the station hash can contain spaces
+            IOUtils::trim(stationHash);
+            if (store_parname != parname || stationHash.empty())
+                continue;
+
+            if (side == "before")
+                orders_before[stationHash] = order;
+            else if (side == "after")
+                orders_after[stationHash] = order;
+            else
+                throw InvalidFormatException("Invalid gap side \"" + side + "\" on line " + IOUtils::toString(lcount) +
+                                                 " in ARIMA model store \"" + model_store + "\" for " + where, AT);
+        }
+    }
+
+    void ARIMAResampling::writeModelStore() const {
+        // the store can be shared by several parameters, so keep their models
+        std::vector<std::string> other_models;
+        std::ifstream fin(model_store.c_str());
+        if (!fin.fail()) {
+            std::string line;
+            while (std::getline(fin, line)) {
+                std::istringstream iss(line);
+                std::string store_parname;
+                if ((iss >> store_parname) && store_parname != parname && store_parname[0] != '#')
+                    other_models.push_back(line);
+            }
+            fin.close();
+        }
+
+        ofilestream fout(model_store.c_str(), std::ofstream::out);
+        if (fout.fail()) {
+            std::ostringstream ss;
+            ss << "ARIMA resampling could not write its model store \"" << model_store;
+            ss << "\", possible reason: " << std::strerror(errno);
+            throw AccessException(ss.str(), AT);
+        }
+        fout << "# [parameter] [gap side] [p d q P D Q] [station]" << std::endl;
+        for (size_t ii = 0; ii < other_models.size(); ii++)
+            fout << other_models[ii] << std::endl;
+        const std::map<std::string, ARIMA_ORDER> *sides[2] = {&orders_before, &orders_after};
+        const char *side_names[2] = {"before", "after"};
+        for (size_t ii = 0; ii < 2; ii++) {
+            for (std::map<std::string, ARIMA_ORDER>::const_iterator it = sides[ii]->begin(); it != sides[ii]->end(); ++it) {
+                const ARIMA_ORDER &order = it->second;
+                fout << parname << " " << side_names[ii] << " " << order.p << " " << order.d << " " << order.q << " " << order.P << " "
+                     << order.D << " " << order.Q << " " << it->first << std::endl;
+            }
+        }
+        fout.close();
+    }
+
+
+
     // ------------------------------ Resample helper functions ------------------------------
 
 
@@ -225,9 +334,9 @@ namespace mio {
         }
 
         // If the position is valid and not the last element, perform linear interpolation
-        double x1 = datesVec[pos].getJulian();
+        double x1 = datesVec[pos].getJulian(true);
         double y1 = data[pos];
-        double x2 = datesVec[pos + 1].getJulian();
+        double x2 = datesVec[pos + 1].getJulian(true);
         double y2 = data[pos + 1];
         double x = date.getJulian(true);
 
@@ -236,7 +345,7 @@ namespace mio {
 
 
 
-    static std::vector<Date>::iterator findDate(std::vector<Date> &gap_dates, const Date &resampling_date) {
+    static std::vector<Date>::const_iterator findDate(const std::vector<Date> &gap_dates, const Date &resampling_date) {
         auto exactTime = [&resampling_date](Date curr_date) { return requal(curr_date, resampling_date); };
         return std::find_if(gap_dates.begin(), gap_dates.end(), exactTime);
     }
@@ -271,16 +380,39 @@ namespace mio {
 
 
 
-    bool ARIMAResampling::processKnownGaps(const Date &resampling_date, const size_t paramindex,
+    void ARIMAResampling::setValueInGap(const std::vector<double> &data_in_gap, const std::vector<Date> &gap_dates,
+                                        const Date &resampling_date, const size_t &paramindex, MeteoData &md) {
+        if (gap_dates.empty())
+            return;
+
+        // if there is an exact match, return the data
+        const std::vector<Date>::const_iterator it = findDate(gap_dates, resampling_date);
+        if (it != gap_dates.end()) {
+            md(paramindex) = data_in_gap[std::distance(gap_dates.begin(), it)];
+            return;
+        }
+
+        // otherwise linearly interpolate between the surrounding dates
+        size_t idx = std::distance(gap_dates.begin(), std::lower_bound(gap_dates.begin(), gap_dates.end(), resampling_date));
+        if (idx > 0)
+            idx--;
+        if (data_in_gap[idx] == IOUtils::nodata || (idx + 1 < data_in_gap.size() && data_in_gap[idx + 1] == IOUtils::nodata))
+            return;
+        md(paramindex) = interpolVecAt(data_in_gap, gap_dates, idx, resampling_date);
+    }
+
+
+
+    bool ARIMAResampling::processKnownGaps(const std::string &stationHash, const Date &resampling_date, const size_t paramindex,
                                            const ResamplingAlgorithms::ResamplingPosition &position, const std::vector<MeteoData> &vecM,
                                            MeteoData &md) {
-        // check whether given position is in a known gap, if it is either return the
+        // check whether given position is in a known gap of this station, if it is either return the
         // exact value or linearly interpolate, to get the correct value
         for (size_t ii = 0; ii < gap_data.size(); ii++) {
-            ARIMA_GAP gap = gap_data[ii];
-            std::vector<Date> gap_dates = all_dates[ii];
-            std::vector<double> data_in_gap = filled_data[ii];
-            bool is_valid_data = is_valid_gap_data[ii];
+            if (gap_stations[ii] != stationHash)
+                continue;
+            const ARIMA_GAP &gap = gap_data[ii];
+            const bool is_valid_data = is_valid_gap_data[ii];
 
             // check if the resampling date is in this gap
             if (resampling_date >= gap.startDate && resampling_date <= gap.endDate) {
@@ -294,28 +426,9 @@ namespace mio {
                     return true;
                 }
 
-                auto it = findDate(gap_dates, resampling_date);
-                // if there is an exact match, return the data
-                if (it != gap_dates.end()) {
-                    size_t idx = std::distance(gap_dates.begin(), it);
-                    double value = data_in_gap[idx];
-                    if (value != IOUtils::nodata) {
-                        md(paramindex) = value; // propagate value
-                        return true;
-                    }
-                    break;
-                } else {
-                    // otherwise linearly interpolate the data
-                    size_t idx = std::distance(gap_dates.begin(), std::lower_bound(gap_dates.begin(), gap_dates.end(), resampling_date));
-
-                    // if the index is at the end, and thus does not have a next value
-                    if (idx == gap_dates.size() - 1)
-                        break;
-                    else if ((data_in_gap[idx] == IOUtils::nodata || data_in_gap[idx + 1] == IOUtils::nodata))
-                        break;
-                    md(paramindex) = interpolVecAt(data_in_gap, gap_dates, idx, resampling_date);
-                    return true;
-                }
+                // this gap has already been fitted, where the models could not fill it there is nothing more to get
+                setValueInGap(filled_data[ii], all_dates[ii], resampling_date, paramindex, md);
+                return true;
 
             } else if (position == ResamplingAlgorithms::end && resampling_date > gap.endDate && resampling_date >= gap.startDate &&
                        gap.startDate == vecM[vecM.size() - 1].date) {
@@ -435,19 +548,28 @@ namespace mio {
 
 
     std::vector<double> ARIMAResampling::getInterpolatedData(std::vector<double> &data, size_t size_before, size_t size_after,
-                                                             size_t startIdx_interpol, size_t length_gap_interpol, int sr_period) {
+                                                             size_t startIdx_interpol, size_t length_gap_interpol, int sr_period,
+                                                             const std::string &stationHash) {
         std::vector<double> interpolated_data;
         if (size_before < MIN_ARIMA_DATA_POINTS && size_after > MIN_ARIMA_DATA_POINTS) {
-            interpolated_data = predictData(data, "backward", startIdx_interpol, length_gap_interpol, sr_period);
+            interpolated_data = predictData(data, "backward", startIdx_interpol, length_gap_interpol, sr_period, stationHash);
         } else if (size_after < MIN_ARIMA_DATA_POINTS && size_before > MIN_ARIMA_DATA_POINTS) {
-            interpolated_data = predictData(data, "forward", startIdx_interpol, length_gap_interpol, sr_period);
+            interpolated_data = predictData(data, "forward", startIdx_interpol, length_gap_interpol, sr_period, stationHash);
         } else if (size_before < MIN_ARIMA_DATA_POINTS && size_after < MIN_ARIMA_DATA_POINTS) {
             throw IOException("Could not accumulate enough data for parameter estimation; Increasing window sizes might help");
         } else {
             InterpolARIMA arima(data, startIdx_interpol, length_gap_interpol, sr_period);
             setMetaData(arima);
+            if (!set_arima_manual)
+                arima.setStartOrders(findOrder(orders_before, stationHash), findOrder(orders_after, stationHash));
             arima.interpolate();
             interpolated_data = arima.getInterpolatedData();
+            if (!set_arima_manual) {
+                const bool new_before = updateOrder(orders_before, stationHash, arima.getForwardOrder());
+                const bool new_after = updateOrder(orders_after, stationHash, arima.getBackwardOrder());
+                if ((new_before || new_after) && !model_store.empty())
+                    writeModelStore();
+            }
             if (verbose) infoARIMA(arima);
         }
         return interpolated_data;
@@ -456,11 +578,12 @@ namespace mio {
 
 
     void ARIMAResampling::cacheGap(const std::vector<double> &interpolated_data, const std::vector<Date> &interpolated_dates,
-                                   const ARIMA_GAP &new_gap) {
+                                   const ARIMA_GAP &new_gap, const std::string &stationHash) {
         bool contains_zeros = std::any_of(interpolated_data.begin(), interpolated_data.end(), [](double value) { return value == 0.0; });
         bool all_zeros = std::all_of(interpolated_data.begin(), interpolated_data.end(), [](double value) { return value == 0.0; });
 
         gap_data.push_back(new_gap);
+        gap_stations.push_back(stationHash);
 
         bool is_valid = !(all_zeros || (contains_zeros && !is_zero_possible));
         is_valid_gap_data.push_back(is_valid);
@@ -471,7 +594,7 @@ namespace mio {
     }
 
     // ------------------------------ Resample ------------------------------
-    void ARIMAResampling::resample(const std::string & /*stationHash*/, const size_t &index, const ResamplingPosition &position,
+    void ARIMAResampling::resample(const std::string &stationHash, const size_t &index, const ResamplingPosition &position,
                                    const size_t &paramindex, const std::vector<MeteoData> &vecM, MeteoData &md) {
         if (index >= vecM.size())
             throw IOException("The index of the element to be resampled is out of bounds", AT);
@@ -489,7 +612,7 @@ namespace mio {
 
         // check wether given position is in a known gap, if it is either return the
         // exact value or linearly interpolate, to get the correct value
-        bool found_gap = processKnownGaps(resampling_date, paramindex, position, vecM, md);
+        bool found_gap = processKnownGaps(stationHash, resampling_date, paramindex, position, vecM, md);
         if (found_gap)
             return;
 
@@ -556,7 +679,7 @@ namespace mio {
             // Now fill the data with the arima model
             int sr_period = static_cast<int>(period * new_gap.sampling_rate);
             std::vector<double> interpolated_data = getInterpolatedData(data, data_vec_before.size(), data_vec_after.size(),
-                                                                        startIdx_interpol, length_gap_interpol, sr_period);
+                                                                        startIdx_interpol, length_gap_interpol, sr_period, stationHash);
 
             std::vector<Date> interpolated_dates(dates.begin() + startIdx_interpol,
                                                  dates.begin() + startIdx_interpol + length_gap_interpol);
@@ -566,7 +689,7 @@ namespace mio {
                 interpolated_dates.push_back(dates[endIdx_interpol]);
             }
 
-            cacheGap(interpolated_data, interpolated_dates, new_gap);
+            cacheGap(interpolated_data, interpolated_dates, new_gap, stationHash);
 
             // check if the data in the gap is valid (arima(0,0,0) arima(0,1,0) model)
             if (!is_valid_gap_data.back()) {
@@ -580,18 +703,7 @@ namespace mio {
             }
 
             // get the value at the resample date
-            auto it = findDate(interpolated_dates, resampling_date);
-            // if there is an exact match, return the data
-            if (it != interpolated_dates.end()) {
-                size_t idx = std::distance(interpolated_dates.begin(), it);
-                md(paramindex) = interpolated_data[idx];
-                return;
-            }
-
-            // otherwise linearly interpolate the data
-            size_t idx = std::distance(interpolated_dates.begin(),
-                                       std::lower_bound(interpolated_dates.begin(), interpolated_dates.end(), resampling_date));
-            md(paramindex) = interpolVecAt(interpolated_data, interpolated_dates, idx, resampling_date);
+            setValueInGap(interpolated_data, interpolated_dates, resampling_date, paramindex, md);
             return;
         }
         return;
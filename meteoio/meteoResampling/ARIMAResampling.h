@@ -22,6 +22,7 @@
 #include <meteoio/meteoResampling/ARIMAutils.h>
 #include <meteoio/meteoResampling/InterpolARIMA.h>
 #include <meteoio/meteoResampling/ResamplingAlgorithms.h>
+#include <map>
 #include <vector>
 
 namespace mio {
@@ -101,6 +102,8 @@ namespace mio {
      *      - `ZSCORE` : Z-Score Normalization
      *      - `NOTHING` : No Normalization
      * - `VERBOSE` : Whether to print additional information. Default: false
+     * - `PARALLEL` : Whether to fit the models before and after a gap concurrently (only when compiled with OpenMP). Default: false
+     * - `MODEL_STORE` : File where the selected model orders are kept from one run to the next (see below). Default: none
      * 
      * It is also possible to set the parameters of the ARIMA model manually. However, only the forward part. It is optionally supported,
      * that a gap is filled in backwards with an auto arima model as well. Be careful when using this though, as it might lead to different results as you have 
@@ -130,6 +133,22 @@ namespace mio {
      * @note In the case that only random/random walk arima models are found, the missing values will not be filled (It would be just the
      * mean otherwise)
      *
+     * Each gap is only fitted once per station. The orders (p,d,q)(P,D,Q) of the last models selected before and after a gap are kept for
+     * each station and used as the starting point of the stepwise search for the next gaps of this station, so when the data regime did not
+     * change the search converges after only a few model evaluations. With `MODEL_STORE`, these orders are also read at startup and written
+     * back after each new selection, so that operational runs that are repeated every day don't restart their model searches from scratch.
+     * The file is a plain text file with one model per line (parameter name, side of the gap, the six orders and the station hash) and
+     * can be shared by several parameters:
+     * @code
+     * TA::ARIMA::MODEL_STORE = ./arima_models.txt
+     * TA::ARIMA::PARALLEL = TRUE
+     * @endcode
+     *
+     * @note Points that fall in between the timesteps of a filled gap are linearly interpolated between the two timesteps surrounding them
+     * (older versions used the next pair of timesteps) and in GMT (older versions mixed local and GMT times, which shifted the
+     * interpolation by the time zone). The values at these points therefore differ from older versions, the values at the timesteps
+     * of the gap do not.
+     *
      * @section introduction Introduction
      *
      * Autoregressive Integrated Moving Average (ARIMA) is a method for forecasting on historic data. It assumes a stochastic process, with
@@ -324,6 +343,7 @@ namespace mio {
         bool verbose;
         // ARIMA related data
         std::vector<ARIMA_GAP> gap_data;
+        std::vector<std::string> gap_stations;
         std::vector<std::vector<double>> filled_data;
         std::vector<std::vector<Date>> all_dates;
 
@@ -343,6 +363,11 @@ namespace mio {
         bool seasonal = true, stationary = false;
         Normalization::Mode normalize = Normalization::Mode::MinMax;
 
+        bool parallel = false;
+        std::string model_store;
+        // orders of the last models fitted before and after a gap, per station
+        std::map<std::string, ARIMA_ORDER> orders_before, orders_after;
+
         bool set_arima_manual = false;
         bool fill_backward_manual = false;
         int p = 0, d = 0, q = 0;
@@ -361,12 +386,17 @@ namespace mio {
         // Private methods
         void setMetaData(InterpolARIMA &arima);
         std::vector<double> predictData(std::vector<double> &data, const std::string &direction, size_t startIdx_interpol,
-                                        size_t length_gap_interpol, int sr_period);
+                                        size_t length_gap_interpol, int sr_period, const std::string &stationHash);
+        bool updateOrder(std::map<std::string, ARIMA_ORDER> &orders, const std::string &stationHash, const ARIMA_ORDER &order) const;
+        void readModelStore();
+        void writeModelStore() const;
 
         // Helper methods for resample
         void checkZeroPossibility(const std::vector<MeteoData> &vecM, size_t paramindex);
-        bool processKnownGaps(const Date &resampling_date, const size_t paramindex,
+        bool processKnownGaps(const std::string &stationHash, const Date &resampling_date, const size_t paramindex,
                               const ResamplingAlgorithms::ResamplingPosition &position, const std::vector<MeteoData> &vecM, MeteoData &md);
+        void setValueInGap(const std::vector<double> &data_in_gap, const std::vector<Date> &gap_dates, const Date &resampling_date,
+                           const size_t &paramindex, MeteoData &md);
         void setEndGap(ARIMA_GAP &new_gap, Date &data_start_date, Date &data_end_date, const std::vector<MeteoData> &vecM,
                        const Date &resampling_date);
         double interpolVecAt(const std::vector<MeteoData> &vecM, const size_t &idx, const Date &date, const size_t &paramindex);
@@ -377,8 +407,9 @@ namespace mio {
                                        bool has_data_before, bool has_data_after, size_t paramindex, std::vector<double> &data,
                                        std::vector<Date> &dates, size_t length);
         std::vector<double> getInterpolatedData(std::vector<double> &data, size_t size_before, size_t size_after, size_t startIdx_interpol,
-                                                size_t length_gap_interpol, int period);
-        void cacheGap(const std::vector<double> &interpolated_data, const std::vector<Date> &interpolated_dates, const ARIMA_GAP &new_gap);
+                                                size_t length_gap_interpol, int period, const std::string &stationHash);
+        void cacheGap(const std::vector<double> &interpolated_data, const std::vector<Date> &interpolated_dates, const ARIMA_GAP &new_gap,
+                      const std::string &stationHash);
 
         // info
         void infoARIMA(InterpolARIMA arima);
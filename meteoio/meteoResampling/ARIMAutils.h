@@ -187,6 +187,19 @@ namespace mio {
             }
         };
 
+        // a struct to keep the (p,d,q)(P,D,Q) orders of a fitted model, so a later search can start from them
+        struct ARIMA_ORDER {
+            ARIMA_ORDER() : p(-1), d(0), q(0), P(0), D(0), Q(0) {}
+            ARIMA_ORDER(int i_p, int i_d, int i_q, int i_P, int i_D, int i_Q) : p(i_p), d(i_d), q(i_q), P(i_P), D(i_D), Q(i_Q) {}
+            bool isValid() const { return p >= 0; }
+            bool isRandomWalk() const { return p == 0 && q == 0 && P == 0 && Q == 0; }
+            bool operator==(const ARIMA_ORDER &in) const {
+                return p == in.p && d == in.d && q == in.q && P == in.P && D == in.D && Q == in.Q;
+            }
+            bool operator!=(const ARIMA_ORDER &in) const { return !(*this == in); }
+            int p, d, q, P, D, Q;
+        };
+
         // return true if a valid point could be found backward from pos
         size_t searchBackward(ARIMA_GAP &last_gap, const size_t &pos, const size_t &paramindex, const std::vector<MeteoData> &vecM,
                               const Date &resampling_date, const double &i_window_size);
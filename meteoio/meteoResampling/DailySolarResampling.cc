@@ -112,9 +112,9 @@ void Daily_solar::resample(const std::string& stationHash, const size_t& index,
 	if (index >= vecM.size())
 		throw IOException("The index of the element to be resampled is out of bounds", AT);
 
-	const double lat = md.meta.position.getLat();
-	const double lon = md.meta.position.getLon();
-	const double alt = md.meta.position.getAltitude();
+	const double lat = md.meta->position.getLat();
+	const double lon = md.meta->position.getLon();
+	const double alt = md.meta->position.getAltitude();
 	if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return;
 	const double HS = md(MeteoData::HS);
 
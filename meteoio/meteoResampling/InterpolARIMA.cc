@@ -26,6 +26,10 @@
 #include <sstream>
 #include <unistd.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace mio {
 
 // ------------------- Constructor ------------------- //
@@ -370,6 +374,21 @@ void InterpolARIMA::setManualARIMA(int p, int d, int q, int P, int D, int Q, boo
     sarima_forward = sarima_init(p, d, q, s, P, D, Q, static_cast<int>(N_data_forward));
 }
 
+// Set the starting point of the stepwise search, has to be called after setAutoArimaMetaData
+static void setStartOrder(auto_arima_object obj, const ARIMA_ORDER &order) {
+    if (!order.isValid())
+        return;
+    obj->p_start = order.p;
+    obj->q_start = order.q;
+    obj->P_start = order.P;
+    obj->Q_start = order.Q;
+}
+
+void InterpolARIMA::setStartOrders(const ARIMA_ORDER &order_forward, const ARIMA_ORDER &order_backward) {
+    setStartOrder(auto_arima_forward, order_forward);
+    setStartOrder(auto_arima_backward, order_backward);
+}
+
 // ------------------- Getters ------------------- //
 // Get the interpolated data
 std::vector<double> InterpolARIMA::getInterpolatedData() {
@@ -377,6 +396,15 @@ std::vector<double> InterpolARIMA::getInterpolatedData() {
     return norm.denormalize(interpolated_data);
 }
 
+// Get the orders of the fitted models
+ARIMA_ORDER InterpolARIMA::getForwardOrder() const {
+    return ARIMA_ORDER(auto_arima_forward->p, auto_arima_forward->d, auto_arima_forward->q, auto_arima_forward->P, auto_arima_forward->D, auto_arima_forward->Q);
+}
+
+ARIMA_ORDER InterpolARIMA::getBackwardOrder() const {
+    return ARIMA_ORDER(auto_arima_backward->p, auto_arima_backward->d, auto_arima_backward->q, auto_arima_backward->P, auto_arima_backward->D, auto_arima_backward->Q);
+}
+
 // ------------------- Interpolation methods ------------------- //
 // Simulate n_steps into the future
 std::vector<double> InterpolARIMA::simulate(int n_steps, int seed) {
@@ -418,14 +446,24 @@ static bool isRandomWalk(auto_arima_object model)
 }
 
 
+// Fit the forward and backward models, they are fully independent so they can be searched concurrently
+void InterpolARIMA::fitModels() {
+#pragma omp parallel sections num_threads(2) if(parallel)
+    {
+#pragma omp section
+        auto_arima_exec(auto_arima_forward, data_forward.data(), xreg_f);
+#pragma omp section
+        auto_arima_exec(auto_arima_backward, data_backward.data(), xreg_b);
+    }
+}
+
 // Fill the gap using the auto arima objects
 void InterpolARIMA::fillGap() {
     bool isRandom_f = false;
     bool isRandom_b = false;
     for (int meth_Id = 0; meth_Id < 3; meth_Id++) {
         // fit the models
-        auto_arima_exec(auto_arima_forward, data_forward.data(), xreg_f);
-        auto_arima_exec(auto_arima_backward, data_backward.data(), xreg_b);
+        fitModels();
 
         isRandom_b = isRandomWalk(auto_arima_backward);
         isRandom_f = isRandomWalk(auto_arima_forward);
@@ -437,8 +475,7 @@ void InterpolARIMA::fillGap() {
             const bool current_stepwise = auto_arima_forward->stepwise;
             auto_arima_setStepwise(auto_arima_forward, !current_stepwise);
             auto_arima_setStepwise(auto_arima_backward, !current_stepwise);
-            auto_arima_exec(auto_arima_forward, data_forward.data(), xreg_f);
-            auto_arima_exec(auto_arima_backward, data_backward.data(), xreg_b);
+            fitModels();
             if ((auto_arima_forward->p == 0 && auto_arima_forward->q == 0) && (auto_arima_forward->P == 0 && auto_arima_forward->Q == 0)) {
                 isRandom_f = true;
             }
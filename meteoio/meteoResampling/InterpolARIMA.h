@@ -102,6 +102,10 @@ namespace mio {
         void setVerbose(bool verbose = false);
         void setNormalizationMode(Normalization::Mode mode);
         void setManualARIMA(int p, int d, int q, int P, int D, int Q, bool fill_backward);
+        // start the stepwise model searches from previously selected orders (invalid orders keep the default start values)
+        void setStartOrders(const ARIMA_ORDER &order_forward, const ARIMA_ORDER &order_backward);
+        // fit the forward and backward models concurrently (if OpenMP is available)
+        void setParallel(bool parallel_fits) { parallel = parallel_fits; }
 
         // Interpolation methods
         std::vector<double> simulate(int n_steps, int seed = 0);
@@ -118,6 +122,8 @@ namespace mio {
         std::vector<double> getForwardData() { return norm.denormalize(data_forward); }
         std::vector<double> getBackwardData() { return  norm.denormalize(data_backward); }
         std::vector<double> getInterpolatedData();
+        ARIMA_ORDER getForwardOrder() const;
+        ARIMA_ORDER getBackwardOrder() const;
 
         // Copy constructor
         InterpolARIMA(const InterpolARIMA &other)
@@ -132,7 +138,7 @@ namespace mio {
               max_P(other.max_P), max_D(other.max_D), max_Q(other.max_Q), start_P(other.start_P), start_Q(other.start_Q), r(other.r),
               s(other.s), method(other.method), opt_method(other.opt_method), stepwise(other.stepwise), approximation(other.approximation),
               num_models(other.num_models), seasonal(other.seasonal), stationary(other.stationary),
-              auto_arima_forward(auto_arima_copy(other.auto_arima_forward)), auto_arima_backward(auto_arima_copy(other.auto_arima_backward)), sarima_forward(other.sarima_forward) {
+              auto_arima_forward(auto_arima_copy(other.auto_arima_forward)), auto_arima_backward(auto_arima_copy(other.auto_arima_backward)), parallel(other.parallel), sarima_forward(other.sarima_forward) {
     }
 
     // Copy assignment operator
@@ -178,6 +184,7 @@ namespace mio {
             num_models = other.num_models;
             seasonal = other.seasonal;
             stationary = other.stationary;
+            parallel = other.parallel;
 
             // 4: handle the pointers to the vectors
             xreg_f = (xreg_vec_f.empty()) ? nullptr : &xreg_vec_f[0];
@@ -232,6 +239,7 @@ private:
     bool seasonal = true, stationary = false;
 
     bool consistencyCheck();
+    void fitModels();
     auto_arima_object initAutoArima(size_t N_data);
 
     // last to be initialized
@@ -243,6 +251,7 @@ private:
     // (S)ARIMA variables
     bool set_manual = false;
     bool fill_backward_manual = false;
+    bool parallel = false;
 
 public:
     sarima_object sarima_forward;
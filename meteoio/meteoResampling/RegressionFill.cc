@@ -121,7 +121,7 @@ void RegressionFill::resample(const std::string& /*stationHash*/, const size_t&
 	if (additional_stations.size() != 1) throw IOException("The Regression Fill needs exactly one additional station to work properly", AT);
 
 	if (verbose && !printed_info) {
-		std::cout << "RegressionFill: Using station " << additional_stations[0].front().meta.getStationID() << " as support station for station " << vecM[index].meta.getStationID() << std::endl;
+		std::cout << "RegressionFill: Using station " << additional_stations[0].front().meta->getStationID() << " as support station for station " << vecM[index].meta->getStationID() << std::endl;
 		printed_info = true;
 	}
 
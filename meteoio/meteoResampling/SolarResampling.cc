@@ -56,9 +56,9 @@ std::string Solar::toString() const
 
 double Solar::getPotentialH(const MeteoData& md)
 {
-	const double lat = md.meta.position.getLat();
-	const double lon = md.meta.position.getLon();
-	const double alt = md.meta.position.getAltitude();
+	const double lat = md.meta->position.getLat();
+	const double lon = md.meta->position.getLon();
+	const double alt = md.meta->position.getAltitude();
 	if (lat==IOUtils::nodata || lon==IOUtils::nodata || alt==IOUtils::nodata) return IOUtils::nodata;
 	SunObject sun(lat, lon, alt);
 
@@ -21,6 +21,7 @@
 #include <meteoio/meteoLaws/Meteoconst.h>
 #include <meteoio/meteoStats/RandomNumberGenerator.h>
 
+#include <algorithm> //for std::min
 #include <cmath>
 #include <fstream> //for hardware seed
 #include <limits> //for numeric_limits
@@ -28,6 +29,137 @@
 
 namespace mio { //the holy land
 
+/* Constants and state transitions of the generators, shared by their single and bulk draws and by their jumps ahead */
+static const uint64_t XOR_LCG_MULT = 3935559000370003845ULL; //Ref. [PE99]
+static const uint64_t XOR_LCG_INC = 6204829405619482337ULL; //arb. odd value
+static const uint64_t XOR_MWC_MULT = 3874257210ULL; //Ref. [PE97]
+static const uint64_t PCG_MULT = 6364136223846793005ULL;
+static const unsigned int STREAM_SHIFT = 48; //the stream #k starts k*2^48 draws further
+static const uint64_t MAX_STREAMS = 1ULL << 15; //so the PCG (which uses 2 steps per draw) does not wrap around
+
+static inline uint64_t xorshiftStep(uint64_t vv)
+{ //64 bit xorshift, using one of the empirical triplets preserving order 2^64-1:
+	vv ^= (vv << 13); vv ^= (vv >> 7); vv ^= (vv << 17); //Ref. [GM03]
+	return vv;
+}
+
+static inline uint64_t mwcStep(const uint64_t& ww)
+{ //multiply with carry:
+	return XOR_MWC_MULT * (ww & 0xffffffff) + (ww >> 32); //Ref. [PE97]
+}
+
+static inline uint64_t xorStep(uint64_t& uu, uint64_t& vv, uint64_t& ww)
+{
+	//first, a linear congruential generator with good figures of merit:
+	uu = uu * XOR_LCG_MULT + XOR_LCG_INC;
+	vv = xorshiftStep(vv);
+	ww = mwcStep(ww);
+	//xorshift on the other states:
+	uint64_t xx = uu ^ (uu << 21); xx ^= xx >> 35; xx ^= xx << 4; //Ref. [NR3]
+	return (xx + vv) ^ ww;
+}
+
+//---------- The following code is under the Apache license (do what you want and include license)
+//https://www.apache.org/licenses/LICENSE-2.0
+static inline uint32_t pcgStep(uint64_t& state, const uint64_t& inc)
+{
+	//linear congruential state transition function:
+	const uint64_t oldstate = state;
+	state = oldstate * PCG_MULT + (inc|1);
+	//permutation function of a tuple as output function:
+	const uint32_t xorshifted = (uint32_t)( ((oldstate >> 18u) ^ oldstate) >> 27u );
+	const uint32_t rot = (uint32_t)(oldstate >> 59u);
+#ifdef _MSC_VER
+#pragma warning( push ) //for Visual C++
+#pragma warning(disable:4146) //Visual C++ rightfully complains... but this behavior is what we want!
+#endif
+	const uint32_t result = (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+#ifdef _MSC_VER
+#pragma warning( pop ) //for Visual C++, restore previous warnings behavior
+#endif
+	return  result;
+}
+//---------- End Apache license
+
+static uint64_t lcgJump(const uint64_t& state, uint64_t mult, uint64_t inc, uint64_t nr_steps)
+{ //the composition of LCG steps is itself an LCG step, so this is done by squaring in log(nr_steps),
+  //cf. F. Brown, "Random number generation with arbitrary strides", Trans. Am. Nucl. Soc., 1994
+	uint64_t acc_mult = 1, acc_inc = 0;
+	while (nr_steps > 0) {
+		if (nr_steps & 1) {
+			acc_mult *= mult;
+			acc_inc = acc_inc * mult + inc;
+		}
+		inc = (mult + 1) * inc;
+		mult *= mult;
+		nr_steps >>= 1;
+	}
+	return acc_mult * state + acc_inc;
+}
+
+static inline uint64_t applyBitMatrix(const uint64_t* mat, const uint64_t& vv)
+{ //mat[ii] is the image of the ii-th unit vector, all operations are in GF(2)
+	uint64_t result = 0;
+	for (unsigned int ii = 0; ii < 64; ++ii) {
+		if ((vv >> ii) & 1) result ^= mat[ii];
+	}
+	return result;
+}
+
+static uint64_t xorshiftJump(uint64_t vv, uint64_t nr_steps)
+{ //the xorshift step is linear in GF(2), so it can be written as a 64x64 bit matrix that is raised to the power nr_steps
+	uint64_t mat[64], tmp[64];
+	for (unsigned int ii = 0; ii < 64; ++ii) mat[ii] = xorshiftStep(1ULL << ii);
+
+	while (nr_steps > 0) {
+		if (nr_steps & 1) vv = applyBitMatrix(mat, vv);
+		nr_steps >>= 1;
+		if (nr_steps > 0) {
+			for (unsigned int ii = 0; ii < 64; ++ii) tmp[ii] = applyBitMatrix(mat, mat[ii]);
+			std::copy(tmp, tmp+64, mat);
+		}
+	}
+	return vv;
+}
+
+static uint64_t mulMod(uint64_t aa, uint64_t bb, const uint64_t& mod)
+{ //(aa*bb) % mod without overflow for any mod < 2^64 (by doubling and adding)
+	aa %= mod;
+	uint64_t result = 0;
+	while (bb > 0) {
+		if (bb & 1) result = (result >= mod - aa)? result - (mod - aa) : result + aa;
+		aa = (aa >= mod - aa)? aa - (mod - aa) : aa + aa;
+		bb >>= 1;
+	}
+	return result;
+}
+
+static uint64_t mwcJump(uint64_t ww, uint64_t nr_steps)
+{ //with b=2^32, a lag-1 multiply with carry step on ww=c*b+x is the same as ww*a modulo the prime p=a*b-1 (since a*b = 1 mod p)
+	static const uint64_t mod = (XOR_MWC_MULT << 32) - 1;
+	while (nr_steps > 0 && ww > mod) { //states that are not yet reduced first have to be brought into [0, p]
+		ww = mwcStep(ww);
+		nr_steps--;
+	}
+	if (nr_steps == 0 || ww == mod) return ww; //nothing left to do or fixed point
+
+	uint64_t factor = 1, base = XOR_MWC_MULT;
+	while (nr_steps > 0) {
+		if (nr_steps & 1) factor = mulMod(factor, base, mod);
+		base = mulMod(base, base, mod);
+		nr_steps >>= 1;
+	}
+	return mulMod(ww, factor, mod);
+}
+
+static inline uint64_t splitMix64(uint64_t& state)
+{ //simple but well mixing generator, to derive seeds from other seeds
+	uint64_t zz = (state += 0x9e3779b97f4a7c15ULL);
+	zz = (zz ^ (zz >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	zz = (zz ^ (zz >> 27)) * 0x94d049bb133111ebULL;
+	return zz ^ (zz >> 31);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //    RANDOM NUMBER GENERATOR class                                          //
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,6 +226,7 @@ RandomNumberGenerator::~RandomNumberGenerator()
 RandomNumberGenerator& RandomNumberGenerator::operator=(const RandomNumberGenerator& source)
 {
 	if (this != &source) {
+		delete rng_core;
 		rng_core = RngFactory::getCore(source.rng_type);
 		rng_type = source.rng_type;
 		rng_distribution = source.rng_distribution;
@@ -178,6 +311,69 @@ double RandomNumberGenerator::draw() //convenience call with no gimmicks
 	return doubUniform();
 }
 
+/**
+ * @brief Fill a buffer with 64 bit random numbers
+ * @details This returns the same numbers as nr_values calls to int64() but much faster.
+ * @param[out] out Pre-allocated array of at least nr_values elements
+ * @param nr_values Number of random numbers to draw
+ */
+void RandomNumberGenerator::fill(uint64_t* out, const size_t& nr_values)
+{
+	rng_core->fill(out, nr_values);
+}
+
+/**
+ * @brief Fill a buffer with random doubles following the set distribution
+ * @details This returns the same numbers as nr_values calls to doub(). The uniform and Gaussian deviates are
+ * computed in bulk, the other ones (that rely on rejection sampling) are still drawn one by one.
+ * @param[out] out Pre-allocated array of at least nr_values elements
+ * @param nr_values Number of random numbers to draw
+ */
+void RandomNumberGenerator::fill(double* out, const size_t& nr_values)
+{
+	switch (rng_distribution) {
+	case RNG_UNIFORM:
+		fillUniform(out, nr_values);
+		break;
+	case RNG_GAUSS: case RNG_NORMAL:
+		fillGauss(out, nr_values);
+		break;
+	default:
+		for (size_t ii = 0; ii < nr_values; ++ii)
+			out[ii] = (this->*doubFunc)();
+	}
+}
+
+/**
+ * @brief Jump ahead in the sequence of random numbers
+ * @details This is the same as discarding nr_draws 64 bit random numbers, but it only costs log(nr_draws) for
+ * the XOR and PCG generators (the Mersenne Twister really discards the numbers).
+ * @param nr_draws Number of 64 bit random numbers to skip
+ */
+void RandomNumberGenerator::jump(const uint64_t& nr_draws)
+{
+	rng_core->jump(nr_draws);
+}
+
+/**
+ * @brief Get an independent generator, for example for another thread
+ * @details The returned generator has the same algorithm and distribution as this one, but has been moved to
+ * the start of the stream #stream_idx (cf. \ref rng_bulk). This generator is not modified and the same state
+ * and stream index always lead to the same stream.
+ * @param stream_idx Index of the stream (stream 0 is this generator's own sequence)
+ * @return Generator drawing from the requested stream
+ */
+RandomNumberGenerator RandomNumberGenerator::getStream(const uint64_t& stream_idx) const
+{
+	if (stream_idx >= MAX_STREAMS)
+		throw InvalidArgumentException("RNG: Stream index too large (max. " + IOUtils::toString(MAX_STREAMS-1) + ")", AT);
+
+	RandomNumberGenerator stream(*this);
+	stream.rng_core->split(stream_idx);
+	stream.rng_muller_generate = false; //the cached Gaussian value belongs to the original stream
+	return stream;
+}
+
 /**
  * @brief Probability density function of selected distribution
  * @param xx Point to evaluate function at
@@ -670,6 +866,18 @@ double RandomNumberGenerator::doubUniform()
 	return RngCore::doubFromInt(rn);
 }
 
+void RandomNumberGenerator::fillUniform(double* out, const size_t& nr_values)
+{ //the integers are drawn into a small buffer that stays in cache
+	static const size_t chunk_size = 256;
+	uint64_t buffer[chunk_size];
+	for (size_t start = 0; start < nr_values; start += chunk_size) {
+		const size_t nr = std::min(chunk_size, nr_values - start);
+		rng_core->fill(buffer, nr);
+		for (size_t ii = 0; ii < nr; ++ii)
+			out[start+ii] = RngCore::doubFromInt(buffer[ii]);
+	}
+}
+
 double RandomNumberGenerator::pdfUniform(const double& /*xx*/) const
 {
 	//in a given interval, it is 1/(b-a) or 0 outside; for [0, 1] this is 1
@@ -712,6 +920,44 @@ double RandomNumberGenerator::doubGaussKernel(const double& mean, const double&
 } //http://mathworld.wolfram.com/Box-MullerTransformation.html
 
 
+void RandomNumberGenerator::fillGauss(double* out, const size_t& nr_values)
+{ //Box-Muller as in doubGaussKernel(), but on buffers of uniform numbers and consuming them in the very same order
+	static const double eps = std::numeric_limits<double>::min();
+	static const size_t chunk_size = 256; //must be even
+	const double mean = DistributionParameters[0];
+	const double sigma = DistributionParameters[1];
+
+	size_t ii = 0;
+	if (rng_muller_generate && nr_values > 0) { //a value is still waiting from a previous draw
+		out[ii++] = rng_muller_z1 * sigma + mean;
+		rng_muller_generate = false;
+	}
+
+	uint64_t buffer[chunk_size];
+	size_t nr_buffered = 0, pos = 0;
+	while (ii < nr_values) {
+		if (pos == nr_buffered) { //only draw as many numbers as needed for the remaining pairs
+			nr_buffered = std::min(chunk_size, 2 * ((nr_values - ii + 1) / 2));
+			rng_core->fill(buffer, nr_buffered);
+			pos = 0;
+		}
+		const double x1 = RngCore::doubFromInt(buffer[pos]);
+		const double x2 = RngCore::doubFromInt(buffer[pos+1]);
+		pos += 2;
+		if (x1 <= eps) continue;
+
+		const double radius = sqrt(-2. * log(x1));
+		out[ii++] = radius * cos(2.*Cst::PI * x2) * sigma + mean;
+		const double z1 = radius * sin(2.*Cst::PI * x2);
+		if (ii < nr_values) {
+			out[ii++] = z1 * sigma + mean;
+		} else { //keep the second value for the next draw, as doubGauss() would
+			rng_muller_z1 = z1;
+			rng_muller_generate = true;
+		}
+	}
+}
+
 double RandomNumberGenerator::pdfGauss(const double& xx) const
 { //Gauss curve around mean and with standard deviation at point xx (probability density function)
 	const double mean = DistributionParameters[0];
@@ -867,15 +1113,7 @@ RngXor::RngXor() : state(0), uu(0), vv(0), ww(0)
 /* PUBLIC FUNCTIONS */
 uint64_t RngXor::int64()
 {
-	//first, a linear congruential generator with good figures of merit:
-	uu = uu * 3935559000370003845LL + 6204829405619482337LL; //Ref. [PE99] + arb. odd value
-	//64 bit xorshift, using one of the empirical triplets preserving order 2^64-1:
-	vv ^= (vv << 13); vv ^= (vv >> 7); vv ^= (vv << 17); //Ref. [GM03]
-	//multiply with carry:
-	ww = 3874257210U * (ww & 0xffffffff) + (ww >> 32); //Ref. [PE97]
-	//xorshift on the other states:
-	uint64_t xx = uu ^ (uu << 21); xx ^= xx >> 35; xx ^= xx << 4; //Ref. [NR3]
-	return (xx + vv) ^ ww;
+	return xorStep(uu, vv, ww);
 }
 
 uint32_t RngXor::int32()
@@ -903,6 +1141,21 @@ void RngXor::setState(const std::vector<uint64_t>& ivec_seed)
 	ww = ivec_seed[3];
 }
 
+void RngXor::fill(uint64_t* out, const size_t& nr_values)
+{ //local copies of the states so they can stay in registers
+	uint64_t u(uu), v(vv), w(ww);
+	for (size_t ii = 0; ii < nr_values; ++ii)
+		out[ii] = xorStep(u, v, w);
+	uu = u; vv = v; ww = w;
+}
+
+void RngXor::jump(const uint64_t& nr_draws)
+{ //the three combined generators are independent, so each of them can be jumped ahead on its own
+	uu = lcgJump(uu, XOR_LCG_MULT, XOR_LCG_INC, nr_draws);
+	vv = xorshiftJump(vv, nr_draws);
+	ww = mwcJump(ww, nr_draws);
+}
+
 /* PRIVATE FUNCTIONS */
 bool RngXor::initAllStates() //initial XOR-generator states
 {
@@ -929,32 +1182,15 @@ RngPcg::RngPcg() : state(0), inc(0)
 /* PUBLIC FUNCTIONS */
 uint64_t RngPcg::int64() //for PCG, draw two 32 bit numbers and combine them to one 64 bit nr
 {
-	const uint32_t lowpart = int32();
-	const uint32_t highpart = int32();
+	const uint32_t lowpart = pcgStep(state, inc);
+	const uint32_t highpart = pcgStep(state, inc);
 	return RngCore::combine32to64(lowpart, highpart);
 }
 
-//---------- The following code is under the Apache license (do what you want and include license)
-//https://www.apache.org/licenses/LICENSE-2.0
 uint32_t RngPcg::int32()
 {
-	//linear congruential state transition function:
-	const uint64_t oldstate = state; 
-	state = oldstate * 6364136223846793005ULL + (inc|1);
-	//permutation function of a tuple as output function:
-	const uint32_t xorshifted = (uint32_t)( ((oldstate >> 18u) ^ oldstate) >> 27u );
-	const uint32_t rot = (uint32_t)(oldstate >> 59u);
-#ifdef _MSC_VER
-#pragma warning( push ) //for Visual C++
-#pragma warning(disable:4146) //Visual C++ rightfully complains... but this behavior is what we want!
-#endif
-	const uint32_t result = (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
-#ifdef _MSC_VER
-#pragma warning( pop ) //for Visual C++, restore previous warnings behavior
-#endif
-	return  result;
+	return pcgStep(state, inc);
 }
-//---------- End Apache license
 
 void RngPcg::getState(std::vector<uint64_t>& ovec_seed) const
 {
@@ -972,6 +1208,22 @@ void RngPcg::setState(const std::vector<uint64_t>& ivec_seed)
 	inc = ivec_seed[1];
 }
 
+void RngPcg::fill(uint64_t* out, const size_t& nr_values)
+{
+	uint64_t st(state);
+	for (size_t ii = 0; ii < nr_values; ++ii) {
+		const uint32_t lowpart = pcgStep(st, inc);
+		const uint32_t highpart = pcgStep(st, inc);
+		out[ii] = RngCore::combine32to64(lowpart, highpart);
+	}
+	state = st;
+}
+
+void RngPcg::jump(const uint64_t& nr_draws)
+{ //each 64 bit number needs two steps
+	state = lcgJump(state, PCG_MULT, inc|1, 2*nr_draws);
+}
+
 /* PRIVATE FUNCTIONS */
 bool RngPcg::initAllStates() //initial PCG-generator states
 {
@@ -1000,8 +1252,8 @@ RngMtw::RngMtw() : MT_NN(624), MT_MM(397), current_mt_index(0), vec_states(std::
 /* PUBLIC FUNCTIONS */
 uint64_t RngMtw::int64()
 {
-	const uint32_t lowpart = int32();
-	const uint32_t highpart = int32();
+	const uint32_t lowpart = RngMtw::int32();
+	const uint32_t highpart = RngMtw::int32();
 	return RngCore::combine32to64(lowpart, highpart);
 }
 
@@ -1017,7 +1269,7 @@ void RngMtw::getState(std::vector<uint64_t>& ovec_seed) const
 void RngMtw::setState(const std::vector<uint64_t>& ivec_seed)
 {
 	//assert that we have NN seeds or NN+1 seeds with the 1st one usable as the current index:
-	if ( (ivec_seed.size() != MT_NN) && ((ivec_seed.size() != MT_NN + 1) || (ivec_seed[0] >= MT_NN)) ) {
+	if ( (ivec_seed.size() != MT_NN) && ((ivec_seed.size() != MT_NN + 1) || (ivec_seed[0] > MT_NN)) ) {
 		std::stringstream ss;
 		ss << "RNG: Unexpected number of seeds for this generator (needed: " << MT_NN << ")";
 		throw InvalidArgumentException(ss.str(), AT);
@@ -1029,10 +1281,26 @@ void RngMtw::setState(const std::vector<uint64_t>& ivec_seed)
 	} else { //initializing from scratch with NN numbers the user provides
 		current_mt_index = 0;
 	}
-	for (size_t i = 0; i < ivec_seed.size(); ++i)
+	for (size_t i = 0; i < MT_NN; ++i)
 		vec_states[i] = (uint32_t)ivec_seed[i+offset];
 }
 
+void RngMtw::fill(uint64_t* out, const size_t& nr_values)
+{
+	for (size_t ii = 0; ii < nr_values; ++ii)
+		out[ii] = RngMtw::int64(); //qualified call, so it is not dispatched virtually
+}
+
+void RngMtw::split(const uint64_t& stream_idx)
+{ //there is no cheap jump ahead, so the states are mixed with a sequence derived from the stream index
+	if (stream_idx == 0) return;
+	uint64_t mixer = stream_idx;
+	for (size_t i = 0; i < MT_NN; ++i)
+		vec_states[i] ^= (uint32_t)(splitMix64(mixer) >> 32);
+	vec_states[0] = 0x80000000UL; //assure non-zero initial array, as in initAllStates()
+	current_mt_index = MT_NN; //start with a fresh set of numbers
+}
+
 
 
 //---------- The following code is adapted from copyrighted but completely free-to-use material by M. Matsumoto and T. Nishimura, Ref. [MN98]
@@ -1122,7 +1390,7 @@ bool RngMtw::initAllStates() //init all states with a mix of "true" and "pseudo"
 		}
 	}
 	vec_states[0] = 0x80000000UL; //assure non-zero initial array (most significant bit is 1)
-	current_mt_index = MT_NN + 1; //make sure int32() inits on the first run
+	current_mt_index = MT_NN; //make sure int32() inits on the first run
 
 	return hardware_success;
 }
@@ -1164,6 +1432,23 @@ bool RngCore::getUniqueSeed(uint64_t& store) const
 	#endif
 }
 
+void RngCore::fill(uint64_t* out, const size_t& nr_values)
+{
+	for (size_t ii = 0; ii < nr_values; ++ii)
+		out[ii] = int64();
+}
+
+void RngCore::jump(const uint64_t& nr_draws)
+{
+	for (uint64_t ii = 0; ii < nr_draws; ++ii)
+		int64();
+}
+
+void RngCore::split(const uint64_t& stream_idx)
+{
+	jump(stream_idx << STREAM_SHIFT);
+}
+
 /* PROTECTED FUNCTIONS */
 uint64_t RngCore::combine32to64(const uint32_t& low, const uint32_t& high) const 
 {
@@ -75,6 +75,7 @@ namespace mio {
  *  - fast downscaling of random numbers to a range
  *  - true floating point random numbers without rounding
  *  - can be resumed from a saved state
+ *  - fill whole buffers at once and provide independent, reproducible streams for parallel computations
  *  - sidesteps some widespread misuse of quick & dirty solutions
  *  - sidesteps some issues with the insidious standard library
  *  - offers a ready-to-use interface for implementing new distributions (or even generators)
@@ -376,6 +377,35 @@ namespace mio {
  * RN2.setState(out_seed);
  * @endcode
  *
+ * @section rng_bulk Bulk generation and parallel streams
+ * When many random numbers are needed at once (for example one per particle of a particle filter), a whole buffer can
+ * be filled in one call. This is much faster than repeated calls to int64() or doub() since the generator's states
+ * stay in registers and the distribution's transform is applied in a tight loop (the Box-Muller transform for Gaussian
+ * deviates then produces both of its values in one pass). The numbers are exactly the same as the ones that would have been
+ * returned by as many calls to int64(), respectively doub() with the current distribution:
+ * @code
+ * std::vector<double> noise(1000);
+ * RNG.setDistribution(mio::RandomNumberGenerator::RNG_GAUSS);
+ * RNG.fill(&noise[0], noise.size());
+ * @endcode
+ *
+ * For parallel computations, each thread should draw from its own generator. In order to keep the results
+ * reproducible, these generators must not be seeded independently but derived from a common one:
+ * getStream() returns a copy of the generator (with the same distribution) that has been moved to the start of an
+ * independent stream of random numbers. The same generator state and stream index always lead to the same stream,
+ * whatever the number of threads:
+ * @code
+ * std::vector<mio::RandomNumberGenerator> vec_rng;
+ * for (size_t ii=0; ii<nr_blocks; ii++)
+ *     vec_rng.push_back( RNG.getStream(ii+1) ); //stream #0 would be the same as RNG itself
+ * @endcode
+ * For the XOR and PCG generators, the stream #k starts k*2^48 numbers further in the sequence of the generator
+ * (so the streams don't overlap as long as less than 2^48 numbers are drawn from each of them). This relies on an
+ * exact jump ahead that can also be called directly with jump(), at a cost in log(nr_draws). The Mersenne Twister
+ * can not be jumped ahead efficiently without large precomputed polynomials: its streams are obtained by
+ * re-seeding its internal states from a hash of the current states and the stream index (given its very long period,
+ * an overlap is extremely unlikely) and jump() simply discards the numbers.
+ *
  * @section rng_developer Developer's guide
  * For developers of statistical filters it may be important to be able to implement custom probability distributions,
  * for example for an empirical nonlinear sensor response. This class tries to be easy to expand in that regard.
@@ -1213,6 +1243,10 @@ class RngCore {
 		virtual uint32_t int32() = 0;
 		virtual void getState(std::vector<uint64_t>& ovec_seed) const = 0;
 		virtual void setState(const std::vector<uint64_t>& ivec_seed) = 0;
+		//the generic versions below simply loop over int64(), generators should provide faster ones if they can:
+		virtual void fill(uint64_t* out, const size_t& nr_values); //nr_values 64 bit numbers at once
+		virtual void jump(const uint64_t& nr_draws); //same as discarding nr_draws 64 bit numbers
+		virtual void split(const uint64_t& stream_idx); //move to the start of the independent stream #stream_idx
 		//hardware or time seed; everyone may retrieve those from our RNG from outside:
 		bool getUniqueSeed(uint64_t& store) const;
 
@@ -1271,6 +1305,11 @@ class RandomNumberGenerator : private RngCore {
 		double doub(const RNG_BOUND& bounds, const bool& true_double = false);
 		double draw(); //alias for uniform double
 
+		void fill(uint64_t* out, const size_t& nr_values); //bulk version of int64()
+		void fill(double* out, const size_t& nr_values); //bulk version of doub()
+		void jump(const uint64_t& nr_draws);
+		RandomNumberGenerator getStream(const uint64_t& stream_idx) const;
+
 		double pdf(const double& xx); //probability density function
 		double cdf(const double& xx); //cumulative distribution function
 
@@ -1326,6 +1365,8 @@ class RandomNumberGenerator : private RngCore {
 		double cdfNotImplemented(const double& xx) const;
 
 		double doubGaussKernel(const double& mean, const double& sigma); //internal calls with specific params
+		void fillUniform(double* out, const size_t& nr_values);
+		void fillGauss(double* out, const size_t& nr_values);
 		double doubGammaKernel(const double& alpha, const double& beta);
 		double doubBetaKernel(const double& alpha, const double& beta);
 };
@@ -1337,6 +1378,8 @@ class RngXor : public RngCore { //combined generator with xor, shift and multipl
 		uint32_t int32();
 		void getState(std::vector<uint64_t>& ovec_seed) const;
 		void setState(const std::vector<uint64_t>& ivec_seed);
+		void fill(uint64_t* out, const size_t& nr_values);
+		void jump(const uint64_t& nr_draws);
 
 	private:
 		uint64_t state;
@@ -1352,6 +1395,8 @@ class RngPcg : public RngCore { //Permuted linear congruential generator
 		uint32_t int32( );
 		void getState(std::vector<uint64_t>& ovec_seed) const;
 		void setState(const std::vector<uint64_t>& ivec_seed);
+		void fill(uint64_t* out, const size_t& nr_values);
+		void jump(const uint64_t& nr_draws);
 
 	private:
 		uint64_t state;
@@ -1367,6 +1412,8 @@ class RngMtw : public RngCore { //Mersenne Twister
 		uint32_t int32( );
 		void getState(std::vector<uint64_t>& ovec_seed) const;
 		void setState(const std::vector<uint64_t>& ivec_seed);
+		void fill(uint64_t* out, const size_t& nr_values);
+		void split(const uint64_t& stream_idx);
 
 	private:
 		const unsigned int MT_NN; //number of states
@@ -283,6 +283,12 @@ double LinVario::f(const double& x) const {
 	}
 }
 
+bool LinVario::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = (x==0)? 0. : 1.;
+	grad[1] = (x==0)? 0. : std::abs(x);
+	return true;
+}
+
 void LinVario::setDefaultGuess() {
 	double xzero=X[0];
 	size_t xzero_idx=0;
@@ -347,6 +353,12 @@ double LinearLS::f(const double& x) const {
 	return y;
 }
 
+bool LinearLS::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = x;
+	grad[1] = 1.;
+	return true;
+}
+
 void LinearLS::setDefaultGuess() {
 	double xzero=X[0];
 	size_t xzero_idx=0;
@@ -364,6 +376,13 @@ double Quadratic::f(const double& x) const {
 	return y;
 }
 
+bool Quadratic::gradient(const double& x, std::vector<double>& grad) const {
+	grad[0] = x*x;
+	grad[1] = x;
+	grad[2] = 1.;
+	return true;
+}
+
 void Quadratic::setDefaultGuess() {
 	const std::vector<double> der( Interpol1D::derivative(X, Y) );
 	const double acc = 0.5 * Interpol1D::arithmeticMean( Interpol1D::derivative(X, der) );
@@ -434,10 +453,12 @@ bool FitLinClosedForm::fit()
 			X(jj+1, ii+2) = predictors[jj][ii];
 	}
 
-	//compute the Betas
-	const Matrix X_T( X.getT() );
-	Beta.resize(nPreds+1, 1);
-	Beta = (X_T * X).getInv() * X_T * Y;
+	//compute the Betas by solving the normal equations (X^T·X)·Beta = X^T·Y
+	Matrix XtX, XtY;
+	Matrix::mult_into(X, X, XtX, true);
+	Matrix::mult_into(X, Y, XtY, true);
+	if (!Matrix::solve_into(XtX, XtY, Beta))
+		throw IOException("The normal equations are singular, the linear regression can not be computed", AT);
 	fit_ready = true;
 
 	//compute R2
@@ -52,6 +52,7 @@ class NoisyLinear : public SimpleLinear {
 		bool fit();
 };
 
+//the non-linear variograms have no analytic gradient: their fits would then converge to different coefficients
 class SphericVario : public FitLeastSquare {
 	public:
 		SphericVario() : FitLeastSquare("SphericVario", 3, 4) {fit_ready = false;}
@@ -64,6 +65,9 @@ class LinVario : public FitLeastSquare {
 		LinVario() : FitLeastSquare("LinVario", 2, 3) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
+		bool isLinear() const {return true;}
 };
 
 class ExpVario : public FitLeastSquare {
@@ -73,6 +77,7 @@ class ExpVario : public FitLeastSquare {
 		double f(const double& x) const;
 };
 
+//the finite differences also damp the steps on ar and converge more often for this model
 class RatQuadVario : public FitLeastSquare {
 	public:
 		RatQuadVario() : FitLeastSquare("RatQuadVario", 3, 4) {fit_ready = false;}
@@ -85,6 +90,9 @@ class LinearLS : public FitLeastSquare {
 		LinearLS() : FitLeastSquare("LinearLS", 2, 3) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
+		bool isLinear() const {return true;}
 };
 
 class Quadratic : public FitLeastSquare {
@@ -92,6 +100,9 @@ class Quadratic : public FitLeastSquare {
 		Quadratic() : FitLeastSquare("Quadratic", 3, 4) {fit_ready = false;}
 		void setDefaultGuess();
 		double f(const double& x) const;
+	protected:
+		bool gradient(const double& x, std::vector<double>& grad) const;
+		bool isLinear() const {return true;}
 };
 
   /**
@@ -144,13 +144,14 @@ bool FitLeastSquare::fit()
 //see http://mathworld.wolfram.com/NonlinearLeastSquaresFitting.html
 bool FitLeastSquare::computeFit()
 {
+	if (isLinear()) return computeLinearFit();
+
 	double max_delta;
 	initLambda();
-	Matrix dLambda; //parameters variations
-	initDLambda(dLambda);
+	initDLambda(); //parameters variations
 
-	Matrix A(nPts, nParam);
-	Matrix dBeta(nPts, (size_t)1);
+	A.resize(nPts, nParam);
+	dBeta.resize(nPts, (size_t)1);
 
 	unsigned int iter = 0;
 	do {
@@ -161,17 +162,12 @@ bool FitLeastSquare::computeFit()
 		}
 
 		//set A matrix
-		for (size_t m=1; m<=nPts; m++) {
-			for (size_t n=1; n<=nParam; n++) {
-				const double value = DDer( X[m-1], n ); //X is a vector
-				A(m,n) = value;
-			}
-		}
+		fillJacobian();
 
 		//calculate parameters deltas
-		const Matrix a( A.getT() * A );
-		const Matrix b( A.getT() * dBeta );
-		if (!Matrix::solve(a, b, dLambda)) return false;
+		Matrix::mult_into(A, A, a, true); //A^T·A
+		Matrix::mult_into(A, dBeta, b, true); //A^T·dBeta
+		if (!Matrix::solve_into(a, b, dLambda)) return false;
 
 		//apply the deltas to the parameters, record maximum delta
 		max_delta = 0.;
@@ -201,13 +197,58 @@ bool FitLeastSquare::computeFit()
 	}
 }
 
+//for models that are linear in their parameters, the normal equations A^T·A·Lambda = A^T·Y are solved directly
+bool FitLeastSquare::computeLinearFit()
+{
+	Lambda.assign(nParam, 0.);
+	A.resize(nPts, nParam);
+	dBeta.resize(nPts, (size_t)1);
+	fillJacobian(); //it does not depend on Lambda
+	Matrix::mult_into(A, A, a, true); //A^T·A
+
+	//solve once from Lambda=0, then refine once with the residuals to recover the rounding errors
+	for (unsigned int iter=0; iter<2; iter++) {
+		for (size_t m=1; m<=nPts; m++) {
+			dBeta(m,1) = Y[m-1] - f(X[m-1]);
+		}
+		Matrix::mult_into(A, dBeta, b, true); //A^T·dBeta
+		if (!Matrix::solve_into(a, b, dLambda)) return false;
+		for (size_t n=1; n<=nParam; n++) Lambda[n-1] += dLambda(n,1);
+	}
+
+	for (size_t m=1; m<=nPts; m++) {
+		dBeta(m,1) = Y[m-1] - f(X[m-1]);
+	}
+	const double R2 = Matrix::dot(dBeta, dBeta);
+
+	ostringstream ss;
+	ss << "Computed regression with " << regname << " model ";
+	ss << "- Sum of square residuals = " << std::setprecision(2) << R2 << " - closed form";
+	infoString = ss.str();
+	fit_ready = true;
+	return true;
+}
+
+//fill the jacobian A with the partial derivatives of f for each data point, analytically if the model supports it
+void FitLeastSquare::fillJacobian()
+{
+	gradBuffer.resize(nParam);
+	for (size_t m=1; m<=nPts; m++) {
+		if (gradient(X[m-1], gradBuffer)) {
+			for (size_t n=1; n<=nParam; n++) A(m,n) = gradBuffer[n-1];
+		} else {
+			for (size_t n=1; n<=nParam; n++) A(m,n) = DDer( X[m-1], n ); //X is a vector
+		}
+	}
+}
+
 void FitLeastSquare::initLambda()
 {
 	if (Lambda.empty()) //else, setGuess has been called
 		Lambda.resize(nParam, lambda_init);
 }
 
-void FitLeastSquare::initDLambda(Matrix& dLambda) const
+void FitLeastSquare::initDLambda()
 {
 	dLambda.resize(nParam,1);
 	for (size_t m=1; m<=nParam; m++) {
@@ -66,6 +66,8 @@ class FitModel {
  * @brief A class to perform non-linear least square fitting.
  * It works on a time serie and uses matrix arithmetic to perform an arbitrary fit
  * (see http://mathworld.wolfram.com/NonlinearLeastSquaresFitting.html).
+ * Models can provide the analytic partial derivatives of their function (otherwise, they are computed by finite differences)
+ * and models that are linear in their parameters are solved directly through their normal equations, without iterating.
  *
  * @ingroup stats
  * @author Mathias Bavay
@@ -73,20 +75,32 @@ class FitModel {
  */
 class FitLeastSquare : public FitModel {
  	public:
-		FitLeastSquare(const std::string& i_regname, const size_t& i_nParam, const size_t& i_min_nb_pts) : FitModel(i_regname, i_nParam, i_min_nb_pts) {}
+		FitLeastSquare(const std::string& i_regname, const size_t& i_nParam, const size_t& i_min_nb_pts)
+		              : FitModel(i_regname, i_nParam, i_min_nb_pts), A(), dBeta(), a(), b(), dLambda(), gradBuffer() {}
 		void setData(const std::vector<double>& in_X, const std::vector<double>& in_Y);
 		bool fit();
 		virtual double f(const double& x) const = 0;
 
 	protected:
 		virtual void setDefaultGuess(); //set defaults guess values. Called by setData
+		//analytic partial derivatives of f(x) for each parameter (grad is already sized). Return false to use finite differences
+		virtual bool gradient(const double& /*x*/, std::vector<double>& /*grad*/) const {return false;}
+		//true if f is linear in its parameters (its gradient does not depend on them), then the fit is computed in closed form
+		virtual bool isLinear() const {return false;}
+		//partial derivative of f(x) for the given parameter (starting at 1), by finite differences
+		double DDer(const double& x, const size_t& index);
 
 	private:
 		void initLambda();
-		void initDLambda(Matrix& dLambda) const;
+		void initDLambda();
 		double getDelta(const double& var) const;
-		double DDer(const double& x, const size_t& index);
+		void fillJacobian();
 		bool computeFit();
+		bool computeLinearFit();
+
+		Matrix A, dBeta; //jacobian and residuals
+		Matrix a, b, dLambda; //normal equations and their solution
+		std::vector<double> gradBuffer; //gradient of f for one data point
 
 		static const double lambda_init; //initial default guess
 		static const double delta_init_abs; //initial delta, absolute
@@ -18,6 +18,8 @@
 */
 #include <cmath>
 #include <algorithm>
+#include <exception>
+#include <limits>
 
 #include <meteoio/meteoStats/libinterpol2D.h>
 #include <meteoio/meteoLaws/Atmosphere.h>
@@ -96,29 +98,174 @@ inline double Interpol2D::HorizontalDistance(const DEMObject& dem, const int& i,
 }
 
 /**
-* @brief Build the list of (distance to grid cell, stations index) ordered by their distance to a grid cell
-* @param x x coordinate of cell
-* @param y y coordinate of cell
-* @param list list of pairs (distance to grid cell, stations index)
+* @class Interpol2D::StationIndex
+* @brief Uniform grid of buckets over the stations that provide valid data, for fast neighbors searches.
+* @details Only the stations that have both a valid value and a valid altitude are indexed (the others would anyway be skipped).
+* They are kept in their original order, so the neighbors are returned sorted by (distance, original index), exactly as
+* a full sort of all the stations would do.
 */
-void Interpol2D::getNeighbors(const double& x, const double& y,
-                              const std::vector<StationData>& vecStations,
-                              std::vector< std::pair<double, size_t> >& list)
+class Interpol2D::StationIndex {
+	public:
+		StationIndex(const std::vector<double>& vecData, const std::vector<StationData>& vecStations);
+
+		size_t size() const {return eastings.size();}
+		void getNeighbors(const double& x, const double& y, const size_t& nrOfNeighbors, const double& MaxDistance,
+		                  std::vector< std::pair<double, size_t> >& list) const;
+
+		std::vector<double> eastings, northings, altitudes, values;
+
+	private:
+		size_t getBucket(const double& coord, const double& origin, const size_t& n) const;
+		void addCandidates(const double& x, const double& y, const size_t& bucket, const double& max_d2,
+		                   std::vector< std::pair<double, size_t> >& list) const;
+
+		std::vector<size_t> bucket_start; ///< offsets into bucket_items, one per bucket plus one (CSR layout)
+		std::vector<size_t> bucket_items; ///< stations indices, grouped per bucket
+		double x0, y0, bucket_size;
+		size_t nx, ny;
+
+		static const size_t max_buckets_per_axis = 512;
+		static const size_t brute_force_threshold = 16; ///< below this number of stations, simply look at all of them
+};
+
+Interpol2D::StationIndex::StationIndex(const std::vector<double>& vecData, const std::vector<StationData>& vecStations)
+                         : eastings(), northings(), altitudes(), values(), bucket_start(), bucket_items(), x0(0.), y0(0.), bucket_size(1.), nx(1), ny(1)
 {
-	list.resize(vecStations.size());
+	for (size_t ii=0; ii<vecStations.size(); ii++) {
+		const double value = vecData[ii];
+		const double altitude = vecStations[ii].position.getAltitude();
+		if (value==IOUtils::nodata || altitude==IOUtils::nodata) continue;
+		eastings.push_back( vecStations[ii].position.getEasting() );
+		northings.push_back( vecStations[ii].position.getNorthing() );
+		altitudes.push_back( altitude );
+		values.push_back( value );
+	}
 
-	for (size_t i=0; i<vecStations.size(); i++) {
-		const Coords& position = vecStations[i].position;
-		const double DX = x-position.getEasting();
-		const double DY = y-position.getNorthing();
+	const size_t nr_stations = eastings.size();
+	if (nr_stations<=brute_force_threshold) return;
+
+	x0 = *std::min_element(eastings.begin(), eastings.end());
+	y0 = *std::min_element(northings.begin(), northings.end());
+	const double width = *std::max_element(eastings.begin(), eastings.end()) - x0;
+	const double height = *std::max_element(northings.begin(), northings.end()) - y0;
+
+	//aim for about one station per bucket
+	if (width>0. && height>0.) bucket_size = sqrt( width*height / static_cast<double>(nr_stations) );
+	else if (width>0. || height>0.) bucket_size = std::max(width, height) / static_cast<double>(nr_stations);
+	bucket_size = std::max(bucket_size, std::max(width, height) / static_cast<double>(max_buckets_per_axis));
+	if (bucket_size<=0.) bucket_size = 1.; //all stations at the same place
+	nx = static_cast<size_t>( width / bucket_size ) + 1;
+	ny = static_cast<size_t>( height / bucket_size ) + 1;
+
+	//counting sort of the stations into their buckets, keeping their original order within each bucket
+	std::vector<size_t> station_bucket( nr_stations );
+	bucket_start.assign(nx*ny+1, 0);
+	for (size_t ii=0; ii<nr_stations; ii++) {
+		station_bucket[ii] = getBucket(eastings[ii], x0, nx) + nx*getBucket(northings[ii], y0, ny);
+		bucket_start[ station_bucket[ii]+1 ]++;
+	}
+	for (size_t bb=0; bb<nx*ny; bb++) bucket_start[bb+1] += bucket_start[bb];
+	std::vector<size_t> fill( bucket_start.begin(), bucket_start.end()-1 );
+	bucket_items.resize( nr_stations );
+	for (size_t ii=0; ii<nr_stations; ii++) bucket_items[ fill[station_bucket[ii]]++ ] = ii;
+}
+
+inline size_t Interpol2D::StationIndex::getBucket(const double& coord, const double& origin, const size_t& n) const
+{
+	const double pos = (coord - origin) / bucket_size;
+	if (pos<=0.) return 0;
+	return std::min(static_cast<size_t>(pos), n-1);
+}
+
+inline void Interpol2D::StationIndex::addCandidates(const double& x, const double& y, const size_t& bucket, const double& max_d2,
+                                                   std::vector< std::pair<double, size_t> >& list) const
+{
+	for (size_t kk=bucket_start[bucket]; kk<bucket_start[bucket+1]; kk++) {
+		const size_t st = bucket_items[kk];
+		const double DX = x-eastings[st];
+		const double DY = y-northings[st];
 		const double d2 = (DX*DX + DY*DY);
-		const std::pair <double, size_t> tmp(d2,i);
-		list[i] = tmp;
+		if (d2<=max_d2) list.push_back( std::make_pair(d2, st) );
 	}
+}
+
+/**
+* @brief Build the list of (squared distance to a point, station index) ordered by their distance to the point
+* @details The list is truncated to the nrOfNeighbors closest stations (if nrOfNeighbors>0) and to the stations
+* that are within MaxDistance (if MaxDistance>0). The search visits the buckets ring by ring around the point and stops
+* as soon as no station that has not been visited yet could make it into the list.
+* @param x easting of the point
+* @param y northing of the point
+* @param nrOfNeighbors maximum number of stations to return (0 for unlimited)
+* @param MaxDistance maximum distance of the stations to the point (0 for unlimited)
+* @param list list of pairs (squared distance to the point, index in the StationIndex)
+*/
+void Interpol2D::StationIndex::getNeighbors(const double& x, const double& y, const size_t& nrOfNeighbors, const double& MaxDistance,
+                                           std::vector< std::pair<double, size_t> >& list) const
+{
+	list.clear();
+	const size_t nr_stations = eastings.size();
+	const double max_d2 = (MaxDistance>0.)? MaxDistance*MaxDistance : std::numeric_limits<double>::max();
+	const size_t k = (nrOfNeighbors>0)? std::min(nrOfNeighbors, nr_stations) : nr_stations;
+	if (k==0) return;
+
+	if (bucket_items.empty()) { //no buckets, look at all the stations
+		for (size_t st=0; st<nr_stations; st++) {
+			const double DX = x-eastings[st];
+			const double DY = y-northings[st];
+			const double d2 = (DX*DX + DY*DY);
+			if (d2<=max_d2) list.push_back( std::make_pair(d2, st) );
+		}
+	} else {
+		const size_t bx = getBucket(x, x0, nx);
+		const size_t by = getBucket(y, y0, ny);
+		const size_t max_ring = std::max( std::max(bx, nx-1-bx), std::max(by, ny-1-by) );
+
+		for (size_t ring=0; ring<=max_ring; ring++) {
+			const size_t ii_min = (bx>=ring)? bx-ring : 0, ii_max = std::min(bx+ring, nx-1);
+			const size_t jj_min = (by>=ring)? by-ring : 0, jj_max = std::min(by+ring, ny-1);
+			for (size_t jj=jj_min; jj<=jj_max; jj++) {
+				const bool full_row = (jj+ring==by || jj==by+ring);
+				if (full_row) {
+					for (size_t ii=ii_min; ii<=ii_max; ii++) addCandidates(x, y, ii+jj*nx, max_d2, list);
+				} else { //only the left and right edges of the ring
+					if (bx>=ring) addCandidates(x, y, bx-ring+jj*nx, max_d2, list);
+					if (ring>0 && bx+ring<nx) addCandidates(x, y, bx+ring+jj*nx, max_d2, list);
+				}
+			}
+
+			//keep only the k best candidates (pairs are ordered by distance then index, as a full sort would do)
+			if (list.size()>k) {
+				std::nth_element(list.begin(), list.begin()+static_cast<std::ptrdiff_t>(k-1), list.end());
+				list.resize( k );
+			}
 
-	sort (list.begin(), list.end());
+			//all the stations beyond this ring are at least "reach" away from the point
+			const double reach = static_cast<double>(ring)*bucket_size - 1e-6*bucket_size;
+			if (reach<=0.) continue;
+			const double reach2 = reach*reach;
+			if (reach2>max_d2) break;
+			if (list.size()==k && std::max_element(list.begin(), list.end())->first<reach2) break;
+		}
+	}
+
+	if (list.size()>k) {
+		std::nth_element(list.begin(), list.begin()+static_cast<std::ptrdiff_t>(k-1), list.end());
+		list.resize( k );
+	}
+	std::sort(list.begin(), list.end());
 }
 
+/**
+* @struct Interpol2D::LLIDWBuffers
+* @brief Scratch buffers for LLIDW_pixel, allocated once per thread and reused for all the pixels it computes
+*/
+struct Interpol2D::LLIDWBuffers {
+	LLIDWBuffers() : neighbors(), altitudes(), values(), distances_sq() {}
+	std::vector< std::pair<double, size_t> > neighbors;
+	std::vector<double> altitudes, values, distances_sq;
+};
+
 //convert a vector of stations into two vectors of eastings and northings
 void Interpol2D::buildPositionsVectors(const std::vector<StationData>& vecStations, std::vector<double>& vecEastings, std::vector<double>& vecNorthings)
 {
@@ -237,59 +384,80 @@ void Interpol2D::LocalLapseIDW(const std::vector<double>& vecData_in, const std:
                                Grid2DObject& grid, const double& scale, const double& alpha)
 {
 	grid.set(dem, IOUtils::nodata);
+	const StationIndex index(vecData_in, vecStations_in); //built once for all the pixels
 
-	//run algorithm
-	for (size_t j=0; j<grid.getNy(); j++) {
-		for (size_t i=0; i<grid.getNx(); i++) {
-			//LL_IDW_pixel returns nodata when appropriate
-			grid(i,j) = LLIDW_pixel(i, j, vecData_in, vecStations_in, dem, nrOfNeighbors, MaxDistance, scale, alpha);
+	//run algorithm, tile by tile so neighboring pixels (that share most of their neighbors) are processed together
+	static const size_t tile_size = 64;
+	const size_t ncols = grid.getNx(), nrows = grid.getNy();
+	const size_t ntiles_x = (ncols+tile_size-1) / tile_size;
+	const int nr_tiles = static_cast<int>( ntiles_x * ((nrows+tile_size-1) / tile_size) );
+	const double xllcorner = dem.llcorner.getEasting();
+	const double yllcorner = dem.llcorner.getNorthing();
+	std::exception_ptr error;
+
+#pragma omp parallel
+	{
+		LLIDWBuffers buffers;
+#pragma omp for schedule(dynamic)
+		for (int tile=0; tile<nr_tiles; tile++) {
+			try {
+				const size_t i0 = (static_cast<size_t>(tile) % ntiles_x) * tile_size;
+				const size_t j0 = (static_cast<size_t>(tile) / ntiles_x) * tile_size;
+				const size_t i1 = std::min(i0+tile_size, ncols), j1 = std::min(j0+tile_size, nrows);
+				for (size_t j=j0; j<j1; j++) {
+					const double y = yllcorner+static_cast<double>(j)*dem.cellsize;
+					for (size_t i=i0; i<i1; i++) {
+						const double cell_altitude = dem(i,j);
+						if (cell_altitude==IOUtils::nodata) continue;
+						const double x = xllcorner+static_cast<double>(i)*dem.cellsize;
+						//LL_IDW_pixel returns nodata when appropriate
+						grid(i,j) = LLIDW_pixel(x, y, cell_altitude, index, nrOfNeighbors, MaxDistance, scale, alpha, buffers);
+					}
+				}
+			} catch (...) { //exceptions can not cross the parallel region
+#pragma omp critical(llidw_error)
+				if (!error) error = std::current_exception();
+			}
 		}
 	}
+	if (error) std::rethrow_exception( error );
 }
 
 //calculate a local pixel for LocalLapseIDW
-double Interpol2D::LLIDW_pixel(const size_t& i, const size_t& j,
-                               const std::vector<double>& vecData_in, const std::vector<StationData>& vecStations_in,
-                               const DEMObject& dem, const size_t& nrOfNeighbors, const double& MaxDistance, const double& scale, const double& alpha)
+double Interpol2D::LLIDW_pixel(const double& x, const double& y, const double& cell_altitude,
+                               const StationIndex& index, const size_t& nrOfNeighbors, const double& MaxDistance,
+                               const double& scale, const double& alpha, LLIDWBuffers& buffers)
 {
-	const double cell_altitude = dem(i,j);
-	if (cell_altitude==IOUtils::nodata)
-		return IOUtils::nodata;
-
-	//fill vectors with neighbors sorted by the square of their distance to (i,j)
-	const double x = dem.llcorner.getEasting()+static_cast<double>(i)*dem.cellsize;
-	const double y = dem.llcorner.getNorthing()+static_cast<double>(j)*dem.cellsize;
-	std::vector< std::pair<double, size_t> > sorted_neighbors;
-	getNeighbors(x, y, vecStations_in, sorted_neighbors);
-
-	//build the vectors of valid data, with max nrOfNeighbors
-	std::vector<double> altitudes, values, distances_sq;
-	for (size_t st=0; st<sorted_neighbors.size(); st++) {
-		const size_t st_index = sorted_neighbors[st].second;
-		const double value = vecData_in[st_index];
-		const double altitude = vecStations_in[st_index].position.getAltitude();
-		if (MaxDistance > 0. && sorted_neighbors[st].first > MaxDistance * MaxDistance) break;
-		if ((value != IOUtils::nodata) && (altitude != IOUtils::nodata)) {
-			altitudes.push_back( altitude );
-			values.push_back( value );
-			distances_sq.push_back( sorted_neighbors[st].first );
-			if (nrOfNeighbors > 0 && altitudes.size()>=nrOfNeighbors) break;
-		}
-
+	//get the valid neighbors (max nrOfNeighbors) sorted by the square of their distance to (x,y)
+	index.getNeighbors(x, y, nrOfNeighbors, MaxDistance, buffers.neighbors);
+	const size_t nr_neighbors = buffers.neighbors.size();
+	if (nr_neighbors==0) return IOUtils::nodata;
+	if (nr_neighbors==1) return index.values[ buffers.neighbors.front().second ];
+
+	std::vector<double> &altitudes = buffers.altitudes, &values = buffers.values, &distances_sq = buffers.distances_sq;
+	altitudes.resize( nr_neighbors );
+	values.resize( nr_neighbors );
+	distances_sq.resize( nr_neighbors );
+	for (size_t st=0; st<nr_neighbors; st++) {
+		const size_t st_index = buffers.neighbors[st].second;
+		altitudes[st] = index.altitudes[st_index];
+		values[st] = index.values[st_index];
+		distances_sq[st] = buffers.neighbors[st].first;
 	}
 
 	//compute lapse rate and detrend the stations' data
-	if (altitudes.empty()) return IOUtils::nodata;
-	if (altitudes.size()==1) return values[0];
-	const Fit1D trend(Fit1D::NOISY_LINEAR, altitudes, values);
-	for (size_t ii=0; ii<altitudes.size(); ii++) {
-		values[ii] -= trend( altitudes[ii] );
+	//(this is what a Fit1D::NOISY_LINEAR would do, without having to build a new fit object for each pixel)
+	double a, b, r;
+	std::string mesg;
+	Interpol1D::NoisyLinRegression(altitudes, values, a, b, r, mesg);
+	for (size_t ii=0; ii<nr_neighbors; ii++) {
+		values[ii] -= a*altitudes[ii] + b;
 	}
 
 	//compute the local pixel value, retrend
 	const double pixel_value = IDWCore(values, distances_sq, scale, alpha);
 	if (pixel_value!=IOUtils::nodata)
-		return pixel_value + trend(cell_altitude);
+		return pixel_value + (a*cell_altitude + b);
 	else
 		return IOUtils::nodata;
 }
@@ -1000,6 +1168,12 @@ void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector
 	//invert the matrix
 	Ginv.inv();
 
+	//since p = data·lambda = data·(Ginv·G0), the weights data·Ginv can be computed once for all cells
+	Matrix data(nrOfMeasurments+1, (size_t)1, 0.); //the Lagrange multiplier does not contribute
+	for (size_t st=0; st<nrOfMeasurments; st++) data(st+1,1) = vecData[st];
+	Matrix weights;
+	Matrix::mult_into(Ginv, data, weights, true);
+
 	Matrix G0(nrOfMeasurments+1, (size_t)1);
 	//now, calculate each point
 	for (size_t j=0; j<grid.getNy(); j++) {
@@ -1021,14 +1195,8 @@ void Interpol2D::ODKriging(const std::vector<double>& vecData, const std::vector
 			}
 			G0(nrOfMeasurments+1,1) = 1.; //last value is always 1
 
-			const Matrix lambda = Ginv*G0;
-
 			//calculate local parameter interpolation
-			double p = 0.;
-			for (size_t st=0; st<nrOfMeasurments; st++) {
-				p += lambda(st+1,1) * vecData[st]; //matrix starts at 1, not 0
-			}
-			grid(i,j) = p;
+			grid(i,j) = Matrix::dot(weights, G0);
 		}
 	}
 }
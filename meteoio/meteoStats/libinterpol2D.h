@@ -79,9 +79,6 @@ class Interpol2D {
 		static double HorizontalDistance(const double& X1, const double& Y1, const double& X2, const double& Y2);
 		static double HorizontalDistance(const DEMObject& dem, const int& i, const int& j,
 		                                 const double& X2, const double& Y2);
-		static void getNeighbors(const double& x, const double& y,
-		                         const std::vector<StationData>& vecStations,
-		                         std::vector< std::pair<double, size_t> >& list);
 		static void buildPositionsVectors(const std::vector<StationData>& vecStations,
 		                                  std::vector<double>& vecEastings, std::vector<double>& vecNorthings);
 
@@ -90,10 +87,11 @@ class Interpol2D {
 		                      const std::vector<double>& vecData_in,
 		                      const std::vector<double>& vecEastings, const std::vector<double>& vecNorthings, const double& scale, const double& alpha=1.);
 		static double IDWCore(const std::vector<double>& vecData_in, const std::vector<double>& vecDistance_sq, const double& scale, const double& alpha=1.);
-		static double LLIDW_pixel(const size_t& i, const size_t& j,
-		                          const std::vector<double>& vecData_in,
-		                          const std::vector<StationData>& vecStations_in,
-		                          const DEMObject& dem, const size_t& nrOfNeighbors, const double& MaxDistance, const double& scale, const double& alpha=1.);
+		class StationIndex; //spatial index over the stations, used for the neighbors search
+		struct LLIDWBuffers; //per thread scratch buffers for LLIDW_pixel
+		static double LLIDW_pixel(const double& x, const double& y, const double& cell_altitude,
+		                          const StationIndex& index, const size_t& nrOfNeighbors, const double& MaxDistance,
+		                          const double& scale, const double& alpha, LLIDWBuffers& buffers);
 
 		static void steepestDescentDisplacement(const DEMObject& dem, const Grid2DObject& grid, const size_t& ii, const size_t& jj, char &d_i_dest, char &d_j_dest);
 		static double depositAroundCell(const DEMObject& dem, const size_t& ii, const size_t& jj, const double& precip, Grid2DObject &grid);
@@ -22,6 +22,8 @@
 #include <cmath>
 #include <sstream>
 #include <algorithm>
+#include <map>
+#include <limits>
 
 using namespace std;
 
@@ -122,21 +124,68 @@ const Array2D<double> LibResampling2D::cubicBSpline(const Array2D<double> &i_gri
 ///////////////////////////////////////////////////////////////////////
 //Private Methods
 ///////////////////////////////////////////////////////////////////////
-void LibResampling2D::Nearest(Array2D<double> &o_grid, const Array2D<double> &i_grid)
+LibResampling2D::ResamplingAxis LibResampling2D::computeAxis(const size_t &org_n, const size_t &dest_n)
 {
-	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
-	const size_t dest_nx = o_grid.getNx(), dest_ny = o_grid.getNy();
-	const double scale_x = (double)dest_nx / (double)org_nx;
-	const double scale_y = (double)dest_ny / (double)org_ny;
+	const double scale = (double)dest_n / (double)org_n;
+	ResamplingAxis axis;
+	axis.nearest.resize(dest_n);
+	axis.index.resize(dest_n);
+	axis.frac.resize(dest_n);
+	axis.bspline_x.resize(4*dest_n);
+	axis.bspline_y.resize(4*dest_n);
+
+	for (size_t ii=0; ii<dest_n; ii++) {
+		axis.nearest[ii] = std::min( (size_t) Optim::floor( (double)ii/scale ) , org_n-1 );
+		const double org = (double)ii/scale;
+		axis.index[ii] = static_cast<size_t>( org );
+		axis.frac[ii] = org - (double)axis.index[ii]; //normalized position, between 0 and 1
+		for (int m=-1; m<=2; m++) {
+			axis.bspline_x[4*ii + (m+1)] = BSpline_weight(m - axis.frac[ii]);
+			axis.bspline_y[4*ii + (m+1)] = BSpline_weight(axis.frac[ii] - m);
+		}
+	}
+	return axis;
+}
 
-	for (size_t jj=0; jj<dest_ny; jj++) {
-		const size_t org_jj = std::min( (size_t) Optim::floor( (double)jj/scale_y ) , org_ny-1 );
+const LibResampling2D::ResamplingAxis& LibResampling2D::getAxis(const size_t &org_n, const size_t &dest_n)
+{
+	static const size_t max_size = 32;
+	static thread_local std::map< std::pair<size_t, size_t>, ResamplingAxis > cache; //one cache per thread, so no locking is required
+	static thread_local std::pair<size_t, size_t> last_key( 0, 0 );
+
+	const std::pair<size_t, size_t> key( org_n, dest_n );
+	const auto it = cache.find( key );
+	if (it!=cache.end()) {
+		last_key = key;
+		return it->second;
+	}
 
-		for (size_t ii=0; ii<dest_nx; ii++) {
-			const size_t org_ii = std::min( (size_t) Optim::floor( (double)ii/scale_x ) , org_nx-1 );
-			o_grid(ii,jj) = i_grid(org_ii, org_jj);
+	if (cache.size()>=max_size) { //the axes are requested by pairs, so the last one returned might still be in use
+		for (auto it_cache=cache.begin(); it_cache!=cache.end(); ) {
+			if (it_cache->first!=last_key) it_cache = cache.erase( it_cache );
+			else ++it_cache;
 		}
 	}
+	last_key = key;
+	return cache.emplace(key, computeAxis(org_n, dest_n)).first->second;
+}
+
+void LibResampling2D::Nearest(Array2D<double> &o_grid, const Array2D<double> &i_grid)
+{
+	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
+	const size_t dest_nx = o_grid.getNx(), dest_ny = o_grid.getNy();
+	const ResamplingAxis& axis_x = getAxis(org_nx, dest_nx);
+	const ResamplingAxis& axis_y = getAxis(org_ny, dest_ny);
+	const double* org = i_grid.data();
+	double* dest = o_grid.data();
+
+#pragma omp parallel for schedule(static)
+	for (int jj=0; jj<static_cast<int>(dest_ny); jj++) {
+		const double* org_row = org + axis_y.nearest[jj]*org_nx;
+		double* dest_row = dest + static_cast<size_t>(jj)*dest_nx;
+		for (size_t ii=0; ii<dest_nx; ii++)
+			dest_row[ii] = org_row[ axis_x.nearest[ii] ];
+	}
 }
 
 double LibResampling2D::bilinear_pixel(const Array2D<double> &i_grid, const size_t &org_ii, const size_t &org_jj, const size_t &org_nx, const size_t &org_ny, const double &x, const double &y)
@@ -190,20 +239,38 @@ void LibResampling2D::Bilinear(Array2D<double> &o_grid, const Array2D<double> &i
 {
 	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
 	const size_t dest_nx = o_grid.getNx(), dest_ny = o_grid.getNy();
-	const double scale_x = (double)dest_nx / (double)org_nx;
-	const double scale_y = (double)dest_ny / (double)org_ny;
-
-	for (size_t jj=0; jj<dest_ny; jj++) {
-		const double org_y = (double)jj/scale_y;
-		const size_t org_jj = static_cast<size_t>( org_y );
-		const double y = org_y - (double)org_jj; //normalized y, between 0 and 1
+	const ResamplingAxis& axis_x = getAxis(org_nx, dest_nx);
+	const ResamplingAxis& axis_y = getAxis(org_ny, dest_ny);
+	const double* org = i_grid.data();
+	double* dest = o_grid.data();
+
+#pragma omp parallel for schedule(static)
+	for (int jj=0; jj<static_cast<int>(dest_ny); jj++) {
+		const size_t org_jj = axis_y.index[jj];
+		const double y = axis_y.frac[jj];
+		double* dest_row = dest + static_cast<size_t>(jj)*dest_nx;
+		if (org_jj>=(org_ny-1)) { //last row: no interpolation
+			for (size_t ii=0; ii<dest_nx; ii++)
+				dest_row[ii] = i_grid(axis_x.index[ii], org_jj);
+			continue;
+		}
 
+		const double* row0 = org + org_jj*org_nx;
+		const double* row1 = row0 + org_nx;
 		for (size_t ii=0; ii<dest_nx; ii++) {
-			const double org_x = (double)ii/scale_x;
-			const size_t org_ii = static_cast<size_t>( org_x );
-			const double x = org_x - (double)org_ii; //normalized x, between 0 and 1
-
-			o_grid(ii,jj) = bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, x, y);
+			const size_t org_ii = axis_x.index[ii];
+			if (org_ii>=(org_nx-1)) {
+				dest_row[ii] = row0[org_ii];
+				continue;
+			}
+			const double f_0_0 = row0[org_ii], f_1_0 = row0[org_ii+1];
+			const double f_0_1 = row1[org_ii], f_1_1 = row1[org_ii+1];
+			if (f_0_0==IOUtils::nodata || f_1_0==IOUtils::nodata || f_0_1==IOUtils::nodata || f_1_1==IOUtils::nodata) {
+				dest_row[ii] = bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, axis_x.frac[ii], y);
+				continue;
+			}
+			const double x = axis_x.frac[ii];
+			dest_row[ii] = f_0_0 * (1.-x)*(1.-y) + f_1_0 * x*(1.-y) + f_0_1 * (1.-x)*y + f_1_1 *x*y;
 		}
 	}
 }
@@ -223,44 +290,63 @@ void LibResampling2D::cubicBSpline(Array2D<double> &o_grid, const Array2D<double
 {//see http://paulbourke.net/texture_colour/imageprocess/
 	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
 	const size_t dest_nx = o_grid.getNx(), dest_ny = o_grid.getNy();
-	const double scale_x = (double)dest_nx / (double)org_nx;
-	const double scale_y = (double)dest_ny / (double)org_ny;
-
-	for (size_t jj=0; jj<dest_ny; jj++) {
-		const double org_y = (double)jj/scale_y;
-		const size_t org_jj = static_cast<size_t>( org_y );
-		const double dy = org_y - (double)org_jj; //normalized y, between 0 and 1
+	const ResamplingAxis& axis_x = getAxis(org_nx, dest_nx);
+	const ResamplingAxis& axis_y = getAxis(org_ny, dest_ny);
+	const double* org = i_grid.data();
+	double* dest = o_grid.data();
+
+#pragma omp parallel for schedule(static)
+	for (int jj=0; jj<static_cast<int>(dest_ny); jj++) {
+		const size_t org_jj = axis_y.index[jj];
+		const double dy = axis_y.frac[jj];
+		const double* wy = &axis_y.bspline_y[4*static_cast<size_t>(jj)];
+		const bool inner_row = (org_jj>=1 && org_jj+2<org_ny);
+		double* dest_row = dest + static_cast<size_t>(jj)*dest_nx;
 
 		for (size_t ii=0; ii<dest_nx; ii++) {
-			const double org_x = (double)ii/scale_x;
-			const size_t org_ii = static_cast<size_t>( org_x );
-			const double dx = org_x - (double)org_ii; //normalized x, between 0 and 1
+			const size_t org_ii = axis_x.index[ii];
+			const double dx = axis_x.frac[ii];
+			const double* wx = &axis_x.bspline_x[4*ii];
 
 			double F = 0., max=-std::numeric_limits<double>::max(), min=std::numeric_limits<double>::max();
 			unsigned int avg_count = 0;
-			for (char n=-1; n<=2; n++) {
-				for (char m=-1; m<=2; m++) {
-					if (((signed)org_ii+m)<0 || ((signed)org_ii+m)>=(signed)org_nx || ((signed)org_jj+n)<0 || ((signed)org_jj+n)>=(signed)org_ny) continue;
-					const double pixel = i_grid(static_cast<size_t>(org_ii+m), static_cast<size_t>(org_jj+n));
-					if (pixel!=IOUtils::nodata) {
-						F += pixel * BSpline_weight(m-dx) * BSpline_weight(dy-n);
-						avg_count++;
-						if (pixel>max) max=pixel;
-						if (pixel<min) min=pixel;
+			if (inner_row && org_ii>=1 && org_ii+2<org_nx) { //all the neighbours are within the grid
+				for (size_t n=0; n<4; n++) {
+					const double* org_row = org + (org_jj+n-1)*org_nx + (org_ii-1);
+					for (size_t m=0; m<4; m++) {
+						const double pixel = org_row[m];
+						if (pixel!=IOUtils::nodata) {
+							F += pixel * wx[m] * wy[n];
+							avg_count++;
+							if (pixel>max) max=pixel;
+							if (pixel<min) min=pixel;
+						}
+					}
+				}
+			} else {
+				for (char n=-1; n<=2; n++) {
+					for (char m=-1; m<=2; m++) {
+						if (((signed)org_ii+m)<0 || ((signed)org_ii+m)>=(signed)org_nx || ((signed)org_jj+n)<0 || ((signed)org_jj+n)>=(signed)org_ny) continue;
+						const double pixel = i_grid(static_cast<size_t>(org_ii+m), static_cast<size_t>(org_jj+n));
+						if (pixel!=IOUtils::nodata) {
+							F += pixel * wx[m+1] * wy[n+1];
+							avg_count++;
+							if (pixel>max) max=pixel;
+							if (pixel<min) min=pixel;
+						}
 					}
 				}
 			}
 
 			if (avg_count==16) { //normal bicubic
-				o_grid(ii,jj) = F;
-				if (o_grid(ii,jj)>max) o_grid(ii,jj)=max; //try to limit overshoot
-				else if (o_grid(ii,jj)<min) o_grid(ii,jj)=min; //try to limit overshoot
-			} else if (avg_count==0) o_grid(ii,jj) = IOUtils::nodata; //nodata-> nodata
+				dest_row[ii] = F;
+				if (F>max) dest_row[ii]=max; //try to limit overshoot
+				else if (F<min) dest_row[ii]=min; //try to limit overshoot
+			} else if (avg_count==0) dest_row[ii] = IOUtils::nodata; //nodata-> nodata
 			else //not enought data points -> bilinear for this pixel
-				o_grid(ii,jj) = bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, dx, dy);
+				dest_row[ii] = bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, dx, dy);
 		}
 	}
 }
 
 } //namespace
-
@@ -23,12 +23,15 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace mio {
 
 /**
  * @class LibResampling2D
  * @brief Spatial resampling algorithms
+ * @details The source indices and weights only depend on the original and destination grid sizes, so they are computed
+ * once for each axis (and kept for the next calls with the same sizes) and the destination rows are computed in parallel.
  *
  * @ingroup stats
  * @author Mathias Bavay
@@ -46,6 +49,19 @@ class LibResampling2D {
 		static const Array2D<double> cubicBSpline(const Array2D<double> &i_grid, const double &factor_x, const double &factor_y);
 
 	private:
+		///source indices and weights along one axis, they only depend on the original and destination sizes along this axis
+		typedef struct RESAMPLING_AXIS {
+			RESAMPLING_AXIS() : nearest(), index(), frac(), bspline_x(), bspline_y() {}
+			std::vector<size_t> nearest; ///< source index for the nearest neighbour
+			std::vector<size_t> index; ///< source index just before the destination point
+			std::vector<double> frac; ///< normalized distance to the source index, between 0 and 1
+			std::vector<double> bspline_x; ///< cubic B-spline weights of the source indices -1 to +2 when used along X (4 per destination point)
+			std::vector<double> bspline_y; ///< cubic B-spline weights of the source indices -1 to +2 when used along Y (4 per destination point)
+		} ResamplingAxis;
+
+		static const ResamplingAxis& getAxis(const size_t &org_n, const size_t &dest_n); //valid until the second next call from the same thread
+		static ResamplingAxis computeAxis(const size_t &org_n, const size_t &dest_n);
+
 		static void cubicBSpline(Array2D<double> &o_grid, const Array2D<double> &i_grid);
 		static void Bilinear(Array2D<double> &o_grid, const Array2D<double> &i_grid);
 		static void Nearest(Array2D<double> &o_grid, const Array2D<double> &i_grid);
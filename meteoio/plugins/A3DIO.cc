@@ -218,8 +218,9 @@ void A3DIO::read1DMeteo(const Date& dateStart, const Date& dateEnd, std::vector<
 	const char eoln = FileUtils::getEoln(fin); //get the end of line character for the file
 
 	//get station metadata
-	MeteoData tmpdata;
-	read1DStation(tmpdata.meta);
+	StationData sd;
+	read1DStation(sd);
+	MeteoData tmpdata(sd);
 
 	//Go through file, save key value pairs
 	std::string line;
@@ -687,19 +688,19 @@ bool A3DIO::create1DFile(const std::vector< std::vector<MeteoData> >& data)
 	for (size_t ii=0; ii<sta_nr; ii++) {
 		const size_t size = data[ii].size();
 		if (size>0) {
-			const std::string filename( tmp_path+"/meteo1D_"+data[ii][0].meta.getStationID()+".txt" );
+			const std::string filename( tmp_path+"/meteo1D_"+data[ii][0].meta->getStationID()+".txt" );
 			if (!FileUtils::validFileAndPath(filename)) throw InvalidNameException(filename,AT);
 			ofilestream file(filename.c_str(), std::ios::out | std::ios::trunc);
 			if (!file) {
 				throw AccessException("[E] Can not open file "+filename, AT);
 			}
 
-			file << "Name = " << data[ii][0].meta.getStationID() << endl;
-			file << "Latitude = " << data[ii][0].meta.position.getLat() << endl;
-			file << "Longitude = " << data[ii][0].meta.position.getLon() << endl;
-			file << "X_Coord = " << data[ii][0].meta.position.getEasting() << endl;
-			file << "Y_Coord = " << data[ii][0].meta.position.getNorthing() << endl;
-			file << "Altitude = " << data[ii][0].meta.position.getAltitude() << endl;
+			file << "Name = " << data[ii][0].meta->getStationID() << endl;
+			file << "Latitude = " << data[ii][0].meta->position.getLat() << endl;
+			file << "Longitude = " << data[ii][0].meta->position.getLon() << endl;
+			file << "X_Coord = " << data[ii][0].meta->position.getEasting() << endl;
+			file << "Y_Coord = " << data[ii][0].meta->position.getNorthing() << endl;
+			file << "Altitude = " << data[ii][0].meta->position.getAltitude() << endl;
 			file << "YYYY MM DD HH ta iswr vw rh ea nswc" << endl;
 
 			file.flags ( std::ios::fixed );
@@ -752,9 +753,9 @@ bool A3DIO::writeHeader(ofilestream &file, const std::vector< std::vector<MeteoD
 	file << "X:\\filepath " << parameter_name <<endl;
 	for (size_t ii=0; ii<sta_nr; ii++) {
 		if (!data[ii].empty()) {
-			str_altitudes << data[ii][0].meta.position.getAltitude() << " ";
-			str_eastings  << data[ii][0].meta.position.getEasting() << " ";
-			str_northings << data[ii][0].meta.position.getNorthing() << " ";
+			str_altitudes << data[ii][0].meta->position.getAltitude() << " ";
+			str_eastings  << data[ii][0].meta->position.getEasting() << " ";
+			str_northings << data[ii][0].meta->position.getNorthing() << " ";
 		}
 	}
 	file << "YY MM DD HH " << str_altitudes.str() << endl; //altitudes
@@ -763,7 +764,7 @@ bool A3DIO::writeHeader(ofilestream &file, const std::vector< std::vector<MeteoD
 	file << "YYYY MM DD HH";
 	for (size_t ii=0; ii<sta_nr; ii++) {
 		if (!data[ii].empty()) {
-			file << " " << data[ii][0].meta.getStationID();
+			file << " " << data[ii][0].meta->getStationID();
 		}
 	}
 	file << std::endl;
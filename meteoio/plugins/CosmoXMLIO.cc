@@ -505,7 +505,7 @@ void CosmoXMLIO::readMeteoData(const Date& dateStart, const Date& dateEnd,
 			//do we already have a vector with this station meteo?
 			size_t found_id = IOUtils::npos;
 			for (size_t jj=0; jj<vecMeteo.size(); jj++) {
-				if (vecMeteo[jj].front().meta.stationID==input_id[ii]) {
+				if (vecMeteo[jj].front().meta->stationID==input_id[ii]) {
 					found_id = jj;
 					break;
 				}
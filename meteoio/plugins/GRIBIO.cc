@@ -25,11 +25,17 @@
 #include <meteoio/dataClasses/CoordsAlgorithms.h>
 #include <meteoio/MathOptim.h>
 #include <meteoio/FileUtils.h>
+#include <meteoio/FStream.h>
 
 #include <cmath>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
 #include <cerrno>
+#include <cstring>
 #include <algorithm>
+#include <sys/stat.h>
 #include <grib_api.h>
 
 using namespace std;
@@ -51,6 +57,9 @@ namespace mio {
  *
  * This means that close to the center of the grid, coordinates and distances will work as expected, but the distortion will increase when moving away from the center and can become significant. As examples for domain size, cone can look at the MeteoSwiss domain definition at http://www.cosmo-model.org/content/tasks/operational/meteoSwiss/default.htm .
  *
+ * When a file is opened for the first time, all its messages are scanned and their parameter, level, validity as well as their position
+ * in the file are stored in an index. Only the requested messages are then decoded, directly from their position in the file.
+ *
  * As a side note, when calling read2DGrid(grid, filename), it will returns the first grid that is found. When using the standard call, it will look for the the file 
  * within the provided directory that contains the requested timestamp and read the requested field from it. Each file should contain all the fields but 
  * only one timestamp per file.
@@ -98,6 +107,11 @@ namespace mio {
  * replaced** by the one coming from the DEM, so feel free to use "-1" for example to make it obvious that it will be discarded. Finally, if a
  * point leads to duplicate grid points, it will be removed from the list (mandatory);
  * - GRIB_DEBUG: output more information about the grib files in order to help fix potential problems (default: false).
+ * - GRIB_WRITE_INDEX: write the messages index of each GRIB file in a sidecar file (same name with the ".mioidx" extension appended)
+ * so the next runs can directly jump to the requested messages instead of scanning the whole file (default: false). If the sidecar
+ * file can not be written, the index is only kept in memory. It is automatically rebuilt when the GRIB file changes.
+ * - GRIB_PARALLEL: decode the independent messages of a timestep concurrently when extracting time series (default: false). This requires
+ * MeteoIO to be compiled with USE_OPENMP and ecCodes to be compiled with thread support (ENABLE_ECCODES_THREADS).
  *
  * @code
  * [Input]
@@ -121,14 +135,16 @@ namespace mio {
 const double GRIBIO::plugin_nodata = -999.; //plugin specific nodata value. It can also be read by the plugin (depending on what is appropriate)
 const double GRIBIO::tz_in = 0.; //GRIB time zone, always UTC
 const std::string GRIBIO::default_ext=".grb"; //filename extension
+const std::string GRIBIO::index_ext=".mioidx"; //messages index sidecar file extension
+const size_t GRIBIO::npos = static_cast<size_t>(-1);
 
 GRIBIO::GRIBIO(const std::string& configfile)
         : cfg(configfile), grid2dpath_in(), meteopath_in(), vecPts(), cache_meteo_files(),
           meteo_ext(default_ext), grid2d_ext(default_ext), grid2d_prefix(), idx_filename(), coordin(), coordinparam(),
-          VW(), DW(), wind_date(), llcorner(), fp(nullptr), idx(nullptr),
+          VW(), DW(), wind_date(), llcorner(), fp(nullptr), idx(),
           latitudeOfNorthernPole(IOUtils::nodata), longitudeOfNorthernPole(IOUtils::nodata), bearing_offset(IOUtils::nodata),
           cellsize(IOUtils::nodata), factor_x(IOUtils::nodata), factor_y(IOUtils::nodata),
-          indexed(false), meteo_initialized(false), llcorner_initialized(false), update_dem(false), debug(false)
+          indexed(false), persist_index(false), parallel_decode(false), meteo_initialized(false), llcorner_initialized(false), update_dem(false), debug(false)
 {
 	setOptions();
 }
@@ -136,10 +152,10 @@ GRIBIO::GRIBIO(const std::string& configfile)
 GRIBIO::GRIBIO(const Config& cfgreader)
         : cfg(cfgreader), grid2dpath_in(), meteopath_in(), vecPts(), cache_meteo_files(),
           meteo_ext(default_ext), grid2d_ext(default_ext), grid2d_prefix(), idx_filename(), coordin(), coordinparam(),
-          VW(), DW(), wind_date(), llcorner(), fp(nullptr), idx(nullptr),
+          VW(), DW(), wind_date(), llcorner(), fp(nullptr), idx(),
           latitudeOfNorthernPole(IOUtils::nodata), longitudeOfNorthernPole(IOUtils::nodata), bearing_offset(IOUtils::nodata),
           cellsize(IOUtils::nodata), factor_x(IOUtils::nodata), factor_y(IOUtils::nodata),
-          indexed(false), meteo_initialized(false), llcorner_initialized(false), update_dem(false), debug(false)
+          indexed(false), persist_index(false), parallel_decode(false), meteo_initialized(false), llcorner_initialized(false), update_dem(false), debug(false)
 {
 	setOptions();
 }
@@ -147,7 +163,7 @@ GRIBIO::GRIBIO(const Config& cfgreader)
 GRIBIO& GRIBIO::operator=(const GRIBIO& source) {
 	if (this != &source) {
 		fp = nullptr;
-		idx = nullptr;
+		idx.clear();
 		grid2dpath_in = source.grid2dpath_in;
 		meteopath_in = source.meteopath_in;
 		vecPts = source.vecPts;
@@ -169,6 +185,8 @@ GRIBIO& GRIBIO::operator=(const GRIBIO& source) {
 		factor_x = source.factor_x;
 		factor_y = source.factor_y;
 		indexed = source.indexed;
+		persist_index = source.persist_index;
+		parallel_decode = source.parallel_decode;
 		meteo_initialized = source.meteo_initialized;
 		llcorner_initialized = source.llcorner_initialized;
 		update_dem = source.update_dem;
@@ -201,6 +219,8 @@ void GRIBIO::setOptions()
 	if (grid2d_ext=="none") grid2d_ext.clear();
 	
 	cfg.getValue("GRIB_DEBUG", "Input", debug, IOUtils::nothrow);
+	cfg.getValue("GRIB_WRITE_INDEX", "Input", persist_index, IOUtils::nothrow);
+	cfg.getValue("GRIB_PARALLEL", "Input", parallel_decode, IOUtils::nothrow);
 }
 
 void GRIBIO::readStations(std::vector<Coords> &vecPoints)
@@ -281,23 +301,15 @@ void  GRIBIO::listFields(const std::string& filename)
 	std::cerr << "******\n";
 }
 
-void GRIBIO::getDate(grib_handle* h, Date &base, double &d1, double &d2) {
-	long dataDate, dataTime;
-	GRIB_CHECK(grib_get_long(h,"dataDate",&dataDate),0);
-	GRIB_CHECK(grib_get_long(h,"dataTime",&dataTime),0);
-
-	const int year=static_cast<int>(dataDate/10000), month=static_cast<int>(dataDate/100-year*100), day=static_cast<int>(dataDate-month*100-year*10000);
-	const int hour=static_cast<int>(dataTime/100), minutes=static_cast<int>(dataTime-hour*100); //HACK: handle seconds!
+void GRIBIO::getDate(const GribMessage& msg, Date &base, double &d1, double &d2)
+{
+	const int year=static_cast<int>(msg.dataDate/10000), month=static_cast<int>(msg.dataDate/100-year*100), day=static_cast<int>(msg.dataDate-month*100-year*10000);
+	const int hour=static_cast<int>(msg.dataTime/100), minutes=static_cast<int>(msg.dataTime-hour*100); //HACK: handle seconds!
 	base.setDate(year, month, day, hour, minutes, tz_in);
 
-	//reading offset to base date/time, as used for forecast, computed at time t for t+offset
-	long stepUnits, startStep, endStep;
-	GRIB_CHECK(grib_get_long(h,"stepUnits",&stepUnits),0);
-	GRIB_CHECK(grib_get_long(h,"startStep",&startStep),0);
-	GRIB_CHECK(grib_get_long(h,"endStep",&endStep),0);
-
+	//offset to base date/time, as used for forecast, computed at time t for t+offset
 	double step_units; //in julian, ie. in days
-	switch(stepUnits) {
+	switch(msg.stepUnits) {
 		case 0: //minutes
 			step_units = 1./(24.*60.);
 			break;
@@ -327,12 +339,72 @@ void GRIBIO::getDate(grib_handle* h, Date &base, double &d1, double &d2) {
 			break;
 		default:
 			std::ostringstream ss;
-			ss << "GRIB file using stepUnits=" << stepUnits << ", which is not supported";
+			ss << "GRIB file using stepUnits=" << msg.stepUnits << ", which is not supported";
 			throw InvalidFormatException(ss.str(), AT);
 	}
 
-	d1 = static_cast<double>(startStep)*step_units;
-	d2 = static_cast<double>(endStep)*step_units;
+	d1 = static_cast<double>(msg.startStep)*step_units;
+	d2 = static_cast<double>(msg.endStep)*step_units;
+}
+
+bool GRIBIO::matchDate(const GribMessage& msg, const Date& i_date, double &P1, double &P2)
+{
+	//P1 and P2 are always needed by the caller (for example, to convert averages to sums)
+	Date base_date;
+	getDate(msg, base_date, P1, P2);
+	if (i_date.isUndef()) return true;
+
+	//see WMO code table5 for definitions of timeRangeIndicator. http://dss.ucar.edu/docs/formats/grib/gribdoc/timer.html
+	// 0 -> at base_date + P1
+	// 1 -> at base_date
+	// 2 -> valid between base_date+P1 and base_date+P2
+	// 3 -> average within [base_date+P1 , base_date+P2]
+	// 4 -> accumulation from base_date+P1 to base_date+P2
+	// 5 -> difference (base_date+P2) - (base_date+P1)
+	const long timeRange = msg.timeRange;
+	return ( (timeRange==0 && i_date==base_date+P1) ||
+	         (timeRange==1 && i_date==base_date) ||
+	         ((timeRange==2 || timeRange==3) && i_date>=base_date+P1 && i_date<=base_date+P2) ||
+	         ((timeRange==4 || timeRange==5) && i_date==base_date+P2) );
+}
+
+//returns the index (within idx) of the first message matching the criteria or npos if none could be found
+size_t GRIBIO::findMessage(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date& i_date) const
+{
+	for (size_t ii=0; ii<idx.size(); ii++) {
+		const GribMessage& msg = idx[ii];
+		if (msg.marsParam!=in_marsParam || msg.levelType!=i_levelType) continue;
+		if (i_level!=0 && msg.level!=i_level) continue;
+
+		double P1, P2;
+		if (matchDate(msg, i_date, P1, P2)) return ii;
+	}
+	return npos;
+}
+
+//same as findMessage but the message is also appended to the list of selected messages
+size_t GRIBIO::selectMessage(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date& i_date, std::vector<size_t>& selected) const
+{
+	const size_t msg_idx = findMessage(in_marsParam, i_levelType, i_level, i_date);
+	if (msg_idx!=npos && std::find(selected.begin(), selected.end(), msg_idx)==selected.end())
+		selected.push_back( msg_idx );
+	return msg_idx;
+}
+
+//the raw message is read in the provided buffer so each caller can work on its own handle
+grib_handle* GRIBIO::loadMessage(const GribMessage& msg, std::vector<unsigned char>& buffer) const
+{
+	buffer.resize( msg.length );
+	bool read_ok = false;
+#pragma omp critical(gribio_file_access)
+	{
+		read_ok = (fseek(fp, msg.offset, SEEK_SET)==0 && fread(&buffer[0], 1, msg.length, fp)==msg.length);
+	}
+	if (!read_ok) throw IOException("Unable to read GRIB message from \""+idx_filename+"\"", AT);
+
+	grib_handle* h = grib_handle_new_from_message_copy(0, &buffer[0], msg.length);
+	if (h==nullptr) throw IOException("Unable to create grib handle for \""+idx_filename+"\"", AT);
+	return h;
 }
 
 Coords GRIBIO::getGeolocalization(grib_handle* h, double &cell_x, double &cell_y)
@@ -434,48 +506,24 @@ void GRIBIO::read2Dlevel(grib_handle* h, Grid2DObject& grid_out)
 
 bool GRIBIO::read2DGrid_indexed(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date i_date, Grid2DObject& grid_out)
 {
-	GRIB_CHECK(grib_index_select_double(idx,"marsParam",in_marsParam),0);
-	GRIB_CHECK(grib_index_select_long(idx,"indicatorOfTypeOfLevel", i_levelType),0);
-
-	grib_handle* h=nullptr;
-	int err=0;
-	while ((h = grib_handle_new_from_index(idx,&err)) != nullptr) {
-		if (!h) {
-			cleanup();
-			throw IOException("Unable to create grib handle from index", AT);
-		}
+	const size_t msg_idx = findMessage(in_marsParam, i_levelType, i_level, i_date);
+	if (msg_idx==npos) return false;
 
-		Date base_date;
-		double P1, P2;
-		getDate(h, base_date, P1, P2);
-
-		//see WMO code table5 for definitions of timeRangeIndicator. http://dss.ucar.edu/docs/formats/grib/gribdoc/timer.html
-		// 0 -> at base_date + P1
-		// 1 -> at base_date
-		// 2 -> valid between base_date+P1 and base_date+P2
-		// 3 -> average within [base_date+P1 , base_date+P2]
-		// 4 -> accumulation from base_date+P1 to base_date+P2
-		// 5 -> difference (base_date+P2) - (base_date+P1)
-		long timeRange;
-		GRIB_CHECK(grib_get_long(h,"timeRangeIndicator", &timeRange),0);
+	const GribMessage& msg = idx[msg_idx];
+	double P1, P2;
+	matchDate(msg, i_date, P1, P2);
 
-		long level=0;
-		if (i_level!=0) GRIB_CHECK(grib_get_long(h,"level", &level),0);
-		if (level==i_level) {
-			if ( (i_date.isUndef()) ||
-			    (timeRange==0 && i_date==base_date+P1) ||
-			    (timeRange==1 && i_date==base_date) ||
-			    ((timeRange==2 || timeRange==3) && i_date>=base_date+P1 && i_date<=base_date+P2) ||
-			    ((timeRange==4 || timeRange==5) && i_date==base_date+P2) ) {
-				read2Dlevel(h, grid_out);
-				if (timeRange==3) grid_out *= ((P2-P1)*24.*3600.); //convert avg to sum
-				grib_handle_delete(h);
-				return true;
-			}
-		}
+	std::vector<unsigned char> buffer;
+	grib_handle* h = loadMessage(msg, buffer);
+	try {
+		read2Dlevel(h, grid_out);
+	} catch(...) {
 		grib_handle_delete(h);
+		throw;
 	}
-	return false;
+	grib_handle_delete(h);
+	if (msg.timeRange==3) grid_out *= ((P2-P1)*24.*3600.); //convert avg to sum
+	return true;
 }
 
 void GRIBIO::read2DGrid(Grid2DObject& grid_out, const std::string& i_name)
@@ -513,7 +561,7 @@ void GRIBIO::indexFile(const std::string& filename)
 {
 	if (!FileUtils::fileExists(filename)) throw AccessException(filename, AT); //prevent invalid filenames
 	errno = 0;
-	fp = fopen(filename.c_str(),"r");
+	fp = fopen(filename.c_str(),"rb");
 	if (fp==nullptr) {
 		std::ostringstream ss;
 		ss << "Error opening file \"" << filename << "\", possible reason: " << std::strerror(errno);
@@ -521,16 +569,103 @@ void GRIBIO::indexFile(const std::string& filename)
 	}
 	if (debug) listFields(filename);
 
+	if (!readIndexFile(filename)) {
+		buildIndex(filename);
+		if (persist_index) writeIndexFile(filename);
+	}
+	indexed=true;
+	idx_filename = filename;
+}
+
+//scan all the messages of the file and store their selection criteria as well as their position
+void GRIBIO::buildIndex(const std::string& filename)
+{
+	idx.clear();
+	grib_handle* h=nullptr;
 	int err=0;
-	static const std::string keys("marsParam:d,indicatorOfTypeOfLevel:l"); //indexing keys
-	char *c_filename = (char *)filename.c_str();
-	idx = grib_index_new_from_file(0, c_filename, keys.c_str(), &err);
-	if (err!=0) {
+	while ((h = grib_handle_new_from_file(0,fp,&err)) != nullptr) {
+		GribMessage msg;
+		size_t msg_len=0;
+		if (grib_get_long(h,"offset",&msg.offset)!=0 || grib_get_message_size(h,&msg_len)!=0) {
+			grib_handle_delete(h);
+			cleanup();
+			throw IOException("Failed to index GRIB file \""+filename+"\". Is it a valid GRIB file?", AT);
+		}
+		msg.length = msg_len;
+		GRIB_CHECK(grib_get_double(h,"marsParam",&msg.marsParam),0);
+		GRIB_CHECK(grib_get_long(h,"indicatorOfTypeOfLevel", &msg.levelType),0);
+		//the following keys are not always present, they are then left to their default values
+		grib_get_long(h,"level", &msg.level);
+		grib_get_long(h,"timeRangeIndicator", &msg.timeRange);
+		grib_get_long(h,"dataDate", &msg.dataDate);
+		grib_get_long(h,"dataTime", &msg.dataTime);
+		grib_get_long(h,"stepUnits", &msg.stepUnits);
+		grib_get_long(h,"startStep", &msg.startStep);
+		grib_get_long(h,"endStep", &msg.endStep);
+		idx.push_back( msg );
+		grib_handle_delete(h);
+	}
+	if (err!=0 || idx.empty()) {
 		cleanup();
 		throw IOException("Failed to index GRIB file \""+filename+"\". Is it a valid GRIB file?", AT);
 	}
-	indexed=true;
-	idx_filename = filename;
+}
+
+//a sidecar index is only used if it has been written for the current version of the GRIB file
+static std::string getFileSignature(const std::string& filename)
+{
+	struct stat buf;
+	if (stat(filename.c_str(), &buf)!=0) return std::string();
+	std::ostringstream ss;
+	ss << static_cast<long long>(buf.st_size) << " " << static_cast<long long>(buf.st_mtime);
+	return ss.str();
+}
+
+bool GRIBIO::readIndexFile(const std::string& filename)
+{
+	const std::string index_filename( filename + index_ext );
+	if (!FileUtils::fileExists(index_filename)) return false;
+	std::ifstream fin(index_filename.c_str());
+	if (fin.fail()) return false;
+
+	std::string line;
+	getline(fin, line);
+	if (line != "#MeteoIO GRIB index " + getFileSignature(filename)) return false; //outdated index
+
+	idx.clear();
+	while (getline(fin, line)) {
+		if (line.empty()) continue;
+		std::istringstream iss(line);
+		GribMessage msg;
+		iss >> msg.offset >> msg.length >> msg.marsParam >> msg.levelType >> msg.level >> msg.timeRange;
+		iss >> msg.dataDate >> msg.dataTime >> msg.stepUnits >> msg.startStep >> msg.endStep;
+		if (iss.fail()) { //corrupted index, it will be rebuilt
+			idx.clear();
+			return false;
+		}
+		idx.push_back( msg );
+	}
+	return !idx.empty();
+}
+
+void GRIBIO::writeIndexFile(const std::string& filename) const
+{
+	const std::string index_filename( filename + index_ext );
+	try {
+		ofilestream fout(index_filename, cfg);
+		if (fout.fail()) return;
+		fout << "#MeteoIO GRIB index " << getFileSignature(filename) << "\n";
+		fout << std::setprecision(17); //so marsParam exactly round-trips
+		for (size_t ii=0; ii<idx.size(); ii++) {
+			const GribMessage& msg = idx[ii];
+			fout << msg.offset << " " << msg.length << " " << msg.marsParam << " " << msg.levelType << " " << msg.level << " " << msg.timeRange << " ";
+			fout << msg.dataDate << " " << msg.dataTime << " " << msg.stepUnits << " " << msg.startStep << " " << msg.endStep << "\n";
+		}
+		fout.close();
+	} catch (const std::exception&) {
+		//the index could not be written (read-only directory, restricted write access, etc), it is only kept in memory
+		if (debug) std::cerr << "[W] Could not write GRIB index \"" << index_filename << "\"\n";
+	}
 }
 
 void GRIBIO::read2DGrid(Grid2DObject& grid_out, const MeteoGrids::Parameters& parameter, const Date& date)
@@ -581,12 +716,13 @@ void GRIBIO::read2DGrid(const std::string& filename, Grid2DObject& grid_out, con
 	if (parameter==MeteoGrids::RH) {
 		if (!read2DGrid_indexed(52.2, 105, 2, date, grid_out)) { //RELHUM_2M
 			Grid2DObject ta;
-			read2DGrid_indexed(11.2, 105, 2, date, ta); //T_2M
-			read2DGrid_indexed(17.2, 105, 2, date, grid_out); //TD_2M
-			for (size_t jj=0; jj<grid_out.getNy(); jj++) {
-				for (size_t ii=0; ii<grid_out.getNx(); ii++) {
-					grid_out(ii,jj) = Atmosphere::DewPointtoRh(grid_out(ii,jj), ta(ii,jj), true);
-				}
+			const bool has_ta = read2DGrid_indexed(11.2, 105, 2, date, ta); //T_2M
+			const bool has_td = read2DGrid_indexed(17.2, 105, 2, date, grid_out); //TD_2M
+			if (has_ta && has_td) {
+				if (grid_out.getNx()!=ta.getNx() || grid_out.getNy()!=ta.getNy()) throw InvalidFormatException("TD_2M and T_2M grids have different sizes, can not compute RH", AT);
+				Atmosphere::DewPointtoRh(grid_out.grid2D.data(), ta.grid2D.data(), grid_out.size(), true, grid_out.grid2D.data());
+			} else {
+				grid_out.clear(); //RH can not be computed, the grid is left empty
 			}
 		}
 	}
@@ -849,15 +985,13 @@ bool GRIBIO::readMeteoMeta(std::vector<Coords>& vecPoints, std::vector<StationDa
 {//return true if the metadata have been read, false if it needs to be re-read (ie: some points were leading to duplicates -> vecPoints has been changed)
 	stations.clear();
 
-	GRIB_CHECK(grib_index_select_double(idx,"marsParam",8.2),0); //This is the DEM
-	GRIB_CHECK(grib_index_select_long(idx,"indicatorOfTypeOfLevel", 1),0);
-
-	int err=0;
-	grib_handle* h = grib_handle_new_from_index(idx,&err);
-	if (h==nullptr) {
+	const size_t dem_idx = findMessage(8.2, 1, 0, Date()); //This is the DEM
+	if (dem_idx==npos) {
 		cleanup();
 		throw IOException("Can not find DEM grid in GRIB file!", AT);
 	}
+	std::vector<unsigned char> buffer;
+	grib_handle* h = loadMessage(idx[dem_idx], buffer);
 
 	const size_t npoints = vecPoints.size();
 	double latitudeOfSouthernPole, longitudeOfSouthernPole;
@@ -912,56 +1046,39 @@ bool GRIBIO::readMeteoMeta(std::vector<Coords>& vecPoints, std::vector<StationDa
 	return true;
 }
 
-bool GRIBIO::readMeteoValues(const double& marsParam, const long& levelType, const long& i_level, const Date& i_date, const size_t& npoints, double *lats, double *lons, double *values)
+//decode the selected messages (possibly concurrently) and extract the values at the given points
+void GRIBIO::decodeMeteoMessages(const std::vector<size_t>& selected, const size_t& npoints, double *lats, double *lons, std::vector< std::vector<double> >& values)
 {
-	GRIB_CHECK(grib_index_select_double(idx,"marsParam",marsParam),0);
-	GRIB_CHECK(grib_index_select_long(idx,"indicatorOfTypeOfLevel", levelType),0);
-
-	grib_handle* h=nullptr;
-	int err=0;
-	while ((h = grib_handle_new_from_index(idx,&err)) != nullptr) {
-		if (!h) {
-			cleanup();
-			throw IOException("Unable to create grib handle from index", AT);
+	values.assign(idx.size(), std::vector<double>());
+	const int nr_msg = static_cast<int>( selected.size() );
+	std::string error_msg;
+
+#pragma omp parallel for schedule(dynamic) if(parallel_decode)
+	for (int ii=0; ii<nr_msg; ii++) { //each worker works with its own buffers and grib_handle
+		try {
+			const size_t msg_idx = selected[ii];
+			std::vector<unsigned char> buffer;
+			grib_handle* h = loadMessage(idx[msg_idx], buffer);
+
+			std::vector<double> outlats(npoints), outlons(npoints), distances(npoints), msg_values(npoints);
+			std::vector<int> indexes(npoints);
+			const int status = grib_nearest_find_multiple(h, 0, lats, lons, static_cast<long>(npoints), &outlats[0], &outlons[0], &msg_values[0], &distances[0], &indexes[0]);
+			grib_handle_delete(h);
+			if (status!=0) throw IOException("Errro when searching for nearest points in \""+idx_filename+"\"", AT);
+			values[msg_idx].swap( msg_values );
+		} catch (const std::exception& e) { //exceptions can not cross the parallel region
+#pragma omp critical(gribio_decode_error)
+			error_msg = e.what();
 		}
+	}
 
-		Date base_date;
-		double P1, P2;
-		getDate(h, base_date, P1, P2);
-
-		//see WMO code table5 for definitions of timeRangeIndicator. http://dss.ucar.edu/docs/formats/grib/gribdoc/timer.html
-		long timeRange;
-		GRIB_CHECK(grib_get_long(h,"timeRangeIndicator", &timeRange),0);
-
-		long level=0;
-		if (i_level!=0) GRIB_CHECK(grib_get_long(h,"level", &level),0);
-		if (level==i_level) {
-			if ( (i_date.isUndef()) ||
-			    (timeRange==0 && i_date==base_date+P1) ||
-			    (timeRange==1 && i_date==base_date) ||
-			    ((timeRange==2 || timeRange==3) && i_date>=base_date+P1 && i_date<=base_date+P2) ||
-			    ((timeRange==4 || timeRange==5) && i_date==base_date+P2) ) {
-				double *outlats = (double*)malloc(npoints*sizeof(double));
-				double *outlons = (double*)malloc(npoints*sizeof(double));
-				double *distances = (double*)malloc(npoints*sizeof(double));
-				int *indexes = (int *)malloc(npoints*sizeof(int));
-				if (grib_nearest_find_multiple(h, 0, lats, lons, npoints, outlats, outlons, values, distances, indexes)!=0) {
-					grib_handle_delete(h);
-					cleanup();
-					throw IOException("Errro when searching for nearest points in DEM", AT);
-				}
-
-				free(outlats); free(outlons); free(distances); free(indexes);
-				grib_handle_delete(h);
-				return true;
-			}
-		}
-		grib_handle_delete(h);
+	if (!error_msg.empty()) {
+		cleanup();
+		throw IOException(error_msg, AT);
 	}
-	return false;
 }
 
-void GRIBIO::fillMeteo(double *values, const MeteoData::Parameters& param, const size_t& npoints, std::vector<MeteoData> &Meteo) {
+void GRIBIO::fillMeteo(const std::vector<double>& values, const MeteoData::Parameters& param, const size_t& npoints, std::vector<MeteoData> &Meteo) {
 	for (size_t ii=0; ii<npoints; ii++) {
 		Meteo[ii](param) = values[ii];
 	}
@@ -978,86 +1095,124 @@ void GRIBIO::readMeteoStep(std::vector<StationData> &stations, double *lats, dou
 		Meteo.push_back(md);
 	}
 
-	double *values = (double*)malloc(npoints*sizeof(double));
-	double *values2 = (double*)malloc(npoints*sizeof(double)); //for extra parameters
-
+	//first, select the messages that are needed for this timestep by only looking at the index
+	std::vector<size_t> sel;
 	//basic meteorological parameters
-	if (readMeteoValues(1.2, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::P, npoints, Meteo); //PS
-	if (readMeteoValues(11.2, 105, 2, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::TA, npoints, Meteo); //T_2M
-	if (readMeteoValues(197.201, 111, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::TSS, npoints, Meteo); //T_SO take 118, BRTMP instead?
-	if (readMeteoValues(11.2, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::TSG, npoints, Meteo); //T_G
-	if (readMeteoValues(52.2, 105, 2, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::RH, npoints, Meteo); //RELHUM_2M
-	else if (readMeteoValues(17.2, 105, 2, i_date, npoints, lats, lons, values)) { //TD_2M
+	const size_t ps = selectMessage(1.2, 1, 0, i_date, sel); //PS
+	const size_t t_2m = selectMessage(11.2, 105, 2, i_date, sel); //T_2M
+	const size_t t_so = selectMessage(197.201, 111, 0, i_date, sel); //T_SO take 118, BRTMP instead?
+	const size_t t_g = selectMessage(11.2, 1, 0, i_date, sel); //T_G
+	const size_t relhum_2m = selectMessage(52.2, 105, 2, i_date, sel); //RELHUM_2M
+	const size_t td_2m = (relhum_2m==npos)? selectMessage(17.2, 105, 2, i_date, sel) : npos; //TD_2M
+
+	//hydrological parameters
+	const size_t tp = selectMessage(61.2, 1, 0, i_date, sel); //tp
+	const size_t hs = selectMessage(66.2, 1, 0, i_date, sel);
+	size_t rho_snow = npos, w_snow = npos;
+	if (hs==npos) {
+		rho_snow = findMessage(133.201, 1, 0, i_date); //RHO_SNOW
+		w_snow = findMessage(65.2, 1, 0, i_date); //W_SNOW
+		if (rho_snow!=npos && w_snow!=npos) {
+			selectMessage(133.201, 1, 0, i_date, sel);
+			selectMessage(65.2, 1, 0, i_date, sel);
+		}
+	}
+
+	//radiation parameters
+	const size_t lw = selectMessage(115.2, 1, 0, i_date, sel); //long wave
+	const size_t alwd_s = (lw==npos)? selectMessage(25.201, 1, 0, i_date, sel) : npos; //ALWD_S
+	const size_t glob_h = selectMessage(109.250, 1, 0, i_date, sel); //GLOB_H
+	size_t sw_dir = npos, sw_diff = npos;
+	if (glob_h==npos) {
+		sw_dir = findMessage(108.250, 1, 0, i_date); //ASWDIR_SH
+		if (sw_dir==npos) sw_dir = findMessage(115.2, 1, 0, i_date); //O_ASWDIR_S
+		if (sw_dir==npos) sw_dir = findMessage(22.201, 1, 0, i_date); //ASWDIR_S
+		sw_diff = findMessage(117.2, 1, 0, i_date); //O_ASWDIFD_S
+		if (sw_diff==npos) sw_diff = findMessage(23.201, 1, 0, i_date); //ASWDIFD_S
+		if (sw_dir!=npos && sw_diff!=npos) {
+			if (std::find(sel.begin(), sel.end(), sw_dir)==sel.end()) sel.push_back( sw_dir );
+			if (std::find(sel.begin(), sel.end(), sw_diff)==sel.end()) sel.push_back( sw_diff );
+		}
+	}
+	const size_t alb_rad = selectMessage(84.2, 1, 0, i_date, sel); //ALB_RAD
+
+	//Wind parameters
+	const size_t vmax_10m = selectMessage(187.201, 105, 10, i_date, sel); //VMAX_10M
+	const size_t dd_10m = selectMessage(31.2, 105, 10, i_date, sel); //DD_10M
+	const size_t ff_10m = selectMessage(32.2, 105, 10, i_date, sel); //FF_10M
+	size_t v_10m = npos, u_10m = npos;
+	if (dd_10m==npos || ff_10m==npos) {
+		v_10m = findMessage(34.2, 105, 10, i_date); //V_10M
+		u_10m = findMessage(33.2, 105, 10, i_date); //U_10M
+		if (v_10m!=npos && u_10m!=npos) {
+			selectMessage(34.2, 105, 10, i_date, sel);
+			selectMessage(33.2, 105, 10, i_date, sel);
+		}
+	}
+
+	//then decode all the selected messages at once
+	std::vector< std::vector<double> > values;
+	decodeMeteoMessages(sel, npoints, lats, lons, values);
+
+	//and finally fill the meteo data
+	if (ps!=npos) fillMeteo(values[ps], MeteoData::P, npoints, Meteo);
+	if (t_2m!=npos) fillMeteo(values[t_2m], MeteoData::TA, npoints, Meteo);
+	if (t_so!=npos) fillMeteo(values[t_so], MeteoData::TSS, npoints, Meteo);
+	if (t_g!=npos) fillMeteo(values[t_g], MeteoData::TSG, npoints, Meteo);
+	if (relhum_2m!=npos) fillMeteo(values[relhum_2m], MeteoData::RH, npoints, Meteo);
+	else if (td_2m!=npos) {
 		for (size_t ii=0; ii<npoints; ii++) {
 			if (Meteo[ii](MeteoData::TA)!=IOUtils::nodata)
-				Meteo[ii](MeteoData::RH) = Atmosphere::DewPointtoRh(values[ii], Meteo[ii](MeteoData::TA), true);
+				Meteo[ii](MeteoData::RH) = Atmosphere::DewPointtoRh(values[td_2m][ii], Meteo[ii](MeteoData::TA), true);
 		}
 	}
 
-	//hydrological parameters
-	if (readMeteoValues(61.2, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::PSUM, npoints, Meteo); //tp
-	if (readMeteoValues(66.2, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::HS, npoints, Meteo);
-	else if (readMeteoValues(133.201, 1, 0, i_date, npoints, lats, lons, values)  //RHO_SNOW
-	   && readMeteoValues(65.2, 1, 0, i_date, npoints, lats, lons, values2)) { //W_SNOW
+	if (tp!=npos) fillMeteo(values[tp], MeteoData::PSUM, npoints, Meteo);
+	if (hs!=npos) fillMeteo(values[hs], MeteoData::HS, npoints, Meteo);
+	else if (rho_snow!=npos && w_snow!=npos) {
 		for (size_t ii=0; ii<npoints; ii++) {
-			Meteo[ii](MeteoData::HS) = values2[ii] / values[ii];
+			Meteo[ii](MeteoData::HS) = values[w_snow][ii] / values[rho_snow][ii];
 		}
 	}
 
-	//radiation parameters
-	if (readMeteoValues(115.2, 1, 0, i_date, npoints, lats, lons, values)) { //long wave
+	if (lw!=npos) {
 		for (size_t ii=0; ii<npoints; ii++) {
-			Meteo[ii](MeteoData::ISWR) = -values[ii];
+			Meteo[ii](MeteoData::ISWR) = -values[lw][ii];
 		}
-	} else if (readMeteoValues(25.201, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::ILWR, npoints, Meteo); //ALWD_S
-	if (readMeteoValues(109.250, 1, 0, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::ISWR, npoints, Meteo); //GLOB_H
-	else {
-		const bool read_dir = (readMeteoValues(108.250, 1, 0, i_date, npoints, lats, lons, values) //ASWDIR_SH
-		                                 || readMeteoValues(115.2, 1, 0, i_date, npoints, lats, lons, values) //O_ASWDIR_S
-		                                 || readMeteoValues(22.201, 1, 0, i_date, npoints, lats, lons, values)); //ASWDIR_S
-		const bool read_diff = (readMeteoValues(117.2, 1, 0, i_date, npoints, lats, lons, values2) //O_ASWDIFD_S
-		                                  || readMeteoValues(23.201, 1, 0, i_date, npoints, lats, lons, values2)); //ASWDIFD_S
-		if (read_dir && read_diff){
-			for (size_t ii=0; ii<npoints; ii++) {
-				Meteo[ii](MeteoData::ISWR) = values[ii] + values2[ii];
-			}
+	} else if (alwd_s!=npos) fillMeteo(values[alwd_s], MeteoData::ILWR, npoints, Meteo);
+	if (glob_h!=npos) fillMeteo(values[glob_h], MeteoData::ISWR, npoints, Meteo);
+	else if (sw_dir!=npos && sw_diff!=npos) {
+		for (size_t ii=0; ii<npoints; ii++) {
+			Meteo[ii](MeteoData::ISWR) = values[sw_dir][ii] + values[sw_diff][ii];
 		}
 	}
-	if (readMeteoValues(84.2, 1, 0, i_date, npoints, lats, lons, values)) { //ALB_RAD
+	if (alb_rad!=npos) {
 		for (size_t ii=0; ii<npoints; ii++) {
-			if (Meteo[ii](MeteoData::ISWR)!=IOUtils::nodata) Meteo[ii](MeteoData::RSWR) = Meteo[ii](MeteoData::ISWR) * values[ii]/100.;
+			if (Meteo[ii](MeteoData::ISWR)!=IOUtils::nodata) Meteo[ii](MeteoData::RSWR) = Meteo[ii](MeteoData::ISWR) * values[alb_rad][ii]/100.;
 		}
 	}
 
-	//Wind parameters
-	if (readMeteoValues(187.201, 105, 10, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::VW_MAX, npoints, Meteo); //VMAX_10M
-	if (readMeteoValues(31.2, 105, 10, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::DW, npoints, Meteo); //DD_10M
-	else {
-		if (readMeteoValues(34.2, 105, 10, i_date, npoints, lats, lons, values) //V_10M
-		   && readMeteoValues(33.2, 105, 10, i_date, npoints, lats, lons, values2)) { //U_10M
-			for (size_t ii=0; ii<npoints; ii++) {
-				Meteo[ii](MeteoData::DW) = fmod( IOUtils::UV_TO_DW(values2[ii], values[ii]) + bearing_offset, 360.); // turn into degrees [0;360)
-			}
+	if (vmax_10m!=npos) fillMeteo(values[vmax_10m], MeteoData::VW_MAX, npoints, Meteo);
+	if (dd_10m!=npos) fillMeteo(values[dd_10m], MeteoData::DW, npoints, Meteo);
+	else if (v_10m!=npos && u_10m!=npos) {
+		for (size_t ii=0; ii<npoints; ii++) {
+			Meteo[ii](MeteoData::DW) = fmod( IOUtils::UV_TO_DW(values[u_10m][ii], values[v_10m][ii]) + bearing_offset, 360.); // turn into degrees [0;360)
 		}
 	}
-	if (readMeteoValues(32.2, 105, 10, i_date, npoints, lats, lons, values)) fillMeteo(values, MeteoData::VW, npoints, Meteo); //FF_10M
-	else {
-		if (readMeteoValues(34.2, 105, 10, i_date, npoints, lats, lons, values) //V_10M
-		   && readMeteoValues(33.2, 105, 10, i_date, npoints, lats, lons, values2)) { //U_10M
-			for (size_t ii=0; ii<npoints; ii++) {
-				Meteo[ii](MeteoData::VW) =  sqrt( Optim::pow2(values[ii]) + Optim::pow2(values2[ii]) );
-			}
+	if (ff_10m!=npos) fillMeteo(values[ff_10m], MeteoData::VW, npoints, Meteo);
+	else if (v_10m!=npos && u_10m!=npos) {
+		for (size_t ii=0; ii<npoints; ii++) {
+			Meteo[ii](MeteoData::VW) =  sqrt( Optim::pow2(values[v_10m][ii]) + Optim::pow2(values[u_10m][ii]) );
 		}
 	}
-
-	free(values); free(values2);
 }
 
 void GRIBIO::cleanup() noexcept
 {
 	if (fp!=nullptr) fclose(fp); fp=nullptr;
-	if (idx!=nullptr) grib_index_delete(idx); idx=nullptr;
+	idx.clear();
 	idx_filename.clear();
+	indexed = false;
 }
 
 } //namespace
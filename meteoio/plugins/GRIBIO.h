@@ -22,6 +22,7 @@
 #include <meteoio/IOInterface.h>
 
 #include <string>
+#include <vector>
 #include <grib_api.h>
 
 namespace mio {
@@ -52,8 +53,31 @@ class GRIBIO : public IOInterface {
 		                           std::vector< std::vector<MeteoData> >& vecMeteo);
 		
 	private:
+		/**
+		 * @brief Compact description of a GRIB message, as stored in the messages index
+		 * @details This contains everything that is necessary to select a message (parameter, level and validity)
+		 * as well as its location in the file so it can be decoded without scanning the whole file.
+		 */
+		typedef struct GRIB_MESSAGE {
+			GRIB_MESSAGE() : offset(0), length(0), marsParam(IOUtils::nodata), levelType(0), level(0), timeRange(-1),
+			                 dataDate(0), dataTime(0), stepUnits(1), startStep(0), endStep(0) {}
+			long offset; ///< offset of the message in the file, in bytes
+			size_t length; ///< length of the message, in bytes
+			double marsParam;
+			long levelType, level, timeRange;
+			long dataDate, dataTime, stepUnits, startStep, endStep; ///< raw reference date and forecast steps
+		} GribMessage;
+
 		void setOptions();
-		void getDate(grib_handle* h, Date &base, double &d1, double &d2);
+		static void getDate(const GribMessage& msg, Date &base, double &d1, double &d2);
+		static bool matchDate(const GribMessage& msg, const Date& i_date, double &d1, double &d2);
+		size_t findMessage(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date& i_date) const;
+		size_t selectMessage(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date& i_date, std::vector<size_t>& selected) const;
+		grib_handle* loadMessage(const GribMessage& msg, std::vector<unsigned char>& buffer) const;
+		void buildIndex(const std::string& filename);
+		bool readIndexFile(const std::string& filename);
+		void writeIndexFile(const std::string& filename) const;
+		void decodeMeteoMessages(const std::vector<size_t>& selected, const size_t& npoints, double *lats, double *lons, std::vector< std::vector<double> >& values);
 		Coords getGeolocalization(grib_handle* h, double &cellsize_x, double &cellsize_y);
 		void read2Dlevel(grib_handle* h, Grid2DObject& grid_out);
 		bool read2DGrid_indexed(const double& in_marsParam, const long& i_levelType, const long& i_level, const Date i_date, Grid2DObject& grid_out);
@@ -68,8 +92,7 @@ class GRIBIO : public IOInterface {
 
 		bool removeDuplicatePoints(std::vector<Coords>& vecPoints, double *lats, double *lons);
 		bool readMeteoMeta(std::vector<Coords>& vecPoints, std::vector<StationData> &stations, double *lats, double *lons);
-		bool readMeteoValues(const double& marsParam, const long& levelType, const long& i_level, const Date& i_date, const size_t& npoints, double *lats, double *lons, double *values);
-		void fillMeteo(double *values, const MeteoData::Parameters& param, const size_t& npoints, std::vector<MeteoData> &Meteo);
+		void fillMeteo(const std::vector<double>& values, const MeteoData::Parameters& param, const size_t& npoints, std::vector<MeteoData> &Meteo);
 		void readMeteoStep(std::vector<StationData> &stations, double *lats, double *lons, const Date i_date, std::vector<MeteoData> &Meteo);
 
 		const Config cfg;
@@ -87,7 +110,7 @@ class GRIBIO : public IOInterface {
 		Coords llcorner;
 
 		FILE *fp; //since passing fp always fail...
-		grib_index *idx; //because it needs to be kept between calls
+		std::vector<GribMessage> idx; //messages index of the currently opened file, kept between calls
 		double latitudeOfNorthernPole, longitudeOfNorthernPole; //for rotated coordinates
 		double bearing_offset; //to correct vectors coming from rotated lat/lon, we will add an offset to the bearing
 		double cellsize, factor_x, factor_y;
@@ -95,7 +118,11 @@ class GRIBIO : public IOInterface {
 		static const std::string default_ext;
 		static const double plugin_nodata; //plugin specific nodata value, e.g. -999
 		static const double tz_in; //GRIB time zone
+		static const std::string index_ext; //extension of the messages index sidecar files
+		static const size_t npos;
 		bool indexed; //flag to know if the file has already been indexed
+		bool persist_index; //write the messages index next to the GRIB files so it can be reused
+		bool parallel_decode; //decode the messages of a timestep concurrently
 		bool meteo_initialized; //set to true after we scanned METEOPATH, filed the cache, read the virtual stations from io.ini
 		bool llcorner_initialized; //set to true after we properly computed llcorner
 		bool update_dem, debug;
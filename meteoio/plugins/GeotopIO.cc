@@ -126,7 +126,7 @@ void GeotopIO::writeMeteoData( const std::vector<std::vector<MeteoData> >& vecMe
 	fout << "1: double matrix meteo_station{" << vecMeteo.size() << ",13}\n";
 	for (size_t ii = 0; ii < vecMeteo.size(); ii++) {
 		if (!vecMeteo.at(ii).empty()) {
-			Coords coord = vecMeteo.at(ii).at(0).meta.position;
+			Coords coord = vecMeteo.at(ii).at(0).meta->position;
 			coord.setProj(coordout, coordoutparam); //Setting the output projection
 			fout.precision(12);
 			fout << coord.getEasting() << "\t" << coord.getNorthing() << "\t"
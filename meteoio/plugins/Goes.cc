@@ -171,12 +171,12 @@ void GoesIO::readMeteoData(const Date& dateStart, const Date& dateEnd,
 		//merge the tmp data into vecMeteo
 		for (size_t st=0; st<vecTmp.size(); st++) {
 			if (vecTmp[st].empty()) continue;
-			const std::string fromID( IOUtils::strToUpper(vecTmp[st][0].meta.stationID) );
+			const std::string fromID( IOUtils::strToUpper(vecTmp[st][0].meta->stationID) );
 
 			bool found = false;
 			for (size_t jj=0; jj<vecMeteo.size(); jj++) {
 				if (vecMeteo[jj].empty()) continue; //This should not happen!
-				const std::string curr_station( IOUtils::strToUpper(vecMeteo[jj][0].meta.stationID) );
+				const std::string curr_station( IOUtils::strToUpper(vecMeteo[jj][0].meta->stationID) );
 				if (curr_station==fromID) {
 					MeteoData::mergeTimeSeries(vecMeteo[jj], vecTmp[st], MeteoData::FULL_MERGE); //merge timeseries for the two stations
 					found = true;
@@ -632,7 +632,7 @@ void ImisIO::readData(const Date& dateStart, const Date& dateEnd, std::vector< s
 
 	MeteoData tmpmd;
 	tmpmd.meta = vecStationIDs.at(stationindex);
-	const bool reduce_pressure = (tmpmd.meta.stationID!="STB2")? true : false; //unfortunately, there is no metadata to know this...
+	const bool reduce_pressure = (tmpmd.meta->stationID!="STB2")? true : false; //unfortunately, there is no metadata to know this...
 	vecMeteo[stationindex].resize( vecResult.size() );
 	for (size_t ii=0; ii<vecResult.size(); ii++) {
 		parseDataSet(vecResult[ii], tmpmd, fullStation);
@@ -640,8 +640,8 @@ void ImisIO::readData(const Date& dateStart, const Date& dateEnd, std::vector< s
 
 		//For IMIS stations the psum value is a rate (kg m-2 h-1), therefore we need to
 		//divide it by two to conjure the accumulated value for the half hour
-		if (tmpmd.meta.stationID.length() > 0) {
-			if (tmpmd.meta.stationID[0] != '*') { //only consider IMIS stations (ie: not ANETZ which simply go through)
+		if (tmpmd.meta->stationID.length() > 0) {
+			if (tmpmd.meta->stationID[0] != '*') { //only consider IMIS stations (ie: not ANETZ which simply go through)
 				if (use_imis_psum==false) {
 					tmpmd(MeteoData::PSUM) = IOUtils::nodata;
 				} else {
@@ -1046,7 +1046,7 @@ void ImisIO::convertUnits(MeteoData& meteo, const bool& reduce_pressure)
 	double& p = meteo(MeteoData::P);
 	if (p != IOUtils::nodata) {
 		if (reduce_pressure) 
-			p *= 100. * Atmosphere::stdAirPressure(meteo.meta.position.getAltitude()) / Cst::std_press;
+			p *= 100. * Atmosphere::stdAirPressure(meteo.meta->position.getAltitude()) / Cst::std_press;
 		else
 			p *= 100.; //simply convert the units
 	}
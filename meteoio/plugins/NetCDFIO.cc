@@ -643,7 +643,7 @@ void NetCDFIO::writeMeteoData(const std::vector< std::vector<MeteoData> >& vecMe
 	} else {
 		for (size_t ii=0; ii<vecMeteo.size(); ii++) {
 			if (vecMeteo[ii].empty()) continue;
-			const std::string file_and_path( out_meteo_path + "/" + vecMeteo[ii].front().meta.stationID + ".nc" );
+			const std::string file_and_path( out_meteo_path + "/" + vecMeteo[ii].front().meta->stationID + ".nc" );
 			if (!FileUtils::validFileAndPath(file_and_path)) throw InvalidNameException("Invalid output file name '"+file_and_path+"'", AT);
 			if (FileUtils::fileExists(file_and_path)) throw IOException("Appending data to timeseries is currently non-functional for NetCDF, please delete file "+file_and_path, AT);
 
@@ -1215,10 +1215,10 @@ void ncFiles::writeMeteo(const std::vector< std::vector<MeteoData> >& vecMeteo,
 		if (param==ncpp::STATION) { //this is not present if !station_dimension
 			if (station_idx==IOUtils::npos) { //writing all stations into one file
 				std::vector<std::string> txtdata( vecMeteo.size() );
-				for (size_t jj=0; jj<vecMeteo.size(); jj++) txtdata[jj] = vecMeteo[jj].front().meta.stationID.substr(0, DFLT_STAT_STR_LEN-1);
+				for (size_t jj=0; jj<vecMeteo.size(); jj++) txtdata[jj] = vecMeteo[jj].front().meta->stationID.substr(0, DFLT_STAT_STR_LEN-1);
 				ncpp::write_1Ddata(ncid, vars[param], txtdata, DFLT_STAT_STR_LEN);
 			} else { //only one station per file
-				std::vector<std::string> txtdata( 1, vecMeteo[station_idx].front().meta.stationID.substr(0, DFLT_STAT_STR_LEN-1));
+				std::vector<std::string> txtdata( 1, vecMeteo[station_idx].front().meta->stationID.substr(0, DFLT_STAT_STR_LEN-1));
 				ncpp::write_1Ddata(ncid, vars[param], txtdata, DFLT_STAT_STR_LEN);
 			}
 		} else {
@@ -1255,9 +1255,9 @@ void ncFiles::writeMeteoMetadataHeader(const std::vector< std::vector<MeteoData>
 
 	if (station_idx==IOUtils::npos) { //multiple stations per file
 		if (vecMeteo.size()<30) {
-			std::string stats_list( vecMeteo[0].front().meta.stationID );
+			std::string stats_list( vecMeteo[0].front().meta->stationID );
 			for (size_t ii=1; ii<vecMeteo.size(); ii++) {
-				stats_list = stats_list + ", " + vecMeteo[ii].front().meta.stationID;
+				stats_list = stats_list + ", " + vecMeteo[ii].front().meta->stationID;
 			}
 			if (stats_list.length()<=140)
 				acdd.addAttribute("title", "Meteorological data timeseries for stations "+stats_list);
@@ -1269,12 +1269,12 @@ void ncFiles::writeMeteoMetadataHeader(const std::vector< std::vector<MeteoData>
 		acdd.setGeometry(vecMeteo, isLatLon);
 		acdd.setTimeCoverage(vecMeteo);
 	} else { //one station per file
-		const std::string stationName( vecMeteo[station_idx].front().meta.stationName );
-		const std::string name = (!stationName.empty())? stationName : vecMeteo[station_idx].front().meta.stationID;
+		const std::string stationName( vecMeteo[station_idx].front().meta->stationName );
+		const std::string name = (!stationName.empty())? stationName : vecMeteo[station_idx].front().meta->stationID;
 		acdd.addAttribute("title", "Meteorological data timeseries for the "+name+" station");
 		acdd.addAttribute("station_name", name);
-		acdd.addAttribute("station_id", vecMeteo[station_idx].front().meta.stationID);
-		acdd.setGeometry( vecMeteo[station_idx].front().meta.position, isLatLon );
+		acdd.addAttribute("station_id", vecMeteo[station_idx].front().meta->stationID);
+		acdd.setGeometry( vecMeteo[station_idx].front().meta->position, isLatLon );
 		acdd.setTimeCoverage(vecMeteo[station_idx]);
 	}
 
@@ -1468,8 +1468,9 @@ std::vector< std::vector<MeteoData> > ncFiles::readMeteoData(const Date& dateSta
 	const size_t nrSteps = end_idx - start_idx;
 	std::vector< std::vector<MeteoData> > vecMeteo(nrStations, std::vector<MeteoData>(nrSteps, mdGeneric));
 	for (size_t st=0; st<nrStations; st++) {
+		const SharedStationData station_meta( vecStation[st] );
 		for (size_t ii=start_idx; ii<end_idx; ii++) {
-			vecMeteo[st][ii-start_idx].meta = vecStation[st];
+			vecMeteo[st][ii-start_idx].meta = station_meta;
 			vecMeteo[st][ii-start_idx].date = vecTime[ii].first;
 		}
 	}
@@ -1736,21 +1737,21 @@ const std::vector<double> ncFiles::fillBufferForAssociatedVar(const std::vector<
 		for (size_t jj=st_start; jj<st_end; jj++) {
 			double value = IOUtils::nodata;
 			if (param==MeteoGrids::DEM) {
-				value = vecMeteo[jj].front().meta.position.getAltitude();
+				value = vecMeteo[jj].front().meta->position.getAltitude();
 			} else if (param==MeteoGrids::SLOPE) {
-				value = vecMeteo[jj].front().meta.getSlopeAngle();
+				value = vecMeteo[jj].front().meta->getSlopeAngle();
 				if (value==IOUtils::nodata) value = dflt_slope;
 			} else if (param==MeteoGrids::AZI) {
-				value = vecMeteo[jj].front().meta.getAzimuth();
+				value = vecMeteo[jj].front().meta->getAzimuth();
 				if (value==IOUtils::nodata) value = dflt_azi;
 			} else if (param==ncpp::EASTING) {
-				value = vecMeteo[jj].front().meta.position.getEasting();
+				value = vecMeteo[jj].front().meta->position.getEasting();
 			} else if (param==ncpp::NORTHING) {
-				value = vecMeteo[jj].front().meta.position.getNorthing();
+				value = vecMeteo[jj].front().meta->position.getNorthing();
 			} else if (param==ncpp::LATITUDE) {
-				value = vecMeteo[jj].front().meta.position.getLat();
+				value = vecMeteo[jj].front().meta->position.getLat();
 			} else if (param==ncpp::LONGITUDE) {
-				value = vecMeteo[jj].front().meta.position.getLon();
+				value = vecMeteo[jj].front().meta->position.getLon();
 			} else if (param==ncpp::ZREF) { //this two are required by Crocus and we don't have anything better for now...
 				value = dflt_zref;
 			} else if (param==ncpp::UREF) {
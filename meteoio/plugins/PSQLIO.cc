@@ -382,8 +382,8 @@ bool PSQLIO::checkConsistency(const std::vector<MeteoData>& vecMeteo, StationDat
 		sd = vecMeteo[0].meta;
 
 	for (size_t ii=1; ii<vecMeteo.size(); ii++){
-		const Coords& p1 = vecMeteo[ii-1].meta.position;
-		const Coords& p2 = vecMeteo[ii].meta.position;
+		const Coords& p1 = vecMeteo[ii-1].meta->position;
+		const Coords& p2 = vecMeteo[ii].meta->position;
 
 		if (p1 != p2) {
 			//we don't mind if p1==nodata or p2==nodata
@@ -258,7 +258,7 @@ void SASEIO::convertUnits(MeteoData& meteo)
 
 void SASEIO::parseDataSet(const std::vector<std::string>& i_meteo, MeteoData& md) const
 {
-	const std::string statID( md.meta.getStationID() );
+	const std::string statID( md.meta->getStationID() );
 
 	if (!IOUtils::convertString(md.date, i_meteo.at(0), in_dflt_TZ))
 		throw ConversionFailedException("Invalid timestamp for station "+statID+": "+i_meteo.at(0), AT);
@@ -20,6 +20,7 @@
 #include <meteoio/IOUtils.h>
 #include <cstdio>
 #include <ctime>
+#include <algorithm>
 
 using namespace std;
 
@@ -108,6 +109,11 @@ namespace mio {
  * 635954 80358 2428
  * @endcode
  *
+ * When the data is written by chunks (see IOManager::appendMeteoData(), for example by meteoio_timeseries), each chunk is directly appended
+ * at the end of the station files. If some new parameters appear in a later chunk (or a station moves while its position was written
+ * in the header), the station file is read back and written again with the new fields. Writing by chunks is not possible when
+ * SMET_VERSIONING or ACDD_WRITE are enabled, since these depend on the whole dataset.
+ *
  * @note There is an R package for handling SMET files available at https://cran.r-project.org/web/packages/RSMET
  */
 
@@ -117,7 +123,7 @@ const double SMETIO::snVirtualSlopeAngle = 38.; //in Snowpack, virtual slopes ar
 SMETIO::SMETIO(const std::string& configfile)
         : cfg(configfile), acdd(false), plot_ppt( initPlotParams() ),
           coordin(), coordinparam(), coordout(), coordoutparam(),
-          vec_smet_reader(), vecFiles(), outpath(), out_dflt_TZ(0.),
+          vec_smet_reader(), vecFiles(), out_sessions(), outpath(), out_dflt_TZ(0.),
           plugin_nodata(IOUtils::nodata), default_prec(3), default_width(8), output_separator(' '), outputVersioning(NO_VERSIONING), outputCommentedHeaders(false),
           outputIsAscii(true), outputPlotHeaders(true), randomColors(false), allowAppend(false), allowOverwrite(true), snowpack_slopes(false)
 {
@@ -127,7 +133,7 @@ SMETIO::SMETIO(const std::string& configfile)
 SMETIO::SMETIO(const Config& cfgreader)
         : cfg(cfgreader), acdd(false), plot_ppt( initPlotParams() ),
           coordin(), coordinparam(), coordout(), coordoutparam(),
-          vec_smet_reader(), vecFiles(), outpath(), out_dflt_TZ(0.),
+          vec_smet_reader(), vecFiles(), out_sessions(), outpath(), out_dflt_TZ(0.),
           plugin_nodata(IOUtils::nodata), default_prec(3), default_width(8), output_separator(' '), outputVersioning(NO_VERSIONING), outputCommentedHeaders(false),
           outputIsAscii(true), outputPlotHeaders(true), randomColors(false), allowAppend(false), allowOverwrite(true), snowpack_slopes(false)
 {
@@ -431,7 +437,9 @@ void SMETIO::populateMeteo(const smet::SMETReader& myreader,
 	const bool data_wgs84 = myreader.location_in_data(smet::WGS84);
 	const bool data_epsg = myreader.location_in_data(smet::EPSG);
 
-	read_meta_data(myreader, md.meta);
+	StationData sd;
+	read_meta_data(myreader, sd);
+	md.meta = sd;
 
 	const double nodata_value = myreader.get_header_doublevalue("nodata");
 	double current_timezone = myreader.get_header_doublevalue("tz");
@@ -486,18 +494,19 @@ void SMETIO::populateMeteo(const smet::SMETReader& myreader,
 		//process location in the data section
 		if (data_epsg || data_wgs84) {
 			if (data_epsg) {
-				tmp_md.meta.position.setXY(east, north, alt, false);
+				sd.position.setXY(east, north, alt, false);
 				east = IOUtils::nodata;
 				north = IOUtils::nodata;
 			}
 			if (data_wgs84) {
-				tmp_md.meta.position.setXY(lat, lon, alt, false);
+				sd.position.setXY(lat, lon, alt, false);
 				lat = IOUtils::nodata;
 				lon = IOUtils::nodata;
 			}
 			alt = IOUtils::nodata;
 			
-			tmp_md.meta.position.check("Inconsistent inline geographic coordinates in file \"" + filename + "\": ");
+			sd.position.check("Inconsistent inline geographic coordinates in file \"" + filename + "\": ");
+			tmp_md.meta = sd;
 		}
 
 		vecMeteo.push_back( tmp_md );
@@ -573,110 +582,174 @@ std::string SMETIO::buildVersionString(const std::vector< std::vector<MeteoData>
 
 void SMETIO::writeMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo, const std::string&)
 {
+	out_sessions.clear();
+
 	//Loop through all stations
 	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
 		if (vecMeteo[ii].empty()) continue; //this station does not have any data in this vecMeteo
-		//1. check consistency of station data position -> write location in header or data section
-		StationData sd;
-		sd.position.setProj(coordout, coordoutparam);
-		const bool isConsistent = checkConsistency(vecMeteo.at(ii), sd);
-		if (sd.stationID.empty()) sd.stationID = "Station"+IOUtils::toString( ii+1 );
-
-		//2. check which meteo parameter fields are actually in use
 		//if the user set an output time zone, all will be converted to it. 
 		//Otherwise, we know that the current station is not empty, we take TZ from the first timestamnp
 		const double smet_timezone = (out_dflt_TZ != IOUtils::nodata)? out_dflt_TZ : vecMeteo[ii][0].date.getTimeZone();
-		const std::set<std::string> paramInUse( MeteoData::listAvailableParameters(vecMeteo[ii]) );
 		const std::string version_str = buildVersionString( vecMeteo, smet_timezone );
-		const std::string filename( outpath + "/" + sd.stationID + version_str + dflt_extension );
-		if (!FileUtils::validFileAndPath(filename)) //Check whether filename is valid
-			throw InvalidNameException(filename, AT);
-
-		try {
-			const smet::SMETType type = (outputIsAscii)? smet::ASCII : smet::BINARY;
-			smet::SMETWriter *mywriter = nullptr;
-			const bool fileExists = FileUtils::fileExists(filename);
-			if (fileExists && allowAppend) {
-				std::string fields = (outputIsAscii)? "timestamp" : "julian"; //we force the first field to have the time
-				int tmpwidth, tmpprecision;
-				std::vector<int> myprecision, mywidth; //set meaningful precision/width for each column
-				for (const std::string& parname : paramInUse) {
-					fields = fields + " " + parname;
-					getFormatting(parname, tmpprecision, tmpwidth);
-					//NOTE: the following works, because sets will always be ordered the same, so even if the order of
-					//parameters change over time, the paramInUse set will keep its ordering
-					myprecision.push_back(tmpprecision);
-					mywidth.push_back(tmpwidth);
-				}
-				
-				if (output_separator!=' ') 
-					throw InvalidArgumentException("It is not possible to set the field separator when appending data to a smet file", AT);
-				mywriter = new smet::SMETWriter(filename, fields, IOUtils::nodata); //set to append mode
-				mywriter->set_width(mywidth);
-				mywriter->set_precision(myprecision);
-			} else {
-				if (fileExists && !allowOverwrite)
-					throw AccessException("File '"+filename+"' already exists, please either allow append or overwrite", AT);
-				
-				mywriter = new smet::SMETWriter(filename, type);
-				if (output_separator!=' ') mywriter->set_separator( output_separator );
-				mywriter->set_commented_headers( outputCommentedHeaders );
-				generateHeaderInfo(sd, outputIsAscii, isConsistent, smet_timezone, paramInUse, *mywriter);
-			}
+		writeStation(ii, vecMeteo[ii], version_str, false);
+	}
+}
 
-			std::vector<std::string> vec_timestamp;
-			std::vector<double> vec_data;
-			std::vector<mio::Coords> vecLocation;
-			if (!vecMeteo[ii].empty()) vecLocation.push_back( vecMeteo[ii].front().meta.position );
-			for (size_t jj=0; jj<vecMeteo[ii].size(); jj++) {
-				//handle the timestamp field
-				if (outputIsAscii){
-					if (out_dflt_TZ != IOUtils::nodata) { //user-specified time zone
-						Date tmp_date(vecMeteo[ii][jj].date);
-						tmp_date.setTimeZone(out_dflt_TZ);
-						vec_timestamp.push_back(tmp_date.toString(Date::ISO));
-					} else {
-						vec_timestamp.push_back(vecMeteo[ii][jj].date.toString(Date::ISO));
-					}
-				} else {
-					double julian;
-					if (out_dflt_TZ!=IOUtils::nodata) {
-						Date tmp_date(vecMeteo[ii][jj].date);
-						tmp_date.setTimeZone(out_dflt_TZ);
-						julian = tmp_date.getJulian();
-					} else {
-						julian = vecMeteo[ii][jj].date.getJulian();
-					}
-					vec_data.push_back(julian);
-				}
+bool SMETIO::canAppendMeteoData()
+{
+	//the versioning and the ACDD metadata depend on the whole dataset, so they can not be written chunk by chunk
+	return (outputVersioning==NO_VERSIONING && !acdd.isEnabled());
+}
 
-				if (!isConsistent) { //Meta data changes
-					if (vecMeteo[ii][jj].meta.position != vecLocation.back())
-						vecLocation.push_back( vecMeteo[ii][jj].meta.position );
-					
-					vec_data.push_back(vecMeteo[ii][jj].meta.position.getLat());
-					vec_data.push_back(vecMeteo[ii][jj].meta.position.getLon());
-					vec_data.push_back(vecMeteo[ii][jj].meta.position.getAltitude());
-				}
+void SMETIO::appendMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo, const std::string&)
+{
+	if (!canAppendMeteoData())
+		throw InvalidArgumentException("The SMET plugin can not write data by chunks when VERSIONING or ACDD are enabled", AT);
 
-				//gather all the data fields for this timestamps
-				for (const std::string& parname : paramInUse) {
-					vec_data.push_back( vecMeteo[ii][jj]( parname ) ); //add data value
-				}
-			}
+	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
+		if (vecMeteo[ii].empty()) continue;
 
-			if (acdd.isEnabled()) {
-				acdd.setTimeCoverage( vecMeteo[ii] );
-				acdd.setGeometry(vecLocation, true);
+		const std::map<size_t, out_session>::iterator it( out_sessions.find(ii) );
+		if (it==out_sessions.end()) { //this station had no data so far
+			writeStation(ii, vecMeteo[ii], "", false);
+			continue;
+		}
+
+		out_session& session = it->second;
+		StationData sd;
+		const bool isConsistent = checkConsistency(vecMeteo[ii], sd);
+		const bool sameLocation = !session.isConsistent || (isConsistent && (sd.position.isNodata() || sd.position==session.sd.position));
+		const std::set<std::string> paramInUse( MeteoData::listAvailableParameters(vecMeteo[ii]) );
+		if (sameLocation && std::includes(session.params.begin(), session.params.end(), paramInUse.begin(), paramInUse.end())) {
+			writeData(vecMeteo[ii], session);
+			continue;
+		}
+
+		//some new parameters appeared or the station moved: the fields or the header have to change, so the
+		//file is read back and written again with the new chunk (this is only done when the fields change)
+		smet::SMETReader reader( session.filename );
+		reader.convert_to_MKSA(true);
+		std::vector<std::string> timestamps;
+		std::vector<double> data;
+		if (reader.contains_timestamp()) reader.read(timestamps, data);
+		else reader.read(data);
+		std::vector<MeteoData> vecStation;
+		populateMeteo(reader, timestamps, data, vecStation);
+		vecStation.insert(vecStation.end(), vecMeteo[ii].begin(), vecMeteo[ii].end());
+		MeteoData::unifyMeteoData( vecStation );
+		writeStation(ii, vecStation, "", true);
+	}
+}
+
+smet::SMETWriter SMETIO::createWriter(const std::string& filename, const StationData& sd, const bool& isConsistent, const double& smet_timezone,
+                                      const std::set<std::string>& paramInUse, const bool& forceOverwrite)
+{
+	const smet::SMETType type = (outputIsAscii)? smet::ASCII : smet::BINARY;
+	const bool fileExists = FileUtils::fileExists(filename);
+	if (fileExists && allowAppend && !forceOverwrite) {
+		std::string fields = (outputIsAscii)? "timestamp" : "julian"; //we force the first field to have the time
+		int tmpwidth, tmpprecision;
+		std::vector<int> myprecision, mywidth; //set meaningful precision/width for each column
+		for (const std::string& parname : paramInUse) {
+			fields = fields + " " + parname;
+			getFormatting(parname, tmpprecision, tmpwidth);
+			//NOTE: the following works, because sets will always be ordered the same, so even if the order of
+			//parameters change over time, the paramInUse set will keep its ordering
+			myprecision.push_back(tmpprecision);
+			mywidth.push_back(tmpwidth);
+		}
+		
+		if (output_separator!=' ') 
+			throw InvalidArgumentException("It is not possible to set the field separator when appending data to a smet file", AT);
+		smet::SMETWriter mywriter(filename, fields, IOUtils::nodata); //set to append mode
+		mywriter.set_width(mywidth);
+		mywriter.set_precision(myprecision);
+		return mywriter;
+	}
+
+	if (fileExists && !allowOverwrite && !forceOverwrite)
+		throw AccessException("File '"+filename+"' already exists, please either allow append or overwrite", AT);
+	
+	smet::SMETWriter mywriter(filename, type);
+	if (output_separator!=' ') mywriter.set_separator( output_separator );
+	mywriter.set_commented_headers( outputCommentedHeaders );
+	generateHeaderInfo(sd, outputIsAscii, isConsistent, smet_timezone, paramInUse, mywriter);
+	return mywriter;
+}
+
+void SMETIO::writeStation(const size_t& stationIdx, const std::vector<MeteoData>& vecStation, const std::string& version_str, const bool& forceOverwrite)
+{
+	//1. check consistency of station data position -> write location in header or data section
+	StationData sd;
+	sd.position.setProj(coordout, coordoutparam);
+	const bool isConsistent = checkConsistency(vecStation, sd);
+	if (sd.stationID.empty()) sd.stationID = "Station"+IOUtils::toString( stationIdx+1 );
+
+	//2. check which meteo parameter fields are actually in use
+	const double smet_timezone = (out_dflt_TZ != IOUtils::nodata)? out_dflt_TZ : vecStation[0].date.getTimeZone();
+	const std::set<std::string> paramInUse( MeteoData::listAvailableParameters(vecStation) );
+	const std::string filename( outpath + "/" + sd.stationID + version_str + dflt_extension );
+	if (!FileUtils::validFileAndPath(filename)) //Check whether filename is valid
+		throw InvalidNameException(filename, AT);
+
+	//3. write the data and keep the writer, in case more data would be appended later
+	out_session session(createWriter(filename, sd, isConsistent, smet_timezone, paramInUse, forceOverwrite), filename, paramInUse, sd, isConsistent);
+	writeData(vecStation, session);
+	out_sessions.erase( stationIdx );
+	out_sessions.insert( std::make_pair(stationIdx, session) );
+}
+
+void SMETIO::writeData(const std::vector<MeteoData>& vecStation, out_session& session)
+{
+	std::vector<std::string> vec_timestamp;
+	std::vector<double> vec_data;
+	std::vector<mio::Coords> vecLocation;
+	if (!vecStation.empty()) vecLocation.push_back( vecStation.front().meta->position );
+	for (size_t jj=0; jj<vecStation.size(); jj++) {
+		const MeteoData& md = vecStation[jj];
+		//handle the timestamp field
+		if (outputIsAscii){
+			if (out_dflt_TZ != IOUtils::nodata) { //user-specified time zone
+				Date tmp_date(md.date);
+				tmp_date.setTimeZone(out_dflt_TZ);
+				vec_timestamp.push_back(tmp_date.toString(Date::ISO));
+			} else {
+				vec_timestamp.push_back(md.date.toString(Date::ISO));
+			}
+		} else {
+			double julian;
+			if (out_dflt_TZ!=IOUtils::nodata) {
+				Date tmp_date(md.date);
+				tmp_date.setTimeZone(out_dflt_TZ);
+				julian = tmp_date.getJulian();
+			} else {
+				julian = md.date.getJulian();
 			}
-			if (outputIsAscii) mywriter->write(vec_timestamp, vec_data, acdd);
-			else mywriter->write(vec_data, acdd);
+			vec_data.push_back(julian);
+		}
+
+		if (!session.isConsistent) { //Meta data changes
+			if (md.meta->position != vecLocation.back())
+				vecLocation.push_back( md.meta->position );
+			
+			vec_data.push_back(md.meta->position.getLat());
+			vec_data.push_back(md.meta->position.getLon());
+			vec_data.push_back(md.meta->position.getAltitude());
+		}
 
-			delete mywriter;
-		} catch(exception&) {
-			throw;
+		//gather all the data fields for this timestamps (when appending, some fields might not be in this chunk)
+		for (const std::string& parname : session.params) {
+			const size_t idx = md.getParameterIndex(parname);
+			vec_data.push_back( (idx!=IOUtils::npos)? md(idx) : IOUtils::nodata ); //add data value
 		}
 	}
+
+	if (acdd.isEnabled()) {
+		acdd.setTimeCoverage( vecStation );
+		acdd.setGeometry(vecLocation, true);
+	}
+	if (outputIsAscii) session.writer.write(vec_timestamp, vec_data, acdd);
+	else session.writer.write(vec_data, acdd);
 }
 
 void SMETIO::generateHeaderInfo(const StationData& sd, const bool& i_outputIsAscii, const bool& isConsistent,
@@ -891,8 +964,8 @@ bool SMETIO::checkConsistency(const std::vector<MeteoData>& vecMeteo, StationDat
 		sd = vecMeteo[0].meta;
 
 	for (size_t ii=1; ii<vecMeteo.size(); ii++){
-		const Coords& p1 = vecMeteo[ii-1].meta.position;
-		const Coords& p2 = vecMeteo[ii].meta.position;
+		const Coords& p1 = vecMeteo[ii-1].meta->position;
+		const Coords& p2 = vecMeteo[ii].meta->position;
 		if (p1 != p2) {
 			//we don't mind if p1==nodata or p2==nodata
 			if (p1.isNodata()==false && p2.isNodata()==false) return false;
@@ -23,6 +23,8 @@
 #include <meteoio/plugins/libsmet.h>
 #include <meteoio/plugins/libacdd.h>
 
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -51,6 +53,9 @@ class SMETIO : public IOInterface {
 
 		virtual void writeMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo,
 		                            const std::string& name="");
+		virtual bool canAppendMeteoData();
+		virtual void appendMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo,
+		                             const std::string& name="");
 
 		virtual void readPOI(std::vector<Coords>& pts);
 
@@ -69,6 +74,18 @@ class SMETIO : public IOInterface {
 			double max; ///< axis maximum
 		} plot_attr;
 		
+		/** This structure contains what is needed to append new data to a station file that has already been written */
+		typedef struct OUT_SESSION {
+			OUT_SESSION(const smet::SMETWriter& i_writer, const std::string& i_filename, const std::set<std::string>& i_params, const StationData& i_sd, const bool& i_isConsistent)
+			           : writer(i_writer), filename(i_filename), params(i_params), sd(i_sd), isConsistent(i_isConsistent) {}
+
+			smet::SMETWriter writer; ///< writer that has already written the header, it appends on any further write
+			std::string filename; ///< file the writer writes to
+			std::set<std::string> params; ///< parameters that are present as fields in the file
+			StationData sd; ///< station metadata as written in the header
+			bool isConsistent; ///< is the location written in the header (otherwise, it is written in the data)?
+		} out_session;
+
 		typedef enum VERSIONING_TYPE {
 		            NO_VERSIONING, ///< no type selected
 		            NOW, ///< creation time
@@ -92,6 +109,10 @@ class SMETIO : public IOInterface {
 		void getFormatting(const std::string& parname, int& prec, int& width) const;
 		std::string buildVersionString(const std::vector< std::vector<MeteoData> >& vecMeteo, const double& smet_timezone) const;
 		double olwr_to_tss(const double& olwr);
+		smet::SMETWriter createWriter(const std::string& filename, const StationData& sd, const bool& isConsistent, const double& smet_timezone,
+		                              const std::set<std::string>& paramInUse, const bool& forceOverwrite);
+		void writeStation(const size_t& stationIdx, const std::vector<MeteoData>& vecStation, const std::string& version_str, const bool& forceOverwrite);
+		void writeData(const std::vector<MeteoData>& vecStation, out_session& session);
 		void generateHeaderInfo(const StationData& sd, const bool& i_outputIsAscii, const bool& isConsistent,
 		                        const double& smet_timezone, const std::set<std::string>& paramInUse, smet::SMETWriter& mywriter);
 
@@ -103,6 +124,7 @@ class SMETIO : public IOInterface {
 		std::string coordin, coordinparam, coordout, coordoutparam; //default projection parameters
 		std::vector<smet::SMETReader> vec_smet_reader;
 		std::vector<std::string> vecFiles;  //read from the Config [Input] section
+		std::map<size_t, out_session> out_sessions; //what has been written by the last writeMeteoData() call, per station index
 		std::string outpath;                //read from the Config [Output] section
 		double out_dflt_TZ;     //default time zone
 		double plugin_nodata;
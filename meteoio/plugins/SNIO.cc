@@ -442,21 +442,21 @@ bool SNIO::parseMeteoLine(const std::vector<std::string>& vecLine, const std::st
 	 * all meteo parameters to doubles and finally copies them into the MeteoData object md
 	 */
 	if (vecLine.size() < nr_meteoData)
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": line is too short", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": line is too short", AT);
 
 	if (vecLine[0] != "M")
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": meteo input lines must start with 'M'", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": meteo input lines must start with 'M'", AT);
 
 	//deal with the date
 	if (vecLine[1].length() != 10)
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": date format must be DD.MM.YYYY", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": date format must be DD.MM.YYYY", AT);
 
 	const std::string year( vecLine[1].substr(6,4) );
 	const std::string month( vecLine[1].substr(3,2) );
 	const std::string day( vecLine[1].substr(0,2) );
 
 	if (!IOUtils::convertString(md.date, year+"-"+month+"-"+day+"T"+vecLine[2], in_tz, std::dec))
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": invalid date format", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": invalid date format", AT);
 
 	if ((md.date < dateStart) || (md.date > dateEnd)) //stop parsing data for dates out of the scope
 		return false;
@@ -465,7 +465,7 @@ bool SNIO::parseMeteoLine(const std::vector<std::string>& vecLine, const std::st
 	std::vector<double> tmpdata( vecLine.size() );
 	for (size_t ii=4; ii<vecLine.size(); ii++) {
 		if (!IOUtils::convertString(tmpdata[ii], vecLine[ii], std::dec))
-			throw ConversionFailedException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": can not convert  '"+vecLine[ii]+"' to double", AT);
+			throw ConversionFailedException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": can not convert  '"+vecLine[ii]+"' to double", AT);
 	}
 
 	//Copy data into MeteoData object
@@ -502,7 +502,7 @@ bool SNIO::parseMeteoLine(const std::vector<std::string>& vecLine, const std::st
 	// Read optional values
 	// TS[]: snow temperatures
 	if (vecLine.size() < nr_meteoData + number_meas_temperatures)
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": not enough measured temperatures data", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": not enough measured temperatures data", AT);
 
 	for (size_t jj = 1; jj <= number_meas_temperatures; jj++) {
 		ostringstream ss;
@@ -512,7 +512,7 @@ bool SNIO::parseMeteoLine(const std::vector<std::string>& vecLine, const std::st
 	}
 	// CONC[]: solute concentrations
 	if (vecLine.size() < nr_meteoData + number_meas_temperatures + number_of_solutes)
-		throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": not enough solute data", AT);
+		throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": not enough solute data", AT);
 
 	for (size_t jj = 0 ; jj < number_of_solutes; jj++) {
 		ostringstream ss;
@@ -523,20 +523,20 @@ bool SNIO::parseMeteoLine(const std::vector<std::string>& vecLine, const std::st
 	// VW_DRIFT: optional wind velocity for blowing and drifting snow
 	if (vw_drift) {
 		if (vecLine.size() < ii+1)
-			throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": no data for vw_drift", AT);
+			throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": no data for vw_drift", AT);
 		md.addParameter("VW_DRIFT");
 		md("VW_DRIFT") = tmpdata[ii++];
 	}
 	// RHO_HN: measured new snow density
 	if (rho_hn) {
 		if (vecLine.size() < ii+1)
-			throw InvalidFormatException("Reading station "+md.meta.stationID+", at "+file_pos(filename, linenr)+": no data for rho_hn", AT);
+			throw InvalidFormatException("Reading station "+md.meta->stationID+", at "+file_pos(filename, linenr)+": no data for rho_hn", AT);
 		md.addParameter("RHO_HN");
 		md("RHO_HN") = tmpdata[ii++];
 	}
 	if (vecLine.size() > ii) {
 		std::ostringstream ss;
-		ss << "Reading station " << md.meta.stationID << ", at " << file_pos(filename, linenr) << ": too many fields.\n";
+		ss << "Reading station " << md.meta->stationID << ", at " << file_pos(filename, linenr) << ": too many fields.\n";
 		ss << "Looking for " << nr_meteoData << " standard fields + " << number_meas_temperatures << " snow temperatures + ";
 		ss << number_of_solutes << " solutes";
 
@@ -564,7 +564,7 @@ void SNIO::writeMeteoData(const std::vector< std::vector<MeteoData> >& vecMeteo,
 
 	for (size_t ii=0; ii<vecMeteo.size(); ii++) {
 		if (!vecMeteo[ii].empty()) {
-			std::string station_id( vecMeteo[ii].front().meta.getStationID() );
+			std::string station_id( vecMeteo[ii].front().meta->getStationID() );
 			if (station_id.empty()) station_id = "UNKNOWN";
 			const std::string output_name( outpath + "/" + station_id + ".inp" );
 			if (!FileUtils::validFileAndPath(output_name)) throw InvalidNameException(output_name,AT);
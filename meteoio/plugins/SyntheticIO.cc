@@ -18,8 +18,10 @@
 */
 #include <meteoio/plugins/SyntheticIO.h>
 #include <meteoio/meteoLaws/Atmosphere.h>
+#include <meteoio/meteoLaws/Meteoconst.h>
 
 #include <regex>
+#include <cmath>
 
 using namespace std;
 
@@ -51,6 +53,8 @@ namespace mio {
  *           - CST: <a href="https://en.wikipedia.org/wiki/Constant_function">constant function</a> with the additional key: VALUE;
  *           - STEP: <a href="https://en.wikipedia.org/wiki/Step_function">step function</a> with the additional keys: STEP_DATE (as ISO formatted date), VALUE_BEFORE, VALUE_AFTER;
  *           - RECTANGLE: <a href="https://en.wikipedia.org/wiki/Rectangular_function">rectangle function</a> with the additional keys: VALUE, STEP_START (as ISO formatted date), STEP_STOP (as ISO formatted date), VALUE_STEP;
+ *           - SINE: <a href="https://en.wikipedia.org/wiki/Sine_wave">sine wave</a> (for example to mimic a daily cycle) with the additional keys: VALUE (mean value), 
+ * AMPLITUDE, PERIOD (in days, optional, default 1) and PHASE (local time of the maximum in hours, optional, default 0);
  *           - STDPRESS: constant, standard atmospheric pressure as a function of the station's altitude (no arguments).
  *
  * @section synthio_examples Example
@@ -324,6 +328,39 @@ double RECT_Synth::generate(const Date& dt) const
 		return value_step;
 }
 
+SINE_Synth::SINE_Synth(const std::string& station, const std::string& parname, const std::vector< std::pair<std::string, std::string> >& vecArgs, const double& i_TZ) 
+          : value(IOUtils::nodata), amplitude(IOUtils::nodata), period(1.), phase(0.), TZ(i_TZ)
+{
+	const std::string where( "SYNTH SINE, " + station + "::" + parname );
+	bool has_value = false, has_amplitude = false;
+	
+	//parse the arguments
+	for (size_t ii=0; ii<vecArgs.size(); ii++) {
+		if (vecArgs[ii].first=="VALUE") {
+			IOUtils::parseArg(vecArgs[ii], where, value);
+			has_value=true;
+		} else if (vecArgs[ii].first=="AMPLITUDE") {
+			IOUtils::parseArg(vecArgs[ii], where, amplitude);
+			has_amplitude=true;
+		} else if (vecArgs[ii].first=="PERIOD") {
+			IOUtils::parseArg(vecArgs[ii], where, period);
+		} else if (vecArgs[ii].first=="PHASE") {
+			IOUtils::parseArg(vecArgs[ii], where, phase);
+		}
+	}
+	
+	if (!has_value) throw InvalidArgumentException("Please provide the VALUE argument for the "+where, AT);
+	if (!has_amplitude) throw InvalidArgumentException("Please provide the AMPLITUDE argument for the "+where, AT);
+	if (period<=0.) throw InvalidArgumentException("The PERIOD argument must be strictly positive for the "+where, AT);
+}
+
+double SINE_Synth::generate(const Date& dt) const
+{
+	//the julian day starts at noon, so shift it to start at midnight local time
+	const double local_days = dt.getJulian(true) + 0.5 + TZ/24.;
+	return value + amplitude * cos( 2.*Cst::PI * (local_days - phase/24.) / period );
+}
+
 STDPRESS_Synth::STDPRESS_Synth(const StationData& sd) 
           : altitude( sd.getAltitude() ) {}
 
@@ -345,6 +382,8 @@ Synthesizer* SynthFactory::getSynth(std::string type, const std::string& station
 		return new STEP_Synth(station, parname, vecArgs, TZ);
 	} else if (type == "RECTANGLE"){
 		return new RECT_Synth(station, parname, vecArgs, TZ);
+	} else if (type == "SINE"){
+		return new SINE_Synth(station, parname, vecArgs, TZ);
 	} else if (type == "STDPRESS"){
 		return new STDPRESS_Synth(sd);
 	} else {
@@ -104,6 +104,14 @@ class RECT_Synth : public Synthesizer {
 		double value, value_step;
 };
 
+class SINE_Synth : public Synthesizer {
+	public:
+		SINE_Synth(const std::string& station, const std::string& parname, const std::vector< std::pair<std::string, std::string> >& vecArgs, const double& TZ);
+		virtual double generate(const Date& dt) const override;
+	private:
+		double value, amplitude, period, phase, TZ;
+};
+
 class STDPRESS_Synth : public Synthesizer {
 	public:
 		STDPRESS_Synth(const StationData& sd);
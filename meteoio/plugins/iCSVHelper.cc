@@ -428,7 +428,7 @@ void iCSVFile::aggregateData(const std::vector<MeteoData> &vecMeteo) {
         md.date.setTimeZone(METADATA.timezone);
         dates_in_file.push_back(md.date);
         if (!location_in_header) {
-            const Coords &loc = md.meta.position;
+            const Coords &loc = md.meta->position;
             locations_in_data.push_back(toiCSVLocation(loc, METADATA.epsg));
         }
         std::vector<double> row;
@@ -449,6 +449,28 @@ void iCSVFile::aggregateData(const std::vector<MeteoData> &vecMeteo) {
     }
 }
 
+/**
+* @brief Converts the rows that have been read from a file to the layout of the rows to write.
+*
+* The rows that have been read contain placeholders for the timestamp and location columns while the rows
+* to write only contain the data fields. The rows are also padded with nodata for the fields that have been added
+* after reading.
+*/
+void iCSVFile::alignRowsToFields() {
+    const size_t nr_data_fields = FIELDS.fields.size() - ((location_in_header) ? 1 : 2);
+    for (auto &row : row_data) {
+        std::vector<double> data_row;
+        data_row.reserve(nr_data_fields);
+        for (size_t jj = 0; jj < row.size(); jj++) {
+            if (jj == time_id || (!location_in_header && jj == location_id))
+                continue;
+            data_row.push_back(row[jj]);
+        }
+        data_row.resize(nr_data_fields, IOUtils::nodata);
+        row.swap(data_row);
+    }
+}
+
 // ----------------- HEADER Format -----------------
 /**
 * @brief Checks the validity of the format for the iCSVFile.
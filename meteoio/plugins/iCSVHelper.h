@@ -383,6 +383,8 @@ class iCSVFile {
         // Data methods
         double readData(const Date &r_date, const std::string &fieldname);
         void aggregateData(const std::vector<MeteoData> &vecMeteo);
+        void clearData() { dates_in_file.clear(); row_data.clear(); locations_in_data.clear(); }
+        void alignRowsToFields();
         void populateMetaData(const std::string &key, const std::string &value);
         void populateFields(const std::string &key, const std::string &value);
 };
@@ -70,6 +70,11 @@ namespace mio {
 * metadata to the headers (then the individual keys are provided according to the ACDD class documentation) (default: false, [Output] section)
 * - iCSV_SEPARATOR: choice of field delimiter, options are: [,;:|/\]; [Output] section
 * 
+* When the data is written by chunks (see IOManager::appendMeteoData(), for example by meteoio_timeseries), each chunk is directly
+* appended at the end of the station files. If some new parameters appear in a later chunk, the whole file is read back and written
+* again with the new columns (as for iCSV_APPEND). Writing by chunks is not possible when ACDD_WRITE is enabled, since the ACDD
+* metadata depends on the whole dataset.
+*
 * @note There is a python package available to read iCSV files, see <a href="https://github.com/GEUS-Glaciology-and-Climate/pyiCSV/tree/main">pyiCSV</a>
 * 
 */
@@ -167,14 +172,16 @@ using namespace iCSV;
 // ----------------- iCSVIO -----------------
 iCSVIO::iCSVIO(const std::string &configfile)
     : cfg(configfile), coordin(), coordinparam(), coordout(), coordoutparam(), snowpack_slopes(false), read_sequential(false),
-        stations_files(), acdd_metadata(false), TZ_out(0), outpath(""), allow_overwrite(false), allow_append(false), out_delimiter(','), file_extension_out(dflt_extension_iCSV) {
+        stations_files(), acdd_metadata(false), TZ_out(0), outpath(""), allow_overwrite(false), allow_append(false), out_delimiter(','), file_extension_out(dflt_extension_iCSV),
+        out_sessions() {
     parseInputSection();
     parseOutputSection();
 }
 
 iCSVIO::iCSVIO(const Config &cfgreader)
     : cfg(cfgreader), coordin(), coordinparam(), coordout(), coordoutparam(), snowpack_slopes(false), read_sequential(false),
-        stations_files(), acdd_metadata(false), TZ_out(0), outpath(""), allow_overwrite(false), allow_append(false), out_delimiter(','), file_extension_out(dflt_extension_iCSV) {
+        stations_files(), acdd_metadata(false), TZ_out(0), outpath(""), allow_overwrite(false), allow_append(false), out_delimiter(','), file_extension_out(dflt_extension_iCSV),
+        out_sessions() {
     parseInputSection();
     parseOutputSection();
 }
@@ -267,7 +274,7 @@ void iCSVIO::readMeteoData(const Date &start_date, const Date &end_date, std::ve
         std::vector<geoLocation> location_vec = current_file.getLocationsInData(start_date, end_date);
 
         std::vector<MeteoData> vecMeteo = createMeteoDataVector(current_file, date_vec, location_vec);
-        vecvecMeteo.push_back(vecMeteo);
+        vecvecMeteo[ii] = vecMeteo;
     }
 }
 
@@ -374,6 +381,10 @@ std::vector<MeteoData> iCSVIO::createMeteoDataVector(iCSVFile &current_file, std
 
     double nodata = current_file.getNoData();
 
+    StationData header_meta;
+    read_meta_data(current_file, header_meta);
+    const SharedStationData shared_meta(header_meta); //all timesteps share the same metadata unless the location is in the data
+
     MeteoData tmp_md(md);
     for (size_t d_idx = 0; d_idx < date_vec.size(); d_idx++) {
         tmp_md.reset();
@@ -381,7 +392,7 @@ std::vector<MeteoData> iCSVIO::createMeteoDataVector(iCSVFile &current_file, std
 
         tmp_md.setDate(date);
 
-        read_meta_data(current_file, tmp_md.meta);
+        tmp_md.meta = shared_meta;
         if (location_vec.size() == date_vec.size()) {
             setMeteoDataLocation(tmp_md, location_vec[d_idx], current_file, nodata);
         }
@@ -393,9 +404,11 @@ std::vector<MeteoData> iCSVIO::createMeteoDataVector(iCSVFile &current_file, std
 }
 
 void iCSVIO::setMeteoDataLocation(MeteoData &tmp_md, geoLocation &loc, iCSVFile &current_file, double nodata) {
-    tmp_md.meta.position.setPoint(IOUtils::standardizeNodata(loc.x, nodata), IOUtils::standardizeNodata(loc.y, nodata),
+    StationData meta(tmp_md.meta);
+    meta.position.setPoint(IOUtils::standardizeNodata(loc.x, nodata), IOUtils::standardizeNodata(loc.y, nodata),
                                     IOUtils::standardizeNodata(loc.z, nodata), current_file.METADATA.epsg); // TODO: what happens if alt=nodata?
-    tmp_md.meta.position.check("Inconsistent geographic coordinates in file \"" + current_file.filename + "\": ");
+    meta.position.check("Inconsistent geographic coordinates in file \"" + current_file.filename + "\": ");
+    tmp_md.meta = meta;
 }
 
 void iCSVIO::setMeteoDataFields(MeteoData &tmp_md, iCSVFile &current_file, Date &date, std::vector<size_t> &indexes, double nodata) {
@@ -504,27 +517,81 @@ void iCSVIO::identify_fields(const std::vector<std::string> &fields, std::vector
 // ---------------------------- iCSVIO write -----------------------------------
 
 void iCSVIO::writeMeteoData(const std::vector<std::vector<MeteoData>> &vecvecMeteo, const std::string &) {
+    out_sessions.clear();
     for (size_t ii = 0; ii < vecvecMeteo.size(); ii++) {
         if (vecvecMeteo[ii].empty())
             continue;
 
-        std::vector<MeteoData> vecMeteo = vecvecMeteo[ii];
-        iCSVFile outfile;
-        bool file_exists = createFilename(outfile, vecMeteo[0].meta, ii);
+        writeStation(vecvecMeteo[ii], ii, false);
+    }
+}
 
-        prepareOutfile(outfile, vecMeteo, file_exists);
-        outfile.aggregateData(vecMeteo);
+bool iCSVIO::canAppendMeteoData() {
+    // the ACDD metadata (time coverage, geometry) depends on the whole dataset
+    return !acdd_metadata.isEnabled();
+}
+
+void iCSVIO::appendMeteoData(const std::vector<std::vector<MeteoData>> &vecvecMeteo, const std::string &) {
+    if (!canAppendMeteoData())
+        throw InvalidArgumentException("The iCSV plugin can not write data by chunks when ACDD_WRITE is enabled", AT);
+
+    for (size_t ii = 0; ii < vecvecMeteo.size(); ii++) {
+        const std::vector<MeteoData> &vecMeteo = vecvecMeteo[ii];
+        if (vecMeteo.empty())
+            continue;
 
-        if (acdd_metadata.isEnabled()) {
-            acdd_metadata.setTimeCoverage(vecMeteo);
-            acdd_metadata.setGeometry(getUniqueLocations(outfile), true);
+        const std::map<size_t, iCSVFile>::iterator it( out_sessions.find(ii) );
+        if (it == out_sessions.end()) { // this station had no data so far
+            writeStation(vecMeteo, ii, false);
+            continue;
+        }
+
+        // the header can only be kept if the fields and the location in the header remain valid
+        iCSVFile &outfile = it->second;
+        const bool same_location = !outfile.location_in_header ||
+                                   (checkLocationConsistency(vecMeteo) && outfile.station_location == toiCSVLocation(vecMeteo[0].meta->position, outfile.METADATA.epsg));
+        if (!same_location || !outfile.columnsToAppend(vecMeteo).empty()) {
+            writeStation(vecMeteo, ii, true);
+            continue;
         }
 
-        writeToFile(outfile);
+        outfile.aggregateData(vecMeteo);
+        ofilestream file(outfile.filename, std::ios_base::out | std::ios_base::app);
+        if (!file.is_open()) {
+            throw IOException("Unable to open file " + outfile.filename, AT);
+        }
+        writeRows(file, outfile, true);
+        file.close();
+        outfile.clearData();
     }
 }
 
 // ----------------- iCSVIO write helper functions -----------------
+/**
+* @brief Writes the data of one station and keeps its header, in case more data would be appended later
+*
+* @param vecMeteo The vector of MeteoData containing the data to be written.
+* @param ii The index of the station.
+* @param append Should the data be appended to an already existing file, whatever iCSV_APPEND is?
+*/
+void iCSVIO::writeStation(const std::vector<MeteoData> &vecMeteo, const size_t &ii, const bool &append) {
+    iCSVFile outfile;
+    bool file_exists = createFilename(outfile, vecMeteo[0].meta, ii);
+
+    prepareOutfile(outfile, vecMeteo, file_exists, file_exists && (allow_append || append));
+    outfile.aggregateData(vecMeteo);
+
+    if (acdd_metadata.isEnabled()) {
+        acdd_metadata.setTimeCoverage(vecMeteo);
+        acdd_metadata.setGeometry(getUniqueLocations(outfile), true);
+    }
+
+    writeToFile(outfile);
+    outfile.clearData();
+    out_sessions.erase(ii);
+    out_sessions.insert(std::make_pair(ii, outfile));
+}
+
 /**
 * @brief Creates a filename for the iCSV file based on the given station data.
 *
@@ -556,9 +623,10 @@ bool iCSVIO::createFilename(iCSVFile &outfile, const StationData &station, size_
 * @param outfile The output file to be prepared.
 * @param vecMeteo The vector of MeteoData containing the data to be written.
 * @param file_exists A flag indicating whether the file already exists.
+* @param append A flag indicating whether the data should be appended to the existing file.
 */
-void iCSVIO::prepareOutfile(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo, bool file_exists) {
-    if (file_exists && allow_append) {
+void iCSVIO::prepareOutfile(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo, bool file_exists, bool append) {
+    if (append) {
         outfile.readFile(outfile.filename, false);
         outfile.parseGeometry();
     } else {
@@ -569,7 +637,7 @@ void iCSVIO::prepareOutfile(iCSVFile &outfile, const std::vector<MeteoData> &vec
     outfile.checkFormatValidity();
     outfile.checkMeteoIOCompatibility();
 
-    if (file_exists && allow_append) {
+    if (append) {
         handleFileAppend(outfile, vecMeteo);
     }
 }
@@ -583,9 +651,9 @@ void iCSVIO::handleNewFile(iCSVFile &outfile, const std::vector<MeteoData> &vecM
 }
 
 void iCSVIO::handleFileAppend(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo) {
-    if (outfile.location_in_header && outfile.station_location != toiCSVLocation(vecMeteo[0].meta.position, outfile.METADATA.epsg)) {
+    if (outfile.location_in_header && outfile.station_location != toiCSVLocation(vecMeteo[0].meta->position, outfile.METADATA.epsg)) {
         throw IOException("Inconsistent geographic coordinates between header and data in file \"" + outfile.filename + "\": " +
-                                outfile.station_location.toString() + " != " + toiCSVLocation(vecMeteo[0].meta.position, outfile.METADATA.epsg).toString(),
+                                outfile.station_location.toString() + " != " + toiCSVLocation(vecMeteo[0].meta->position, outfile.METADATA.epsg).toString(),
                             AT);
     }
     std::vector<std::string> columns_to_append = outfile.columnsToAppend(vecMeteo);
@@ -594,6 +662,7 @@ void iCSVIO::handleFileAppend(iCSVFile &outfile, const std::vector<MeteoData> &v
                     << joinVector(columns_to_append, outfile.METADATA.field_delimiter) << "\n";
         outfile.FIELDS.fields.insert(outfile.FIELDS.fields.end(), columns_to_append.begin(), columns_to_append.end());
     }
+    outfile.alignRowsToFields();
 }
 
 /**
@@ -613,7 +682,7 @@ void iCSVIO::createMetaDataSection(iCSVFile &outfile, const std::vector<MeteoDat
     outfile.METADATA.nodata = IOUtils::nodata;
     outfile.METADATA.field_delimiter = out_delimiter;
 
-    Coords loc = vecMeteo[0].meta.position;
+    Coords loc = vecMeteo[0].meta->position;
     loc.setProj(coordout, coordoutparam);
     int epsg = loc.getEPSG();
     outfile.METADATA.setEPSG(epsg);
@@ -629,7 +698,7 @@ void iCSVIO::createMetaDataSection(iCSVFile &outfile, const std::vector<MeteoDat
         outfile.METADATA.geometry = "geometry";
         outfile.FIELDS.fields.push_back("geometry");
     }
-    outfile.METADATA.optional_metadata = vecMeteo[0].meta.extra;
+    outfile.METADATA.optional_metadata = vecMeteo[0].meta->extra;
     outfile.findLocation();
 }
 
@@ -643,8 +712,8 @@ void iCSVIO::createFieldsSection(iCSVFile &outfile, const std::vector<MeteoData>
 
 bool iCSVIO::checkLocationConsistency(const std::vector<MeteoData> &vecMeteo) {
     for (size_t ii = 1; ii < vecMeteo.size(); ii++) {
-        const Coords &p1 = vecMeteo[ii - 1].meta.position;
-        const Coords &p2 = vecMeteo[ii].meta.position;
+        const Coords &p1 = vecMeteo[ii - 1].meta->position;
+        const Coords &p2 = vecMeteo[ii].meta->position;
         if (p1 != p2) {
             // we don't mind if p1==nodata or p2==nodata
             if (p1.isNodata() == false && p2.isNodata() == false)
@@ -698,6 +767,11 @@ void iCSVIO::writeToFile(const iCSVFile &outfile) {
         file << "# " << field.first << " = " << joinVector(field.second, outfile.METADATA.field_delimiter) << "\n";
     }
     file << "# [DATA]\n";
+    writeRows(file, outfile, false);
+    file.close();
+}
+
+void iCSVIO::writeRows(std::ostream &file, const iCSVFile &outfile, const bool &continued) {
     // timestamp and geometry will not be in row data
     size_t num_data_fields = outfile.FIELDS.fields.size() - 1;
     if (!outfile.location_in_header) {
@@ -707,11 +781,16 @@ void iCSVIO::writeToFile(const iCSVFile &outfile) {
     const auto& out_dates = outfile.getAllDatesInFile();
     const auto& out_locations = outfile.getAllLocationsInData();
     const double nodata = outfile.getNoData();
+    char date_buffer[Date::max_chars];
     for (size_t ii = 0; ii < outfile.getRowData().size(); ii++) {
+        if (ii > 0 || continued) { // there is no end of line after the last row
+            file << "\n";
+        }
         size_t data_idx = 0;
         for (size_t jj = 0; jj < outfile.FIELDS.fields.size(); jj++) {
             if (outfile.FIELDS.fields[jj] == "timestamp") {
-                file << out_dates[ii].toString(Date::ISO) << outfile.METADATA.field_delimiter;
+                file.write(date_buffer, static_cast<std::streamsize>(out_dates[ii].toChars(date_buffer, Date::ISO)));
+                file << outfile.METADATA.field_delimiter;
             } else if (outfile.FIELDS.fields[jj] == outfile.METADATA.geometry) {
                 file << getGeometry(out_locations[ii]) << outfile.METADATA.field_delimiter;
             } else {
@@ -726,11 +805,7 @@ void iCSVIO::writeToFile(const iCSVFile &outfile) {
                 }
             }
         }
-        if (ii != out_data.size() - 1) {
-            file << "\n";
-        }
     }
-    file.close();
 }
 
 } // namespace
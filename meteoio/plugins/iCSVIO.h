@@ -25,6 +25,8 @@
 #include <meteoio/plugins/iCSVHelper.h>
 #include <meteoio/plugins/libacdd.h>
 
+#include <map>
+#include <ostream>
 #include <vector>
 
 namespace mio {
@@ -52,6 +54,8 @@ namespace mio {
         virtual void readMeteoData(const Date &dateStart, const Date &dateEnd, std::vector<std::vector<MeteoData>> &vecMeteo);
 
         virtual void writeMeteoData(const std::vector<std::vector<MeteoData>> &vecMeteo, const std::string &name = "");
+        virtual bool canAppendMeteoData();
+        virtual void appendMeteoData(const std::vector<std::vector<MeteoData>> &vecMeteo, const std::string &name = "");
 
     private:
         // input section
@@ -71,6 +75,7 @@ namespace mio {
         bool allow_append;
         char out_delimiter;
         std::string file_extension_out;
+        std::map<size_t, iCSVFile> out_sessions; // header of the files written by the last writeMeteoData() call, per station index
 
 
         // constants
@@ -97,7 +102,8 @@ namespace mio {
         void setMeteoDataFields(MeteoData &tmp_md, iCSVFile &current_file, Date &date, std::vector<size_t> &indexes, double nodata);
 
         // write helpers
-        void prepareOutfile(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo, bool file_exists);
+        void writeStation(const std::vector<MeteoData> &vecMeteo, const size_t &ii, const bool &append);
+        void prepareOutfile(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo, bool file_exists, bool append);
         void handleNewFile(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo, bool file_exists);
         void handleFileAppend(iCSVFile &outfile, const std::vector<MeteoData> &vecMeteo);
 
@@ -107,6 +113,7 @@ namespace mio {
         void createMetaDataSection(iCSVFile &current_file, const std::vector<MeteoData> &vecMeteo);
         void createFieldsSection(iCSVFile &current_file, const std::vector<MeteoData> &vecMeteo);
         void writeToFile(const iCSVFile &outfile);
+        void writeRows(std::ostream &file, const iCSVFile &outfile, const bool &continued);
     };
 
 } // namespace
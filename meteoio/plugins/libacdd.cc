@@ -361,21 +361,21 @@ void ACDD::setGeometry(const std::vector< std::vector<mio::MeteoData> >& vecMete
 		//create the strings for the MultiPoint property
 		std::ostringstream ss;
 		if (isLatLon) {
-			ss  << std::fixed << std::setprecision(10) << "(" << timeseries.front().meta.position.getLon() << " " << timeseries.front().meta.position.getLat() << ")";
+			ss  << std::fixed << std::setprecision(10) << "(" << timeseries.front().meta->position.getLon() << " " << timeseries.front().meta->position.getLat() << ")";
 		} else {
-			ss  << std::fixed << std::setprecision(0) << "(" << timeseries.front().meta.position.getEasting() << " " << timeseries.front().meta.position.getNorthing() << ")";
+			ss  << std::fixed << std::setprecision(0) << "(" << timeseries.front().meta->position.getEasting() << " " << timeseries.front().meta->position.getNorthing() << ")";
 		}
 		if (epsg==-1) { //first valid point
-			epsg = (isLatLon)? 4326 : timeseries.front().meta.position.getEPSG();
+			epsg = (isLatLon)? 4326 : timeseries.front().meta->position.getEPSG();
 			multiPts = ss.str();
 		} else {
-			if (!isLatLon && epsg!=timeseries.front().meta.position.getEPSG()) epsg = 0; //we use 0 as a marker for non-consistent epsg between points
+			if (!isLatLon && epsg!=timeseries.front().meta->position.getEPSG()) epsg = 0; //we use 0 as a marker for non-consistent epsg between points
 			multiPts += ", "+ss.str();
 		}
 
-		const double curr_lat = timeseries.front().meta.position.getLat();
-		const double curr_lon = timeseries.front().meta.position.getLon();
-		const double curr_alt = timeseries.front().meta.position.getAltitude();
+		const double curr_lat = timeseries.front().meta->position.getLat();
+		const double curr_lon = timeseries.front().meta->position.getLon();
+		const double curr_alt = timeseries.front().meta->position.getAltitude();
 		found = true;
 		
 		if (lat_min>curr_lat) lat_min = curr_lat;
@@ -667,14 +667,18 @@ void SMETWriter::write(const std::vector<double>& data, const mio::ACDD& acdd)
 {
 	if (!SMETCommon::validFileAndPath(filename)) throw SMETException("Invalid file name \""+filename+"\"", AT);
 	errno = 0;
-	mio::ofilestream fout(filename.c_str(), ios::binary);
+	//as for timestamped data, the first write overwrites any previous content and the next ones append
+	const bool write_headers = !append_possible;
+	const ios_base::openmode mode_flags = (write_headers)? ios::binary : ios::binary | ofstream::app;
+	append_possible = true;
+	mio::ofilestream fout(filename.c_str(), mode_flags);
 	if (fout.fail()) {
 		std::ostringstream ss;
 		ss << "Error opening file \"" << filename << "\" for writing, possible reason: " << std::strerror(errno);
 		throw SMETException(ss.str(), SMET_AT);
 	}
 
-	write_header(fout, acdd); //Write the header info, always in ASCII format
+	if (write_headers) write_header(fout, acdd); //Write the header info, always in ASCII format
 
 	if (nr_of_fields == 0){
 		fout.close();
@@ -1544,6 +1548,11 @@ void SMETReader::read_data_binary(std::ifstream& fin, std::vector<double>& vec_d
 			}
 		}
 
+		if (fin.fail()) { //the end of file was reached while reading the record, so there was no record left
+			for (size_t ii=0; ii<nr_of_fields; ii++) vec_data.pop_back();
+			break;
+		}
+
 		if (julian_present && julian_interval){
 			if ( (linenr % streampos_every_n_lines)==0 && (tmp_fpointer != static_cast<streampos>(-1)) )
 				indexer.setIndex(julian, tmp_fpointer);
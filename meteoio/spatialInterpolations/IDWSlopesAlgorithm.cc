@@ -57,12 +57,12 @@ double IDWSlopesAlgorithm::getQualityRating(const Date& i_date)
 		const double val = vecMeteo[ii](param);
 		if (val==IOUtils::nodata) continue;
 
-		const double slope = vecMeteo[ii].meta.getSlopeAngle();
+		const double slope = vecMeteo[ii].meta->getSlopeAngle();
 		if (slope==IOUtils::nodata) continue;
 		
 		Slopes curr_slope = FLAT;
 		if (slope>min_slope) {
-			const double azimuth = vecMeteo[ii].meta.getAzimuth();
+			const double azimuth = vecMeteo[ii].meta->getAzimuth();
 			if (azimuth==IOUtils::nodata) continue;
 			
 			if (azimuth<45. || azimuth>315.) {
@@ -70,11 +70,12 @@ void ILWREpsAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 	Interpol2D::IDW(vecDataEA, vecMeta, dem, grid, scale, alpha); //the meta should NOT be used for elevations!
 	trend.retrend(dem, grid);
 
-	//Recompute ILWR from the interpolated ea
-	for (size_t ii=0; ii<grid.size(); ii++) {
-		double &value = grid(ii);
-		const double ta = ta_grid(ii);
-		if (value!=IOUtils::nodata && ta!=IOUtils::nodata) value = Atmosphere::blkBody_Radiation(value, ta);
+	//Recompute ILWR from the interpolated ea (where TA is nodata, the cell is left untouched)
+	const size_t nrCells = grid.size();
+	std::vector<double> ilwr( nrCells );
+	Atmosphere::blkBody_Radiation(grid.grid2D.data(), ta_grid.grid2D.data(), nrCells, ilwr.data());
+	for (size_t ii=0; ii<nrCells; ii++) {
+		if (ta_grid(ii)!=IOUtils::nodata) grid(ii) = ilwr[ii];
 	}
 }
 
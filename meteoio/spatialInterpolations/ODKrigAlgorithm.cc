@@ -59,7 +59,7 @@ std::vector< std::vector<double> > OrdinaryKrigingAlgorithm::getTimeSeries(const
 	//get the stations altitudes
 	std::vector<double> vecAltitudes;
 	for (size_t ii=0; ii<nrStations; ii++){
-		const double& alt = Meteo[ii].meta.position.getAltitude();
+		const double& alt = Meteo[ii].meta->position.getAltitude();
 		if (alt != IOUtils::nodata) {
 			vecAltitudes.push_back(alt);
 		}
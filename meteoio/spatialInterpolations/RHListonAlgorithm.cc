@@ -93,11 +93,7 @@ void RHListonAlgorithm::calculate(const DEMObject& dem, Grid2DObject& grid)
 	}
 
 	//Recompute Rh from the interpolated td
-	for (size_t ii=0; ii<grid.size(); ii++) {
-		double &value = grid(ii);
-		if (value!=IOUtils::nodata)
-			value = Atmosphere::DewPointtoRh(value, ta(ii), 1);
-	}
+	Atmosphere::DewPointtoRh(grid.grid2D.data(), ta.grid2D.data(), grid.size(), true, grid.grid2D.data());
 }
 
 } //namespace
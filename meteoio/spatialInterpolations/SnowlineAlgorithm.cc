@@ -175,37 +175,22 @@ void SnowlineAlgorithm::assimilateBands(const double& snowline, const DEMObject&
 
 void SnowlineAlgorithm::assimilateFormula(const double& snowline, const DEMObject& dem, Grid2DObject& grid)
 { //set to result of formula evaluated at grid points
-	std::vector< std::pair<std::string, double> > substitutions; //fixed memory for tinyexpr
-
-	static const size_t nr_sub = 3;
-	static const std::string sub[nr_sub] = {"snowline", "altitude", "param"};
-	for (size_t ii = 0; ii < nr_sub; ++ii) {
-		std::pair<std::string, double> item(sub[ii], IOUtils::nodata);
-		substitutions.push_back(item);
+	static const std::vector<std::string> sub = {"snowline", "altitude", "param"};
+	Expression expr_formula(formula_, sub, where_); //compiled once for the whole grid
+	expr_formula.setVariable(0, snowline); //this is the same for all points
+
+	//evaluate the whole grid at once, the altitudes and parameter values being read from the grids
+	const size_t nr_cells = grid.size();
+	std::vector<double> results( nr_cells );
+	const std::vector<const double*> columns = {nullptr, dem.grid2D.data(), grid.grid2D.data()};
+	expr_formula.evaluate(columns, nr_cells, &results[0]);
+
+	for (size_t ii = 0; ii < nr_cells; ++ii) {
+		const double altitude = dem(ii);
+		if (altitude == IOUtils::nodata)
+			continue;
+		grid(ii) = (altitude < snowline)? cutoff_val_ : results[ii];
 	}
-	substitutions[0].second = snowline; //this is the same for all points
-
-	te_variable *te_vars = new te_variable[substitutions.size()];
-	initExpressionVars(substitutions, te_vars); //build te_variables from substitution vector
-	te_expr *expr_formula = compileExpression(formula_, te_vars, nr_sub);
-
-	for (size_t ii = 0; ii < grid.getNx(); ++ii) {
-		for (size_t jj = 0; jj < grid.getNy(); ++jj) {
-			if (dem(ii, jj) == IOUtils::nodata)
-				continue;
-			if (dem(ii, jj) < snowline) {
-				grid(ii, jj) = cutoff_val_;
-				continue;
-			}
-
-			substitutions[1].second = dem(ii, jj); //point-dependent substitutions
-			substitutions[2].second = grid(ii, jj);
-			grid(ii, jj) = te_eval(expr_formula);
-		}
-	}
-
-	te_free(expr_formula);
-	delete[] te_vars;
 }
 
 Grid2DObject SnowlineAlgorithm::mergeSlopes(const DEMObject& dem, const std::vector<Grid2DObject>& azi_grids)
@@ -248,29 +233,6 @@ Grid2DObject SnowlineAlgorithm::mergeSlopes(const DEMObject& dem, const std::vec
 	return outgrid;
 }
 
-void SnowlineAlgorithm::initExpressionVars(const std::vector< std::pair<std::string, double> >& substitutions, te_variable* vars) const
-{ //build a substitutions expression for tinyexpr
-	size_t cc = 0;
-	for (std::vector< std::pair<std::string, double> >::const_iterator it = substitutions.begin();
-	    it != substitutions.end(); ++it) {
-		vars[cc].name = it->first.c_str();
-		vars[cc].address = &it->second;
-		vars[cc].type = 0;
-		vars[cc].context = nullptr;
-		cc++;
-	}
-}
-
-te_expr* SnowlineAlgorithm::compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const
-{ //ready the lazy expressions (with syntax check)
-	int te_err;
-	te_expr *expr = te_compile(expression.c_str(), te_vars, static_cast<int>(sz), &te_err);
-	if (!expr)
-		throw InvalidFormatException("Arithmetic expression \"" + expression +
-		        "\" could not be evaluated for " + where_ + "; parse error at " + IOUtils::toString(te_err), AT);
-	return expr;
-}
-
 /**
  * @brief Read in snowline elevation information from a textfile.
  * @details Example file:
@@ -22,7 +22,7 @@
 
 #include <meteoio/spatialInterpolations/InterpolationAlgorithms.h>
 
-#include <meteoio/thirdParty/tinyexpr.h>
+#include <meteoio/Expression.h>
 #include <string>
 #include <utility>
 #include <vector>
@@ -127,8 +127,6 @@ class SnowlineAlgorithm : public InterpolationAlgorithm {
 		void assimilateBands(const double& snowline, const DEMObject& dem, Grid2DObject& grid);
 		void assimilateFormula(const double& snowline, const DEMObject& dem, Grid2DObject& grid);
 		Grid2DObject mergeSlopes(const DEMObject& dem, const std::vector<Grid2DObject>& azi_grids);
-		void initExpressionVars(const std::vector< std::pair<std::string, double> >& substitutions, te_variable* vars) const;
-		te_expr* compileExpression(const std::string& expression, const te_variable* te_vars, const size_t& sz) const;
 		std::vector<aspect> readSnowlineFile();
 		void getSnowlines();
 		double probeTrend();
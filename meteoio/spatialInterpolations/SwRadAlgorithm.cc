@@ -55,7 +55,7 @@ double SWRadInterpolation::getQualityRating(const Date& i_date)
 	//fill vecIdx with the indices of the stations that can be used and set the Sun coordinates to the middle of the stations
 	double avg_lat = 0., avg_lon = 0., avg_alt = 0.;
 	for(size_t ii=0; ii<vecMeteo.size(); ii++) {
-		const Coords &location( vecMeteo[ii].meta.position );
+		const Coords &location( vecMeteo[ii].meta->position );
 		const bool has_meta = (location.getLat()!=IOUtils::nodata) && (location.getLon()!=IOUtils::nodata) && (location.getAltitude()!=IOUtils::nodata);
 		const bool has_meteo = (vecMeteo[ii](MeteoData::ISWR)!=IOUtils::nodata)
 		                                  && (vecMeteo[ii](MeteoData::TA)!=IOUtils::nodata)
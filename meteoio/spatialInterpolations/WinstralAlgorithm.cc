@@ -110,7 +110,7 @@ bool WinstralAlgorithm::windIsAvailable(const std::vector<MeteoData>& i_vecMeteo
 
 double WinstralAlgorithm::getSynopticBearing(const std::vector<MeteoData>& i_vecMeteo, const std::string& i_ref_station)
 {
-	const std::vector<MeteoData>::const_iterator it = std::find_if(i_vecMeteo.begin(), i_vecMeteo.end(), [&](const MeteoData& md){ return md.meta.stationID == i_ref_station; });
+	const std::vector<MeteoData>::const_iterator it = std::find_if(i_vecMeteo.begin(), i_vecMeteo.end(), [&](const MeteoData& md){ return md.meta->stationID == i_ref_station; });
 	
 	if (it!=i_vecMeteo.end())
 		return it->operator()(MeteoData::DW);
@@ -195,7 +195,7 @@ double WinstralAlgorithm::getSynopticBearing(const DEMObject& dem, const std::ve
 
 	std::vector<MeteoData> stationsSubset;
 	for (const auto& md : i_vecMeteo) {
-		if (isExposed(dem, md.meta.position))
+		if (isExposed(dem, md.meta->position))
 			stationsSubset.push_back( md );
 	}
 
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const std::string model_store( "./arima_resampling_models.txt" );
+static const double time_zone = 1.;
+static const Date data_start(2021, 3, 1, 0, 0, time_zone);
+static const size_t nr_steps = 10*24, gap_start = 5*24, gap_length = 6; //hourly data with a 6 hours gap
+
+//hourly temperatures with a daily cycle, the points following gap_start are missing
+static std::vector<MeteoData> build_series(const StationData& sd)
+{
+	std::vector<MeteoData> vecMeteo;
+	for (size_t ii=0; ii<nr_steps; ii++) {
+		if (ii>gap_start && ii<gap_start+gap_length) continue;
+		MeteoData md(data_start + static_cast<double>(ii)/24., sd);
+		const double t = static_cast<double>(ii);
+		md(MeteoData::TA) = 270. + 5.*sin(2.*Cst::PI*t/24.) + 0.5*sin(0.7*t) + 0.002*static_cast<double>((ii*7919)%100);
+		vecMeteo.push_back( md );
+	}
+	return vecMeteo;
+}
+
+static Config build_config(const bool& parallel)
+{
+	Config cfg;
+	cfg.addKey("TIME_ZONE", "Input", IOUtils::toString(time_zone));
+	cfg.addKey("WINDOW_SIZE", "Interpolations1D", "432000");
+	cfg.addKey("TA::RESAMPLE1", "Interpolations1D", "ARIMA");
+	cfg.addKey("TA::ARIMA::BEFORE_WINDOW", "Interpolations1D", "172800");
+	cfg.addKey("TA::ARIMA::AFTER_WINDOW", "Interpolations1D", "172800");
+	cfg.addKey("TA::ARIMA::VERBOSE", "Interpolations1D", "false");
+	cfg.addKey("TA::ARIMA::NORMALIZATION", "Interpolations1D", "NOTHING"); //the normalization bounds would include the nodata of the gap
+	cfg.addKey("TA::ARIMA::PARALLEL", "Interpolations1D", (parallel)? "true" : "false");
+	cfg.addKey("TA::ARIMA::MODEL_STORE", "Interpolations1D", model_store);
+	return cfg;
+}
+
+//resample TA at the given offsets (in hours) from the start of the gap
+static std::vector<double> fill_gap(Meteo1DInterpolator& interpolator, const StationData& sd, const std::vector<MeteoData>& vecM, const std::vector<double>& offsets)
+{
+	std::vector<double> results;
+	for (const double offset : offsets) {
+		MeteoData md;
+		interpolator.resampleData(data_start + (static_cast<double>(gap_start) + offset)/24., sd.getHash(), vecM, md);
+		results.push_back( md(MeteoData::TA) );
+	}
+	return results;
+}
+
+static std::string read_file(const std::string& filename)
+{
+	std::ifstream fin( filename.c_str() );
+	std::ostringstream ss;
+	ss << fin.rdbuf();
+	return ss.str();
+}
+
+int main() {
+	const StationData sd(Coords("CH1903", ""), "STA", "Station");
+	const std::vector<MeteoData> vecM( build_series(sd) );
+	std::remove( model_store.c_str() );
+	bool status = true;
+
+	//the gap is fitted once, then the points in between its timesteps are linearly interpolated from the cached gap
+	Meteo1DInterpolator interpolator( build_config(false) );
+	const std::vector<double> hours{1., 2., 3., 4., 5.}, half_hours{1.5, 2.5, 3.5, 4.5};
+	const std::vector<double> filled( fill_gap(interpolator, sd, vecM, hours) );
+	for (const double value : filled) {
+		if (value==IOUtils::nodata) {
+			cerr << "The gap has not been filled\n";
+			status = false;
+		}
+	}
+	const std::vector<double> interpolated( fill_gap(interpolator, sd, vecM, half_hours) );
+	for (size_t ii=0; ii<interpolated.size(); ii++) {
+		if (std::abs(interpolated[ii] - .5*(filled[ii] + filled[ii+1])) > 1e-6) {
+			cerr << "Wrong interpolation within the gap at +" << half_hours[ii] << "h: " << interpolated[ii] << " instead of " << .5*(filled[ii] + filled[ii+1]) << "\n";
+			status = false;
+		}
+	}
+	status &= (fill_gap(interpolator, sd, vecM, hours)==filled); //filling the same gap again only reads the cache
+	cout << "Gap cache: " << ((status)? "success" : "failed") << "\n";
+
+	//the selected orders are stored for both sides of the gap, then reused as the starting point of the next run
+	bool store_status = true;
+	const std::string stored( read_file(model_store) );
+	store_status &= (stored.find("\nTA before ")!=std::string::npos && stored.find("\nTA after ")!=std::string::npos);
+	store_status &= (stored.find(sd.getHash())!=std::string::npos);
+	Meteo1DInterpolator next_run( build_config(true) );
+	const std::vector<double> refilled( fill_gap(next_run, sd, vecM, hours) );
+	for (size_t ii=0; ii<refilled.size(); ii++) {
+		if (std::abs(refilled[ii] - filled[ii]) > 1e-6) {
+			cerr << "The stored models gave " << refilled[ii] << " instead of " << filled[ii] << " at +" << hours[ii] << "h\n";
+			store_status = false;
+		}
+	}
+	store_status &= (read_file(model_store)==stored);
+	cout << "Model store: " << ((store_status)? "success" : "failed") << "\n";
+
+	std::remove( model_store.c_str() );
+	if (!status || !store_status)
+		throw IOException("ARIMA resampling error!", AT);
+
+	return 0;
+}
@@ -202,6 +202,33 @@ static bool matrix(const size_t& n) {
 		status=false;
 	}
 
+	Matrix spd = m1*m1.getT() + I; //symmetric positive definite
+	const Matrix spd_orig = spd;
+	Matrix X = m1;
+	if(Matrix::LLT_solve(spd, X)==false || spd_orig*X != m1) {
+		cout << "\terror when solving A*X=B for a positive definite A\n";
+		status=false;
+	}
+	Matrix indefinite = I;
+	indefinite(n, n) = -1.;
+	X = m1;
+	if(Matrix::LLT_solve(indefinite, X)==true || X != m1) {
+		cout << "\terror: a matrix that is not positive definite has been accepted\n";
+		status=false;
+	}
+	indefinite = I;
+	indefinite(n, n) = -1.;
+	if(Matrix::solve_into(indefinite, m1, X)==false || indefinite*X != m1) { //the fallback for non positive definite matrices
+		cout << "\terror when solving A*X=B for an indefinite A\n";
+		status=false;
+	}
+	Matrix singular(n, n, 1.); //only ones
+	X = m1;
+	if(Matrix::LLT_solve(singular, X)==true) {
+		cout << "\terror: a singular matrix has been accepted\n";
+		status=false;
+	}
+
 	return status;
 }
 
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cmath>
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const double rel_tolerance = 1e-13;
+
+//input values, covering the ice/water transition (between -16°C and 0°C) and with some nodata
+struct Inputs {
+	Inputs() : TA(), RH(), TD(), alt(), qi(), cld(), lwr(), ea() {
+		for (double ta=IOUtils::C_TO_K(-35.); ta<IOUtils::C_TO_K(35.); ta+=0.37) {
+			for (double rh=0.02; rh<=1.; rh+=0.07) {
+				TA.push_back( ta );
+				RH.push_back( rh );
+				TD.push_back( ta - 25.*(1.-rh) );
+				alt.push_back( 4000.*rh );
+				qi.push_back( 0.01*rh );
+				cld.push_back( 1.-rh );
+				lwr.push_back( 150.+150.*rh );
+				ea.push_back( 0.6+0.4*rh );
+			}
+		}
+		//the exact phase boundaries
+		const double bounds[] = {0., -16., IOUtils::K_TO_C(Cst::t_water_triple_pt)};
+		for (const double& bound : bounds) {
+			TA.push_back( IOUtils::C_TO_K(bound) ); RH.push_back( 0.5 ); TD.push_back( IOUtils::C_TO_K(bound)-5. );
+			alt.push_back( 1500. ); qi.push_back( 0.003 ); cld.push_back( 0.5 ); lwr.push_back( 250. ); ea.push_back( 0.8 );
+		}
+
+		//nodata in each input
+		for (size_t ii=0; ii<TA.size(); ii+=11) {
+			std::vector<double>* vec[] = {&TA, &RH, &TD, &alt, &qi, &cld, &lwr, &ea};
+			vec[ (ii/11) % 8 ]->at(ii) = IOUtils::nodata;
+		}
+	}
+
+	std::vector<double> TA, RH, TD, alt, qi, cld, lwr, ea;
+};
+
+//compare one array result with the scalar version, nodata inputs must give nodata
+static bool compare(const std::string& name, const std::vector<double>& array_result, const std::vector<double>& scalar_result, const std::vector<bool>& has_nodata)
+{
+	for (size_t ii=0; ii<array_result.size(); ii++) {
+		if (has_nodata[ii]) {
+			if (array_result[ii]==IOUtils::nodata) continue;
+			cerr << name << "[" << ii << "]: got " << array_result[ii] << " instead of nodata\n";
+			return false;
+		}
+		const double ref = scalar_result[ii];
+		if (std::abs(array_result[ii]-ref) > rel_tolerance*std::max(1., std::abs(ref))) {
+			cerr << name << "[" << ii << "]: got " << array_result[ii] << " instead of " << ref << "\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+static std::vector<bool> nodata_mask(const std::vector<double>& in1, const std::vector<double>& in2=std::vector<double>(), const std::vector<double>& in3=std::vector<double>())
+{
+	std::vector<bool> mask( in1.size(), false );
+	for (size_t ii=0; ii<in1.size(); ii++) {
+		mask[ii] = (in1[ii]==IOUtils::nodata) || (!in2.empty() && in2[ii]==IOUtils::nodata) || (!in3.empty() && in3[ii]==IOUtils::nodata);
+	}
+	return mask;
+}
+
+typedef double (*scalarLaw1)(const double&);
+typedef double (*scalarLaw2)(const double&, const double&);
+typedef double (*scalarLaw3)(const double&, const double&, const double&);
+typedef void (*arrayLaw1)(const double*, const size_t&, double*);
+typedef void (*arrayLaw2)(const double*, const double*, const size_t&, double*);
+typedef void (*arrayLaw3)(const double*, const double*, const double*, const size_t&, double*);
+
+static bool check_law(const std::string& name, scalarLaw1 scalar, arrayLaw1 array, const std::vector<double>& in1)
+{
+	const size_t n = in1.size();
+	const std::vector<bool> mask( nodata_mask(in1) );
+	std::vector<double> ref( n ), res( n );
+	for (size_t ii=0; ii<n; ii++) if (!mask[ii]) ref[ii] = scalar( in1[ii] );
+	array(&in1[0], n, &res[0]);
+	return compare(name, res, ref, mask);
+}
+
+static bool check_law(const std::string& name, scalarLaw2 scalar, arrayLaw2 array, const std::vector<double>& in1, const std::vector<double>& in2)
+{
+	const size_t n = in1.size();
+	const std::vector<bool> mask( nodata_mask(in1, in2) );
+	std::vector<double> ref( n ), res( n );
+	for (size_t ii=0; ii<n; ii++) if (!mask[ii]) ref[ii] = scalar(in1[ii], in2[ii]);
+	array(&in1[0], &in2[0], n, &res[0]);
+	return compare(name, res, ref, mask);
+}
+
+static bool check_law(const std::string& name, scalarLaw3 scalar, arrayLaw3 array, const std::vector<double>& in1, const std::vector<double>& in2, const std::vector<double>& in3)
+{
+	const size_t n = in1.size();
+	const std::vector<bool> mask( nodata_mask(in1, in2, in3) );
+	std::vector<double> ref( n ), res( n );
+	for (size_t ii=0; ii<n; ii++) if (!mask[ii]) ref[ii] = scalar(in1[ii], in2[ii], in3[ii]);
+	array(&in1[0], &in2[0], &in3[0], n, &res[0]);
+	return compare(name, res, ref, mask);
+}
+
+static bool check_basic_laws(const Inputs& in)
+{
+	bool status = true;
+	status &= check_law("stdAirPressure", &Atmosphere::stdAirPressure, &Atmosphere::stdAirPressure, in.alt);
+	status &= check_law("vaporSaturationPressure", &Atmosphere::vaporSaturationPressure, &Atmosphere::vaporSaturationPressure, in.TA);
+	status &= check_law("vaporSaturationPressureWater", &Atmosphere::vaporSaturationPressureWater, &Atmosphere::vaporSaturationPressureWater, in.TA);
+	status &= check_law("specToRelHumidity", &Atmosphere::specToRelHumidity, &Atmosphere::specToRelHumidity, in.alt, in.TA, in.qi);
+	status &= check_law("blkBody_Emissivity", &Atmosphere::blkBody_Emissivity, &Atmosphere::blkBody_Emissivity, in.lwr, in.TA);
+	status &= check_law("blkBody_Radiation", &Atmosphere::blkBody_Radiation, &Atmosphere::blkBody_Radiation, in.ea, in.TA);
+
+	cout << "Basic laws: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_dew_point(const Inputs& in)
+{
+	const size_t n = in.TA.size();
+	const std::vector<bool> mask( nodata_mask(in.RH, in.TA) ), mask_td( nodata_mask(in.TD, in.TA) );
+	bool status = true;
+	for (const bool force_water : {false, true}) {
+		std::vector<double> ref( n ), res( n );
+		for (size_t ii=0; ii<n; ii++) if (!mask[ii]) ref[ii] = Atmosphere::RhtoDewPoint(in.RH[ii], in.TA[ii], force_water);
+		Atmosphere::RhtoDewPoint(&in.RH[0], &in.TA[0], n, force_water, &res[0]);
+		status &= compare((force_water)? "RhtoDewPoint over water" : "RhtoDewPoint", res, ref, mask);
+
+		for (size_t ii=0; ii<n; ii++) if (!mask_td[ii]) ref[ii] = Atmosphere::DewPointtoRh(in.TD[ii], in.TA[ii], force_water);
+		Atmosphere::DewPointtoRh(&in.TD[0], &in.TA[0], n, force_water, &res[0]);
+		status &= compare((force_water)? "DewPointtoRh over water" : "DewPointtoRh", res, ref, mask_td);
+	}
+
+	//in place computation
+	std::vector<double> data( in.RH );
+	Atmosphere::RhtoDewPoint(&data[0], &in.TA[0], n, false, &data[0]);
+	Atmosphere::DewPointtoRh(&data[0], &in.TA[0], n, false, &data[0]);
+	for (size_t ii=0; ii<n; ii++) {
+		if (mask[ii]) continue;
+		const double ref = Atmosphere::DewPointtoRh(Atmosphere::RhtoDewPoint(in.RH[ii], in.TA[ii], false), in.TA[ii], false);
+		if (std::abs(data[ii]-ref) > rel_tolerance) {
+			cerr << "In place dew point round trip[" << ii << "]: got " << data[ii] << " instead of " << ref << "\n";
+			status = false;
+			break;
+		}
+	}
+
+	cout << "Dew point: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_ilwr(const Inputs& in)
+{
+	bool status = true;
+	status &= check_law("Brutsaert_ilwr", &Atmosphere::Brutsaert_ilwr, &Atmosphere::Brutsaert_ilwr, in.RH, in.TA);
+	status &= check_law("Dilley_ilwr", &Atmosphere::Dilley_ilwr, &Atmosphere::Dilley_ilwr, in.RH, in.TA);
+	status &= check_law("Prata_ilwr", &Atmosphere::Prata_ilwr, &Atmosphere::Prata_ilwr, in.RH, in.TA);
+	status &= check_law("Clark_ilwr", &Atmosphere::Clark_ilwr, &Atmosphere::Clark_ilwr, in.RH, in.TA);
+	status &= check_law("Tang_ilwr", &Atmosphere::Tang_ilwr, &Atmosphere::Tang_ilwr, in.RH, in.TA);
+	status &= check_law("Idso_ilwr", &Atmosphere::Idso_ilwr, &Atmosphere::Idso_ilwr, in.RH, in.TA);
+	status &= check_law("Omstedt_ilwr", &Atmosphere::Omstedt_ilwr, &Atmosphere::Omstedt_ilwr, in.RH, in.TA, in.cld);
+	status &= check_law("Konzelmann_ilwr", &Atmosphere::Konzelmann_ilwr, &Atmosphere::Konzelmann_ilwr, in.RH, in.TA, in.cld);
+	status &= check_law("Carmona_ilwr", &Atmosphere::Carmona_ilwr, &Atmosphere::Carmona_ilwr, in.RH, in.TA, in.cld);
+
+	cout << "ILWR parametrizations: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const Inputs inputs;
+	const bool basic_status = check_basic_laws(inputs);
+	const bool dew_point_status = check_dew_point(inputs);
+	const bool ilwr_status = check_ilwr(inputs);
+
+	if (!basic_status || !dew_point_status || !ilwr_status)
+		throw IOException("The array versions of the atmospheric laws differ from the scalar versions!", AT);
+
+	return 0;
+}
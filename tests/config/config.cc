@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static Config build_config()
+{
+	Config cfg;
+	cfg.addKey("STATION1", "Input", "STA1");
+	cfg.addKey("STATION2", "Input", "STA2");
+	cfg.addKey("STATION10", "Input", "STA10");
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("STATION1", "InputEditing", "EDIT1");
+	cfg.addKey("STA1::EDIT1", "InputEditing", "EXCLUDE");
+	cfg.addKey("HEIGHT", "General", "2.5");
+	cfg.addKey("ENABLE", "General", "true");
+	cfg.addKey("LIST", "General", "1 2 3");
+	cfg.addKey("WRONG", "General", "abc");
+	return cfg;
+}
+
+static bool check_values()
+{
+	bool status = true;
+	const Config cfg( build_config() );
+
+	double height = 0.;
+	cfg.getValue("height", "general", height);
+	status &= (height==2.5);
+	bool enable = false;
+	cfg.getValue("ENABLE", "GENERAL", enable);
+	status &= enable;
+	std::vector<int> vecList;
+	cfg.getValue("LIST", "General", vecList);
+	status &= (vecList.size()==3 && vecList[2]==3);
+
+	//missing keys and conversion failures are reported as UnknownValueException, unless nothrow has been requested
+	double value = 1.;
+	cfg.getValue("MISSING", "General", value, IOUtils::nothrow);
+	status &= (value==1.);
+	cfg.getValue("WRONG", "General", value, IOUtils::nothrow);
+	for (const std::string key : {"MISSING", "WRONG"}) {
+		try {
+			cfg.getValue(key, "General", value);
+			status = false;
+		} catch (const UnknownValueException&) {}
+		try {
+			cfg.getValue(key, "General", vecList);
+			status = false;
+		} catch (const UnknownValueException&) {}
+	}
+
+	cout << "Values: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//the keys of INPUTEDITING must never be mistaken for keys of INPUT
+static bool check_sections()
+{
+	bool status = true;
+	Config cfg( build_config() );
+
+	const std::vector<std::string> vecStations( cfg.getKeys("STATION", "Input") );
+	status &= (vecStations==std::vector<std::string>({"STATION1", "STATION2", "STATION10"}));
+	std::vector<std::string> vecIDs;
+	cfg.getValues("STATION", "INPUT", vecIDs);
+	status &= (vecIDs==std::vector<std::string>({"STA1", "STA2", "STA10"}));
+	status &= (cfg.getValues("", "Input").size()==4);
+	status &= (cfg.getKeys("EDIT", "Input", true).empty());
+	status &= (cfg.getKeys("STATION", "InputEditing")==std::vector<std::string>({"STATION1"}));
+
+	cfg.deleteKeys("STATION", "Input");
+	status &= (cfg.getKeys("STATION", "Input").empty());
+	status &= cfg.keyExists("COORDSYS", "Input");
+	status &= cfg.keyExists("STATION1", "InputEditing");
+	status &= cfg.keyExists("STA1::EDIT1", "InputEditing");
+
+	cout << "Sections: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_move()
+{
+	bool status = true;
+	for (const bool overwrite : {false, true}) {
+		Config cfg( build_config() );
+		cfg.moveSection("Input", "INPUT", overwrite); //moving a section onto itself must leave it unchanged
+		status &= (cfg.getValues("", "Input").size()==4);
+		status &= (cfg.get("STATION10", "Input", std::string())=="STA10");
+	}
+
+	Config cfg( build_config() );
+	cfg.addKey("COORDSYS", "Output", "UTM");
+	cfg.addKey("METEO", "Output", "SMET");
+	cfg.moveSection("Input", "Output", true);
+	status &= (cfg.getValues("", "Input").empty());
+	status &= (cfg.getValues("", "Output").size()==4);
+	status &= (cfg.get("COORDSYS", "Output", std::string())=="CH1903" && !cfg.keyExists("METEO", "Output"));
+	status &= (cfg.getValues("", "InputEditing").size()==2);
+
+	cout << "Move sections: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//the compiled regexes are cached, so successive calls with different regexes must not return the same matches
+static bool check_regex()
+{
+	bool status = true;
+	const Config cfg( build_config() );
+
+	for (size_t ii=0; ii<2; ii++) {
+		const std::vector< std::pair<std::string, std::string> > vecStations( cfg.getValuesRegex("STATION[0-9]+", "Input") );
+		status &= (vecStations.size()==3 && vecStations.back().first=="STATION10" && vecStations.back().second=="STA10");
+		const std::vector< std::pair<std::string, std::string> > vecCoords( cfg.getValuesRegex("COORD.*", "Input") );
+		status &= (vecCoords.size()==1 && vecCoords.front().second=="CH1903");
+		status &= (cfg.getKeysRegex("STATION1", "Input")==std::vector<std::string>({"STATION1"}));
+		status &= (cfg.getKeysRegex(".*EDIT.*", "InputEditing")==std::vector<std::string>({"STA1::EDIT1"}));
+	}
+
+	cout << "Regex: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool values_status = check_values();
+	const bool sections_status = check_sections();
+	const bool move_status = check_move();
+	const bool regex_status = check_regex();
+
+	if (!values_status || !sections_status || !move_status || !regex_status)
+		throw IOException("Config error!", AT);
+
+	return 0;
+}
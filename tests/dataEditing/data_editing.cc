@@ -19,11 +19,13 @@
     along with MeteoIO.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <iostream>
+#include <sstream>
 #include <cstdio>
 #include <string.h>
 #include <map>
 #include <vector>
 #include <meteoio/MeteoIO.h>
+#include <meteoio/DataEditingAlgorithms.h>
 
 using namespace mio; //The MeteoIO namespace is called mio
 
@@ -52,7 +54,7 @@ static std::vector< std::vector<MeteoData> > read_data(const std::string& io_fil
 		io.getMeteoData(d, Meteo); //read 1 timestep at once, forcing resampling to the timestep
 		for(size_t ii=0; ii<Meteo.size(); ii++) { //loop over all stations
 			if (Meteo[ii].isNodata()) continue;
-			const std::string stationID( Meteo[ii].meta.stationID );
+			const std::string stationID( Meteo[ii].meta.getStationID() );
 			if (mapIDs.count( stationID )==0) { //if this is the first time we encounter this station, save where it should be inserted
 				mapIDs[ stationID ] = insert_position++;
 				vecMeteo.push_back( std::vector<MeteoData>() ); //allocating the new station
@@ -151,6 +153,102 @@ static bool compare_data(const std::vector< std::vector<MeteoData> > &ref, const
 	return false;
 }
 
+static std::vector<MeteoData> build_fragment(const std::string& stationID, const size_t& first_hour, const size_t& last_hour, const size_t& step, const size_t& param, const double& value, const bool& add_hour)
+{
+	Coords loc("CH1903", "");
+	loc.setXY(780000., 189000., 2540.);
+	const StationData sd(loc, stationID, "Fragment "+stationID);
+	const Date start(2020, 1, 1, 0, 0, 1.);
+
+	std::vector<MeteoData> vecMeteo;
+	for (size_t hour=first_hour; hour<=last_hour; hour+=step) {
+		MeteoData md(start + static_cast<double>(hour)/24., sd);
+		md(param) = (add_hour)? value + static_cast<double>(hour) : value;
+		vecMeteo.push_back( md );
+	}
+	return vecMeteo;
+}
+
+//merge interleaved and overlapping fragments whose IDs only differ by their case, return the reported conflicts
+static std::string automerge(const std::string& conflicts, std::vector< std::vector<MeteoData> >& vecMeteo)
+{
+	vecMeteo.clear();
+	vecMeteo.push_back( build_fragment("STA", 0, 20, 2, MeteoData::TA, 270., true) );
+	vecMeteo.push_back( build_fragment("OTHER", 0, 5, 1, MeteoData::TA, 250., false) );
+	vecMeteo.push_back( build_fragment("sta", 1, 21, 2, MeteoData::TA, 270., true) );
+	vecMeteo.push_back( std::vector<MeteoData>() );
+	vecMeteo.push_back( build_fragment("Sta", 10, 14, 1, MeteoData::TA, 300., false) );
+	vecMeteo.push_back( build_fragment("other", 3, 8, 1, MeteoData::TA, 250., false) );
+	vecMeteo.back()[2](MeteoData::TA) = 251.;
+	vecMeteo.push_back( build_fragment("sTa", 0, 3, 1, MeteoData::RH, 0.5, false) );
+
+	std::vector< std::pair<std::string, std::string> > vecArgs;
+	if (!conflicts.empty()) vecArgs.push_back( std::make_pair("MERGE_CONFLICTS", conflicts) );
+	Config cfg;
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	EditingBlock *block = EditingBlockFactory::getBlock("*", vecArgs, "AUTOMERGE", cfg);
+
+	std::ostringstream messages;
+	std::streambuf *cerr_buf = std::cerr.rdbuf( messages.rdbuf() );
+	block->editTimeSeries( vecMeteo );
+	std::cerr.rdbuf( cerr_buf );
+	delete block;
+
+	return messages.str();
+}
+
+static bool check_automerge_station(const std::vector<MeteoData>& vecMeteo, const std::string& stationID, const size_t& nr_hours, const std::vector<double>& TA, const std::vector<double>& RH)
+{
+	if (vecMeteo.size()!=nr_hours || vecMeteo.front().getStationID()!=stationID) return false;
+
+	const Date start(2020, 1, 1, 0, 0, 1.);
+	for (size_t hour=0; hour<nr_hours; hour++) {
+		const MeteoData& md = vecMeteo[hour];
+		if (md.date!=start + static_cast<double>(hour)/24.) return false;
+		if (md(MeteoData::TA)!=TA[hour] || md(MeteoData::RH)!=RH[hour]) {
+			std::cout << "AutoMerge: wrong values for " << stationID << " at " << md.date.toString(Date::ISO) << ": TA=" << md(MeteoData::TA) << " RH=" << md(MeteoData::RH) << "\n";
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool check_automerge()
+{
+	bool status = true;
+	std::vector<double> TA_sta(22), RH_sta(22, IOUtils::nodata), TA_other(9, 250.);
+	for (size_t hour=0; hour<22; hour++) TA_sta[hour] = 270. + static_cast<double>(hour);
+	for (size_t hour=0; hour<4; hour++) RH_sta[hour] = 0.5;
+
+	for (const std::string conflicts : {"", "CONFLICTS_AVERAGE"}) {
+		std::vector< std::vector<MeteoData> > vecMeteo;
+		const std::string messages( automerge(conflicts, vecMeteo) );
+
+		std::vector<double> TA_sta_merged( TA_sta ), TA_other_merged( TA_other );
+		std::string expected_messages;
+		if (conflicts=="CONFLICTS_AVERAGE") { //only the averaging reports conflicts
+			for (size_t hour=10; hour<=14; hour++) TA_sta_merged[hour] = .5 * (TA_sta[hour] + 300.);
+			TA_other_merged[5] = .5 * (250. + 251.);
+			expected_messages = "[E] 5 automerge conflicts on station STA\n[E] 1 automerge conflicts on station OTHER\n";
+		}
+
+		if (vecMeteo.size()!=3 || !vecMeteo[2].empty()) {
+			std::cout << "AutoMerge: " << vecMeteo.size() << " stations left after merging\n";
+			status = false;
+			continue;
+		}
+		status &= check_automerge_station(vecMeteo[0], "STA", 22, TA_sta_merged, RH_sta);
+		status &= check_automerge_station(vecMeteo[1], "OTHER", 9, TA_other_merged, std::vector<double>(9, IOUtils::nodata));
+		if (messages!=expected_messages) {
+			std::cout << "AutoMerge: unexpected conflicts reported: '" << messages << "'\n";
+			status = false;
+		}
+	}
+
+	std::cout << "AutoMerge: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
 int main()
 {
 	setbuf(stdout, nullptr); //always flush stdout
@@ -161,7 +259,7 @@ int main()
 		std::vector< std::vector<MeteoData> > vecMeteoRef( read_data("io_ref_data.ini", false) );
 		std::vector< std::vector<MeteoData> > vecMeteoTest( read_data("io.ini", false) );
 		
-		const bool status = compare_data(vecMeteoRef, vecMeteoTest);
+		const bool status = compare_data(vecMeteoRef, vecMeteoTest) && check_automerge();
 		if (status) {
 			std::cout << "All OK\n";
 			exit(0);
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const double time_zones[] = {0., 1., -1., 5.5, -3.5, 5.75, -9.5, 12., -12.};
+static const size_t nr_time_zones = sizeof(time_zones) / sizeof(time_zones[0]);
+
+//check that a date parsed from a string is the expected one
+static bool check_parsed(const std::string& str, const double& tz_in, const Date& expected)
+{
+	Date parsed;
+	if (!IOUtils::convertString(parsed, str, tz_in)) {
+		cerr << "Could not parse '" << str << "'\n";
+		return false;
+	}
+	if (parsed!=expected || parsed.getTimeZone()!=expected.getTimeZone()) {
+		cerr << "Parsing '" << str << "' gave " << parsed.toString(Date::ISO_TZ) << " instead of " << expected.toString(Date::ISO_TZ) << "\n";
+		return false;
+	}
+	return true;
+}
+
+static bool check_formatting()
+{
+	bool status = true;
+	const Date d1(2024, 2, 29, 23, 50, 1.);
+	status &= (d1.toString(Date::ISO)=="2024-02-29T23:50:00");
+	status &= (d1.toString(Date::ISO_TZ)=="2024-02-29T23:50:00+01:00");
+	status &= (d1.toString(Date::ISO_Z)=="2024-02-29T22:50:00Z");
+	status &= (d1.toString(Date::ISO_DATE)=="2024-02-29");
+	status &= (d1.toString(Date::NUM)=="20240229235000");
+	status &= (d1.toString(Date::DIN)=="29.02.2024 23:50:00");
+	status &= (d1.toString(Date::ISO, true)=="2024-02-29T22:50:00");
+
+	const Date d2(1999, 12, 31, 22, 15, 12.5, -3.5);
+	status &= (d2.toString(Date::ISO_TZ)=="1999-12-31T22:15:12.500-03:30");
+	status &= (d2.toString(Date::ISO_Z)=="2000-01-01T01:45:12.500Z");
+	status &= (d2.toString(Date::NUM)=="19991231221512");
+
+	char buffer[Date::max_chars];
+	const size_t len = d2.toChars(buffer, Date::ISO_TZ);
+	status &= (std::string(buffer, len)==d2.toString(Date::ISO_TZ));
+
+	cout << "Formatting: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_parsing()
+{
+	bool status = true;
+	const Date ref(2017, 2, 2, 12, 35, 1.);
+	status &= check_parsed("2017-02-02T12:35:00", 1., ref);
+	status &= check_parsed("2017-02-02 12:35", 1., ref);
+	status &= check_parsed("  2017-02-02T12:35:00\t", 1., ref);
+	status &= check_parsed("2017-02-02T12:35:00 # comment", 1., ref);
+	status &= check_parsed("2017-02-02T11:35:00Z", 0., Date(2017, 2, 2, 11, 35, 0.));
+	status &= check_parsed("2017-02-02T12:35:00+01:00", 0., ref);
+	status &= check_parsed("2017-02-02 12:35 +01", 0., ref);
+	status &= check_parsed("20170202123500", 1., ref);
+	status &= check_parsed("201702021235+01:00", -5., ref);
+	status &= check_parsed("2017-02-02", 1., Date(2017, 2, 2, 0, 0, 1.));
+	status &= check_parsed("2017-02-02T12:35:12.25", 1., Date(2017, 2, 2, 12, 35, 12.25, 1.));
+
+	Date dummy;
+	status &= !IOUtils::convertString(dummy, "garbage", 1.);
+	status &= !IOUtils::convertString(dummy, "2017-02-02T12:35:00+ab", 1.);
+	bool leap_error = false;
+	try {
+		IOUtils::convertString(dummy, "2023-02-29", 1.);
+	} catch (const IOException&) {
+		leap_error = true;
+	}
+	status &= leap_error;
+
+	cout << "Parsing: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//format and parse back many dates around leap days, century boundaries and year changes
+static bool check_roundtrip()
+{
+	static const int days[][3] = {{2000, 2, 28}, {2024, 2, 28}, {2023, 2, 28}, {1900, 2, 28}, {2100, 2, 28}, {1999, 12, 31}, {1582, 10, 14}};
+	static const Date::FORMATS formats[] = {Date::ISO_TZ, Date::ISO_Z, Date::ISO, Date::NUM};
+	bool status = true;
+
+	for (size_t ii=0; ii<sizeof(days)/sizeof(days[0]); ii++) {
+		for (size_t jj=0; jj<nr_time_zones; jj++) {
+			const double tz = time_zones[jj];
+			const Date start(days[ii][0], days[ii][1], days[ii][2], 0, 0, tz);
+			for (unsigned int step=0; step<3*24*6; step++) { //three days by 10 minutes
+				const Date date( start + static_cast<double>(step)/(24.*6.) );
+				for (size_t kk=0; kk<sizeof(formats)/sizeof(formats[0]); kk++) {
+					const std::string str( date.toString(formats[kk]) );
+					Date parsed;
+					if (!IOUtils::convertString(parsed, str, tz) || parsed!=date) {
+						cerr << "Round trip failed for " << date.toString(Date::ISO_TZ) << " through '" << str << "'\n";
+						status = false;
+					}
+				}
+
+				int year, month, day, hour, minute;
+				double second;
+				date.getDate(year, month, day, hour, minute, second);
+				const Date rebuilt(year, month, day, hour, minute, second, tz);
+				if (rebuilt!=date) {
+					cerr << "Calendar decomposition failed for " << date.toString(Date::ISO_TZ) << "\n";
+					status = false;
+				}
+			}
+		}
+	}
+
+	//leap days must exist only in leap years
+	status &= (Date(2000, 2, 28, 0, 0, 0.) + 1.).toString(Date::ISO_DATE)=="2000-02-29";
+	status &= (Date(1900, 2, 28, 0, 0, 0.) + 1.).toString(Date::ISO_DATE)=="1900-03-01";
+	status &= (Date(2024, 2, 28, 0, 0, 0.) + 1.).toString(Date::ISO_DATE)=="2024-02-29";
+	status &= (Date(2023, 2, 28, 0, 0, 0.) + 1.).toString(Date::ISO_DATE)=="2023-03-01";
+
+	cout << "Round trips: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool formatting_status = check_formatting();
+	const bool parsing_status = check_parsing();
+	const bool roundtrip_status = check_roundtrip();
+
+	if (!formatting_status || !parsing_status || !roundtrip_status)
+		throw IOException("Date conversion error!", AT);
+
+	return 0;
+}
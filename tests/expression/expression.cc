@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cmath>
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static bool check_value(const std::string& what, const double& value, const double& expected)
+{
+	if (std::abs(value-expected) > 1e-12*std::max(1., std::abs(expected))) {
+		cerr << what << ": got " << value << " instead of " << expected << "\n";
+		return false;
+	}
+	return true;
+}
+
+//expressions that can not be compiled must be rejected
+static bool check_errors()
+{
+	bool status = true;
+	const std::vector<std::string> vars = {"x", "y"};
+	static const char* invalid[] = {"x +* y", "(x + y", "x + z", "sqrt(x", "", "x y"};
+
+	for (const char* str : invalid) {
+		Expression expr;
+		bool rejected = false;
+		try {
+			expr.compile(str, vars, "the expression test");
+		} catch (const InvalidFormatException&) {
+			rejected = true;
+		}
+		if (!rejected || expr.isCompiled() || expr.getNrOfVariables()!=0) {
+			cerr << "The invalid expression \"" << str << "\" has been accepted\n";
+			status = false;
+		}
+	}
+
+	bool rejected = false;
+	try {
+		Expression::evaluate("2 * unknown");
+	} catch (const InvalidFormatException&) {
+		rejected = true;
+	}
+	status &= rejected;
+
+	Expression expr("x + y", vars);
+	rejected = false;
+	try {
+		const double col[] = {1., 2.};
+		double res[2];
+		const std::vector<const double*> columns = {col};
+		expr.evaluate(columns, 2, res);
+	} catch (const InvalidArgumentException&) {
+		rejected = true;
+	}
+	status &= rejected;
+
+	cout << "Compilation errors: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_binding()
+{
+	bool status = true;
+	status &= check_value("constant expression", Expression::evaluate("2^10 - sqrt(16) + 3*(1+1)"), 1026.);
+
+	const std::vector<std::string> vars = {"snowline", "altitude", "param"};
+	Expression expr("param * (altitude - snowline) / 100", vars, "the expression test");
+	status &= (expr.isCompiled() && expr.getNrOfVariables()==3 && expr.getExpression()=="param * (altitude - snowline) / 100");
+	status &= (expr.getVariableIndex("altitude")==1 && expr.getVariableIndex("param")==2 && expr.getVariableIndex("other")==IOUtils::npos);
+
+	expr.setVariable(expr.getVariableIndex("snowline"), 1500.);
+	expr.setVariable(expr.getVariableIndex("altitude"), 2000.);
+	expr.setVariable(expr.getVariableIndex("param"), 2.);
+	status &= check_value("setVariable()", expr.evaluate(), 10.);
+	expr.setVariable(1, 2500.); //only one variable changes
+	status &= check_value("setVariable() on one variable", expr.evaluate(), 20.);
+
+	const double values[] = {1000., 1200., 0.5};
+	status &= check_value("evaluate(values)", expr.evaluate(values), 1.);
+
+	//copies are independent and keep the values of the variables
+	Expression copy( expr );
+	status &= check_value("copied expression", copy.evaluate(), 1.);
+	copy.setVariable(2, 4.);
+	status &= check_value("modified copy", copy.evaluate(), 8.);
+	status &= check_value("original after modifying the copy", expr.evaluate(), 1.);
+	Expression assigned;
+	assigned = copy;
+	status &= check_value("assigned expression", assigned.evaluate(), 8.);
+
+	//variables that are not used in the expression do not matter
+	const std::vector<std::string> more_vars = {"a", "b", "unused"};
+	Expression expr2("a - b", more_vars);
+	const double values2[] = {5., 3., IOUtils::nodata};
+	status &= check_value("unused variable", expr2.evaluate(values2), 2.);
+
+	cout << "Variables binding: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_columns()
+{
+	bool status = true;
+	const size_t n = 1000;
+	std::vector<double> altitude( n ), param( n ), results( n );
+	for (size_t ii=0; ii<n; ii++) {
+		altitude[ii] = 1000. + 2.5*static_cast<double>(ii);
+		param[ii] = 0.001*static_cast<double>(ii);
+	}
+
+	const std::vector<std::string> vars = {"snowline", "altitude", "param"};
+	Expression expr("param * (altitude - snowline) / 100 + abs(2000 - altitude)", vars);
+	expr.setVariable(0, 1500.); //a nullptr column keeps the current value
+	const std::vector<const double*> columns = {nullptr, &altitude[0], &param[0]};
+	expr.evaluate(columns, n, &results[0]);
+
+	for (size_t ii=0; ii<n; ii++) {
+		const double expected = param[ii] * (altitude[ii] - 1500.) / 100. + std::abs(2000. - altitude[ii]);
+		if (!check_value("column evaluation", results[ii], expected)) {
+			status = false;
+			break;
+		}
+	}
+
+	//in place evaluation on one of the columns
+	expr.evaluate(columns, n, &param[0]);
+	status &= check_value("in place column evaluation", param[n-1], results[n-1]);
+
+	//no values to compute
+	expr.evaluate(columns, 0, &results[0]);
+
+	cout << "Columns evaluation: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool errors_status = check_errors();
+	const bool binding_status = check_binding();
+	const bool columns_status = check_columns();
+
+	if (!errors_status || !binding_status || !columns_status)
+		throw IOException("Arithmetic expression error!", AT);
+
+	return 0;
+}
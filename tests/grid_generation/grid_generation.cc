@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const std::string grids_path( "./grid_generation_tmp" );
+static const size_t ncols = 3, nrows = 2;
+static const Date date(2020, 1, 1, 12, 0, 0.);
+
+//the value of each cell, the first cell being the lower left one
+typedef double (*CellValue)(const size_t& idx);
+
+static double u_wind(const size_t& idx) {return static_cast<double>(idx) - 2.;}
+static double v_wind(const size_t& idx) {return 3. - 1.5*static_cast<double>(idx);}
+static double altitude(const size_t& idx) {return 250.*static_cast<double>(idx);}
+static double ta(const size_t& idx) {return 270. + static_cast<double>(idx);}
+static double p_sea(const size_t& /*idx*/) {return 101325.;}
+static double td(const size_t& idx) {return 265. + 0.5*static_cast<double>(idx);}
+static double psum_s(const size_t& idx) {return (idx==1)? 0. : 0.2*static_cast<double>(idx);}
+static double psum_l(const size_t& idx) {return (idx==1)? 0. : (idx==4)? IOUtils::nodata : 1. - 0.1*static_cast<double>(idx);}
+static double iswr_dir(const size_t& idx) {return 400. + 10.*static_cast<double>(idx);}
+static double iswr_diff(const size_t& idx) {return 50. + static_cast<double>(idx);}
+static double albedo(const size_t& idx) {return 0.3 + 0.1*static_cast<double>(idx);}
+
+//local pressure at a given altitude, inverting the formula used to rebuild the DEM
+static double pressure(const size_t& idx)
+{
+	static const double k = Cst::gravity / (Cst::mean_adiabatique_lapse_rate * Cst::gaz_constant_dry_air);
+	const double z = altitude(idx);
+	const double K = 1. - Cst::mean_adiabatique_lapse_rate * Cst::earth_R0 * z / (ta(idx) * (Cst::earth_R0 + z));
+	return p_sea(idx) * pow(K, k);
+}
+
+static void write_grid(const std::string& param, const CellValue& value)
+{
+	std::string date_str( date.toString(Date::ISO) );
+	std::replace(date_str.begin(), date_str.end(), ':', '.');
+	std::ofstream fout( (grids_path + "/" + date_str + "_" + param + ".asc").c_str() );
+	fout << "ncols " << ncols << "\nnrows " << nrows << "\nxllcorner 600000\nyllcorner 150000\ncellsize 100\nNODATA_value -999\n";
+	fout << std::setprecision(12);
+	for (size_t jj=0; jj<nrows; jj++) { //ARC grids start with the northern line
+		for (size_t ii=0; ii<ncols; ii++) fout << value(ii + (nrows-1-jj)*ncols) << " ";
+		fout << "\n";
+	}
+}
+
+static bool check_grid(IOManager& io, const MeteoGrids::Parameters& param, const CellValue& expected, const double& tolerance)
+{
+	Grid2DObject grid;
+	io.read2DGrid(grid, param, date);
+	if (grid.getNx()!=ncols || grid.getNy()!=nrows) {
+		cerr << "Wrong dimensions for the generated " << MeteoGrids::getParameterName(param) << " grid\n";
+		return false;
+	}
+
+	bool status = true;
+	for (size_t idx=0; idx<grid.size(); idx++) {
+		const double value = expected(idx);
+		const bool valid = (value==IOUtils::nodata)? grid(idx)==IOUtils::nodata : std::abs(grid(idx) - value)<=tolerance;
+		if (!valid) {
+			cerr << "Wrong generated " << MeteoGrids::getParameterName(param) << " in cell " << idx << ": " << grid(idx) << " instead of " << value << "\n";
+			status = false;
+		}
+	}
+	return status;
+}
+
+//the grids generated in the same pass as the requested one must come from the grid buffer
+static bool check_buffered(IOManager& io, const MeteoGrids::Parameters& param, const CellValue& expected, const double& tolerance)
+{
+	const Profiler::StageStats before( Profiler::getStats()["cache::grids"] );
+	bool status = check_grid(io, param, expected, tolerance);
+	const Profiler::StageStats after( Profiler::getStats()["cache::grids"] );
+	if (after.misses!=before.misses || after.hits!=before.hits+1) {
+		cerr << MeteoGrids::getParameterName(param) << " has not been buffered when generating the other grids of the same sources\n";
+		status = false;
+	}
+	return status;
+}
+
+static double vw(const size_t& idx) {return sqrt( u_wind(idx)*u_wind(idx) + v_wind(idx)*v_wind(idx) );}
+static double dw(const size_t& idx) {return IOUtils::UV_TO_DW(u_wind(idx), v_wind(idx));}
+static double rh(const size_t& idx) {return Atmosphere::DewPointtoRh(td(idx), ta(idx), false);}
+static double psum(const size_t& idx) {return (psum_l(idx)==IOUtils::nodata)? IOUtils::nodata : psum_s(idx) + psum_l(idx);}
+static double psum_ph(const size_t& idx) {return (psum(idx)==IOUtils::nodata || psum(idx)==0.)? psum(idx) : psum_l(idx) / psum(idx);}
+static double iswr(const size_t& idx) {return iswr_dir(idx) + iswr_diff(idx);}
+static double rswr(const size_t& idx) {return iswr(idx) * albedo(idx);}
+
+int main() {
+	FileUtils::createDirectories( grids_path );
+	write_grid("U", &u_wind);
+	write_grid("V", &v_wind);
+	write_grid("P", &pressure);
+	write_grid("TA", &ta);
+	write_grid("P_SEA", &p_sea);
+	write_grid("TD", &td);
+	write_grid("PSUM_S", &psum_s);
+	write_grid("PSUM_L", &psum_l);
+	write_grid("ISWR_DIR", &iswr_dir);
+	write_grid("ISWR_DIFF", &iswr_diff);
+	write_grid("ALB", &albedo);
+
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "0");
+	cfg.addKey("GRID2D", "Input", "ARC");
+	cfg.addKey("GRID2DPATH", "Input", grids_path);
+	cfg.addKey("DEM_FROM_PRESSURE", "Input", "true");
+	IOManager io(cfg);
+	Profiler::setEnabled( true );
+
+	bool status = true;
+	status &= check_grid(io, MeteoGrids::VW, &vw, 1e-9);
+	status &= check_buffered(io, MeteoGrids::DW, &dw, 1e-9);
+	status &= check_buffered(io, MeteoGrids::U, &u_wind, 1e-9); //the source grids are also buffered
+	status &= check_grid(io, MeteoGrids::DEM, &altitude, 1e-3);
+	status &= check_grid(io, MeteoGrids::RH, &rh, 1e-9);
+	status &= check_grid(io, MeteoGrids::PSUM, &psum, 1e-9);
+	status &= check_buffered(io, MeteoGrids::PSUM_PH, &psum_ph, 1e-9);
+	status &= check_grid(io, MeteoGrids::RSWR, &rswr, 1e-9);
+	status &= check_buffered(io, MeteoGrids::ISWR, &iswr, 1e-9);
+
+	cout << "Grid generation: " << ((status)? "success" : "failed") << "\n";
+	if (!status)
+		throw IOException("Grid generation error!", AT);
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const std::string grids_path( "./grid_resampling_tmp" );
+static const size_t ncols = 4, nrows = 3;
+
+//TA grids every 3 hours, their values increasing by 1.5 K between grids
+static double expected_value(const double& hours, const size_t& ii, const size_t& jj, const double& offset)
+{
+	return offset + 250. + hours/3.*1.5 + static_cast<double>(ii) + static_cast<double>(nrows-1-jj)*10.;
+}
+
+static void write_grids(const double& offset)
+{
+	FileUtils::createDirectories( grids_path );
+	for (unsigned int step=0; step<8; step++) {
+		const double hours = 3.*step;
+		const Date date( Date(2020, 1, 1, 0, 0, 0.) + hours/24. );
+		std::string date_str( date.toString(Date::ISO) );
+		std::replace(date_str.begin(), date_str.end(), ':', '.');
+
+		std::ofstream fout( (grids_path + "/" + date_str + "_TA.asc").c_str() );
+		fout << "ncols " << ncols << "\nnrows " << nrows << "\nxllcorner 600000\nyllcorner 150000\ncellsize 100\nNODATA_value -999\n";
+		fout << std::setprecision(10);
+		for (size_t jj=0; jj<nrows; jj++) { //ARC grids start with the northern line
+			for (size_t ii=0; ii<ncols; ii++) fout << expected_value(hours, ii, nrows-1-jj, offset) << " ";
+			fout << "\n";
+		}
+	}
+}
+
+//read the grid at the given hour and compare it with the expected values
+static bool check_grid(IOManager& io, const double& hours, const double& offset)
+{
+	const Date date( Date(2020, 1, 1, 0, 0, 0.) + hours/24. );
+	Grid2DObject grid;
+	io.read2DGrid(grid, MeteoGrids::TA, date);
+
+	bool status = (grid.getNx()==ncols && grid.getNy()==nrows);
+	for (size_t jj=0; status && jj<nrows; jj++) {
+		for (size_t ii=0; ii<ncols; ii++) {
+			if (std::abs(grid(ii, jj) - expected_value(hours, ii, jj, offset)) > 1e-6) {
+				cerr << "Wrong TA at " << date.toString(Date::ISO) << " in (" << ii << "," << jj << "): " << grid(ii, jj) << " instead of " << expected_value(hours, ii, jj, offset) << "\n";
+				status = false;
+			}
+		}
+	}
+	return status;
+}
+
+int main() {
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "0");
+	cfg.addKey("GRID2D", "Input", "ARC");
+	cfg.addKey("GRID2DPATH", "Input", grids_path);
+	cfg.addKey("TA::RESAMPLE", "GridInterpolations1D", "TIMESERIES");
+	cfg.addKey("TA::TIMESERIES::ALGORITHM", "GridInterpolations1D", "LINEAR");
+	IOManager io(cfg);
+
+	bool status = true;
+	write_grids( 0. );
+	for (unsigned int hour=1; hour<20; hour++) status &= check_grid(io, hour, 0.);
+
+	//the data changed: after clearing the cache, the new grids must be used, both for grids read before and for new dates
+	write_grids( 100. );
+	io.clear_cache();
+	status &= check_grid(io, 1., 100.);
+	status &= check_grid(io, 2., 100.);
+	status &= check_grid(io, 20., 100.);
+
+	cout << "Grid resampling cache: " << ((status)? "success" : "failed") << "\n";
+	if (!status)
+		throw IOException("Temporal grid resampling error!", AT);
+
+	return 0;
+}
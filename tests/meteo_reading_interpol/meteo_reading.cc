@@ -39,7 +39,7 @@ static bool controllStation(MeteoData& datMeteo, int i_results, Date datDate){
 	bool status = true;
 
 	// Coords content
-	Coords& dataCoord = datMeteo.meta.position;
+	const Coords dataCoord( datMeteo.meta.getPosition() );
 	if(!IOUtils::checkEpsilonEquality(dataCoord.getAltitude(), res_Alt[i_results], epsilon)){
 		cerr << "error on Altitude on " << res_ID[i_results] << endl;
 		status = false;
@@ -71,9 +71,9 @@ static bool controllStation(MeteoData& datMeteo, int i_results, Date datDate){
 	refCoord.setLatLon(res_Lat[i_results], res_Lon[i_results], res_Alt[i_results]);
 	refCoord.setXY(res_X[i_results], res_Y[i_results], res_Alt[i_results]);
 	refCoord.setProj("CH1903");
-	if(datMeteo.meta.position != refCoord){
+	if(datMeteo.meta.getPosition() != refCoord){
 		cerr << "error on == operator for Coords :";
-		cerr << datMeteo.meta.position.toString() << endl;
+		cerr << datMeteo.meta.getPosition().toString() << endl;
 		cerr << refCoord.toString() << endl;
 		status = false;
 	}
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const std::string tmp_path( "./meteo_streaming_tmp" );
+static const size_t nr_timesteps = 50;
+static const size_t chunk_size = 12;
+
+//two stations, the second one only starts in the second chunk and gets an extra field in the third chunk
+static std::vector<METEO_SET> build_data()
+{
+	Coords loc1("CH1903", ""), loc2("CH1903", "");
+	loc1.setXY(780000., 189000., 2540.);
+	loc2.setXY(783000., 187000., 1560.);
+	const StationData sd1(loc1, "STA1", "Station one");
+	const StationData sd2(loc2, "STA2", "Station two");
+
+	std::vector<METEO_SET> vecMeteo(2);
+	const Date start(2021, 3, 1, 0, 0, 1.);
+	for (size_t ii=0; ii<nr_timesteps; ii++) {
+		const Date date( start + static_cast<double>(ii)/24. );
+		MeteoData md1(date, sd1);
+		md1(MeteoData::TA) = 265. + 0.1*static_cast<double>(ii);
+		md1(MeteoData::RH) = (ii%7==0)? IOUtils::nodata : 0.8;
+		vecMeteo[0].push_back( md1 );
+
+		if (ii<15) continue;
+		MeteoData md2(date, sd2);
+		md2(MeteoData::TA) = 270. - 0.05*static_cast<double>(ii);
+		md2(MeteoData::VW) = 2.5;
+		if (ii>=30) {
+			md2.addParameter( "TSNOW" );
+			md2("TSNOW") = 268.;
+		}
+		vecMeteo[1].push_back( md2 );
+	}
+	return vecMeteo;
+}
+
+static Config output_config(const std::string& plugin, const std::string& path)
+{
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("COORDSYS", "Output", "CH1903");
+	cfg.addKey("TIME_ZONE", "Output", "1");
+	cfg.addKey("METEO", "Output", plugin);
+	cfg.addKey("METEOPATH", "Output", path);
+	return cfg;
+}
+
+//write all the data at once (as when not streaming)
+static void write_once(const std::string& plugin, const std::string& path, std::vector<METEO_SET> vecMeteo)
+{
+	FileUtils::createDirectories( path );
+	const Config cfg( output_config(plugin, path) );
+	IOManager io(cfg);
+	for (METEO_SET& station : vecMeteo) MeteoData::unifyMeteoData( station );
+	io.writeMeteoData( vecMeteo );
+}
+
+//write the first chunk, then append the next ones
+static void write_chunks(const std::string& plugin, const std::string& path, const std::vector<METEO_SET>& vecMeteo)
+{
+	FileUtils::createDirectories( path );
+	const Config cfg( output_config(plugin, path) );
+	IOManager io(cfg);
+	if (!io.canAppendMeteoData())
+		throw InvalidArgumentException("The "+plugin+" plugin should be able to append data", AT);
+
+	const Date start( vecMeteo.front().front().date );
+	for (size_t chunk=0; chunk*chunk_size<nr_timesteps; chunk++) {
+		const Date chunk_start( start + static_cast<double>(chunk*chunk_size)/24. );
+		const Date chunk_end( start + static_cast<double>((chunk+1)*chunk_size)/24. );
+		std::vector<METEO_SET> vecChunk( vecMeteo.size() );
+		for (size_t st=0; st<vecMeteo.size(); st++) {
+			for (const MeteoData& md : vecMeteo[st])
+				if (md.date>=chunk_start && md.date<chunk_end) vecChunk[st].push_back( md );
+			MeteoData::unifyMeteoData( vecChunk[st] );
+		}
+
+		if (chunk==0) io.writeMeteoData( vecChunk );
+		else io.appendMeteoData( vecChunk );
+	}
+}
+
+static std::string read_file(const std::string& filename)
+{
+	std::ifstream fin( filename.c_str() );
+	if (fin.fail()) throw AccessException(filename, AT);
+	std::ostringstream ss;
+	ss << fin.rdbuf();
+	return ss.str();
+}
+
+//read back a written time series
+static std::vector<METEO_SET> read_back(const std::string& plugin, const std::string& path, const std::string& extension)
+{
+	Config cfg( output_config(plugin, path) );
+	cfg.addKey("METEO", "Input", plugin);
+	cfg.addKey("METEOPATH", "Input", path);
+	cfg.addKey("STATION1", "Input", "STA1"+extension);
+	cfg.addKey("STATION2", "Input", "STA2"+extension);
+	IOManager io(cfg);
+
+	std::vector<METEO_SET> vecMeteo;
+	io.getMeteoData(Date(2021, 2, 28, 0, 0, 1.), Date(2021, 3, 4, 0, 0, 1.), vecMeteo);
+	return vecMeteo;
+}
+
+//compare two time series, the parameters being matched by name since their order might differ
+static bool same_data(const std::vector<METEO_SET>& vec1, const std::vector<METEO_SET>& vec2)
+{
+	if (vec1.size()!=vec2.size()) return false;
+	for (size_t st=0; st<vec1.size(); st++) {
+		if (vec1[st].size()!=vec2[st].size()) return false;
+		for (size_t ii=0; ii<vec1[st].size(); ii++) {
+			const MeteoData& md1 = vec1[st][ii];
+			const MeteoData& md2 = vec2[st][ii];
+			if (md1.date!=md2.date || md1.meta.getStationID()!=md2.meta.getStationID()) return false;
+			if (md1.getNrOfParameters()!=md2.getNrOfParameters()) return false;
+			for (size_t param=0; param<md1.getNrOfParameters(); param++) {
+				const size_t idx = md2.getParameterIndex( md1.getNameForParameter(param) );
+				if (idx==IOUtils::npos || !IOUtils::checkEpsilonEquality(md1(param), md2(idx), 1e-6)) return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool compare_outputs(const std::string& plugin, const std::string& extension, const bool& identical_files)
+{
+	const std::vector<METEO_SET> vecMeteo( build_data() );
+	const std::string path_once( tmp_path + "/" + plugin + "_once" );
+	const std::string path_chunks( tmp_path + "/" + plugin + "_chunks" );
+	write_once(plugin, path_once, vecMeteo);
+	write_chunks(plugin, path_chunks, vecMeteo);
+
+	bool status = true;
+	if (identical_files) {
+		for (const std::string stationID : {"STA1", "STA2"}) {
+			const std::string once( read_file(path_once + "/" + stationID + extension) );
+			const std::string chunks( read_file(path_chunks + "/" + stationID + extension) );
+			if (once!=chunks) {
+				cerr << "The " << plugin << " file for " << stationID << " differs when written by chunks:\n" << chunks << "\ninstead of:\n" << once << "\n";
+				status = false;
+			}
+		}
+	}
+
+	const std::vector<METEO_SET> vecOnce( read_back(plugin, path_once, extension) );
+	const std::vector<METEO_SET> vecChunks( read_back(plugin, path_chunks, extension) );
+	if (vecOnce.size()!=2 || !same_data(vecOnce, vecChunks)) {
+		cerr << "The " << plugin << " data written by chunks differs from the data written at once\n";
+		status = false;
+	}
+	//the field appearing in the third chunk must be there, as nodata before it appeared
+	if (vecChunks.size()!=2 || vecChunks[1].size()!=nr_timesteps-15 || vecChunks[1].front()("TSNOW")!=IOUtils::nodata || vecChunks[1].back()("TSNOW")!=268.) {
+		cerr << "The " << plugin << " data written by chunks is missing the TSNOW field\n";
+		status = false;
+	}
+
+	cout << plugin << " written by chunks: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static size_t nr_progress = 0;
+static void count_progress(const Date& /*date*/)
+{
+	nr_progress++;
+}
+
+//reading back by chunks must give the same data as reading everything at once
+static bool check_stream()
+{
+	Config cfg( output_config("SMET", tmp_path + "/SMET_stream") );
+	cfg.addKey("METEO", "Input", "SMET");
+	cfg.addKey("METEOPATH", "Input", tmp_path + "/SMET_once");
+	cfg.addKey("STATION1", "Input", "STA1");
+	cfg.addKey("STATION2", "Input", "STA2");
+	IOManager io(cfg);
+
+	const Date start(2021, 3, 1, 0, 0, 1.);
+	const Date end( start + static_cast<double>(nr_timesteps-1)/24. );
+	std::vector<METEO_SET> vecOnce, vecChunk;
+	MeteoDataStream stream_once(io, start, end, 1./24., 0);
+	stream_once.next( vecOnce );
+
+	std::vector<METEO_SET> vecChunks;
+	MeteoDataStream stream(io, start, end, 1./24., 7);
+	stream.setProgressCallback( count_progress ); //the progress is reported at each timestep, not at each chunk
+	size_t nr_chunks = 0;
+	while (stream.next(vecChunk)) {
+		nr_chunks++;
+		if (vecChunks.size()<vecChunk.size()) vecChunks.resize( vecChunk.size() );
+		for (size_t st=0; st<vecChunk.size(); st++) vecChunks[st].insert(vecChunks[st].end(), vecChunk[st].begin(), vecChunk[st].end());
+	}
+	for (METEO_SET& station : vecChunks) MeteoData::unifyMeteoData( station );
+
+	const bool status = (nr_chunks==(nr_timesteps+6)/7 && stream.getNrOfTimesteps()==nr_timesteps && nr_progress==nr_timesteps && vecChunks==vecOnce && vecOnce.size()==2);
+	cout << "Reading by chunks: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	bool status = true;
+	status &= compare_outputs("SMET", ".smet", true);
+	status &= compare_outputs("ICSV", ".icsv", false); //new columns are appended after the existing ones
+	status &= check_stream();
+
+	if (!status)
+		throw IOException("Writing or reading time series by chunks failed!", AT);
+
+	return 0;
+}
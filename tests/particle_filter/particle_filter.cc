@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <cmath>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const size_t nr_steps = 12;
+
+//noisy snow height with a control signal for the model fit, with a gap to carry the particles over
+static std::vector<MeteoData> build_series()
+{
+	const StationData sd(Coords("CH1903", ""), "STA", "Station");
+	std::vector<MeteoData> vecMeteo;
+	for (size_t kk=0; kk<nr_steps; kk++) {
+		MeteoData md(Date(2020, 1, 1, 0, 0, 0.) + static_cast<double>(kk)/24., sd);
+		const size_t ctrl_idx = md.addParameter("CTRL");
+		const double t = static_cast<double>(kk);
+		md(MeteoData::HS) = (kk==7)? IOUtils::nodata : 2.5 - 0.02*t + 0.05*sin(2.3*t);
+		md(ctrl_idx) = 2.5 - 0.02*t;
+		vecMeteo.push_back( md );
+	}
+	return vecMeteo;
+}
+
+static std::vector<double> run_filter(const std::string& model, const bool& parallel)
+{
+	std::vector< std::pair<std::string, std::string> > vecArgs;
+	vecArgs.push_back( std::make_pair("MODEL_FUNCTION", model) );
+	if (model.substr(0, 4)=="FIT ") vecArgs.push_back( std::make_pair("MODEL_FIT_PARAM", "CTRL") );
+	vecArgs.push_back( std::make_pair("OBS_MODEL_FUNCTION", "0.8*xx + 0.2*x_km1") );
+	vecArgs.push_back( std::make_pair("INITIAL_STATE", "2.5") );
+	vecArgs.push_back( std::make_pair("NO_OF_PARTICLES", "200") );
+	vecArgs.push_back( std::make_pair("PATH_RESAMPLING", "TRUE") );
+	vecArgs.push_back( std::make_pair("PARALLEL", (parallel)? "TRUE" : "FALSE") );
+	vecArgs.push_back( std::make_pair("VERBOSE", "FALSE") );
+	vecArgs.push_back( std::make_pair("MODEL_RNG_DISTRIBUTION", "GAUSS") );
+	vecArgs.push_back( std::make_pair("MODEL_RNG_PARAMETERS", "0 0.05") );
+	vecArgs.push_back( std::make_pair("OBS_RNG_DISTRIBUTION", "GAUSS") );
+	vecArgs.push_back( std::make_pair("OBS_RNG_PARAMETERS", "0 0.03") );
+	vecArgs.push_back( std::make_pair("PRIOR_RNG_DISTRIBUTION", "GAUSS") );
+	vecArgs.push_back( std::make_pair("PRIOR_RNG_PARAMETERS", "0 0.02") );
+	vecArgs.push_back( std::make_pair("MODEL_RNG_SEED", "11 22 33 44") );
+	vecArgs.push_back( std::make_pair("OBS_RNG_SEED", "55 66 77 88") );
+	vecArgs.push_back( std::make_pair("PRIOR_RNG_SEED", "99 111 222 333") );
+	vecArgs.push_back( std::make_pair("RESAMPLE_RNG_SEED", "444 555 666 777") );
+
+	Config cfg;
+	cfg.addKey("TIME_ZONE", "Input", "0");
+	ProcessingBlock *filter = BlockFactory::getBlock("PARTICLE", vecArgs, cfg);
+	const std::vector<MeteoData> ivec( build_series() );
+	std::vector<MeteoData> ovec;
+	filter->process(MeteoData::HS, ivec, ovec);
+	delete filter;
+
+	std::vector<double> results;
+	for (const MeteoData& md : ovec) results.push_back( md(MeteoData::HS) );
+	return results;
+}
+
+static bool check_model(const std::string& name, const std::string& model, const std::vector<double>& expected)
+{
+	bool status = true;
+	const std::vector<double> results( run_filter(model, false) );
+	if (results.size()!=expected.size()) {
+		cerr << name << ": " << results.size() << " values instead of " << expected.size() << "\n";
+		status = false;
+	} else {
+		for (size_t kk=0; kk<results.size(); kk++) {
+			if (std::abs(results[kk] - expected[kk]) > 1e-9) {
+				cerr << name << ": " << results[kk] << " instead of " << expected[kk] << " at step " << kk << "\n";
+				status = false;
+			}
+		}
+	}
+
+	//the particles are split among the threads, but the random numbers are always drawn in the same order
+	status &= (run_filter(model, true)==results);
+
+	cout << name << ": " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	//reference values for a fixed seed, they only change if the filter's algorithm changes
+	const bool model_status = check_model("System model", "x_km1 - 0.02", {2.50121535516, 2.50648942708, 2.43779212104, 2.44934863482, 2.43330059155, 2.37551102264,
+	                                                              2.3981921302, 2.40711006119, 2.34310055917, 2.34673747048, 2.2861638908, 2.2767779494});
+	const bool fit_status = check_model("Model fit", "FIT SIMPLE_LINEAR", {2.50121535516, 2.50385712893, 2.43715495604, 2.45654187251, 2.42831128725, 2.3730887881,
+	                                                            2.4068275916, 2.41813115601, 2.33339554561, 2.34802548448, 2.28062564629, 2.28405241209});
+
+	if (!model_status || !fit_status)
+		throw IOException("Particle filter error!", AT);
+
+	return 0;
+}
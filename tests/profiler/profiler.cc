@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+//keep the cpu busy for the given wall clock duration, so the timers have something to measure
+static void busy_wait(const double& seconds)
+{
+	const long double start = Timer::getCurrentTime();
+	volatile double sum = 0.;
+	while (Timer::getCurrentTime() - start < seconds) sum = sum + 1.;
+}
+
+static void record_stages()
+{
+	{
+		const ProfilerScope outer( "test::outer" );
+		for (size_t ii=0; ii<2; ii++) {
+			const ProfilerScope inner( "test::", "inner" );
+			busy_wait( 0.01 );
+		}
+	}
+	Profiler::addBytes("test::outer", 1024);
+	Profiler::addBytes("test::outer", 512);
+	for (const bool hit : {true, false, true, true})
+		Profiler::addCacheAccess("test::cache", hit);
+	Profiler::addCacheAccess("test::\"quoted\"", false);
+}
+
+//when disabled, nothing must be recorded, but the statistics must remain available
+static bool check_disabled()
+{
+	bool status = true;
+	Profiler::setEnabled( false );
+	Profiler::reset();
+	record_stages();
+	status &= (!Profiler::isEnabled() && Profiler::getStats().empty());
+	status &= (IOManager::getPerformanceReport(true)=="{\"profiling\": false, \"stages\": [\n]}\n");
+
+	cout << "Disabled: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_counters()
+{
+	bool status = true;
+	Profiler::setEnabled( true );
+	Profiler::reset();
+	record_stages();
+
+	std::map<std::string, Profiler::StageStats> stats( Profiler::getStats() );
+	status &= (stats.size()==4);
+	const Profiler::StageStats &outer = stats["test::outer"], &inner = stats["test::inner"];
+	status &= (outer.calls==1 && outer.bytes==1536 && outer.hits==0 && outer.misses==0);
+	status &= (inner.calls==2 && inner.bytes==0);
+	status &= (inner.wall_time>=0.02 && outer.wall_time>=inner.wall_time); //nested stages are inclusive
+	status &= (inner.cpu_time>0.);
+	const Profiler::StageStats &cache = stats["test::cache"];
+	status &= (cache.calls==0 && cache.hits==3 && cache.misses==1);
+
+	//the statistics are cumulative until reset
+	Profiler::addCacheAccess("test::cache", false);
+	status &= (Profiler::getStats()["test::cache"].misses==2);
+	Profiler::reset();
+	status &= (Profiler::getStats().empty() && Profiler::isEnabled());
+
+	cout << "Counters: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_reports()
+{
+	bool status = true;
+	Profiler::setEnabled( true );
+	Profiler::reset();
+	record_stages();
+
+	const std::string json( IOManager::getPerformanceReport(true) );
+	status &= (json.compare(0, 33, "{\"profiling\": true, \"stages\": [\n\t")==0);
+	status &= (json.find("{\"name\": \"test::cache\", \"calls\": 0, \"wall_time\": 0, \"cpu_time\": 0, \"bytes\": 0, \"cache_hits\": 3, \"cache_misses\": 1}")!=std::string::npos);
+	status &= (json.find("{\"name\": \"test::inner\", \"calls\": 2,")!=std::string::npos);
+	status &= (json.find("\"bytes\": 1536, \"cache_hits\": 0, \"cache_misses\": 0}")!=std::string::npos);
+	status &= (json.find("{\"name\": \"test::\\\"quoted\\\"\",")!=std::string::npos); //the names are escaped
+	status &= (json.compare(json.size()-5, 5, "}\n]}\n")==0);
+
+	const std::string table( IOManager::getPerformanceReport() );
+	status &= (table.compare(0, 5, "stage")==0);
+	status &= (table.find("75.0%")!=std::string::npos); //hit rate of test::cache
+	status &= (table.find("0.0%")!=std::string::npos); //hit rate of test::"quoted"
+
+	cout << "Reports: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//the PROFILING key enables the recording when building an IOManager
+static bool check_config()
+{
+	bool status = true;
+	Profiler::setEnabled( false );
+	Config cfg;
+	cfg.addKey("PROFILING", "General", "true");
+	const IOManager io(cfg);
+	status &= Profiler::isEnabled();
+
+	cout << "Config: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool disabled_status = check_disabled();
+	const bool counters_status = check_counters();
+	const bool reports_status = check_reports();
+	const bool config_status = check_config();
+
+	if (!disabled_status || !counters_status || !reports_status || !config_status)
+		throw IOException("Profiler error!", AT);
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <cmath>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const size_t src_nx = 16, src_ny = 11;
+static const double ll_lat = 46.75, ll_lon = 9.75, dlat = 0.01, dlon = 0.01;
+
+//linear field, so the expected values can be computed at any position
+static double field(const double& lat, const double& lon, const double& scale)
+{
+	return scale * (1000.*(lat-ll_lat) + 500.*(lon-ll_lon));
+}
+
+//the reprojection is only available to the plugins and GridsManager, so it is exposed here
+class LatLonGrid : public Grid2DObject {
+	public:
+		LatLonGrid(const size_t& ncols, const size_t& nrows, const Coords& i_llcorner) : Grid2DObject(ncols, nrows, IOUtils::nodata, i_llcorner, IOUtils::nodata) {}
+		using Grid2DObject::setLatLon;
+		using Grid2DObject::isLatlon;
+		using Grid2DObject::computeReprojectionMap;
+		using Grid2DObject::reproject;
+};
+
+//small lat/lon grid around Davos, its lower left corner given in CH1903
+static LatLonGrid source_grid(const double& scale)
+{
+	Coords llcorner("CH1903", "");
+	llcorner.setLatLon(ll_lat, ll_lon, 1500.);
+	LatLonGrid grid(src_nx, src_ny, llcorner);
+	for (size_t jj=0; jj<src_ny; jj++) {
+		for (size_t ii=0; ii<src_nx; ii++)
+			grid(ii, jj) = field(ll_lat + static_cast<double>(jj)*dlat, ll_lon + static_cast<double>(ii)*dlon, scale);
+	}
+	grid.setLatLon(ll_lat + static_cast<double>(src_ny-1)*dlat, ll_lon + static_cast<double>(src_nx-1)*dlon);
+	return grid;
+}
+
+//compare each reprojected cell with the field at the cell's center
+static bool check_method(const Grid2DObject::ReprojectionMethod& method, const std::string& name, const double& tolerance)
+{
+	bool status = true;
+	LatLonGrid grid( source_grid(1.) );
+	grid.reproject( method );
+	if (grid.isLatlon() || grid.getNx()<src_nx/2 || grid.getNy()<src_ny/2) {
+		cout << name << ": failed\n";
+		return false;
+	}
+
+	size_t nr_inside = 0, nr_errors = 0;
+	Coords pt( grid.llcorner );
+	for (size_t jj=0; jj<grid.getNy(); jj++) {
+		for (size_t ii=0; ii<grid.getNx(); ii++) {
+			pt.setXY(grid.llcorner.getEasting() + static_cast<double>(ii)*grid.cellsize, grid.llcorner.getNorthing() + static_cast<double>(jj)*grid.cellsize, IOUtils::nodata);
+			const double fi = (pt.getLon() - ll_lon) / dlon, fj = (pt.getLat() - ll_lat) / dlat;
+			const bool inside = (fi>=0. && fi<=static_cast<double>(src_nx-1) && fj>=0. && fj<=static_cast<double>(src_ny-1));
+			const bool outside = (fi<-1. || fi>static_cast<double>(src_nx) || fj<-1. || fj>static_cast<double>(src_ny));
+			if (inside) {
+				nr_inside++;
+				if (grid(ii, jj)==IOUtils::nodata || std::abs(grid(ii, jj) - field(pt.getLat(), pt.getLon(), 1.)) > tolerance) nr_errors++;
+			} else if (outside && grid(ii, jj)!=IOUtils::nodata) {
+				nr_errors++;
+			}
+		}
+	}
+	if (nr_errors>0) {
+		cerr << name << ": " << nr_errors << " wrong cells\n";
+		status = false;
+	}
+	status &= (nr_inside>grid.getNx()*grid.getNy()/2);
+
+	cout << name << ": " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool same_maps(const Grid2DObject::ReprojectionMap& map1, const Grid2DObject::ReprojectionMap& map2)
+{
+	return (map1.ncols==map2.ncols && map1.nrows==map2.nrows && map1.cellsize==map2.cellsize && map1.llcorner==map2.llcorner
+	        && map1.offsets==map2.offsets && map1.indices==map2.indices && map1.weights==map2.weights);
+}
+
+//a map only depends on the geometry, so it must be reusable for all the grids sharing it (as GridsManager caches them)
+static bool check_reuse()
+{
+	bool status = true;
+	for (const Grid2DObject::ReprojectionMethod method : {Grid2DObject::NEAREST, Grid2DObject::BILINEAR, Grid2DObject::CONSERVATIVE}) {
+		const Grid2DObject::ReprojectionMap rmap( LatLonGrid::computeReprojectionMap(source_grid(1.), method) );
+		status &= same_maps(rmap, LatLonGrid::computeReprojectionMap(source_grid(1.), method));
+
+		for (const double scale : {1., -2.5, 7.}) {
+			LatLonGrid cached( source_grid(scale) );
+			cached(3, 4) = IOUtils::nodata;
+			LatLonGrid direct( cached );
+			cached.reproject( rmap );
+			direct.reproject( method );
+			status &= (cached.llcorner==direct.llcorner && cached.cellsize==direct.cellsize && cached.grid2D==direct.grid2D);
+		}
+	}
+
+	//a map must not be applied to a grid of another geometry
+	try {
+		LatLonGrid other( src_nx+1, src_ny, source_grid(1.).llcorner );
+		other.reproject( LatLonGrid::computeReprojectionMap(source_grid(1.), Grid2DObject::BILINEAR) );
+		status = false;
+	} catch (const InvalidArgumentException&) {}
+
+	cout << "Maps reuse: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	//the nearest cell is at most half a cell away along each axis, the conservative footprint at most one cell
+	const bool nearest_status = check_method(Grid2DObject::NEAREST, "Nearest", .5*10. + .5*5. + 1e-6);
+	const bool bilinear_status = check_method(Grid2DObject::BILINEAR, "Bilinear", 1e-6);
+	const bool conservative_status = check_method(Grid2DObject::CONSERVATIVE, "Conservative", 10. + 5.);
+	const bool reuse_status = check_reuse();
+
+	if (!nearest_status || !bilinear_status || !conservative_status || !reuse_status)
+		throw IOException("Reprojection error!", AT);
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+//reference implementations, computing each destination pixel independently as the original per pixel loops did
+static double ref_bilinear_pixel(const Array2D<double> &i_grid, const size_t &org_ii, const size_t &org_jj, const size_t &org_nx, const size_t &org_ny, const double &x, const double &y)
+{
+	if (org_jj>=(org_ny-1) || org_ii>=(org_nx-1)) return i_grid(org_ii, org_jj);
+
+	const double f[4] = {i_grid(org_ii, org_jj), i_grid(org_ii+1, org_jj), i_grid(org_ii, org_jj+1), i_grid(org_ii+1, org_jj+1)};
+	const double w[4] = {(1.-x)*(1.-y), x*(1.-y), (1.-x)*y, x*y};
+	double avg_value = 0.;
+	unsigned int avg_count = 0;
+	for (size_t kk=0; kk<4; kk++) {
+		if (f[kk]==IOUtils::nodata) continue;
+		avg_value += f[kk];
+		avg_count++;
+	}
+
+	if (avg_count==4) return f[0]*w[0] + f[1]*w[1] + f[2]*w[2] + f[3]*w[3];
+	if (avg_count<=2) return IOUtils::nodata;
+
+	const double avg = avg_value/(double)avg_count;
+	double value = 0.;
+	for (size_t kk=0; kk<4; kk++) value += ((f[kk]!=IOUtils::nodata)? f[kk] : avg) * w[kk];
+	return value;
+}
+
+static double ref_BSpline_weight(const double &x)
+{
+	double R = 0.;
+	if ((x+2.)>0.) R += Optim::pow3(x+2.);
+	if ((x+1.)>0.) R += -4.*Optim::pow3(x+1.);
+	if ((x)>0.) R += 6.*Optim::pow3(x);
+	if ((x-1.)>0.) R += -4.*Optim::pow3(x-1.);
+	return 1./6.*R;
+}
+
+static Array2D<double> ref_Bilinear(const Array2D<double> &i_grid, const size_t& dest_nx, const size_t& dest_ny)
+{
+	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
+	const double scale_x = (double)dest_nx / (double)org_nx;
+	const double scale_y = (double)dest_ny / (double)org_ny;
+	Array2D<double> o_grid(dest_nx, dest_ny);
+
+	for (size_t jj=0; jj<dest_ny; jj++) {
+		const double org_y = (double)jj/scale_y;
+		const size_t org_jj = static_cast<size_t>( org_y );
+		for (size_t ii=0; ii<dest_nx; ii++) {
+			const double org_x = (double)ii/scale_x;
+			const size_t org_ii = static_cast<size_t>( org_x );
+			o_grid(ii,jj) = ref_bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, org_x - (double)org_ii, org_y - (double)org_jj);
+		}
+	}
+	return o_grid;
+}
+
+static Array2D<double> ref_cubicBSpline(const Array2D<double> &i_grid, const size_t& dest_nx, const size_t& dest_ny)
+{
+	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
+	const double scale_x = (double)dest_nx / (double)org_nx;
+	const double scale_y = (double)dest_ny / (double)org_ny;
+	Array2D<double> o_grid(dest_nx, dest_ny);
+
+	for (size_t jj=0; jj<dest_ny; jj++) {
+		const double org_y = (double)jj/scale_y;
+		const size_t org_jj = static_cast<size_t>( org_y );
+		const double dy = org_y - (double)org_jj;
+		for (size_t ii=0; ii<dest_nx; ii++) {
+			const double org_x = (double)ii/scale_x;
+			const size_t org_ii = static_cast<size_t>( org_x );
+			const double dx = org_x - (double)org_ii;
+
+			double F = 0., max=-std::numeric_limits<double>::max(), min=std::numeric_limits<double>::max();
+			unsigned int avg_count = 0;
+			for (int n=-1; n<=2; n++) {
+				for (int m=-1; m<=2; m++) {
+					if (((signed)org_ii+m)<0 || ((signed)org_ii+m)>=(signed)org_nx || ((signed)org_jj+n)<0 || ((signed)org_jj+n)>=(signed)org_ny) continue;
+					const double pixel = i_grid(static_cast<size_t>((signed)org_ii+m), static_cast<size_t>((signed)org_jj+n));
+					if (pixel!=IOUtils::nodata) {
+						F += pixel * ref_BSpline_weight(m-dx) * ref_BSpline_weight(dy-n);
+						avg_count++;
+						if (pixel>max) max=pixel;
+						if (pixel<min) min=pixel;
+					}
+				}
+			}
+
+			if (avg_count==16) o_grid(ii,jj) = std::min(std::max(F, min), max);
+			else if (avg_count==0) o_grid(ii,jj) = IOUtils::nodata;
+			else o_grid(ii,jj) = ref_bilinear_pixel(i_grid, org_ii, org_jj, org_nx, org_ny, dx, dy);
+		}
+	}
+	return o_grid;
+}
+
+static Array2D<double> ref_Nearest(const Array2D<double> &i_grid, const size_t& dest_nx, const size_t& dest_ny)
+{
+	const size_t org_nx = i_grid.getNx(), org_ny = i_grid.getNy();
+	const double scale_x = (double)dest_nx / (double)org_nx;
+	const double scale_y = (double)dest_ny / (double)org_ny;
+	Array2D<double> o_grid(dest_nx, dest_ny);
+
+	for (size_t jj=0; jj<dest_ny; jj++) {
+		const size_t org_jj = std::min( (size_t) Optim::floor( (double)jj/scale_y ) , org_ny-1 );
+		for (size_t ii=0; ii<dest_nx; ii++) {
+			const size_t org_ii = std::min( (size_t) Optim::floor( (double)ii/scale_x ) , org_nx-1 );
+			o_grid(ii,jj) = i_grid(org_ii, org_jj);
+		}
+	}
+	return o_grid;
+}
+
+//smooth field with some nodata pixels and a nodata patch
+static Array2D<double> build_grid(const size_t& nx, const size_t& ny, const unsigned int& seed)
+{
+	Array2D<double> grid(nx, ny);
+	srand( seed );
+	for (size_t jj=0; jj<ny; jj++) {
+		for (size_t ii=0; ii<nx; ii++) {
+			grid(ii,jj) = 100.*sin(0.3*(double)ii) + 50.*cos(0.2*(double)jj) + (double)(rand()%1000)/100.;
+			if (rand()%17==0) grid(ii,jj) = IOUtils::nodata;
+		}
+	}
+	for (size_t jj=ny/3; jj<ny/2; jj++)
+		for (size_t ii=nx/4; ii<nx/3; ii++) grid(ii,jj) = IOUtils::nodata;
+	return grid;
+}
+
+static bool compare(const std::string& name, const Array2D<double>& result, const Array2D<double>& ref)
+{
+	if (result.getNx()!=ref.getNx() || result.getNy()!=ref.getNy()) {
+		cerr << name << ": got a " << result.getNx() << "x" << result.getNy() << " grid instead of " << ref.getNx() << "x" << ref.getNy() << "\n";
+		return false;
+	}
+	for (size_t jj=0; jj<ref.getNy(); jj++) {
+		for (size_t ii=0; ii<ref.getNx(); ii++) {
+			const double val = result(ii,jj), expected = ref(ii,jj);
+			if ((val==IOUtils::nodata) != (expected==IOUtils::nodata) || std::abs(val-expected)>1e-12*std::max(1., std::abs(expected))) {
+				cerr << name << ": got " << val << " instead of " << expected << " at (" << ii << "," << jj << ")\n";
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main() {
+	static const size_t sizes[][2] = {{1, 1}, {2, 3}, {7, 5}, {20, 13}, {33, 47}, {64, 64}};
+	static const double factors[][2] = {{1., 1.}, {2., 2.}, {2.5, 0.7}, {0.4, 0.4}, {3.3, 1.9}, {0.51, 4.}, {10., 10.}};
+	bool status = true;
+	unsigned int seed = 1;
+
+	//more size combinations than the axis cache can hold, so it also gets purged while resampling
+	for (const auto& size : sizes) {
+		const Array2D<double> grid( build_grid(size[0], size[1], seed++) );
+		for (const auto& factor : factors) {
+			std::ostringstream ss;
+			ss << size[0] << "x" << size[1] << " by (" << factor[0] << "," << factor[1] << ")";
+
+			const Array2D<double> bilinear( LibResampling2D::Bilinear(grid, factor[0], factor[1]) );
+			if (bilinear.getNx()==0 || bilinear.getNy()==0) continue;
+			status &= compare("Bilinear "+ss.str(), bilinear, ref_Bilinear(grid, bilinear.getNx(), bilinear.getNy()));
+
+			const Array2D<double> bspline( LibResampling2D::cubicBSpline(grid, factor[0], factor[1]) );
+			status &= compare("cubicBSpline "+ss.str(), bspline, ref_cubicBSpline(grid, bspline.getNx(), bspline.getNy()));
+
+			const Array2D<double> nearest( LibResampling2D::Nearest(grid, factor[0], factor[1]) );
+			status &= compare("Nearest "+ss.str(), nearest, ref_Nearest(grid, nearest.getNx(), nearest.getNy()));
+		}
+	}
+
+	cout << "Resampling fast paths: " << ((status)? "success" : "failed") << "\n";
+	if (!status)
+		throw IOException("Grid resampling error!", AT);
+
+	return 0;
+}
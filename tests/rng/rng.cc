@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const RandomNumberGenerator::RNG_TYPE rng_types[] = {RandomNumberGenerator::RNG_XOR, RandomNumberGenerator::RNG_PCG, RandomNumberGenerator::RNG_MTW};
+static const std::string rng_names[] = {"XOR", "PCG", "MTW"};
+
+//fill() must return exactly what as many single draws would return (draw() being the same as doub() for uniform deviates)
+static bool check_fill(const RandomNumberGenerator::RNG_TYPE& type, const std::string& name)
+{
+	bool status = true;
+	static const size_t sizes[] = {1, 7, 255, 256, 257, 1001};
+
+	for (const size_t& n : sizes) {
+		RandomNumberGenerator bulk(type);
+		RandomNumberGenerator single(bulk); //same state
+		std::vector<uint64_t> vecInt( n );
+		bulk.fill(&vecInt[0], n);
+		for (size_t ii=0; ii<n; ii++) {
+			if (vecInt[ii]!=single.int64()) {
+				cerr << name << ": fill(uint64_t*, " << n << ") differs from int64() at index " << ii << "\n";
+				status = false;
+				break;
+			}
+		}
+		if (bulk.int64()!=single.int64()) { //both should continue from the same state
+			cerr << name << ": the state after fill(uint64_t*, " << n << ") differs\n";
+			status = false;
+		}
+
+		for (const RandomNumberGenerator::RNG_DISTR distr : {RandomNumberGenerator::RNG_UNIFORM, RandomNumberGenerator::RNG_GAUSS, RandomNumberGenerator::RNG_GAMMA}) {
+			bulk.setDistribution( distr );
+			single = bulk;
+			std::vector<double> vecDouble( n );
+			bulk.fill(&vecDouble[0], n);
+			for (size_t ii=0; ii<n; ii++) {
+				if (vecDouble[ii]!=single.doub()) {
+					cerr << name << ": fill(double*, " << n << ") differs from doub() at index " << ii << " for distribution " << distr << "\n";
+					status = false;
+					break;
+				}
+			}
+			if (bulk.doub()!=single.doub()) {
+				cerr << name << ": the state after fill(double*, " << n << ") differs for distribution " << distr << "\n";
+				status = false;
+			}
+		}
+	}
+
+	cout << name << " fill: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//jump(k) must be the same as discarding k draws
+static bool check_jump(const RandomNumberGenerator::RNG_TYPE& type, const std::string& name)
+{
+	bool status = true;
+	static const uint64_t jumps[] = {0, 1, 2, 63, 64, 1000, 12345, 65537};
+
+	for (const uint64_t& k : jumps) {
+		RandomNumberGenerator jumped(type);
+		RandomNumberGenerator discarded(jumped);
+		jumped.jump( k );
+		for (uint64_t ii=0; ii<k; ii++) discarded.int64();
+
+		for (size_t ii=0; ii<10; ii++) {
+			if (jumped.int64()!=discarded.int64()) {
+				cerr << name << ": jump(" << k << ") differs from discarding " << k << " numbers\n";
+				status = false;
+				break;
+			}
+		}
+	}
+
+	//jumps must add up
+	RandomNumberGenerator twice(type);
+	RandomNumberGenerator once(twice);
+	twice.jump( 5000 );
+	twice.jump( 7000 );
+	once.jump( 12000 );
+	if (twice.int64()!=once.int64()) {
+		cerr << name << ": jump(5000)+jump(7000) differs from jump(12000)\n";
+		status = false;
+	}
+
+	cout << name << " jump: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static bool check_streams(const RandomNumberGenerator::RNG_TYPE& type, const std::string& name)
+{
+	bool status = true;
+	static const uint64_t max_streams = 1ULL << 15; //see MAX_STREAMS in RandomNumberGenerator.cc
+
+	const RandomNumberGenerator rng(type);
+	RandomNumberGenerator stream1( rng.getStream(1) ), stream1_again( rng.getStream(1) ), stream2( rng.getStream(2) );
+	RandomNumberGenerator stream0( rng.getStream(0) ), copy( rng );
+	const uint64_t first1 = stream1.int64();
+	if (first1!=stream1_again.int64() || first1==stream2.int64() || stream0.int64()!=copy.int64()) {
+		cerr << name << ": the streams are not reproducible or not independent\n";
+		status = false;
+	}
+
+	try {
+		rng.getStream( max_streams-1 );
+	} catch (const InvalidArgumentException&) {
+		cerr << name << ": the last stream has been rejected\n";
+		status = false;
+	}
+	for (const uint64_t idx : {max_streams, max_streams+1, static_cast<uint64_t>(-1)}) {
+		bool rejected = false;
+		try {
+			rng.getStream( idx );
+		} catch (const InvalidArgumentException&) {
+			rejected = true;
+		}
+		if (!rejected) {
+			cerr << name << ": the stream index " << idx << " has not been rejected\n";
+			status = false;
+		}
+	}
+
+	cout << name << " streams: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	bool status = true;
+	for (size_t ii=0; ii<sizeof(rng_types)/sizeof(rng_types[0]); ii++) {
+		status &= check_fill(rng_types[ii], rng_names[ii]);
+		status &= check_jump(rng_types[ii], rng_names[ii]);
+		status &= check_streams(rng_types[ii], rng_names[ii]);
+	}
+
+	if (!status)
+		throw IOException("Random number generator error!", AT);
+
+	return 0;
+}
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <set>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static const std::string tmp_path( "./shards_tmp" );
+static const size_t nr_stations = 7;
+static const Date data_start(2021, 1, 1, 0, 0, 1.);
+static const size_t nr_data_steps = 40*24; //hourly data over 40 days
+
+static bool expect_exception(const std::string& shard_str, const bool& format_error)
+{
+	size_t idx = 0, nr = 0;
+	try {
+		IOHandler::parseShard(shard_str, idx, nr);
+	} catch (const InvalidFormatException&) {
+		return format_error;
+	} catch (const InvalidArgumentException&) {
+		return !format_error;
+	}
+	cerr << "Shard '" << shard_str << "' should have been rejected\n";
+	return false;
+}
+
+static bool check_parsing()
+{
+	bool status = true;
+	size_t idx = 0, nr = 0;
+	IOHandler::parseShard("2/5", idx, nr);
+	status &= (idx==1 && nr==5);
+	IOHandler::parseShard("1/1", idx, nr);
+	status &= (idx==0 && nr==1);
+	IOHandler::parseShard("12/12", idx, nr);
+	status &= (idx==11 && nr==12);
+
+	for (const std::string str : {"", "3", "a/b", "1/", "/2", "x/3", "2/y", "1-3"})
+		status &= expect_exception(str, true);
+	for (const std::string str : {"0/3", "4/3", "1/0", "0/0"})
+		status &= expect_exception(str, false);
+
+	cout << "Parsing: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//the assignments must never change, otherwise the outputs of previous runs would be split differently
+static bool check_assignment()
+{
+	bool status = true;
+	//FNV-1a 64 bits reference values
+	static const uint64_t fnv_empty = 0xcbf29ce484222325ULL, fnv_a = 0xaf63dc4c8601ec8cULL, fnv_foobar = 0x85944171f73967e8ULL;
+	for (const size_t nr : {1, 2, 3, 7, 10, 1000003}) {
+		status &= (IOHandler::getShard("", nr)==fnv_empty % nr);
+		status &= (IOHandler::getShard("a", nr)==fnv_a % nr);
+		status &= (IOHandler::getShard("foobar", nr)==fnv_foobar % nr);
+	}
+
+	//every hash belongs to exactly one shard and the shards are reasonably balanced
+	static const size_t nr_shards = 4, nr_hashes = 4000;
+	std::vector<size_t> counts(nr_shards, 0);
+	for (size_t ii=0; ii<nr_hashes; ii++) {
+		const size_t shard = IOHandler::getShard("STA"+IOUtils::toString(ii), nr_shards);
+		if (shard>=nr_shards) {
+			status = false;
+			continue;
+		}
+		counts[shard]++;
+	}
+	for (const size_t count : counts) status &= (count>nr_hashes/nr_shards*8/10 && count<nr_hashes/nr_shards*12/10);
+
+	cout << "Assignment: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+static void write_input()
+{
+	FileUtils::createDirectories( tmp_path+"/input" );
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("COORDSYS", "Output", "CH1903");
+	cfg.addKey("TIME_ZONE", "Output", "1");
+	cfg.addKey("METEO", "Output", "SMET");
+	cfg.addKey("METEOPATH", "Output", tmp_path+"/input");
+	IOManager io(cfg);
+
+	std::vector<METEO_SET> vecMeteo(nr_stations);
+	for (size_t st=0; st<nr_stations; st++) {
+		Coords loc("CH1903", "");
+		loc.setXY(780000.+1000.*static_cast<double>(st), 189000., 1500.+100.*static_cast<double>(st));
+		const StationData sd(loc, "STA"+IOUtils::toString(st), "Station "+IOUtils::toString(st));
+		for (size_t ii=0; ii<nr_data_steps; ii++) {
+			if ((ii+st)%17==0 || (ii>300 && ii<310)) continue; //some gaps to resample over
+			MeteoData md(data_start + static_cast<double>(ii)/24., sd);
+			const double t = static_cast<double>(ii);
+			md(MeteoData::TA) = 268. + 5.*sin(t*0.26) + 0.01*static_cast<double>((ii*7919+st*104729)%1000);
+			md(MeteoData::RH) = 0.6 + 0.3*cos(t*0.11+static_cast<double>(st));
+			vecMeteo[st].push_back( md );
+		}
+	}
+	io.writeMeteoData( vecMeteo );
+}
+
+static Config input_config()
+{
+	Config cfg;
+	cfg.addKey("COORDSYS", "Input", "CH1903");
+	cfg.addKey("TIME_ZONE", "Input", "1");
+	cfg.addKey("METEO", "Input", "SMET");
+	cfg.addKey("METEOPATH", "Input", tmp_path+"/input");
+	for (size_t st=0; st<nr_stations; st++)
+		cfg.addKey("STATION"+IOUtils::toString(st+1), "Input", "STA"+IOUtils::toString(st));
+	cfg.addKey("BUFFER_SIZE", "General", "5"); //so that the unsharded run also has to rebuffer
+	cfg.addKey("TA::filter1", "Filters", "AGGREGATE");
+	cfg.addKey("TA::arg1::TYPE", "Filters", "MEAN");
+	cfg.addKey("TA::arg1::MIN_PTS", "Filters", "1");
+	cfg.addKey("TA::arg1::MIN_SPAN", "Filters", "21600");
+	cfg.addKey("RH::filter1", "Filters", "AGGREGATE");
+	cfg.addKey("RH::arg1::TYPE", "Filters", "MEDIAN");
+	cfg.addKey("RH::arg1::MIN_PTS", "Filters", "1");
+	cfg.addKey("RH::arg1::MIN_SPAN", "Filters", "43200");
+	cfg.addKey("RH::arg1::CENTERING", "Filters", "left");
+	return cfg;
+}
+
+//each station must belong to exactly one shard, the one given by getShard()
+static bool check_station_shards()
+{
+	bool status = true;
+	static const size_t nr_shards = 3;
+	std::set<std::string> found;
+	size_t nr_found = 0;
+	for (size_t kk=1; kk<=nr_shards; kk++) {
+		Config cfg( input_config() );
+		cfg.addKey("SHARD", "Input", IOUtils::toString(kk)+"/"+IOUtils::toString(nr_shards));
+		IOManager io(cfg);
+		std::vector<StationData> vecStation;
+		io.getStationData(data_start, vecStation);
+		for (const StationData& sd : vecStation) {
+			status &= (IOHandler::getShard(sd.getHash(), nr_shards)==kk-1);
+			found.insert( sd.getStationID() );
+			nr_found++;
+		}
+	}
+	status &= (found.size()==nr_stations && nr_found==nr_stations);
+
+	cout << "Station shards: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//read the requested timesteps one by one, as meteoio_timeseries does
+static void read_steps(const Date& start, const double& sampling_rate, const size_t& start_idx, const size_t& end_idx, std::vector<METEO_SET>& vecOut)
+{
+	IOManager io( input_config() );
+	for (size_t ii=start_idx; ii<end_idx; ii++) {
+		METEO_SET vecMeteo;
+		io.getMeteoData(start + static_cast<double>(ii)*sampling_rate, vecMeteo);
+		vecOut.push_back( vecMeteo );
+	}
+}
+
+//the time slabs, once merged, must give the same results as an unsharded run
+static bool check_time_slabs()
+{
+	bool status = true;
+	const Date start( data_start + 5. );
+	const double sampling_rate = 20./(24.*60.);
+	const size_t nr_steps = 30*24*3;
+
+	std::vector<METEO_SET> vecFull;
+	read_steps(start, sampling_rate, 0, nr_steps, vecFull);
+
+	for (const size_t nr_shards : {2, 3, 7}) {
+		std::vector<METEO_SET> vecMerged;
+		for (size_t shard_idx=0; shard_idx<nr_shards; shard_idx++) //same split as meteoio_timeseries
+			read_steps(start, sampling_rate, shard_idx*nr_steps/nr_shards, (shard_idx+1)*nr_steps/nr_shards, vecMerged);
+
+		if (vecMerged.size()!=vecFull.size()) {
+			cerr << "The " << nr_shards << " time slabs returned " << vecMerged.size() << " timesteps instead of " << vecFull.size() << "\n";
+			status = false;
+			continue;
+		}
+		size_t nr_diffs = 0;
+		for (size_t ii=0; ii<vecFull.size(); ii++) {
+			if (vecMerged[ii].size()!=vecFull[ii].size()) {
+				nr_diffs++;
+				continue;
+			}
+			for (size_t st=0; st<vecFull[ii].size(); st++) {
+				if (vecMerged[ii][st]!=vecFull[ii][st]) nr_diffs++;
+			}
+		}
+		if (nr_diffs>0) {
+			cerr << "The " << nr_shards << " time slabs differ from the unsharded run for " << nr_diffs << " records\n";
+			status = false;
+		}
+	}
+
+	cout << "Time slabs: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool parsing_status = check_parsing();
+	const bool assignment_status = check_assignment();
+	write_input();
+	const bool stations_status = check_station_shards();
+	const bool slabs_status = check_time_slabs();
+
+	if (!parsing_status || !assignment_status || !stations_status || !slabs_status)
+		throw IOException("Sharding error!", AT);
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include <cstdlib>
+#include <meteoio/MeteoIO.h>
+
+using namespace std;
+using namespace mio;
+
+static StationData make_station(const std::string& id, const std::string& name, const double& altitude)
+{
+	Coords position("CH1903", "");
+	position.setXY(780000., 189000., altitude);
+	StationData sd(position, id, name);
+	sd.setSlope(35., 180.);
+	return sd;
+}
+
+//identical metadata must be interned only once
+static bool check_interning()
+{
+	bool status = true;
+	const StationData sd1( make_station("WFJ2", "Weissfluhjoch", 2540.) );
+	const StationData sd2( make_station("WFJ2", "Weissfluhjoch", 2540.) );
+	const SharedStationData h1( sd1 ), h2( sd2 );
+	status &= (h1.get()==h2.get());
+
+	const SharedStationData h3( make_station("WFJ2", "Weissfluhjoch", 2541.) );
+	const SharedStationData h4( make_station("WFJ2", "Davos", 2540.) );
+	status &= (h3.get()!=h1.get());
+	status &= (h4.get()!=h1.get());
+
+	//all the copies of a MeteoData point to the same metadata
+	const MeteoData md1( Date(2020, 1, 1, 0, 0, 1.), sd1 );
+	const MeteoData md2( md1 );
+	MeteoData md3( Date(2020, 1, 1, 1, 0, 1.), sd2 );
+	status &= (md1.meta.get()==h1.get() && md2.meta.get()==h1.get() && md3.meta.get()==h1.get());
+
+	//a modified copy of the metadata is interned separately and leaves the other data points untouched
+	StationData sd( md3.meta );
+	sd.stationName = "Davos";
+	md3.meta = sd;
+	status &= (md3.meta.get()==h4.get());
+	status &= (md1.meta.getStationName()=="Weissfluhjoch");
+
+	//the forwarded getters
+	status &= (md1.meta.getStationID()=="WFJ2" && md1.meta.getAltitude()==2540. && md1.meta.getSlopeAngle()==35. && md1.meta.getAzimuth()==180.);
+	status &= (md1.meta.getPosition()==sd1.position && md1.meta.getHash()==sd1.getHash() && md1.meta.toString()==sd1.toString());
+
+	cout << "Interning: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+//operator== ignores the station name while isIdentical() compares all the fields
+static bool check_comparisons()
+{
+	bool status = true;
+	const SharedStationData h1( make_station("WFJ2", "Weissfluhjoch", 2540.) );
+	const SharedStationData h2( make_station("WFJ2", "Davos", 2540.) );
+	const SharedStationData h3( make_station("WFJ2", "Weissfluhjoch", 2600.) );
+
+	status &= (h1==h2 && !(h1!=h2));
+	status &= (!h1.isIdentical(*h2) && !h1->isIdentical(*h2));
+	status &= (h1!=h3 && !h1.isIdentical(*h3));
+	status &= (h1==*h2 && h1.isIdentical(*h1));
+
+	StationData sd( *h1 );
+	sd.extra["sensor"] = "HMP45";
+	status &= (sd==*h1 && !sd.isIdentical(*h1));
+	status &= (SharedStationData(sd).get()!=h1.get());
+
+	cout << "Comparisons: " << ((status)? "success" : "failed") << "\n";
+	return status;
+}
+
+int main() {
+	const bool interning_status = check_interning();
+	const bool comparisons_status = check_comparisons();
+
+	if (!interning_status || !comparisons_status)
+		throw IOException("Station metadata error!", AT);
+
+	return 0;
+}
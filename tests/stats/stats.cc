@@ -324,6 +324,91 @@ static bool check_regressions(const vector<double>& x, const vector<double>& y)
 	return status;
 }
 
+//give access to the analytic and finite differences derivatives of a least square model
+template <class T> class GradientCheck : public T {
+	public:
+		GradientCheck() : T() {}
+		bool hasGradient() {
+			std::vector<double> grad(this->nParam);
+			return this->gradient(1., grad);
+		}
+		bool check(const std::vector<double>& lambda, const vector<double>& vecX) {
+			this->setGuess(lambda);
+			std::vector<double> grad(this->nParam);
+			bool status = true;
+			for (size_t ii=0; ii<vecX.size(); ii++) {
+				if (!this->gradient(vecX[ii], grad)) return false;
+				for (size_t jj=0; jj<this->nParam; jj++) {
+					const double dder = this->DDer(vecX[ii], jj+1);
+					if (!IOUtils::checkEpsilonEquality(grad[jj], dder, 1e-9*std::max(1., std::abs(dder)))) {
+						std::cout << "wrong gradient for " << this->getName() << " at x=" << vecX[ii] << " for parameter " << jj << ": ";
+						std::cout << setprecision(12) << grad[jj] << " instead of " << dder << "\n";
+						status = false;
+					}
+				}
+			}
+			return status;
+		}
+};
+
+static bool check_gradients(const vector<double>& x) {
+	bool status = true;
+	vector<double> X( x );
+	X.push_back( 0. );
+
+	status &= GradientCheck<LinearLS>().check({-0.5, 12.8}, X);
+	status &= GradientCheck<LinVario>().check({0.05, 0.02}, X);
+	status &= GradientCheck<Quadratic>().check({0.0017, -0.36, -98.4}, X);
+
+	//the non-linear variograms rely on finite differences
+	status &= !GradientCheck<SphericVario>().hasGradient();
+	status &= !GradientCheck<ExpVario>().hasGradient();
+	status &= !GradientCheck<RatQuadVario>().hasGradient();
+
+	if (status)
+		std::cout << "Gradients: success\n";
+	else
+		std::cout << "Gradients: failed\n";
+	return status;
+}
+
+//the non-linear variograms must keep converging to the same coefficients
+static bool check_variograms() {
+	bool status = true;
+	const vector<double> X = {2., 5., 7., 10., 14., 19., 22., 39., 60., 90., 100.};
+	const vector<double> Y_spheric = {0.104297, 0.170506, 0.228454, 0.306584, 0.405278, 0.505431, 0.567754, 0.737875, 0.743890, 0.738105, 0.758723};
+	const vector<double> Y_exp = {0.140379, 0.244428, 0.313038, 0.390608, 0.471731, 0.556761, 0.587515, 0.700008, 0.735179, 0.751265, 0.748109};
+	const vector<double> guess = {0.1, 1., 40.};
+
+	Fit1D fit(Fit1D::SPHERICVARIO, X, Y_spheric, false);
+	fit.setGuess(guess);
+	vector<double> coeff;
+	if (fit.fit()) coeff = fit.getParams();
+	if (coeff.size()!=3 || !IOUtils::checkEpsilonEquality(coeff[0], 0.0474855, 1e-6) ||
+	    !IOUtils::checkEpsilonEquality(coeff[1], 0.6974362, 1e-6) ||
+	    !IOUtils::checkEpsilonEquality(coeff[2], 39.8255671, 1e-6)) {
+		std::cout << "wrong results for the spherical variogram: " << fit.toString() << "\n";
+		status = false;
+	}
+
+	fit.setModel(Fit1D::EXPVARIO, X, Y_exp, false);
+	fit.setGuess(guess);
+	coeff.clear();
+	if (fit.fit()) coeff = fit.getParams();
+	if (coeff.size()!=3 || !IOUtils::checkEpsilonEquality(coeff[0], 0.0509106, 1e-6) ||
+	    !IOUtils::checkEpsilonEquality(coeff[1], 0.6997639, 1e-6) ||
+	    !IOUtils::checkEpsilonEquality(coeff[2], 15.0485826, 1e-6)) {
+		std::cout << "wrong results for the exponential variogram: " << fit.toString() << "\n";
+		status = false;
+	}
+
+	if (status)
+		std::cout << "Variograms: success\n";
+	else
+		std::cout << "Variograms: failed\n";
+	return status;
+}
+
 int main() {
 	vector<double> x,y;
 	//cr_rand_vectors(x, y);
@@ -336,8 +421,10 @@ int main() {
 	const bool der_status = check_derivative(x,y);
 	const bool quantiles_status = check_quantiles(x);
 	const bool regressions_status = check_regressions(x, y);
+	const bool gradients_status = check_gradients(x);
+	const bool variograms_status = check_variograms();
 
-	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status)
+	if(!basics_status || !sort_status || !bin_status || !quantiles_status || !covariance_status || !der_status || !regressions_status || !gradients_status || !variograms_status)
 		throw IOException("Statistical functions error!", AT);
 
 
@@ -83,7 +83,7 @@ MACRO (SET_COMPILER_OPTIONS)
 			LIST(APPEND CFLAGS " -D_USE_MATH_DEFINES") #USE_MATH_DEFINES needed for Win32
 		ENDIF(WIN32)
 		
-		SET(WARNINGS "-Wall -Wno-long-long -Wswitch") #-Wno-unknown-pragmas
+		SET(WARNINGS "-Wall -Wno-long-long -Wswitch") #-Wno-unknown-pragmas is added when not using USE_OPENMP
 		SET(DEEP_WARNINGS "-Wunused-value -Wshadow -Wpointer-arith -Wconversion -Winline -Wdisabled-optimization -Wctor-dtor-privacy") #-Wfloat-equal -Wpadded
 		SET(EXTRA_WARNINGS "-Wextra -pedantic -Weffc++ ${DEEP_WARNINGS}")
 		SET(OPTIM "-g -O3 -DNDEBUG -DNOSAFECHECKS")